@@ -197,3 +197,46 @@ macro(dune_probe_cpu_variant)
     set(DUNE_CPU_VARIANT_UCASE "${DUNE_CPU_UCASE}")
   endif(NOT DUNE_CPU_VARIANT)
 endmacro(dune_probe_cpu_variant)
+
+macro(dune_probe_cpu_simd)
+  message(STATUS "")
+  message(STATUS "******************************************")
+  message(STATUS "***  Probing Target CPU Vector Units   ***")
+  message(STATUS "******************************************")
+
+  # AVX2/FMA kernels are compiled with function level target
+  # attributes and selected at runtime.
+  if(DUNE_CPU_X86)
+    check_cxx_source_compiles("
+#include <immintrin.h>
+
+__attribute__((target(\"avx2,fma\"))) static double
+f(const double* p)
+{
+  double o[4];
+  __m256d v = _mm256_loadu_pd(p);
+  _mm256_storeu_pd(o, _mm256_fmadd_pd(v, v, v));
+  return o[0];
+}
+
+int main(void)
+{
+  double p[4] = {0, 0, 0, 0};
+  __builtin_cpu_init();
+  return __builtin_cpu_supports(\"avx2\") ? (int)f(p) : 0;
+}
+" DUNE_CPU_HAS_AVX2)
+  endif(DUNE_CPU_X86)
+
+  # Advanced SIMD with double precision lanes (AArch64).
+  check_cxx_source_compiles("
+#include <arm_neon.h>
+
+int main(void)
+{
+  float64x2_t v = vdupq_n_f64(1.0);
+  v = vfmaq_f64(v, v, v);
+  return (int)vaddvq_f64(v);
+}
+" DUNE_CPU_HAS_NEON)
+endmacro(dune_probe_cpu_simd)
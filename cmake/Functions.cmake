@@ -206,6 +206,12 @@ macro(dune_probe_functions)
     "pthread.h"
     DUNE_SYS_HAS_PTHREAD_CONDATTR_SETCLOCK)
 
+  dune_test_function(pthread_setaffinity_np
+    "int"
+    "pthread_t;size_t;cpu_set_t*"
+    "sched.h;pthread.h"
+    DUNE_SYS_HAS_PTHREAD_SETAFFINITY_NP)
+
   dune_test_function(sigaction
     "int"
     "int;struct sigaction*;struct sigaction*"
@@ -698,6 +704,18 @@ macro(dune_probe_functions)
     ""
     DUNE_SYS_HAS___SYNC_SUB_AND_FETCH)
 
+  dune_test_function(__sync_bool_compare_and_swap
+    "bool"
+    "int*;int;int"
+    ""
+    DUNE_SYS_HAS___SYNC_BOOL_COMPARE_AND_SWAP)
+
+  dune_test_function(__sync_synchronize
+    "void"
+    ""
+    ""
+    DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+
   dune_test_function(fork
     "pid_t"
     ""
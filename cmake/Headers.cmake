@@ -108,6 +108,7 @@ macro(dune_probe_headers)
   dune_test_header(linux/i2c.h)
   dune_test_header(linux/rtc.h)
   dune_test_header(linux/input.h)
+  dune_test_header(linux/futex.h)
   dune_test_header(netdb.h)
   dune_test_header(pthread.h)
   dune_test_header(signal.h)
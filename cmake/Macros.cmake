@@ -39,6 +39,7 @@ macro(DUNE_PROBE_SYSTEM)
   dune_probe_cxx()
   dune_probe_cpu()
   dune_probe_cpu_variant()
+  dune_probe_cpu_simd()
   dune_probe_os()
   dune_probe_cxx_lib()
   dune_probe_libs()
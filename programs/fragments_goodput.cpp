@@ -0,0 +1,117 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Jose Pinto                                                       *
+//***************************************************************************
+// Utility program to benchmark goodput of fragmented messages with and     *
+// without parity fragments over a link with random fragment losses.       *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstdlib>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Network/Fragments.hpp>
+#include <DUNE/Network/FragmentedMessage.hpp>
+
+using DUNE_NAMESPACES;
+
+int
+main(int argc, char** argv)
+{
+  --argc; ++argv;
+
+  int mtu = argc >= 1 ? std::atoi(argv[0]) : 64;
+  int size = argc >= 2 ? std::atoi(argv[1]) : 1024;
+  int trials = argc >= 3 ? std::atoi(argv[2]) : 500;
+
+  static const float c_losses[] = {0.0f, 0.05f, 0.1f, 0.2f, 0.3f};
+  static const float c_redundancies[] = {0.0f, 0.25f, 0.5f, 1.0f};
+
+  IMC::LogBookEntry msg;
+  msg.text.resize(size);
+  for (int i = 0; i < size; ++i)
+    msg.text[i] = 'a' + (i % 26);
+
+  Math::Random::Generator* prng = Math::Random::Factory::create(Math::Random::Factory::c_default, 0);
+
+  std::printf("MTU: %d, message size: %u, trials: %d\n", mtu, msg.getSerializationSize(), trials);
+  std::printf("%6s %10s %6s %10s %10s %12s %12s\n",
+              "loss", "redundancy", "frags", "delivered", "goodput", "encode (us)", "decode (us)");
+
+  for (unsigned l = 0; l < sizeof(c_losses) / sizeof(c_losses[0]); ++l)
+  {
+    for (unsigned r = 0; r < sizeof(c_redundancies) / sizeof(c_redundancies[0]); ++r)
+    {
+      int delivered = 0;
+      int frags = 0;
+      double sent_bytes = 0;
+      double encode_time = 0;
+      double decode_time = 0;
+
+      for (int t = 0; t < trials; ++t)
+      {
+        double start = Clock::get();
+        Network::Fragments out(&msg, mtu, c_redundancies[r]);
+        encode_time += Clock::get() - start;
+
+        frags = out.getNumberOfFragments();
+        sent_bytes += frags * mtu;
+        Network::FragmentedMessage in;
+        in.enableParity(true);
+        IMC::Message* result = NULL;
+
+        for (int i = 0; i < frags; ++i)
+        {
+          if (prng->uniform() < c_losses[l])
+            continue;
+
+          start = Clock::get();
+          result = in.setFragment(out.getFragment(i));
+          decode_time += Clock::get() - start;
+
+          if (result != NULL)
+            break;
+        }
+
+        if (result != NULL)
+        {
+          ++delivered;
+          delete result;
+        }
+      }
+
+      std::printf("%6.2f %10.2f %6d %9.1f%% %9.1f%% %12.1f %12.1f\n",
+                  c_losses[l], c_redundancies[r], frags,
+                  100.0 * delivered / trials,
+                  100.0 * delivered * msg.getSerializationSize() / sent_bytes,
+                  encode_time * 1e6 / trials, decode_time * 1e6 / trials);
+    }
+  }
+
+  delete prng;
+  return 0;
+}
@@ -0,0 +1,144 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to benchmark the throughput of geodetic conversions,     *
+// comparing per-point WGS84 calls against the batch conversions of         *
+// WGS84, LocalFrame and UTM.                                               *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Print one result line.
+static void
+report(const char* name, double time, size_t points, double error)
+{
+  std::printf("%-28s %12.2f %12g\n", name, points / time * 1e-6, error);
+}
+
+int
+main(int argc, char** argv)
+{
+  size_t count = argc >= 2 ? std::atoi(argv[1]) : 10000;
+  int iterations = argc >= 3 ? std::atoi(argv[2]) : 100;
+
+  const double ref_lat = Angles::radians(41.1850);
+  const double ref_lon = Angles::radians(-8.7060);
+
+  std::vector<double> lat(count), lon(count), hae(count);
+  std::vector<double> n(count), e(count), d(count);
+  std::vector<double> bn(count), be(count), bd(count);
+  std::vector<double> lat2(count), lon2(count), hae2(count);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    lat[i] = ref_lat + 0.01 * std::sin(0.37 * i);
+    lon[i] = ref_lon + 0.01 * std::cos(0.11 * i);
+    hae[i] = 10.0 * std::sin(0.05 * i);
+  }
+
+  size_t points = count * iterations;
+  std::printf("%-28s %12s %12s\n", "conversion", "Mpoints/s", "difference");
+
+  // Geodetic to NED.
+  double start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+      WGS84::displacement(ref_lat, ref_lon, 0.0, lat[i], lon[i], hae[i], &n[i], &e[i], &d[i]);
+  }
+  report("WGS84::displacement", Clock::get() - start, points, 0.0);
+
+  LocalFrame frame(ref_lat, ref_lon);
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+    frame.toNED(&lat[0], &lon[0], &hae[0], count, &bn[0], &be[0], &bd[0]);
+  double time = Clock::get() - start;
+
+  double error = 0.0;
+  for (size_t i = 0; i < count; ++i)
+    error = std::max(error, std::fabs(n[i] - bn[i]) + std::fabs(e[i] - be[i]) + std::fabs(d[i] - bd[i]));
+  report("LocalFrame::toNED", time, points, error);
+
+  // NED to geodetic.
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      lat2[i] = ref_lat;
+      lon2[i] = ref_lon;
+      hae2[i] = 0.0;
+      WGS84::displace(n[i], e[i], d[i], &lat2[i], &lon2[i], &hae2[i]);
+    }
+  }
+  report("WGS84::displace", Clock::get() - start, points, 0.0);
+
+  std::vector<double> blat(count), blon(count), bhae(count);
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+    frame.fromNED(&n[0], &e[0], &d[0], count, &blat[0], &blon[0], &bhae[0]);
+  time = Clock::get() - start;
+
+  error = 0.0;
+  for (size_t i = 0; i < count; ++i)
+    error = std::max(error, (std::fabs(lat2[i] - blat[i]) + std::fabs(lon2[i] - blon[i])) * c_wgs84_a);
+  report("LocalFrame::fromNED", time, points, error);
+
+  // UTM.
+  std::vector<double> north(count), east(count);
+  std::vector<int> zone(count);
+  bool* hem = new bool[count];
+
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+    UTM::fromWGS84(&lat[0], &lon[0], count, &north[0], &east[0], &zone[0], hem);
+  report("UTM::fromWGS84 (batch)", Clock::get() - start, points, 0.0);
+
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+    UTM::toWGS84(&north[0], &east[0], count, zone[0], hem[0], &blat[0], &blon[0]);
+  time = Clock::get() - start;
+
+  error = 0.0;
+  for (size_t i = 0; i < count; ++i)
+    error = std::max(error, (std::fabs(lat[i] - blat[i]) + std::fabs(lon[i] - blon[i])) * c_wgs84_a);
+  report("UTM::toWGS84 (batch)", time, points, error);
+
+  delete [] hem;
+
+  return 0;
+}
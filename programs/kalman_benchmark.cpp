@@ -0,0 +1,243 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Jose Pinto                                                       *
+//***************************************************************************
+// Utility program to benchmark one cycle (predict and update) of a         *
+// 9-state Kalman filter implemented with Math::Matrix, with               *
+// Math::FixedMatrix and with the update strategies of                      *
+// Navigation::KalmanFilter.                                                *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstdlib>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+// Number of states (position, velocity and acceleration in 3D).
+static const size_t c_states = 9;
+// Number of outputs (position in 3D).
+static const size_t c_outputs = 3;
+// Sampling period (s).
+static const double c_period = 0.01;
+
+typedef FixedMatrix<c_states, c_states> StateMatrix;
+typedef FixedMatrix<c_states, 1> StateVector;
+typedef FixedMatrix<c_outputs, c_states> OutputMatrix;
+typedef FixedMatrix<c_outputs, c_outputs> OutputCovariance;
+typedef FixedMatrix<c_outputs, 1> OutputVector;
+
+//! Build constant acceleration model matrices.
+static void
+buildModel(StateMatrix& a, StateMatrix& q, OutputMatrix& h, OutputCovariance& r)
+{
+  a.identity();
+  for (size_t i = 0; i < 3; ++i)
+  {
+    a(i, i + 3) = c_period;
+    a(i, i + 6) = 0.5 * c_period * c_period;
+    a(i + 3, i + 6) = c_period;
+  }
+
+  q.fill(0.0);
+  for (size_t i = 0; i < c_states; ++i)
+    q(i, i) = (i < 6) ? 1e-4 : 1e-2;
+
+  h.fill(0.0);
+  for (size_t i = 0; i < c_outputs; ++i)
+    h(i, i) = 1.0;
+
+  r.identity();
+  r *= 0.25;
+}
+
+//! Generic (heap allocated) filter, written as the navigation tasks do.
+struct DynamicFilter
+{
+  Matrix a, q, h, r, x, p;
+
+  void
+  step(const Matrix& z)
+  {
+    x = a * x;
+    p = a * p * transpose(a) + q;
+
+    Matrix s = h * p * transpose(h) + r;
+    Matrix k = p * transpose(h) * inverse(s);
+    x = x + k * (z - h * x);
+    p = (Matrix(c_states) - k * h) * p;
+  }
+};
+
+//! Fixed size filter using fused operations.
+struct FixedFilter
+{
+  StateMatrix a, q, p;
+  OutputMatrix h;
+  OutputCovariance r;
+  StateVector x;
+
+  void
+  step(const OutputVector& z)
+  {
+    StateVector xp;
+    multiply(a, x, xp);
+    x = xp;
+
+    StateMatrix pp;
+    multiplyAPAT(a, p, pp);
+    p = pp + q;
+
+    OutputCovariance s;
+    multiplyAPAT(h, p, s);
+    s += r;
+
+    FixedMatrix<c_states, c_outputs> pht;
+    multiplyTransposed(p, h, pht);
+    FixedMatrix<c_states, c_outputs> k = pht * inverse(s);
+
+    OutputVector hx;
+    multiply(h, x, hx);
+    x += k * (z - hx);
+
+    StateMatrix ikh;
+    ikh.identity();
+    ikh -= k * h;
+    multiply(ikh, p, pp);
+    p = pp;
+  }
+};
+
+//! Navigation::KalmanFilter with a given update strategy.
+struct NavigationFilter
+{
+  Navigation::KalmanFilter kf;
+
+  void
+  setup(const Matrix& a, const Matrix& q, const Matrix& h, const Matrix& r)
+  {
+    kf.reset(c_states, c_outputs);
+    kf.setTransitions(a);
+    kf.setCovariance(1.0);
+    for (size_t i = 0; i < c_states; ++i)
+      kf.setProcessNoise(i, q(i, i));
+    for (size_t i = 0; i < c_outputs; ++i)
+    {
+      kf.setMeasurementNoise(i, r(i, i));
+      for (size_t j = 0; j < c_states; ++j)
+        kf.setObservation(i, j, h(i, j));
+    }
+  }
+
+  void
+  step(const OutputVector& z)
+  {
+    kf.predict();
+    for (size_t i = 0; i < c_outputs; ++i)
+      kf.setInnovation(i, z(i) - kf.getState(i));
+    kf.update(0.0);
+  }
+};
+
+int
+main(int argc, char** argv)
+{
+  int iterations = argc >= 2 ? std::atoi(argv[1]) : 100000;
+
+  StateMatrix a, q;
+  OutputMatrix h;
+  OutputCovariance r;
+  buildModel(a, q, h, r);
+
+  FixedFilter ff;
+  ff.a = a;
+  ff.q = q;
+  ff.h = h;
+  ff.r = r;
+  ff.p.identity();
+
+  DynamicFilter df;
+  df.a = a.toMatrix();
+  df.q = q.toMatrix();
+  df.h = h.toMatrix();
+  df.r = r.toMatrix();
+  df.x = StateVector().toMatrix();
+  df.p = Matrix(c_states);
+
+  Math::Random::Generator* prng = Math::Random::Factory::create(Math::Random::Factory::c_default, 0);
+  std::vector<OutputVector> measurements(1000);
+  for (size_t i = 0; i < measurements.size(); ++i)
+  {
+    for (size_t j = 0; j < c_outputs; ++j)
+      measurements[i](j) = 10.0 * std::sin(0.01 * i + j) + 0.5 * prng->gaussian();
+  }
+  delete prng;
+
+  std::vector<Matrix> dynamic_measurements(measurements.size());
+  for (size_t i = 0; i < measurements.size(); ++i)
+    dynamic_measurements[i] = measurements[i].toMatrix();
+
+  double start = Clock::get();
+  for (int i = 0; i < iterations; ++i)
+    df.step(dynamic_measurements[i % measurements.size()]);
+  double dynamic_time = Clock::get() - start;
+
+  start = Clock::get();
+  for (int i = 0; i < iterations; ++i)
+    ff.step(measurements[i % measurements.size()]);
+  double fixed_time = Clock::get() - start;
+
+  double error = (StateVector(df.x) - ff.x).norm_2() + (StateMatrix(df.p) - ff.p).norm_2();
+
+  std::printf("%-24s %12s %12s\n", "implementation", "cycle (us)", "difference");
+  std::printf("%-24s %12.3f %12s\n", "Matrix", dynamic_time * 1e6 / iterations, "-");
+  std::printf("%-24s %12.3f %12g\n", "FixedMatrix", fixed_time * 1e6 / iterations, error);
+
+  // Navigation::KalmanFilter update strategies.
+  const char* names[] = {"KalmanFilter (batch)", "KalmanFilter (scalar)", "KalmanFilter (U-D)"};
+  for (int v = 0; v < 3; ++v)
+  {
+    NavigationFilter nf;
+    nf.setup(df.a, df.q, df.h, df.r);
+    nf.kf.setSequentialUpdates(v != 0);
+    if (v == 2)
+      nf.kf.setCovarianceForm(Navigation::KalmanFilter::CF_UD);
+
+    start = Clock::get();
+    for (int i = 0; i < iterations; ++i)
+      nf.step(measurements[i % measurements.size()]);
+    double time = Clock::get() - start;
+
+    error = ((StateVector(nf.kf.getState()) - ff.x).norm_2()
+             + (StateMatrix(nf.kf.getCovariance()) - ff.p).norm_2());
+
+    std::printf("%-24s %12.3f %12g\n", names[v], time * 1e6 / iterations, error);
+  }
+
+  return 0;
+}
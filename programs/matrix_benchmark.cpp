@@ -0,0 +1,196 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to benchmark the dense matrix kernels (multiplication,   *
+// covariance propagation, Cholesky and LU solves) against the reference    *
+// Math::Matrix operators for sizes ranging from 3x3 to 100x100.            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+// Matrix orders to benchmark.
+static const size_t c_sizes[] = {3, 6, 9, 12, 16, 24, 32, 48, 64, 100};
+// Number of matrix orders.
+static const size_t c_size_count = sizeof(c_sizes) / sizeof(c_sizes[0]);
+// Approximate number of floating point operations per measurement.
+static const double c_work = 2e8;
+
+//! Fill matrix with uniformly distributed values in [-1, 1].
+static void
+randomize(Matrix& m, Math::Random::Generator* prng)
+{
+  for (int i = 0; i < m.size(); ++i)
+    m(i) = prng->uniform(-1.0, 1.0);
+}
+
+//! Build a well conditioned symmetric positive definite matrix.
+static Matrix
+spd(size_t n, Math::Random::Generator* prng)
+{
+  Matrix a(n, n);
+  randomize(a, prng);
+  Matrix s;
+  multiplyTransposed(a, a, s);
+  for (size_t i = 0; i < n; ++i)
+    s(i, i) += (double)n;
+  return s;
+}
+
+//! Largest absolute difference between two matrices.
+static double
+difference(const Matrix& a, const Matrix& b)
+{
+  double d = 0.0;
+  for (int i = 0; i < a.size(); ++i)
+    d = std::max(d, std::fabs(a(i) - b(i)));
+  return d;
+}
+
+//! Compute number of repetitions for an operation of 'flops'.
+static unsigned
+repetitions(double flops)
+{
+  double r = c_work / flops;
+  return r < 10 ? 10 : (unsigned)r;
+}
+
+//! Time the reference operators and the kernels for one matrix order.
+static void
+run(size_t n, Math::Random::Generator* prng, const char* impl)
+{
+  Matrix a(n, n), b(n, n);
+  randomize(a, prng);
+  randomize(b, prng);
+  Matrix p = spd(n, prng);
+  Matrix rhs(n, 1);
+  randomize(rhs, prng);
+
+  Matrix ref, out;
+  double start = 0;
+  unsigned reps = 0;
+
+  // Multiplication.
+  reps = repetitions(2.0 * n * n * n);
+  Kernels::setImplementation("generic");
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    ref = a * b;
+  double mul_generic = (Clock::get() - start) / reps;
+
+  Kernels::setImplementation(impl);
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    multiply(a, b, out);
+  double mul_kernel = (Clock::get() - start) / reps;
+  double mul_error = difference(ref, out);
+
+  // Covariance propagation (A * P * A^T).
+  reps = repetitions(3.0 * n * n * n);
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    ref = a * p * transpose(a);
+  double apat_reference = (Clock::get() - start) / reps;
+
+  Matrix work;
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    multiplyAPAT(a, p, out, work);
+  double apat_kernel = (Clock::get() - start) / reps;
+  double apat_error = difference(ref, out);
+
+  // Solve of a symmetric positive definite system.
+  reps = repetitions(2.0 * n * n * n);
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    ref = inverse(p) * rhs;
+  double chol_reference = (Clock::get() - start) / reps;
+
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    out = cholesky_solve(cholesky(p), rhs);
+  double chol_kernel = (Clock::get() - start) / reps;
+  double chol_error = difference(ref, out);
+
+  // Solve of a general system.
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    ref = inverse(a) * rhs;
+  double lu_reference = (Clock::get() - start) / reps;
+
+  start = Clock::get();
+  for (unsigned i = 0; i < reps; ++i)
+    out = lu_solve(a, rhs);
+  double lu_kernel = (Clock::get() - start) / reps;
+  double lu_error = difference(ref, out);
+
+  std::printf("%4u | %9.2f %9.2f %8.2e | %9.2f %9.2f %8.2e | %9.2f %9.2f %8.2e | %9.2f %9.2f %8.2e\n",
+              (unsigned)n,
+              mul_generic * 1e6, mul_kernel * 1e6, mul_error,
+              apat_reference * 1e6, apat_kernel * 1e6, apat_error,
+              chol_reference * 1e6, chol_kernel * 1e6, chol_error,
+              lu_reference * 1e6, lu_kernel * 1e6, lu_error);
+}
+
+int
+main(int argc, char** argv)
+{
+  const char* impl = Kernels::getImplementation();
+
+  if (argc >= 2)
+  {
+    if (!Kernels::setImplementation(argv[1]))
+    {
+      std::fprintf(stderr, "ERROR: implementation '%s' is not available\n", argv[1]);
+      return 1;
+    }
+
+    impl = argv[1];
+  }
+
+  std::printf("kernels: %s, times in microseconds per operation\n\n", impl);
+  std::printf("%4s | %-29s | %-29s | %-29s | %-29s\n", "n",
+              "A * B (generic/kernel/err)",
+              "A * P * A^T (ref/kernel/err)",
+              "P^-1 * b (inv/chol/err)",
+              "A^-1 * b (inv/lu/err)");
+
+  Math::Random::Generator* prng = Math::Random::Factory::create(Math::Random::Factory::c_default, 0);
+
+  for (size_t i = 0; i < c_size_count; ++i)
+    run(c_sizes[i], prng, impl);
+
+  delete prng;
+
+  return 0;
+}
@@ -27,7 +27,9 @@
 
 // ISO C++ 98 headers.
 #include <cstdlib>
+#include <cmath>
 #include <fstream>
+#include <string>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -36,14 +38,94 @@ using DUNE_NAMESPACES;
 
 using namespace DUNE::Math;
 
+// Pseudo-random value in [-1, 1].
+static double
+uniform(unsigned& seed)
+{
+  seed = seed * 1103515245U + 12345U;
+  return ((seed >> 8) & 0xffff) / 32768.0 - 1.0;
+}
+
+// Solve a sequence of problems with constant Hessian and constraint
+// matrix, as found in receding horizon control, comparing one-shot
+// solves against a solver object with and without warm start.
+static int
+benchmark(int n_var, int n_constr, int iterations)
+{
+  unsigned seed = 1;
+  Matrix M(n_var, n_var);
+  for (int i = 0; i < M.size(); ++i)
+    M(i) = uniform(seed);
+
+  Matrix H = M * transpose(M) + Matrix(n_var) * 0.5;
+  Matrix f(n_var, 1);
+  Matrix A(n_constr, n_var);
+  Matrix b(n_constr, 1);
+
+  for (int i = 0; i < A.size(); ++i)
+    A(i) = uniform(seed);
+
+  for (int i = 0; i < n_constr; ++i)
+    b(i) = 1.0 + uniform(seed);
+
+  QPSolver cold;
+  cold.setHessian(H);
+  cold.setWarmStart(false);
+
+  QPSolver warm;
+  warm.setHessian(H);
+
+  double times[3] = {0, 0, 0};
+  double error = 0;
+  Matrix x[3];
+
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (int i = 0; i < n_var; ++i)
+      f(i) = 3.0 * std::sin(0.01 * k + i);
+
+    for (int i = 0; i < n_constr; ++i)
+      b(i) += 0.02 * uniform(seed);
+
+    double t = Clock::get();
+    QPSolver::solve(H, f, A, b, x[0]);
+    times[0] += Clock::get() - t;
+
+    t = Clock::get();
+    cold.solve(f, A, b, x[1]);
+    times[1] += Clock::get() - t;
+
+    t = Clock::get();
+    warm.solve(f, A, b, x[2]);
+    times[2] += Clock::get() - t;
+
+    for (int i = 0; i < n_var; ++i)
+      error = std::max(error, std::fabs(x[0](i) - x[2](i)));
+  }
+
+  const char* names[3] = {"one-shot", "cached", "warm start"};
+  for (int i = 0; i < 3; ++i)
+  {
+    std::cout << names[i] << ": " << times[i] / iterations * 1e6 << " us per solve ("
+              << times[0] / times[i] << "x)" << std::endl;
+  }
+
+  std::cout << "Maximum difference: " << error << std::endl;
+  return 0;
+}
+
 int
 main(int argc, char** argv)
 {
   --argc; ++argv;
 
+  if (argc == 4 && std::string(argv[0]) == "-b")
+    return benchmark(atoi(argv[1]), atoi(argv[2]), atoi(argv[3]));
+
   if (argc < 3)
   {
     std::cerr << "Usage: quadprog vars constraints file1 ... filen" << std::endl;
+    std::cerr << "       quadprog -b vars constraints iterations" << std::endl;
     return 1;
   }
 
@@ -0,0 +1,253 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Task recording the messages it receives.
+class Recorder: public Tasks::AbstractTask
+{
+public:
+  //! Time stamps of the received messages.
+  std::vector<double> stamps;
+  //! Number of messages handed over by the bus.
+  unsigned adopted;
+
+  Recorder(void):
+    adopted(0)
+  { }
+
+  void
+  receive(const IMC::Message* msg)
+  {
+    Concurrency::ScopedMutex l(m_lock);
+    stamps.push_back(msg->getTimeStamp());
+  }
+
+  void
+  adopt(IMC::Message* msg)
+  {
+    receive(msg);
+    delete msg;
+    Concurrency::ScopedMutex l(m_lock);
+    ++adopted;
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Recorder";
+  }
+
+  void
+  inf(const char*, ...)
+  { }
+
+  void
+  war(const char*, ...)
+  { }
+
+  void
+  err(const char*, ...)
+  { }
+
+  void
+  cri(const char*, ...)
+  { }
+
+  void
+  debug(const char*, ...)
+  { }
+
+  void
+  trace(const char*, ...)
+  { }
+
+  void
+  spew(const char*, ...)
+  { }
+
+  //! Test if the messages were received in order.
+  //! @return true if messages were received in order.
+  bool
+  ordered(void)
+  {
+    for (size_t i = 1; i < stamps.size(); ++i)
+    {
+      if (stamps[i] <= stamps[i - 1])
+        return false;
+    }
+
+    return true;
+  }
+
+private:
+  Concurrency::Mutex m_lock;
+
+  void
+  run(void)
+  { }
+};
+
+//! Thread dispatching messages.
+class Dispatcher: public Concurrency::Thread
+{
+public:
+  Dispatcher(IMC::Bus& bus, unsigned count):
+    m_bus(bus),
+    m_count(count)
+  { }
+
+private:
+  IMC::Bus& m_bus;
+  unsigned m_count;
+
+  void
+  run(void)
+  {
+    IMC::Heartbeat hb;
+    for (unsigned i = 0; i < m_count; ++i)
+      m_bus.dispatch(&hb);
+  }
+};
+
+//! Dispatch heartbeats with increasing time stamps.
+//! @param[in] bus message bus.
+//! @param[in] first first time stamp.
+//! @param[in] count number of messages.
+static void
+dispatch(IMC::Bus& bus, unsigned first, unsigned count)
+{
+  IMC::Heartbeat hb;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    hb.setTimeStamp(first + i);
+    bus.dispatch(&hb);
+  }
+}
+
+int
+main(void)
+{
+  Test test("IMC::Bus");
+
+  {
+    IMC::Bus bus;
+    Recorder early;
+    Recorder late;
+    bus.registerRecipient(&early, DUNE_IMC_HEARTBEAT);
+
+    test.boolean("not paused", !bus.isPaused());
+    dispatch(bus, 1, 10);
+    test.boolean("delivered right away", early.stamps.size() == 10);
+
+    bus.pause();
+    test.boolean("paused", bus.isPaused());
+    dispatch(bus, 11, 10);
+    test.boolean("held while paused", early.stamps.size() == 10);
+
+    bus.registerRecipient(&late, DUNE_IMC_HEARTBEAT);
+    bus.resume();
+    test.boolean("resumed", !bus.isPaused());
+    test.boolean("back log delivered", early.stamps.size() == 20 && early.ordered());
+    test.boolean("back log delivered to late recipients", late.stamps.size() == 10);
+    test.boolean("back log copies handed over", early.adopted == 0 && late.adopted == 10);
+
+    bus.resume();
+    test.boolean("back log delivered once", early.stamps.size() == 20);
+  }
+
+  {
+    IMC::Bus bus;
+    Recorder recorder;
+    Recorder excluded;
+    bus.registerRecipient(&recorder, DUNE_IMC_HEARTBEAT);
+    bus.registerRecipient(&excluded, DUNE_IMC_HEARTBEAT);
+
+    bus.pause();
+    IMC::Heartbeat hb;
+    bus.dispatch(&hb, &excluded);
+    bus.resume();
+    test.boolean("excluded task is kept", recorder.stamps.size() == 1 && excluded.stamps.empty());
+  }
+
+  {
+    IMC::Bus bus;
+    Recorder recorder;
+    bus.registerRecipient(&recorder, DUNE_IMC_HEARTBEAT);
+
+    bus.pause();
+    dispatch(bus, 1, 5000);
+    test.boolean("back log grows", recorder.stamps.empty());
+    bus.resume();
+    test.boolean("no messages dropped", recorder.stamps.size() == 5000
+                 && recorder.stamps.back() == 5000);
+    dispatch(bus, 5001, 10);
+    test.boolean("order kept after a long pause", recorder.stamps.size() == 5010
+                 && recorder.ordered());
+  }
+
+  {
+    IMC::Bus bus;
+    Recorder recorder;
+    bus.registerRecipient(&recorder, DUNE_IMC_HEARTBEAT);
+
+    std::vector<Dispatcher*> dispatchers;
+    for (unsigned i = 0; i < 4; ++i)
+      dispatchers.push_back(new Dispatcher(bus, 10000));
+
+    bus.pause();
+    for (size_t i = 0; i < dispatchers.size(); ++i)
+      dispatchers[i]->start();
+
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      bus.resume();
+      bus.pause();
+    }
+
+    bus.resume();
+
+    for (size_t i = 0; i < dispatchers.size(); ++i)
+    {
+      dispatchers[i]->stopAndJoin();
+      delete dispatchers[i];
+    }
+
+    test.boolean("concurrent pause and resume", recorder.stamps.size() == 40000);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,127 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+static void
+writeFile(const Path& path, const std::string& contents)
+{
+  std::ofstream ofs(path.c_str());
+  ofs << contents;
+}
+
+int
+main(void)
+{
+  Test test("Parsers::Config");
+
+#if defined(DUNE_OS_POSIX)
+  Path dir = Path("/tmp") / String::str("dune-test-config-%u", (unsigned)getpid());
+#else
+  Path dir = Path::current() / "dune-test-config";
+#endif
+  dir.create();
+
+  Path main = dir / "main.ini";
+  Path common = dir / "common.ini";
+  Path cache = dir / "main.cache";
+
+  writeFile(common, "[Task A]\nPeriod = 1.0\n\n[Task B]\nPeriod = 2.0\n");
+  writeFile(main, "[Require common.ini]\n\n[Task A]\nGain = 3\n");
+
+  {
+    Parsers::Config cfg;
+    bool cached = cfg.parseFile(main.c_str(), cache.c_str());
+    std::vector<std::string> includes = cfg.getIncludes(main.str());
+    test.boolean("parse and write cache",
+                 !cached && cfg.get("Task A", "Gain") == "3" && cfg.get("Task B", "Period") == "2.0");
+    test.boolean("include graph", includes.size() == 1 && includes[0] == common.str());
+  }
+
+  {
+    Parsers::Config cfg;
+    bool cached = cfg.parseFile(main.c_str(), cache.c_str());
+    test.boolean("load unchanged files from cache",
+                 cached && cfg.get("Task A", "Period") == "1.0" && cfg.get("Task A", "Gain") == "3"
+                 && cfg.getIncludes(main.str()).size() == 1);
+
+    test.boolean("lookups do not create sections",
+                 cfg.get("Task C", "Period").empty() && cfg.sections().size() == 2);
+
+    cfg.set("Task A", "Gain", "4");
+    writeFile(common, "[Task A]\nPeriod = 1.0\n\n[Task B]\nPeriod = 0.5\nDepth = 10\n");
+
+    Parsers::Config::Changes changed = cfg.reload();
+    test.boolean("reload reports changed sections only",
+                 changed.size() == 1 && changed.count("Task B") == 1
+                 && cfg.get("Task B", "Period") == "0.5" && cfg.get("Task B", "Depth") == "10");
+
+    std::vector<std::string>& keys = changed["Task B"];
+    std::sort(keys.begin(), keys.end());
+    test.boolean("reload reports changed options only",
+                 keys.size() == 2 && keys[0] == "Depth" && keys[1] == "Period");
+    test.boolean("reload keeps options set after parsing", cfg.get("Task A", "Gain") == "4");
+    test.boolean("reload without changes", cfg.reload().empty());
+
+    // Same size and, most likely, the same modification time.
+    writeFile(common, "[Task A]\nPeriod = 1.0\n\n[Task B]\nPeriod = 0.7\nDepth = 10\n");
+    changed = cfg.reload();
+    test.boolean("reload detects same size edits",
+                 changed.size() == 1 && changed["Task B"].size() == 1
+                 && cfg.get("Task B", "Period") == "0.7");
+
+    writeFile(common, "[Task A]\nPeriod = 1.0\n\n[Task B]\nPeriod = 0.7\n");
+    changed = cfg.reload();
+    test.boolean("reload reports removed options",
+                 changed.size() == 1 && changed["Task B"].size() == 1
+                 && changed["Task B"][0] == "Depth" && cfg.get("Task B", "Depth").empty());
+
+    writeFile(common, "[Task A]\nPeriod = 1.0\n\n[Task B]\nPeriod = 0.5\nDepth = 10\n");
+  }
+
+  {
+    Parsers::Config cfg;
+    bool cached = cfg.parseFile(main.c_str(), cache.c_str());
+    test.boolean("stale cache is not used", !cached && cfg.get("Task B", "Depth") == "10");
+  }
+
+  dir.remove(Path::MODE_RECURSIVE);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,138 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Number of entities reserved while readers are running.
+static const unsigned c_entities = 1000;
+
+//! Thread resolving entities while they are being reserved.
+class Reader: public Concurrency::Thread
+{
+public:
+  bool consistent;
+  unsigned lookups;
+
+  Reader(Entities::EntityDataBase& db):
+    consistent(true),
+    lookups(0),
+    m_db(db)
+  { }
+
+private:
+  Entities::EntityDataBase& m_db;
+
+  void
+  run(void)
+  {
+    std::vector<std::string> labels;
+    for (unsigned i = 0; i < c_entities; ++i)
+      labels.push_back(String::str("Entity %u", i));
+
+    while (!isStopping())
+    {
+      for (unsigned i = 0; i < c_entities; ++i)
+      {
+        if (!m_db.labelExists(labels[i]))
+          continue;
+
+        unsigned id = m_db.resolve(labels[i]);
+        consistent = consistent && m_db.resolve(id) == labels[i] && id == i;
+        ++lookups;
+      }
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("Entities::EntityDataBase");
+
+  {
+    Entities::EntityDataBase db;
+    unsigned a = db.reserve("Navigation", "Navigation.AUV.Navigation");
+    unsigned b = db.reserve("Control", "Control.AUV.Attitude");
+
+    test.boolean("resolve by label", db.resolve("Navigation") == a && db.resolve("Control") == b);
+    test.boolean("resolve by id", db.resolve(a) == "Navigation" && db.resolve(b) == "Control");
+    test.boolean("resolve task name", db.resolveTaskName("Control") == "Control.AUV.Attitude");
+
+    bool thrown = false;
+    try
+    {
+      db.reserve("Control", "Other");
+    }
+    catch (Entities::EntityDataBase::ReservedUnique&)
+    {
+      thrown = true;
+    }
+
+    test.boolean("labels are unique", thrown);
+    test.boolean("unknown entities", !db.labelExists("Unknown") && !db.idExists(2));
+  }
+
+  {
+    Entities::EntityDataBase db;
+    std::vector<Reader*> readers;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+      readers.push_back(new Reader(db));
+      readers.back()->start();
+    }
+
+    for (unsigned i = 0; i < c_entities; ++i)
+      db.reserve(String::str("Entity %u", i), "Test");
+
+    Delay::wait(0.1);
+
+    bool consistent = true;
+    unsigned lookups = 0;
+    for (size_t i = 0; i < readers.size(); ++i)
+    {
+      readers[i]->stopAndJoin();
+      consistent = consistent && readers[i]->consistent;
+      lookups += readers[i]->lookups;
+      delete readers[i];
+    }
+
+    test.boolean("concurrent lookups and reservations", consistent && lookups > 0);
+    test.boolean("all entities reserved", db.idExists(c_entities - 1) && !db.idExists(c_entities));
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,431 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Cooperative task counting the heartbeats it receives and checking
+//! that its consumers never run concurrently.
+class CountingTask: public Tasks::Task
+{
+public:
+  unsigned count;
+  unsigned attempts;
+  unsigned failures;
+  unsigned initializations;
+  unsigned releases;
+  bool concurrent;
+  bool restart;
+  double init_delay;
+
+  CountingTask(const std::string& name, Tasks::Context& ctx):
+    Tasks::Task(name, ctx),
+    count(0),
+    attempts(0),
+    failures(0),
+    initializations(0),
+    releases(0),
+    concurrent(false),
+    restart(false),
+    init_delay(0),
+    m_busy(false)
+  {
+    setEntityLabel(name);
+    setCooperative();
+    bind<IMC::Heartbeat>(this);
+  }
+
+  void
+  onResourceInitialization(void)
+  {
+    ++attempts;
+    if (attempts <= failures)
+      throw std::runtime_error("not yet");
+
+    Delay::wait(init_delay);
+    ++initializations;
+  }
+
+  void
+  onResourceRelease(void)
+  {
+    ++releases;
+  }
+
+  void
+  consume(const IMC::Heartbeat* msg)
+  {
+    (void)msg;
+
+    if (m_busy)
+      concurrent = true;
+    m_busy = true;
+
+    if (restart)
+    {
+      restart = false;
+      m_busy = false;
+      throw RestartNeeded("restart requested", 0, false);
+    }
+
+    ++count;
+    Delay::waitUsec(10);
+    m_busy = false;
+  }
+
+  void
+  onMain(void)
+  { }
+
+private:
+  bool m_busy;
+};
+
+//! Periodic task counting its cycles.
+class TickingTask: public Tasks::Periodic
+{
+public:
+  //! Time at which the last heartbeat was consumed.
+  double received;
+
+  TickingTask(const std::string& name, Tasks::Context& ctx):
+    Tasks::Periodic(name, ctx),
+    received(-1.0)
+  {
+    setEntityLabel(name);
+    bind<IMC::Heartbeat>(this);
+  }
+
+  void
+  consume(const IMC::Heartbeat* msg)
+  {
+    (void)msg;
+    received = Clock::get();
+  }
+
+  void
+  task(void)
+  { }
+};
+
+//! Cooperative task asking to run again long after each step.
+class PollingTask: public Tasks::Task
+{
+public:
+  //! Time at which the last heartbeat was consumed.
+  double received;
+
+  PollingTask(const std::string& name, Tasks::Context& ctx):
+    Tasks::Task(name, ctx),
+    received(-1.0)
+  {
+    setEntityLabel(name);
+    setCooperative();
+    bind<IMC::Heartbeat>(this);
+  }
+
+  void
+  consume(const IMC::Heartbeat* msg)
+  {
+    (void)msg;
+    received = Clock::get();
+  }
+
+  double
+  onJob(bool restarted)
+  {
+    (void)restarted;
+    consumeMessages();
+    return Clock::get() + 10.0;
+  }
+
+  void
+  onMain(void)
+  { }
+};
+
+//! Wait until the tasks consumed the given number of messages.
+static bool
+waitFor(std::vector<CountingTask*>& tasks, unsigned count)
+{
+  for (unsigned i = 0; i < 500; ++i)
+  {
+    bool done = true;
+    for (size_t j = 0; j < tasks.size(); ++j)
+      done = done && (tasks[j]->count >= count);
+
+    if (done)
+      return true;
+
+    Delay::wait(0.01);
+  }
+
+  return false;
+}
+
+int
+main(void)
+{
+  Test test("Executor");
+
+  {
+    Tasks::Context ctx;
+    std::vector<CountingTask*> tasks;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+      tasks.push_back(new CountingTask(String::str("Counter %u", i), ctx));
+      tasks.back()->loadConfig();
+      tasks.back()->reserveEntities();
+    }
+
+    Tasks::Executor executor(3);
+    for (size_t i = 0; i < tasks.size(); ++i)
+      executor.add(tasks[i]);
+
+    IMC::Heartbeat hb;
+    for (unsigned i = 0; i < 1000; ++i)
+      ctx.mbus.dispatch(&hb);
+
+    bool done = waitFor(tasks, 1000);
+    executor.stop();
+
+    bool serial = true;
+    bool lifecycle = true;
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      serial = serial && !tasks[i]->concurrent;
+      lifecycle = lifecycle && tasks[i]->count == 1000 && tasks[i]->initializations == 1;
+      delete tasks[i];
+    }
+
+    test.boolean("all messages consumed", done && lifecycle);
+    test.boolean("jobs never run concurrently", serial);
+  }
+
+  {
+    Tasks::Context ctx;
+    std::vector<CountingTask*> tasks;
+    tasks.push_back(new CountingTask("Restarting", ctx));
+    tasks[0]->loadConfig();
+    tasks[0]->reserveEntities();
+    tasks[0]->restart = true;
+
+    Tasks::Executor executor(2);
+    executor.add(tasks[0]);
+
+    IMC::Heartbeat hb;
+    ctx.mbus.dispatch(&hb);
+    ctx.mbus.dispatch(&hb);
+    ctx.mbus.dispatch(&hb);
+
+    bool done = waitFor(tasks, 2);
+    executor.stop();
+
+    // Resources are released before each initialization and on stop.
+    test.boolean("restart and release",
+                 done && tasks[0]->initializations == 2 && tasks[0]->releases == 3);
+    delete tasks[0];
+  }
+
+  {
+    Tasks::Context ctx;
+    std::vector<TickingTask*> tasks;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+      tasks.push_back(new TickingTask(String::str("Ticker %u", i), ctx));
+      tasks.back()->loadConfig();
+      tasks.back()->setFrequency(50.0 + i * 10.0);
+      tasks.back()->reserveEntities();
+    }
+
+    Tasks::Executor executor(2);
+    for (size_t i = 0; i < tasks.size(); ++i)
+      executor.add(tasks[i]);
+
+    Delay::wait(1.0);
+    executor.stop();
+
+    // Cycles run on schedule (one period is spent initializing).
+    bool periodic = true;
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      int expected = (int)tasks[i]->getFrequency() - 1;
+      int count = (int)tasks[i]->getRunCount();
+      periodic = periodic && std::abs(count - expected) <= 2;
+      periodic = periodic && tasks[i]->getStatistics().jitter_mean < 0.005;
+      delete tasks[i];
+    }
+
+    test.boolean("periodic tasks run on schedule", periodic);
+  }
+
+  {
+    Tasks::Context ctx;
+    std::vector<CountingTask*> tasks;
+    tasks.push_back(new CountingTask("Dependent", ctx));
+    tasks.push_back(new CountingTask("Dependency", ctx));
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      tasks[i]->loadConfig();
+      tasks[i]->reserveEntities();
+    }
+
+    tasks[1]->init_delay = 0.3;
+    tasks[0]->setDependencies(std::vector<Tasks::Task*>(1, tasks[1]));
+
+    Tasks::Executor executor(2);
+    executor.add(tasks[0]);
+    executor.add(tasks[1]);
+
+    bool ready = false;
+    for (unsigned i = 0; i < 200 && !ready; ++i)
+    {
+      ready = tasks[0]->isReady() && tasks[1]->isReady();
+      Delay::wait(0.01);
+    }
+
+    executor.stop();
+
+    Tasks::Task::Timeline dependent = tasks[0]->getTimeline();
+    Tasks::Task::Timeline dependency = tasks[1]->getTimeline();
+    test.boolean("dependencies initialize first",
+                 ready && dependent.ready >= dependency.ready && dependent.wait >= 0.25);
+
+    delete tasks[0];
+    delete tasks[1];
+  }
+
+  {
+    Tasks::Executor executor;
+    test.boolean("one thread per processor",
+                 executor.getThreadCount() == System::Resources::getProcessorCount());
+  }
+
+  {
+    // Two runs of ten seconds of simulated time, ending away from
+    // cycle boundaries as the runs start at different times.
+    std::vector<unsigned> counts[2];
+    bool periodic = true;
+    for (unsigned run = 0; run < 2; ++run)
+    {
+      Tasks::Context ctx;
+      std::vector<TickingTask*> tasks;
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        tasks.push_back(new TickingTask(String::str("Ticker %u", i), ctx));
+        tasks.back()->loadConfig();
+        tasks.back()->setFrequency(10.0 * (i + 1));
+        tasks.back()->reserveEntities();
+      }
+
+      Tasks::Executor executor(0, true);
+      for (size_t i = 0; i < tasks.size(); ++i)
+        executor.add(tasks[i]);
+
+      double start = Clock::get();
+      while (Clock::get() - start < 10.01 && executor.step())
+      { }
+      executor.stop();
+
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        int expected = (int)tasks[i]->getFrequency() * 10 - 1;
+        int count = (int)tasks[i]->getRunCount();
+        periodic = periodic && std::abs(count - expected) <= 1;
+        counts[run].push_back(count);
+        delete tasks[i];
+      }
+    }
+
+    test.boolean("deterministic runs use the virtual clock", Clock::isVirtual() && periodic);
+    test.boolean("deterministic runs are reproducible", counts[0] == counts[1]);
+  }
+
+  {
+    Tasks::Context ctx;
+    CountingTask task("Failing", ctx);
+    task.loadConfig();
+    task.reserveEntities();
+    task.failures = 3;
+
+    Tasks::Executor executor(0, true);
+    executor.add(&task);
+
+    // Retries are scheduled on the (virtual) clock, not slept.
+    double start = Clock::get();
+    while (!task.isReady() && Clock::get() - start < 10.0 && executor.step())
+    { }
+    double elapsed = Clock::get() - start;
+    executor.stop();
+
+    test.boolean("failed initializations are rescheduled",
+                 task.isReady() && task.attempts == 4 && elapsed >= 0.7 && elapsed < 1.0);
+  }
+
+  {
+    Tasks::Context ctx;
+    PollingTask polling("Polling", ctx);
+    TickingTask ticking("Ticking", ctx);
+    polling.loadConfig();
+    ticking.loadConfig();
+    ticking.setFrequency(1.0);
+    polling.reserveEntities();
+    ticking.reserveEntities();
+
+    Tasks::Executor executor(0, true);
+    executor.add(&polling);
+    executor.add(&ticking);
+
+    while (!(polling.isReady() && ticking.isReady()) && executor.step())
+    { }
+
+    double sent = Clock::get();
+    IMC::Heartbeat hb;
+    ctx.mbus.dispatch(&hb);
+
+    while ((polling.received < 0 || ticking.received < 0) && Clock::get() - sent < 20.0 && executor.step())
+    { }
+    executor.stop();
+
+    // Delayed jobs run on new messages, periodic ones at their next
+    // cycle.
+    test.boolean("messages run delayed jobs", polling.received >= sent && polling.received - sent < 0.001);
+    test.boolean("periodic tasks defer messages", ticking.received - sent > 0.001 && ticking.received - sent < 1.001);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,150 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Compare fixed and dynamic matrices element-wise.
+template <size_t R, size_t C>
+static bool
+near(const FixedMatrix<R, C>& a, const Matrix& b, double tol = 1e-12)
+{
+  if ((size_t)b.rows() != R || (size_t)b.columns() != C)
+    return false;
+
+  for (size_t i = 0; i < R; ++i)
+  {
+    for (size_t j = 0; j < C; ++j)
+    {
+      if (std::fabs(a(i, j) - b(i, j)) > tol)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Math::FixedMatrix");
+
+  FixedMatrix<4, 3> a;
+  FixedMatrix<3, 5> b;
+  FixedMatrix<4, 4> p;
+  for (size_t i = 0; i < a.size(); ++i)
+    a(i) = std::sin(i + 1.0);
+  for (size_t i = 0; i < b.size(); ++i)
+    b(i) = std::cos(i + 0.5);
+  for (size_t i = 0; i < 4; ++i)
+    for (size_t j = 0; j < 4; ++j)
+      p(i, j) = 1.0 / (i + j + 1.0) + (i == j ? 1.0 : 0.0);
+
+  Matrix ma = a.toMatrix();
+  Matrix mb = b.toMatrix();
+  Matrix mp = p.toMatrix();
+
+  test.boolean("Conversion to Matrix", near(a, ma, 0.0));
+  test.boolean("Conversion from Matrix", FixedMatrix<4, 3>(ma) == a);
+
+  {
+    bool thrown = false;
+    try
+    {
+      FixedMatrix<3, 4> bad(ma);
+    }
+    catch (Matrix::Error&)
+    {
+      thrown = true;
+    }
+    test.boolean("Dimension mismatch", thrown);
+  }
+
+  test.boolean("Product", near(a * b, ma * mb));
+  test.boolean("Transpose", near(transpose(a), transpose(ma), 0.0));
+  test.boolean("Sum and difference", near(a + a - 3.0 * a, ma + ma - 3.0 * ma));
+
+  {
+    FixedMatrix<4, 5> out;
+    multiplyTransposed(a, transpose(b), out);
+    test.boolean("Product with transpose", near(out, ma * mb));
+  }
+
+  {
+    FixedMatrix<3, 3> out;
+    multiplyAPAT(transpose(a), p, out);
+    test.boolean("Congruence (A * P * A^T)", near(out, transpose(ma) * mp * ma));
+  }
+
+  {
+    FixedMatrix<4, 4> id;
+    id.identity();
+    test.boolean("Inverse", near(inverse(p), inverse(mp), 1e-9));
+    test.boolean("Inverse product is identity", near(inverse(p) * p, id.toMatrix(), 1e-9));
+
+    FixedMatrix<2, 2> singular(1.0);
+    bool thrown = false;
+    try
+    {
+      inverse(singular);
+    }
+    catch (Matrix::Error&)
+    {
+      thrown = true;
+    }
+    test.boolean("Singular inverse", thrown);
+  }
+
+  {
+    FixedMatrix<3, 1> x, y;
+    x(0) = 1.0;
+    y(1) = 1.0;
+    FixedMatrix<3, 1> z = cross(x, y);
+    test.boolean("Cross product", z(0) == 0.0 && z(1) == 0.0 && z(2) == 1.0);
+    test.boolean("Dot product", dot(x, y) == 0.0 && dot(z, z) == 1.0);
+  }
+
+  {
+    FixedMatrix<2, 2> s;
+    FixedMatrix<4, 4> m;
+    m.identity();
+    m.get(1, 1, s);
+    s(0, 1) = 5.0;
+    m.put(2, 2, s);
+    test.boolean("Submatrices", m(2, 3) == 5.0 && m(1, 1) == 1.0 && m.trace() == 4.0);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,202 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Jose Pinto                                                       *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Network/Fragments.hpp>
+#include <DUNE/Network/FragmentedMessage.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+static IMC::Message*
+reassemble(Network::Fragments& frags, const std::vector<int>& order)
+{
+  Network::FragmentedMessage incoming;
+  IMC::Message* result = NULL;
+
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    IMC::MessagePart* part = frags.getFragment(order[i]);
+    part->setSource(0x1234);
+    IMC::Message* msg = incoming.setFragment(part);
+    if (msg != NULL)
+      result = msg;
+  }
+
+  return result;
+}
+
+int
+main(void)
+{
+  Test test("Network::Fragments");
+
+  IMC::LogBookEntry entry;
+  entry.setSource(0x1234);
+  entry.context = "test";
+  entry.text.assign(1500, 'x');
+  for (size_t i = 0; i < entry.text.size(); ++i)
+    entry.text[i] = 'a' + (i % 26);
+
+  Network::Fragments frags(&entry, 100);
+  int count = frags.getNumberOfFragments();
+
+  {
+    unsigned total = 0;
+    for (int i = 0; i < count; ++i)
+    {
+      unsigned size = 0;
+      frags.getFragmentData(i, size);
+      total += size;
+    }
+
+    test.boolean("Fragment sizes add up", total == entry.getSerializationSize());
+    test.boolean("Fragment payload fits MTU", frags.getFragmentSize() + sizeof(IMC::Header) + 5 == 100);
+  }
+
+  {
+    std::vector<int> order;
+    for (int i = 0; i < count; ++i)
+      order.push_back(i);
+
+    IMC::Message* msg = reassemble(frags, order);
+    test.boolean("In order reassembly", msg != NULL && entry.fieldsEqual(*msg));
+    delete msg;
+  }
+
+  {
+    std::vector<int> order;
+    for (int i = count - 1; i >= 0; --i)
+      order.push_back(i);
+
+    IMC::Message* msg = reassemble(frags, order);
+    test.boolean("Reverse order reassembly", msg != NULL && entry.fieldsEqual(*msg));
+    delete msg;
+  }
+
+  {
+    Network::FragmentedMessage incoming;
+    for (int i = 0; i < count; i += 2)
+    {
+      IMC::MessagePart* part = frags.getFragment(i);
+      incoming.setFragment(part);
+      incoming.setFragment(part);
+    }
+
+    test.boolean("Duplicates ignored", incoming.getFragmentsMissing() == count / 2);
+    test.boolean("Received fragments tracked", incoming.hasFragment(0) && !incoming.hasFragment(1));
+
+    IMC::Message* msg = NULL;
+    for (int i = 1; i < count; i += 2)
+    {
+      IMC::Message* m = incoming.setFragment(frags.getFragment(i));
+      if (m != NULL)
+        msg = m;
+    }
+
+    test.boolean("Missing fragments completed", msg != NULL && entry.fieldsEqual(*msg));
+    delete msg;
+  }
+
+  {
+    IMC::MessagePart part;
+    test.boolean("Out of range fragment", !frags.getFragment(count, part));
+  }
+
+  {
+    Network::Fragments encoded(&entry, 100, 0.5f);
+    int n = encoded.getNumberOfFragments();
+    int k = encoded.getNumberOfDataFragments();
+    test.boolean("Parity fragments added", encoded.isEncoded() && n == k + (k + 1) / 2);
+
+    // Drop every third fragment, starting with the first one.
+    Network::FragmentedMessage incoming;
+    incoming.enableParity(true);
+    IMC::Message* msg = NULL;
+    int received = 0;
+    for (int i = 0; i < n && msg == NULL; ++i)
+    {
+      if (i % 3 == 0)
+        continue;
+
+      msg = incoming.setFragment(encoded.getFragment(i));
+      ++received;
+    }
+
+    test.boolean("Recovered from k of n fragments", msg != NULL && received == k && entry.fieldsEqual(*msg));
+    test.boolean("Late fragments ignored", incoming.setFragment(encoded.getFragment(n - 1)) == NULL);
+    delete msg;
+  }
+
+  {
+    Network::Fragments encoded(&entry, 100, 0.25f);
+    int n = encoded.getNumberOfFragments();
+    int k = encoded.getNumberOfDataFragments();
+
+    // Only parity fragments and the last data fragments.
+    Network::FragmentedMessage incoming;
+    incoming.enableParity(true);
+    IMC::Message* msg = NULL;
+    for (int i = n - 1; i >= n - k && msg == NULL; --i)
+      msg = incoming.setFragment(encoded.getFragment(i));
+
+    test.boolean("Recovered mostly from parity", msg != NULL && entry.fieldsEqual(*msg));
+    delete msg;
+  }
+
+  {
+    // Plain fragments from other implementations may use any id.
+    Network::FragmentedMessage incoming;
+    IMC::Message* msg = NULL;
+    for (int i = 0; i < count && msg == NULL; ++i)
+    {
+      IMC::MessagePart part = *frags.getFragment(i);
+      part.uid = 200;
+      msg = incoming.setFragment(&part);
+    }
+
+    test.boolean("Plain fragments with high unique ids", msg != NULL && entry.fieldsEqual(*msg));
+    delete msg;
+  }
+
+  {
+    IMC::LogBookEntry large;
+    large.text.assign(Network::Fragments::c_max_message_size, 'x');
+    Network::Fragments plain(&large, 1500);
+    Network::Fragments encoded(&large, 1500, 0.5f);
+    test.boolean("Oversized messages rejected",
+                 plain.getNumberOfFragments() == 0 && encoded.getNumberOfFragments() == 0);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,304 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+#include <Transports/HTTP/EventStream.hpp>
+#include <Transports/HTTP/MessageMonitor.hpp>
+#include <Transports/HTTP/RequestHandler.hpp>
+#include <Transports/HTTP/Server.hpp>
+
+using DUNE_NAMESPACES;
+using Transports::HTTP::EventStream;
+using Transports::HTTP::MessageMonitor;
+using Transports::HTTP::RequestHandler;
+using Transports::HTTP::Server;
+
+//! Request handler answering with the number of requests it served
+//! on the same connection.
+class Handler: public RequestHandler
+{
+public:
+  Handler(void):
+    m_last(NULL),
+    m_count(0)
+  { }
+
+  void
+  handleGET(TCPSocket* sock, Utils::TupleList& headers, const char* uri)
+  {
+    (void)headers;
+    (void)uri;
+
+    Concurrency::ScopedMutex l(m_lock);
+    if (sock != m_last)
+      m_count = 0;
+    m_last = sock;
+
+    sendData(sock, String::str("%u", ++m_count));
+  }
+
+private:
+  Concurrency::Mutex m_lock;
+  TCPSocket* m_last;
+  unsigned m_count;
+};
+
+//! Thread polling the server.
+class Poller: public Concurrency::Thread
+{
+public:
+  Poller(Server& server):
+    m_server(server)
+  { }
+
+private:
+  Server& m_server;
+
+  void
+  run(void)
+  {
+    while (!isStopping())
+      m_server.poll(0.05);
+  }
+};
+
+//! Read from a socket until a delimiter is found.
+//! @param[in] sock socket.
+//! @param[in] delim delimiter.
+//! @return data read including the delimiter, or what was read
+//! until the peer closed the connection or the read timed out.
+static std::string
+readUntil(TCPSocket& sock, const std::string& delim)
+{
+  std::string data;
+  char c = 0;
+
+  try
+  {
+    while (data.size() < delim.size()
+           || data.compare(data.size() - delim.size(), delim.size(), delim) != 0)
+    {
+      if (sock.read(&c, 1) <= 0)
+        break;
+      data += c;
+    }
+  }
+  catch (std::runtime_error&)
+  { }
+
+  return data;
+}
+
+//! Read an HTTP response.
+//! @param[in] sock socket.
+//! @param[out] header response header.
+//! @return response body.
+static std::string
+readResponse(TCPSocket& sock, std::string& header)
+{
+  header = readUntil(sock, "\r\n\r\n");
+
+  size_t pos = header.find("Content-Length: ");
+  if (pos == std::string::npos)
+    return "";
+
+  unsigned length = std::atoi(header.c_str() + pos + 16);
+  std::string body;
+  char c = 0;
+  while (body.size() < length && sock.read(&c, 1) > 0)
+    body += c;
+
+  return body;
+}
+
+//! Connect a client to a local port.
+//! @param[in] port port.
+//! @return client socket.
+static TCPSocket*
+connect(uint16_t port)
+{
+  TCPSocket* sock = new TCPSocket;
+  sock->connect(Address::Loopback, port);
+  sock->setReceiveTimeout(2.0);
+  return sock;
+}
+
+//! Get a free local port.
+//! @return port.
+static uint16_t
+getFreePort(void)
+{
+  TCPSocket sock;
+  sock.bind(0, Address::Loopback);
+  return sock.getBoundPort();
+}
+
+static void
+testKeepAlive(Test& test)
+{
+  uint16_t port = getFreePort();
+  Handler handler;
+  Server server(port, 2, handler);
+  Poller poller(server);
+  poller.start();
+
+  std::string header;
+  TCPSocket* sock = connect(port);
+
+  sock->write("GET / HTTP/1.1\r\n\r\n", 18);
+  std::string body = readResponse(*sock, header);
+  test.boolean("HTTP/1.1 connections are persistent",
+               body == "1" && header.find("Connection: keep-alive") != std::string::npos);
+
+  sock->write("GET / HTTP/1.1\r\n\r\n", 18);
+  body = readResponse(*sock, header);
+  test.boolean("persistent connections are reused", body == "2");
+
+  sock->write("GET / HTTP/1.1\r\nConnection: close\r\n\r\n", 37);
+  body = readResponse(*sock, header);
+  test.boolean("clients may close persistent connections",
+               body == "3" && header.find("Connection: close") != std::string::npos
+               && readUntil(*sock, "\n").empty());
+  delete sock;
+
+  sock = connect(port);
+  sock->write("GET / HTTP/1.0\r\n\r\n", 18);
+  body = readResponse(*sock, header);
+  test.boolean("HTTP/1.0 connections are closed",
+               body == "1" && header.find("Connection: close") != std::string::npos
+               && readUntil(*sock, "\n").empty());
+  delete sock;
+
+  sock = connect(port);
+  sock->write("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n", 42);
+  readResponse(*sock, header);
+  sock->write("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n", 42);
+  body = readResponse(*sock, header);
+  test.boolean("HTTP/1.0 connections may be persistent", body == "2");
+  delete sock;
+
+  poller.stopAndJoin();
+}
+
+static void
+testEventStream(Test& test)
+{
+  TCPSocket server;
+  server.bind(0, Address::Loopback);
+  server.listen(4);
+
+  EventStream stream;
+  stream.start();
+
+  IMC::Temperature temp;
+  temp.setSourceEntity(3);
+  temp.value = 12.5;
+
+  IMC::Pressure press;
+  press.setSourceEntity(3);
+  press.value = 1.5;
+
+  std::map<uint64_t, std::string> initial;
+  initial[MessageMonitor::getKey(&temp)] = "{\"abbrev\":\"Temperature\",\n\"value\":12.5}\n";
+  initial[MessageMonitor::getKey(&press)] = "{\"abbrev\":\"Pressure\"}\n";
+
+  EventStream::Filter filter;
+  filter.ids.insert(DUNE_IMC_TEMPERATURE);
+  // Updates published within a period are sent together.
+  filter.rate = 2.0;
+
+  TCPSocket* client = connect(server.getBoundPort());
+  TCPSocket* peer = server.accept();
+  test.boolean("stream is accepted", stream.add(peer, filter, initial));
+
+  std::string header = readUntil(*client, "\r\n\r\n");
+  test.boolean("stream header",
+               header.find("HTTP/1.1 200 OK\r\n") == 0
+               && header.find("Content-Type: text/event-stream\r\n") != std::string::npos);
+
+  std::string event = readUntil(*client, "\n\n");
+  test.boolean("multi-line payloads are split in data fields",
+               event == "data: {\"abbrev\":\"Temperature\",\ndata: \"value\":12.5}\n\n");
+
+  stream.publish(MessageMonitor::getKey(&press), &press);
+  stream.publish(MessageMonitor::getKey(&temp), &temp);
+  event = readUntil(*client, "\n\n");
+  test.boolean("filtered messages are streamed",
+               event.find("data: ") == 0 && event.find("Temperature") != std::string::npos
+               && event.find("Pressure") == std::string::npos);
+
+  for (unsigned i = 0; i < 10; ++i)
+  {
+    temp.value = i;
+    stream.publish(MessageMonitor::getKey(&temp), &temp);
+  }
+
+  event = readUntil(*client, "\n\n");
+  test.boolean("updates are coalesced",
+               event.find("\"value\": \"9\"") != std::string::npos
+               && event.find("Temperature") == event.rfind("Temperature"));
+
+  std::vector<TCPSocket*> clients;
+  unsigned accepted = 0;
+  for (unsigned i = 0; i < 20; ++i)
+  {
+    clients.push_back(connect(server.getBoundPort()));
+    TCPSocket* sock = server.accept();
+    if (stream.add(sock, filter, std::map<uint64_t, std::string>()))
+      ++accepted;
+    else
+      delete sock;
+  }
+
+  test.boolean("number of clients is bounded", accepted == 15);
+
+  stream.stopAndJoin();
+  delete client;
+  for (size_t i = 0; i < clients.size(); ++i)
+    delete clients[i];
+}
+
+int
+main(void)
+{
+  Test test("HTTP");
+
+  testKeepAlive(test);
+  testEventStream(test);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,170 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/Integrator.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+using DUNE::Simulation::Integrator;
+
+//! Harmonic oscillator with angular frequency w.
+struct Oscillator: public Integrator::System
+{
+  double w;
+  unsigned evaluations;
+
+  Oscillator(double frequency):
+    w(frequency),
+    evaluations(0)
+  { }
+
+  void
+  derivatives(double t, const double* x, double* dx)
+  {
+    (void)t;
+    dx[0] = x[1];
+    dx[1] = -w * w * x[0];
+    ++evaluations;
+  }
+};
+
+//! Integrate the oscillator for 10 s in steps of the given period and
+//! return the position error.
+static double
+run(Integrator& integrator, Oscillator& system, double period, unsigned* steps = NULL)
+{
+  double x[2] = {1.0, 0.0};
+  unsigned total = 0;
+  double t = 0.0;
+  int count = static_cast<int>(10.0 / period + 0.5);
+
+  for (int i = 0; i < count; ++i)
+  {
+    total += integrator.integrate(system, x, 2, t, period);
+    t += period;
+  }
+
+  if (steps != NULL)
+    *steps = total;
+
+  return std::fabs(x[0] - std::cos(system.w * t));
+}
+
+int
+main(void)
+{
+  Test test("Integrator");
+
+  {
+    Integrator euler(Integrator::IM_EULER);
+    Oscillator system(1.0);
+    double x[2] = {1.0, 0.5};
+    euler.integrate(system, x, 2, 0.0, 0.1);
+    test.boolean("Euler step", x[0] == 1.05 && x[1] == 0.4);
+  }
+
+  {
+    Integrator rk4(Integrator::IM_RK4);
+    Oscillator system(1.0);
+    double e1 = run(rk4, system, 0.1);
+    double e2 = run(rk4, system, 0.05);
+    double ratio = e1 / e2;
+    test.boolean("RK4 fourth order convergence", ratio > 12.0 && ratio < 20.0);
+  }
+
+  {
+    Integrator rk4(Integrator::IM_RK4);
+    rk4.setStepLimits(1e-6, 0.01);
+    Oscillator coarse(1.0);
+    double error = run(rk4, coarse, 0.1);
+
+    Integrator fine(Integrator::IM_RK4);
+    Oscillator reference(1.0);
+    double fine_error = run(fine, reference, 0.01);
+    test.boolean("RK4 substeps respect maximum step",
+                 coarse.evaluations == 4000 && std::fabs(error - fine_error) < 1e-12);
+  }
+
+  {
+    Integrator dp(Integrator::IM_DORMAND_PRINCE);
+    dp.setTolerances(1e-9, 1e-9);
+    Oscillator system(1.0);
+    double error = run(dp, system, 1.0);
+    test.boolean("Dormand-Prince meets tolerance", error < 1e-7);
+  }
+
+  {
+    // Fast dynamics at a slow update rate: Euler diverges while the
+    // adaptive method substeps.
+    Integrator euler(Integrator::IM_EULER);
+    Oscillator fast_euler(20.0);
+    double euler_error = run(euler, fast_euler, 0.1);
+
+    Integrator dp(Integrator::IM_DORMAND_PRINCE);
+    dp.setTolerances(1e-8, 1e-8);
+    Oscillator fast(20.0);
+    unsigned steps = 0;
+    double error = run(dp, fast, 0.1, &steps);
+
+    test.boolean("Dormand-Prince substeps fast dynamics",
+                 euler_error > 1.0 && error < 1e-5 && steps > 100);
+  }
+
+  {
+    // Slow dynamics at a fast update rate take one step per call.
+    Integrator dp(Integrator::IM_DORMAND_PRINCE);
+    Oscillator slow(0.1);
+    unsigned steps = 0;
+    double error = run(dp, slow, 0.1, &steps);
+    test.boolean("Dormand-Prince one step per call", steps == 100 && error < 1e-6);
+  }
+
+  {
+    bool ok = Integrator::parseMethod("Euler") == Integrator::IM_EULER
+    && Integrator::parseMethod("RK4") == Integrator::IM_RK4
+    && Integrator::parseMethod("Dormand-Prince") == Integrator::IM_DORMAND_PRINCE;
+
+    try
+    {
+      Integrator::parseMethod("Verlet");
+      ok = false;
+    }
+    catch (Integrator::Error&)
+    { }
+
+    test.boolean("method names", ok);
+  }
+
+  return test.getReturnValue();
+}
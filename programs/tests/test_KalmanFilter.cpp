@@ -0,0 +1,370 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+// Number of states.
+static const short c_states = 6;
+// Number of outputs.
+static const short c_outputs = 4;
+
+//! TextbookFilter filter using the textbook equations.
+struct TextbookFilter
+{
+  Matrix a, c, p, q, r, x;
+
+  void
+  predict(void)
+  {
+    x = a * x;
+    p = a * p * transpose(a) + q;
+  }
+
+  void
+  update(const Matrix& innov)
+  {
+    Matrix s = c * p * transpose(c) + r;
+    Matrix k = p * transpose(c) * inverse(s);
+    x = x + k * innov;
+    p = p - k * c * p;
+  }
+};
+
+//! Largest absolute difference between two matrices.
+static double
+difference(const Matrix& a, const Matrix& b)
+{
+  double d = 0.0;
+  for (int i = 0; i < a.size(); ++i)
+    d = std::max(d, std::fabs(a(i) - b(i)));
+  return d;
+}
+
+//! Configure filter and reference with the same model.
+static void
+setup(KalmanFilter& kf, TextbookFilter& ref, bool correlated)
+{
+  kf.reset(c_states, c_outputs);
+  ref.a = Matrix(c_states);
+  for (short i = 0; i < c_states; ++i)
+  {
+    if (i + 1 < c_states)
+      ref.a(i, i + 1) = 0.1;
+    kf.setCovariance(i, 1.0 + i);
+    kf.setProcessNoise(i, 0.01 * (i + 1));
+  }
+
+  kf.setCovariance(0, 1, 0.2);
+  kf.setCovariance(1, 0, 0.2);
+  kf.setTransitions(ref.a);
+
+  if (correlated)
+  {
+    kf.setProcessNoise(2, 3, 0.004);
+    kf.setProcessNoise(3, 2, 0.004);
+  }
+
+  for (short i = 0; i < c_outputs; ++i)
+  {
+    kf.setObservation(i, i, 1.0);
+    kf.setMeasurementNoise(i, 0.1 + 0.05 * i);
+  }
+
+  // Output depending on two states and an unobserved output.
+  kf.setObservation(1, 4, 0.5);
+  kf.setObservation(3, 3, 0.0);
+
+  if (correlated)
+  {
+    kf.setMeasurementNoise(0, 1, 0.02);
+    kf.setMeasurementNoise(1, 0, 0.02);
+  }
+
+  ref.c = Matrix(c_outputs, c_states, 0.0);
+  ref.c(0, 0) = 1.0;
+  ref.c(1, 1) = 1.0;
+  ref.c(1, 4) = 0.5;
+  ref.c(2, 2) = 1.0;
+  ref.p = kf.getCovariance();
+  ref.q = Matrix(c_states, c_states, 0.0);
+  for (short i = 0; i < c_states; ++i)
+    ref.q(i, i) = 0.01 * (i + 1);
+  ref.r = Matrix(c_outputs, c_outputs, 0.0);
+  for (short i = 0; i < c_outputs; ++i)
+    ref.r(i, i) = 0.1 + 0.05 * i;
+
+  if (correlated)
+  {
+    ref.q(2, 3) = ref.q(3, 2) = 0.004;
+    ref.r(0, 1) = ref.r(1, 0) = 0.02;
+  }
+
+  ref.x = Matrix(c_states, 1, 0.0);
+}
+
+//! Run a few filter cycles and compare against the reference.
+static bool
+run(KalmanFilter::CovarianceForm form, bool sequential, bool correlated, bool sparse = false)
+{
+  KalmanFilter kf;
+  TextbookFilter ref;
+  setup(kf, ref, correlated);
+  kf.setCovarianceForm(form);
+  kf.setSequentialUpdates(sequential);
+
+  if (sparse)
+  {
+    kf.setTransitionPattern(ref.a);
+    kf.setObservationPattern(ref.c);
+  }
+
+  double error = 0.0;
+  for (int k = 0; k < 50; ++k)
+  {
+    kf.predict();
+    ref.predict();
+
+    Matrix innov(c_outputs, 1);
+    for (short i = 0; i < c_outputs; ++i)
+    {
+      innov(i) = std::sin(0.3 * k + i);
+      kf.setInnovation(i, innov(i));
+    }
+
+    kf.update(0.0);
+    ref.update(innov);
+
+    error = std::max(error, difference(kf.getState(), ref.x));
+    error = std::max(error, difference(kf.getCovariance(), ref.p));
+  }
+
+  return error < 1e-9;
+}
+
+//! Fuse a measurement some steps late and compare against a
+//! reference that received it in sequence. If requested, the
+//! process noise changes between the measurement and its fusion.
+static bool
+runDelayed(KalmanFilter::CovarianceForm form, bool vary = false)
+{
+  KalmanFilter kf;
+  TextbookFilter ref;
+  setup(kf, ref, false);
+  kf.setCovarianceForm(form);
+  kf.setHistorySize(10);
+
+  // Delayed measurement of the last state.
+  Matrix c(1, c_states, 0.0);
+  c(0, c_states - 1) = 1.0;
+  Matrix r(1, 1, 0.2);
+  double z = 2.0;
+  double time = 0.0;
+
+  for (int k = 0; k < 8; ++k)
+  {
+    Delay::wait(0.001);
+
+    if (vary && k == 5)
+    {
+      kf.setProcessNoise(0.5);
+      for (short i = 0; i < c_states; ++i)
+        ref.q(i, i) = 0.5;
+    }
+
+    kf.predict();
+    ref.predict();
+
+    Matrix y(c_outputs, 1);
+    for (short i = 0; i < c_outputs; ++i)
+      y(i) = std::sin(0.3 * k + i);
+
+    // Innovations relative to each filter's own prediction.
+    Matrix innov = y - ref.c * kf.getState();
+    for (short i = 0; i < c_outputs; ++i)
+      kf.setInnovation(i, innov(i));
+
+    kf.update(0.0);
+    ref.update(y - ref.c * ref.x);
+
+    if (k == 3)
+    {
+      TextbookFilter late = ref;
+      late.c = c;
+      late.r = r;
+      late.update(Matrix(1, 1, z) - c * ref.x);
+      ref.x = late.x;
+
+      ref.p = late.p;
+      time = Clock::getSinceEpoch();
+    }
+  }
+
+  Matrix x;
+  Matrix p;
+  if (!kf.getPastState(time, x, p))
+    return false;
+
+  if (kf.updateDelayed(time, c, r, Matrix(1, 1, z) - c * x) != 0)
+    return false;
+
+  double error = difference(kf.getState(), ref.x);
+  error = std::max(error, difference(kf.getCovariance(), ref.p));
+  return error < 1e-9;
+}
+
+int
+main(void)
+{
+  Test test("Navigation::KalmanFilter");
+
+  {
+    KalmanFilter kf;
+    test.boolean("standard form by default", kf.getCovarianceForm() == KalmanFilter::CF_STANDARD);
+  }
+
+  test.boolean("standard form, batch update", run(KalmanFilter::CF_STANDARD, false, false));
+  test.boolean("standard form, sequential update", run(KalmanFilter::CF_STANDARD, true, false));
+  test.boolean("standard form, sparse update", run(KalmanFilter::CF_STANDARD, false, true, true));
+  test.boolean("Joseph form, batch update", run(KalmanFilter::CF_JOSEPH, false, false));
+  test.boolean("Joseph form, sequential update", run(KalmanFilter::CF_JOSEPH, true, false));
+  test.boolean("Joseph form, correlated noise", run(KalmanFilter::CF_JOSEPH, true, true));
+  test.boolean("U-D form, diagonal noise", run(KalmanFilter::CF_UD, true, false));
+  test.boolean("U-D form, correlated noise", run(KalmanFilter::CF_UD, true, true));
+  test.boolean("sparse, batch update", run(KalmanFilter::CF_JOSEPH, false, false, true));
+  test.boolean("sparse, correlated noise", run(KalmanFilter::CF_JOSEPH, true, true, true));
+  test.boolean("sparse, sequential update", run(KalmanFilter::CF_JOSEPH, true, false, true));
+  test.boolean("sparse, U-D form", run(KalmanFilter::CF_UD, true, true, true));
+
+  {
+    KalmanFilter kf;
+    TextbookFilter ref;
+    setup(kf, ref, false);
+    kf.setObservationPattern(ref.c);
+    kf.resize(c_outputs + 1);
+    kf.setObservation(c_outputs, 5, 1.0);
+    kf.setMeasurementNoise(c_outputs, 0.5);
+    kf.setInnovation(c_outputs, 1.0);
+    kf.setSequentialUpdates(false);
+    kf.update(0.0);
+    test.boolean("outputs added by resize are dense", kf.getState(5) != 0.0);
+  }
+
+  {
+    KalmanFilter kf;
+    TextbookFilter ref;
+    setup(kf, ref, false);
+    kf.setInnovation(0, 100.0);
+    test.boolean("innovation above threshold rejected", kf.update(10.0) == -1);
+    test.boolean("state unchanged after rejection", kf.getState(0) == 0.0);
+    kf.setInnovation(0, 0.1);
+    test.boolean("innovation below threshold accepted", kf.update(10.0) == 0);
+  }
+
+  {
+    KalmanFilter kf;
+    TextbookFilter ref;
+    setup(kf, ref, false);
+    kf.setCovarianceForm(KalmanFilter::CF_UD);
+    kf.predict();
+    kf.setCovariance(0, 5.0);
+    ref.predict();
+    ref.p(0, 0) = 5.0;
+    kf.predict();
+    ref.predict();
+    test.boolean("U-D factors follow covariance changes", difference(kf.getCovariance(), ref.p) < 1e-9);
+  }
+
+  {
+    // Invertible but indefinite measurement prediction covariance.
+    KalmanFilter kf;
+    TextbookFilter ref;
+    setup(kf, ref, false);
+    kf.setMeasurementNoise(2, -5.0);
+    ref.r(2, 2) = -5.0;
+
+    Matrix innov(c_outputs, 1);
+    for (short i = 0; i < c_outputs; ++i)
+    {
+      innov(i) = 0.1 * (i + 1);
+      kf.setInnovation(i, innov(i));
+    }
+
+    bool accepted = kf.update(100.0) == 0;
+    ref.update(innov);
+    test.boolean("indefinite innovation covariance",
+                 accepted && difference(kf.getState(), ref.x) < 1e-9
+                 && difference(kf.getCovariance(), ref.p) < 1e-9);
+  }
+
+  test.boolean("delayed measurement, Joseph form", runDelayed(KalmanFilter::CF_JOSEPH));
+  test.boolean("delayed measurement, U-D form", runDelayed(KalmanFilter::CF_UD));
+  test.boolean("delayed measurement, model change", runDelayed(KalmanFilter::CF_JOSEPH, true));
+
+  {
+    KalmanFilter kf;
+    TextbookFilter ref;
+    setup(kf, ref, false);
+    kf.setHistorySize(4);
+    double start = Clock::getSinceEpoch();
+    double middle = 0.0;
+
+    for (int k = 0; k < 6; ++k)
+    {
+      Delay::wait(0.001);
+      kf.predict();
+
+      if (k == 2)
+        middle = Clock::getSinceEpoch();
+    }
+
+    Matrix x;
+    Matrix p;
+    Matrix c(1, c_states, 0.0);
+    Matrix innov(1, 1, 0.0);
+    double now = Clock::getSinceEpoch();
+    test.boolean("no past state before history", !kf.getPastState(start, x, p));
+    test.boolean("no past state after last step", !kf.getPastState(now, x, p));
+    test.boolean("delayed update after last step not applicable",
+                 kf.updateDelayed(now, c, Matrix(1, 1, 1.0), innov) == -2);
+
+    kf.setReplayLimit(1);
+    test.boolean("replay limit enforced",
+                 kf.updateDelayed(middle, c, Matrix(1, 1, 1.0), innov) == -2);
+  }
+
+  return test.getReturnValue();
+}
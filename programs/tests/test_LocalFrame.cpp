@@ -0,0 +1,164 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Number of points per batch (not a multiple of the block size).
+static const size_t c_count = 1000;
+
+int
+main(void)
+{
+  Test test("LocalFrame");
+
+  const double ref_lat = Angles::radians(41.1850);
+  const double ref_lon = Angles::radians(-8.7060);
+  const double ref_hae = 120.0;
+
+  std::vector<double> lat(c_count), lon(c_count), hae(c_count);
+  std::vector<double> n(c_count), e(c_count), d(c_count);
+  std::vector<double> x(c_count), y(c_count), z(c_count);
+
+  for (size_t i = 0; i < c_count; ++i)
+  {
+    lat[i] = ref_lat + 0.02 * std::sin(0.37 * i);
+    lon[i] = ref_lon + 0.02 * std::cos(0.11 * i);
+    hae[i] = 50.0 * std::sin(0.05 * i);
+  }
+
+  {
+    WGS84::toECEF(&lat[0], &lon[0], &hae[0], c_count, &x[0], &y[0], &z[0]);
+
+    std::vector<double> lat2(c_count), lon2(c_count), hae2(c_count);
+    WGS84::fromECEF(&x[0], &y[0], &z[0], c_count, &lat2[0], &lon2[0], &hae2[0]);
+
+    double error = 0.0;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      error = std::max(error, std::fabs(lat2[i] - lat[i]) * c_wgs84_a);
+      error = std::max(error, std::fabs(lon2[i] - lon[i]) * c_wgs84_a);
+      error = std::max(error, std::fabs(hae2[i] - hae[i]));
+    }
+
+    test.boolean("ECEF batch round trip", error < 1e-3);
+  }
+
+  {
+    LocalFrame frame(ref_lat, ref_lon, ref_hae);
+    frame.toNED(&lat[0], &lon[0], &hae[0], c_count, &n[0], &e[0], &d[0]);
+
+    double error = 0.0;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      double sn, se, sd;
+      WGS84::displacement(ref_lat, ref_lon, ref_hae, lat[i], lon[i], hae[i], &sn, &se, &sd);
+      error = std::max(error, std::fabs(sn - n[i]) + std::fabs(se - e[i]) + std::fabs(sd - d[i]));
+    }
+
+    test.boolean("toNED matches WGS84::displacement", error < 1e-6);
+
+    std::vector<double> n2(c_count), e2(c_count);
+    frame.toNED(&lat[0], &lon[0], &hae[0], c_count, &n2[0], &e2[0]);
+    test.boolean("toNED without down output", std::equal(n.begin(), n.end(), n2.begin())
+                 && std::equal(e.begin(), e.end(), e2.begin()));
+  }
+
+  {
+    LocalFrame frame(ref_lat, ref_lon, ref_hae);
+    std::vector<double> lat2(c_count), lon2(c_count), hae2(c_count);
+    frame.fromNED(&n[0], &e[0], &d[0], c_count, &lat2[0], &lon2[0], &hae2[0]);
+
+    double error = 0.0;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      double slat = ref_lat;
+      double slon = ref_lon;
+      double shae = ref_hae;
+      WGS84::displace(n[i], e[i], d[i], &slat, &slon, &shae);
+      error = std::max(error, std::fabs(slat - lat2[i]) + std::fabs(slon - lon2[i]));
+      error = std::max(error, std::fabs(shae - hae2[i]) / c_wgs84_a);
+    }
+
+    test.boolean("fromNED matches WGS84::displace", error < 1e-12);
+  }
+
+  {
+    LocalFrame frame(0.0, 0.0);
+    frame.setReference(ref_lat, ref_lon);
+
+    double n0, e0, d0;
+    frame.toNED(&ref_lat, &ref_lon, NULL, 1, &n0, &e0, &d0);
+    test.boolean("reference maps to origin", std::fabs(n0) + std::fabs(e0) + std::fabs(d0) < 1e-6);
+  }
+
+  {
+    std::vector<double> north(c_count), east(c_count);
+    std::vector<int> zone(c_count);
+    bool hem[c_count];
+
+    UTM::fromWGS84(&lat[0], &lon[0], c_count, &north[0], &east[0], &zone[0], hem);
+
+    double error = 0.0;
+    bool same_zone = true;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      double sn, se;
+      int sz;
+      bool sh;
+      UTM::fromWGS84(lat[i], lon[i], &sn, &se, &sz, &sh);
+      error = std::max(error, std::fabs(sn - north[i]) + std::fabs(se - east[i]));
+      same_zone = same_zone && (sz == zone[i]) && (sh == hem[i]) && (zone[i] == zone[0]);
+    }
+
+    test.boolean("UTM fromWGS84 batch matches scalar", error < 1e-6 && same_zone);
+
+    std::vector<double> lat2(c_count), lon2(c_count);
+    UTM::toWGS84(&north[0], &east[0], c_count, zone[0], hem[0], &lat2[0], &lon2[0]);
+
+    error = 0.0;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      error = std::max(error, std::fabs(lat2[i] - lat[i]) * c_wgs84_a);
+      error = std::max(error, std::fabs(lon2[i] - lon[i]) * c_wgs84_a);
+    }
+
+    test.boolean("UTM batch round trip", error < 1e-2);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,162 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Reference product.
+static Matrix
+naive(const Matrix& a, const Matrix& b)
+{
+  Matrix c(a.rows(), b.columns(), 0.0);
+  for (int i = 0; i < a.rows(); ++i)
+    for (int j = 0; j < b.columns(); ++j)
+      for (int k = 0; k < a.columns(); ++k)
+        c(i, j) += a(i, k) * b(k, j);
+  return c;
+}
+
+//! Compare matrices element-wise.
+static bool
+near(const Matrix& a, const Matrix& b, double tol = 1e-9)
+{
+  if (a.rows() != b.rows() || a.columns() != b.columns())
+    return false;
+
+  for (int i = 0; i < a.size(); ++i)
+  {
+    if (std::fabs(a(i) - b(i)) > tol)
+      return false;
+  }
+
+  return true;
+}
+
+//! Deterministic matrix contents.
+static Matrix
+sample(size_t r, size_t c, double seed)
+{
+  Matrix m(r, c);
+  for (int i = 0; i < m.size(); ++i)
+    m(i) = std::sin(seed + 0.7 * i);
+  return m;
+}
+
+//! Run all checks with the currently selected implementation.
+static void
+check(Test& test, const std::string& impl)
+{
+  static const size_t sizes[] = {1, 3, 5, 9, 17, 40};
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    size_t n = sizes[s];
+    std::string tag = impl + " " + Utils::String::str(n) + ": ";
+
+    Matrix a = sample(n, n + 2, 1.0);
+    Matrix b = sample(n + 2, n + 1, 2.0);
+    Matrix c;
+    multiply(a, b, c);
+    test.boolean((tag + "multiply").c_str(), near(c, naive(a, b)));
+    test.boolean((tag + "operator*").c_str(), near(a * b, naive(a, b)));
+
+    Matrix bt = transpose(b);
+    multiplyTransposed(a, bt, c);
+    test.boolean((tag + "multiplyTransposed").c_str(), near(c, naive(a, b)));
+    test.boolean((tag + "transpose").c_str(), near(transpose(bt), b, 0.0));
+
+    Matrix p = naive(sample(n + 2, n + 2, 3.0), transpose(sample(n + 2, n + 2, 3.0)));
+    p += Matrix(n + 2) * (double)n;
+    Matrix work;
+    multiplyAPAT(a, p, c, work);
+    test.boolean((tag + "multiplyAPAT").c_str(), near(c, naive(naive(a, p), transpose(a))));
+
+    Matrix rhs = sample(n + 2, 2, 4.0);
+    Matrix x = cholesky_solve(cholesky(p), rhs);
+    test.boolean((tag + "cholesky_solve").c_str(), near(naive(p, x), rhs));
+
+    Matrix g = sample(n, n, 5.0) + Matrix(n) * 2.0;
+    x = lu_solve(g, sample(n, 3, 6.0));
+    test.boolean((tag + "lu_solve").c_str(), near(naive(g, x), sample(n, 3, 6.0)));
+    test.boolean((tag + "inverse_lup").c_str(), near(naive(g, inverse_lup(g)), Matrix(n)));
+  }
+}
+
+int
+main(void)
+{
+  Test test("Math::Kernels");
+
+  const char* impls[] = {"generic", "avx2", "neon"};
+  std::string native = Kernels::getImplementation();
+
+  for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); ++i)
+  {
+    if (Kernels::setImplementation(impls[i]))
+      check(test, impls[i]);
+  }
+
+  Kernels::setImplementation(native.c_str());
+  test.boolean("restore implementation", native == Kernels::getImplementation());
+
+  Matrix a = sample(3, 3, 1.0);
+  multiply(a, a, a);
+  test.boolean("aliased multiply", near(a, naive(sample(3, 3, 1.0), sample(3, 3, 1.0))));
+
+  bool thrown = false;
+  try
+  {
+    cholesky(Matrix(2, 2, -1.0));
+  }
+  catch (Matrix::Error&)
+  {
+    thrown = true;
+  }
+  test.boolean("cholesky of non positive definite matrix", thrown);
+
+  thrown = false;
+  try
+  {
+    lu_solve(Matrix(3, 3, 1.0), Matrix(3, 1, 1.0));
+  }
+  catch (Matrix::Error&)
+  {
+    thrown = true;
+  }
+  test.boolean("lu_solve of singular matrix", thrown);
+
+  return test.getReturnValue();
+}
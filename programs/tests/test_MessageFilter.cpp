@@ -0,0 +1,210 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Move the virtual clock forward.
+//! @param[in] sec seconds.
+static void
+advance(double sec)
+{
+  Time::Clock::setVirtualNsec(Time::Clock::getNsec() + (uint64_t)(sec * 1e9));
+}
+
+//! Offer a message to a filter.
+//! @param[in] filter message filter.
+//! @param[in] msg message.
+//! @param[in] count number of times the message is offered.
+//! @return number of times the message passed.
+static unsigned
+offer(Tasks::MessageFilter& filter, const IMC::Message& msg, unsigned count)
+{
+  unsigned passed = 0;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    if (!filter.filter(&msg))
+      ++passed;
+  }
+
+  return passed;
+}
+
+int
+main(void)
+{
+  Test test("Tasks::MessageFilter");
+
+  Time::Clock::enableVirtual();
+
+  std::vector<std::string> rates;
+  rates.push_back("EstimatedState:1");
+  rates.push_back("Temperature:2:3");
+  rates.push_back("SimulatedState:0");
+
+  IMC::EstimatedState state;
+  IMC::Temperature temp;
+  IMC::SimulatedState sim;
+  IMC::Heartbeat beat;
+
+  {
+    Tasks::MessageFilter filter;
+    filter.setup(rates);
+
+    test.boolean("unlimited messages pass", offer(filter, beat, 100) == 100);
+    test.boolean("first message passes", offer(filter, state, 1) == 1);
+    test.boolean("rate is limited", offer(filter, state, 10) == 0);
+    advance(1.0);
+    test.boolean("tokens are refilled", offer(filter, state, 10) == 1);
+
+    test.boolean("burst passes", offer(filter, temp, 10) == 3);
+    advance(0.5);
+    test.boolean("burst is refilled at rate", offer(filter, temp, 10) == 1);
+    advance(100.0);
+    test.boolean("burst is bounded", offer(filter, temp, 10) == 3);
+
+    test.boolean("zero rate passes once", offer(filter, sim, 10) == 1);
+    advance(100.0);
+    test.boolean("zero rate never refills", offer(filter, sim, 10) == 0);
+
+    state.setSourceEntity(5);
+    test.boolean("buckets by source entity", offer(filter, state, 10) == 1);
+
+    std::vector<Tasks::MessageFilter::Statistics> stats = filter.getStatistics();
+    test.boolean("statistics by rule", stats.size() == 3);
+    test.boolean("statistics ordered by id", stats[0].id < stats[1].id && stats[1].id < stats[2].id);
+
+    unsigned passed = 0;
+    unsigned limited = 0;
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+      if (stats[i].id == DUNE_IMC_ESTIMATEDSTATE)
+      {
+        passed = stats[i].passed;
+        limited = stats[i].limited;
+      }
+    }
+
+    test.boolean("statistics count messages", passed == 3 && limited == 28);
+  }
+
+  {
+    Entities::EntityDataBase db;
+    unsigned nav = db.reserve("Navigation", "Navigation.AUV.Navigation");
+    unsigned sim_nav = db.reserve("Simulated Navigation", "Simulators.GPS");
+
+    std::vector<std::string> entities;
+    entities.push_back("EstimatedState:Navigation+Unknown");
+
+    Tasks::MessageFilter filter;
+    filter.setup(std::vector<std::string>(), entities, db);
+
+    state.setSourceEntity(nav);
+    test.boolean("allowed entity passes", offer(filter, state, 10) == 10);
+    state.setSourceEntity(sim_nav);
+    test.boolean("other entities are dropped", offer(filter, state, 10) == 0);
+    test.boolean("other messages pass", offer(filter, temp, 10) == 10);
+
+    std::vector<Tasks::MessageFilter::Statistics> stats = filter.getStatistics();
+    test.boolean("entity filter statistics",
+                 stats.size() == 1 && stats[0].passed == 10 && stats[0].filtered == 10);
+  }
+
+  {
+    std::vector<std::string> ranges;
+    ranges.push_back("LblRange:1");
+
+    IMC::LblRange range;
+    Tasks::MessageFilter filter;
+    filter.setup(ranges);
+
+    range.setSubId(0);
+    unsigned first = offer(filter, range, 10);
+    range.setSubId(1);
+    test.boolean("sub-ids share a bucket", first == 1 && offer(filter, range, 10) == 0);
+
+    filter.setKeyBySubId(true);
+    filter.setup(ranges);
+    range.setSubId(0);
+    first = offer(filter, range, 10);
+    range.setSubId(1);
+    test.boolean("buckets by sub-id", first == 1 && offer(filter, range, 10) == 1);
+  }
+
+  {
+    Tasks::MessageFilter filter;
+    filter.setup(rates);
+    filter.setup(std::vector<std::string>());
+    test.boolean("setup removes rules", offer(filter, sim, 10) == 10 && filter.getStatistics().empty());
+
+    std::vector<std::string> bad;
+    bad.push_back("EstimatedState:fast");
+    bool thrown = false;
+    try
+    {
+      filter.setup(bad);
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+
+    test.boolean("invalid rules throw", thrown);
+
+    Entities::EntityDataBase db;
+    db.reserve("Navigation", "Navigation.AUV.Navigation");
+
+    std::vector<std::string> trailing_rates;
+    trailing_rates.push_back("EstimatedState:1");
+    trailing_rates.push_back("");
+    std::vector<std::string> trailing_entities;
+    trailing_entities.push_back("EstimatedState:Navigation");
+    trailing_entities.push_back(" ");
+    thrown = false;
+    try
+    {
+      filter.setup(trailing_rates, trailing_entities, db);
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+
+    test.boolean("empty entries are ignored", !thrown && filter.getStatistics().size() == 1);
+  }
+
+  return test.getReturnValue();
+}
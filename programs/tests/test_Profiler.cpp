@@ -0,0 +1,134 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Task spending one millisecond of processor time per heartbeat.
+class BusyTask: public Tasks::Task
+{
+public:
+  unsigned count;
+
+  BusyTask(const std::string& name, Tasks::Context& ctx):
+    Tasks::Task(name, ctx),
+    count(0)
+  {
+    setEntityLabel(name);
+    bind<IMC::Heartbeat>(this);
+  }
+
+  void
+  consume(const IMC::Heartbeat* msg)
+  {
+    (void)msg;
+
+    uint64_t end = Clock::getNsec() + 1000000;
+    while (Clock::getNsec() < end)
+    { }
+
+    ++count;
+  }
+
+  void
+  onMain(void)
+  {
+    while (!stopping())
+      waitForMessages(0.05);
+  }
+};
+
+int
+main(void)
+{
+  Test test("Profiler");
+
+  Tasks::Context ctx;
+  BusyTask* busy = new BusyTask("Busy", ctx);
+  busy->loadConfig();
+  busy->reserveEntities();
+  busy->setProfiling(true);
+
+  std::vector<Tasks::Task*> tasks(1, busy);
+  Tasks::Profiler* profiler = new Tasks::Profiler("Profiler", ctx, tasks);
+  profiler->loadConfig();
+  profiler->setFrequency(20);
+  profiler->reserveEntities();
+
+  busy->start();
+  profiler->start();
+  Delay::wait(0.1);
+
+  IMC::Heartbeat hb;
+  for (unsigned i = 0; i < 50; ++i)
+    ctx.mbus.dispatch(&hb);
+
+  for (unsigned i = 0; i < 100 && busy->count < 50; ++i)
+    Delay::wait(0.05);
+  Delay::wait(0.2);
+
+  Concurrency::Thread::Usage usage;
+  bool has_usage = busy->getUsage(usage);
+
+  profiler->stopAndJoin();
+  busy->stopAndJoin();
+
+  std::ostringstream os;
+  profiler->writeFoldedStacks(os);
+  std::string stacks = os.str();
+
+  unsigned long usec = 0;
+  size_t pos = stacks.find("dune;Busy;Heartbeat ");
+  if (pos != std::string::npos)
+    usec = std::strtoul(stacks.c_str() + pos + 20, NULL, 10);
+
+  test.boolean("all messages consumed", busy->count == 50);
+  test.boolean("consume time is measured", usec >= 50000 && usec < 500000);
+
+#if defined(DUNE_OS_LINUX)
+  test.boolean("thread usage is available",
+               has_usage && usage.cpu_time >= 0.04 && usage.voluntary_switches > 0);
+#else
+  (void)has_usage;
+#endif
+
+  delete profiler;
+  delete busy;
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,133 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Eduardo Marques                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Pseudo-random value in [-1, 1].
+static double
+uniform(unsigned& seed)
+{
+  seed = seed * 1103515245U + 12345U;
+  return ((seed >> 8) & 0xffff) / 32768.0 - 1.0;
+}
+
+//! Solve a sequence of problems sharing the Hessian and compare the
+//! solver object against one-shot solves.
+static bool
+run(int n, int m, bool warm, unsigned seed)
+{
+  Matrix M(n, n);
+  for (int i = 0; i < M.size(); ++i)
+    M(i) = uniform(seed);
+
+  Matrix H = M * transpose(M) + Matrix(n) * 0.5;
+  Matrix f(n, 1);
+  Matrix A(m, n);
+  Matrix b(m, 1);
+
+  for (int i = 0; i < A.size(); ++i)
+    A(i) = uniform(seed);
+
+  for (int i = 0; i < m; ++i)
+    b(i) = 1.0 + uniform(seed);
+
+  QPSolver qp;
+  qp.setHessian(H);
+  qp.setWarmStart(warm);
+
+  double error = 0.0;
+  for (int k = 0; k < 100; ++k)
+  {
+    for (int i = 0; i < n; ++i)
+      f(i) = 3.0 * std::sin(0.05 * k + i);
+
+    for (int i = 0; i < m; ++i)
+      b(i) += 0.05 * uniform(seed);
+
+    Matrix x0;
+    Matrix x1;
+    double v0 = QPSolver::solve(H, f, A, b, x0);
+    double v1 = qp.solve(f, A, b, x1);
+
+    error = std::max(error, std::fabs(v0 - v1));
+    for (int i = 0; i < n; ++i)
+      error = std::max(error, std::fabs(x0(i) - x1(i)));
+  }
+
+  return error < 1e-9;
+}
+
+int
+main(void)
+{
+  Test test("Math::QPSolver");
+
+  test.boolean("cached factorization, 4 variables", run(4, 8, false, 1));
+  test.boolean("cached factorization, 12 variables", run(12, 30, false, 2));
+  test.boolean("warm start, 4 variables", run(4, 8, true, 3));
+  test.boolean("warm start, 12 variables", run(12, 30, true, 4));
+  test.boolean("warm start, many constraints", run(6, 60, true, 5));
+
+  {
+    QPSolver qp;
+    Matrix x;
+    bool thrown = false;
+    try
+    {
+      qp.solve(Matrix(2, 1, 0.0), Matrix(1, 2, 1.0), Matrix(1, 1, 1.0), x);
+    }
+    catch (QPSolver::Error&)
+    {
+      thrown = true;
+    }
+
+    test.boolean("solve without Hessian fails", thrown);
+
+    thrown = false;
+    try
+    {
+      qp.setHessian(Matrix(2, 2, 1.0));
+    }
+    catch (QPSolver::Error&)
+    {
+      thrown = true;
+    }
+
+    test.boolean("non positive definite Hessian rejected", thrown);
+  }
+
+  return test.getReturnValue();
+}
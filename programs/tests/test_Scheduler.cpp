@@ -0,0 +1,106 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <stdexcept>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Thread that records the processor it ran on.
+class PinnedThread: public Concurrency::Thread
+{
+public:
+  int cpu;
+
+  PinnedThread(void):
+    cpu(-1)
+  { }
+
+private:
+  void
+  run(void)
+  {
+#if defined(DUNE_OS_LINUX)
+    cpu = sched_getcpu();
+#endif
+  }
+};
+
+//! Test if parsing a processor list fails.
+static bool
+invalid(const std::string& list)
+{
+  try
+  {
+    Scheduler::parseProcessors(list);
+  }
+  catch (std::runtime_error&)
+  {
+    return true;
+  }
+
+  return false;
+}
+
+int
+main(void)
+{
+  Test test("Scheduler");
+
+  {
+    std::vector<unsigned> cpus = Scheduler::parseProcessors("5, 0-2,1");
+    test.boolean("parse processor list",
+                 cpus.size() == 4 && cpus[0] == 0 && cpus[2] == 2 && cpus[3] == 5);
+    test.boolean("format processor list",
+                 Scheduler::formatProcessors(cpus) == "0-2,5");
+    test.boolean("parse empty processor list",
+                 Scheduler::parseProcessors("").empty());
+    test.boolean("reject invalid processor lists",
+                 invalid("3-1") && invalid("-1") && invalid("a") && invalid("1-2-3"));
+  }
+
+  {
+    std::vector<unsigned> cpus(1, System::Resources::getProcessorCount() - 1);
+    PinnedThread thread;
+    thread.setAffinity(cpus);
+    thread.start();
+    thread.join();
+
+#if defined(DUNE_SYS_HAS_PTHREAD_SETAFFINITY_NP)
+    test.boolean("pin thread", thread.cpu == (int)cpus[0]);
+#endif
+  }
+
+  return test.getReturnValue();
+}
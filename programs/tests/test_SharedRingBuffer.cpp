@@ -0,0 +1,232 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_SYS_HAS_UNISTD_H) && defined(DUNE_SYS_HAS_SYS_WAIT_H)
+#  include <unistd.h>
+#  include <sys/wait.h>
+#endif
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+// Number of records exchanged by the producer thread.
+static const unsigned c_records = 200000;
+
+//! Fill a record with a pattern derived from its sequence number.
+static unsigned
+fill(unsigned seq, uint8_t* bfr)
+{
+  unsigned size = 4 + (seq * 7) % 300;
+  std::memcpy(bfr, &seq, 4);
+  for (unsigned i = 4; i < size; ++i)
+    bfr[i] = (uint8_t)(seq + i);
+  return size;
+}
+
+class Producer: public Concurrency::Thread
+{
+public:
+  Producer(const char* name):
+    m_ring(name, 4096)
+  {
+    m_ring.open();
+  }
+
+private:
+  SharedRingBuffer m_ring;
+
+  void
+  run(void)
+  {
+    for (unsigned seq = 0; seq < c_records; )
+    {
+      uint8_t* bfr = m_ring.reserve(304);
+      if (bfr == NULL)
+      {
+        Delay::wait(0.0001);
+        continue;
+      }
+
+      m_ring.commit(fill(seq++, bfr));
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("Concurrency::SharedRingBuffer");
+
+  {
+    SharedRingBuffer ring("test-ring-missing", 4096);
+    bool failed = false;
+    try
+    {
+      ring.open();
+    }
+    catch (std::exception&)
+    {
+      failed = true;
+    }
+    test.boolean("Open non-existent ring", failed);
+  }
+
+  {
+    SharedRingBuffer* consumer = new SharedRingBuffer("test-ring-close", 4096);
+    consumer->create();
+
+    SharedRingBuffer other("test-ring-close", 8192);
+    bool failed = false;
+    try
+    {
+      other.open();
+    }
+    catch (std::exception&)
+    {
+      failed = true;
+    }
+    test.boolean("Reject ring with different capacity", failed);
+
+    SharedRingBuffer* producer = new SharedRingBuffer("test-ring-close", 4096);
+    producer->open();
+    test.boolean("Producer attached", producer->isOpen());
+
+    uint8_t data[16] = {0};
+    unsigned count = 0;
+    while (producer->write(data, sizeof(data)))
+      ++count;
+    test.boolean("Ring full", count > 0 && count <= 4096 / 20);
+    test.boolean("Oversized record rejected",
+                 producer->reserve(producer->getMaximumRecordSize() + 1) == NULL);
+
+    unsigned size = 0;
+    test.boolean("Peek record", consumer->peek(size) != NULL && size == sizeof(data));
+    consumer->release();
+    test.boolean("Space reclaimed", producer->write(data, sizeof(data)));
+
+    delete consumer;
+    test.boolean("Consumer closed", !producer->isOpen());
+    delete producer;
+  }
+
+  {
+    SharedRingBuffer first("test-ring-restart", 4096);
+    first.create();
+
+    SharedRingBuffer producer("test-ring-restart", 4096);
+    producer.open();
+
+    // A restarted consumer replaces the ring without closing it.
+    SharedRingBuffer second("test-ring-restart", 4096);
+    second.create();
+    test.boolean("Restarted consumer detected", !producer.isOpen());
+
+    producer.open();
+    uint8_t data[16] = {0};
+    unsigned size = 0;
+    test.boolean("Producer reattached", producer.checkConsumer() && producer.write(data, sizeof(data))
+                 && second.peek(size) != NULL && size == sizeof(data));
+  }
+
+#if defined(DUNE_SYS_HAS_UNISTD_H) && defined(DUNE_SYS_HAS_SYS_WAIT_H)
+  {
+    // Consumer terminates without closing the ring.
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      SharedRingBuffer* consumer = new SharedRingBuffer("test-ring-crash", 4096);
+      consumer->create();
+      _exit(0);
+    }
+
+    waitpid(pid, NULL, 0);
+
+    SharedRingBuffer producer("test-ring-crash", 4096);
+    bool failed = false;
+    try
+    {
+      producer.open();
+    }
+    catch (std::exception&)
+    {
+      failed = true;
+    }
+
+    test.boolean("Terminated consumer detected", failed && !producer.checkConsumer());
+
+    SharedRingBuffer consumer("test-ring-crash", 4096);
+    consumer.create();
+    producer.open();
+    test.boolean("Consumer replaced after termination", producer.checkConsumer());
+  }
+#endif
+
+  {
+    SharedRingBuffer consumer("test-ring-stream", 4096);
+    consumer.create();
+
+    Producer producer("test-ring-stream");
+    producer.start();
+
+    uint8_t expected[512];
+    unsigned received = 0;
+    bool ok = true;
+    while (received < c_records && ok)
+    {
+      if (!consumer.wait(1.0))
+      {
+        ok = false;
+        break;
+      }
+
+      unsigned size = 0;
+      const uint8_t* data = NULL;
+      while ((data = consumer.peek(size)) != NULL)
+      {
+        unsigned esize = fill(received, expected);
+        if (size != esize || std::memcmp(data, expected, size) != 0)
+          ok = false;
+        consumer.release();
+        ++received;
+      }
+    }
+
+    producer.stopAndJoin();
+    test.boolean("Records received in order and intact", ok && received == c_records);
+  }
+
+  return test.getReturnValue();
+}
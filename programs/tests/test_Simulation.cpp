@@ -0,0 +1,228 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <string>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Daemon.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+void
+registerStaticTasks(void);
+
+//! Tasks talking to the network, writing logs or measuring the host.
+static const char* c_disabled[] =
+{
+  "Monitors.CPU",
+  "Transports.Announce",
+  "Transports.Discovery",
+  "Transports.FTP",
+  "Transports.HTTP",
+  "Transports.Logging",
+  "Transports.TCP.Server",
+  "Transports.UDP"
+};
+//! Distance to the Goto target (m).
+static const double c_range = 100.0;
+//! Simulated time limit (s).
+static const double c_duration = 900.0;
+
+//! True if the plan ran.
+static volatile bool s_executed = false;
+//! True if the plan finished.
+static volatile bool s_finished = false;
+//! Simulated time taken by the plan (s).
+static volatile double s_elapsed = 0;
+//! Outcome of the plan.
+static volatile unsigned s_outcome = IMC::PlanControlState::LPO_NONE;
+//! Distance between the vehicle and the target when the plan
+//! finished (m).
+static volatile double s_error = -1.0;
+
+//! Cooperative task sending a Goto plan once the vehicle is ready and
+//! recording its outcome.
+class PlanTask: public Tasks::Task
+{
+public:
+  PlanTask(const std::string& name, Tasks::Context& ctx):
+    Tasks::Task(name, ctx),
+    m_service(false),
+    m_started(false),
+    m_lat(0),
+    m_lon(0),
+    m_start(0)
+  {
+    setCooperative();
+    bind<IMC::EstimatedState>(this);
+    bind<IMC::PlanControlState>(this);
+    bind<IMC::VehicleState>(this);
+  }
+
+  void
+  consume(const IMC::EstimatedState* msg)
+  {
+    if (msg->getSource() != getSystemId())
+      return;
+
+    m_estate = *msg;
+  }
+
+  void
+  consume(const IMC::VehicleState* msg)
+  {
+    m_service = (msg->op_mode == IMC::VehicleState::VS_SERVICE);
+  }
+
+  void
+  consume(const IMC::PlanControlState* msg)
+  {
+    if (!m_started)
+    {
+      if (m_service && msg->state == IMC::PlanControlState::PCS_READY && m_estate.lat != 0)
+        start();
+      return;
+    }
+
+    if (msg->state == IMC::PlanControlState::PCS_EXECUTING)
+      s_executed = true;
+
+    if (s_executed && msg->state == IMC::PlanControlState::PCS_READY && !s_finished)
+    {
+      double lat = 0;
+      double lon = 0;
+      Coordinates::toWGS84(m_estate, lat, lon);
+
+      double bearing = 0;
+      double range = 0;
+      WGS84::getNEBearingAndRange(lat, lon, m_lat, m_lon, &bearing, &range);
+
+      s_error = range;
+      s_elapsed = Clock::get() - m_start;
+      s_outcome = msg->last_outcome;
+      s_finished = true;
+    }
+  }
+
+  void
+  onMain(void)
+  { }
+
+private:
+  //! Send a plan going c_range meters north of the vehicle.
+  void
+  start(void)
+  {
+    Coordinates::toWGS84(m_estate, m_lat, m_lon);
+    WGS84::displace(c_range, 0.0, &m_lat, &m_lon);
+
+    IMC::Goto man;
+    man.timeout = 600;
+    man.lat = m_lat;
+    man.lon = m_lon;
+    man.z = 2.0;
+    man.z_units = IMC::Z_DEPTH;
+    man.speed = 1.5;
+    man.speed_units = IMC::SUNITS_METERS_PS;
+
+    IMC::PlanManeuver pman;
+    pman.maneuver_id = "goto";
+    pman.data.set(man);
+
+    IMC::PlanSpecification spec;
+    spec.plan_id = "test";
+    spec.start_man_id = pman.maneuver_id;
+    spec.maneuvers.push_back(pman);
+
+    IMC::PlanControl pc;
+    pc.type = IMC::PlanControl::PC_REQUEST;
+    pc.op = IMC::PlanControl::PC_START;
+    pc.plan_id = spec.plan_id;
+    pc.arg.set(spec);
+    dispatch(pc);
+
+    m_start = Clock::get();
+    m_started = true;
+  }
+
+  bool m_service;
+  bool m_started;
+  double m_lat;
+  double m_lon;
+  double m_start;
+  IMC::EstimatedState m_estate;
+};
+
+static Tasks::Task*
+createPlanTask(const std::string& name, Tasks::Context& ctx)
+{
+  return new PlanTask(name, ctx);
+}
+
+int
+main(void)
+{
+  Test test("Simulation");
+
+  Tasks::Context ctx;
+  Tasks::Factory::registerDynamicTasks(ctx.dir_lib.c_str());
+  registerStaticTasks();
+  Tasks::Factory::registerStaticTask("Test.Plan", createPlanTask);
+
+  ctx.config.parseFile((ctx.dir_cfg / "lauv-simulator-1.ini").c_str());
+  for (unsigned i = 0; i < sizeof(c_disabled) / sizeof(c_disabled[0]); ++i)
+    ctx.config.set(c_disabled[i], "Enabled", "Never");
+  ctx.config.set("Test.Plan", "Enabled", "Always");
+  ctx.config.set("Test.Plan", "Entity Label", "Test Plan");
+  ctx.config.set("General", "Deterministic Executor", "true");
+  ctx.config.set("General", "Deterministic Duration", Utils::String::str(c_duration));
+
+  {
+    DUNE::Daemon daemon(ctx, "Simulation");
+    daemon.start();
+
+    while (!s_finished && !daemon.isFinished() && daemon.isRunning())
+      Delay::wait(0.1);
+
+    daemon.stopAndJoin();
+  }
+
+  test.boolean("plan executed", s_executed);
+  test.boolean("plan finished", s_finished);
+  test.boolean("plan succeeded", s_outcome == IMC::PlanControlState::LPO_SUCCESS);
+  test.boolean("target reached", s_error >= 0 && s_error < 10.0);
+  test.boolean("plan ran on simulated time", s_elapsed > c_range / 2.0 && s_elapsed < c_duration);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,133 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+#include <cstdlib>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+//! Timer expected by the tests.
+struct Expected
+{
+  uint64_t deadline;
+  unsigned id;
+};
+
+int
+main(void)
+{
+  Test test("Timer Wheel");
+
+  // Tick of 1 ms, starting at an arbitrary time.
+  const uint64_t res = 1000000;
+  const uint64_t origin = 123456789012ULL;
+
+  {
+    Tasks::TimerWheel<unsigned> wheel(origin, res);
+    std::vector<Expected> timers;
+
+    // Deadlines spread over all levels and past the range of the wheel.
+    std::srand(42);
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+      Expected e;
+      e.id = i;
+      e.deadline = origin + (uint64_t)(std::rand() % 20000) * (uint64_t)(std::rand() % 1000) * 1000;
+      if (i % 100 == 0)
+        e.deadline = origin + (uint64_t)(30000 + i) * 1000000000ULL;
+      timers.push_back(e);
+      wheel.add(e.deadline, e.id);
+    }
+
+    bool early = false;
+    bool late = false;
+    bool hint = true;
+    std::vector<bool> fired(timers.size(), false);
+    std::vector<unsigned> expired;
+
+    // Sleep until the next deadline hint, as the executor does.
+    uint64_t now = origin;
+    while (!wheel.empty())
+    {
+      uint64_t next = wheel.getNextDeadline();
+      for (size_t i = 0; i < timers.size(); ++i)
+      {
+        uint64_t tick = (timers[i].deadline + res - 1) / res;
+        if (!fired[i] && tick * res < next)
+          hint = false;
+      }
+
+      now = std::max(now + res / 3, next);
+      expired.clear();
+      wheel.advance(now, expired);
+
+      for (size_t i = 0; i < expired.size(); ++i)
+      {
+        const Expected& e = timers[expired[i]];
+        fired[e.id] = true;
+        early = early || (e.deadline > now);
+        late = late || (now - e.deadline > res);
+      }
+    }
+
+    bool all = true;
+    for (size_t i = 0; i < fired.size(); ++i)
+      all = all && fired[i];
+
+    test.boolean("all timers expire", all);
+    test.boolean("no timer expires early", !early);
+    test.boolean("no timer expires late", !late);
+    test.boolean("next deadline is never late", hint);
+  }
+
+  {
+    Tasks::TimerWheel<unsigned> wheel(origin, res);
+    std::vector<unsigned> expired;
+
+    // Long idle periods without timers.
+    wheel.advance(origin + 3600 * 1000000000ULL, expired);
+    wheel.add(origin + 3600 * 1000000000ULL + 5 * res, 1);
+    wheel.add(origin, 2);
+    wheel.advance(origin + 3600 * 1000000000ULL + res, expired);
+    test.boolean("overdue timers expire on next advance",
+                 expired.size() == 1 && expired[0] == 2);
+
+    expired.clear();
+    wheel.advance(origin + 3600 * 1000000000ULL + 6 * res, expired);
+    test.boolean("timers expire after idle period",
+                 expired.size() == 1 && expired[0] == 1 && wheel.empty());
+  }
+
+  return test.getReturnValue();
+}
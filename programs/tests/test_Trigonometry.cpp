@@ -0,0 +1,128 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+
+int
+main(void)
+{
+  Test test("Trigonometry");
+
+  {
+    double error = 0.0;
+    for (int i = -200000; i <= 200000; ++i)
+    {
+      double a = i * 1e-4 + 1e-9 * (i % 7);
+      double s, c;
+      Trigonometry::fastSinCos(a, s, c);
+      error = std::max(error, std::fabs(s - std::sin(a)));
+      error = std::max(error, std::fabs(c - std::cos(a)));
+    }
+
+    test.boolean("fastSinCos error in [-20, 20]", error < 3e-16);
+  }
+
+  {
+    double error = 0.0;
+    for (int i = 0; i <= 100000; ++i)
+    {
+      double a = Trigonometry::c_fast_range * (2.0 * i / 100000.0 - 1.0);
+      error = std::max(error, std::fabs(Trigonometry::fastSin(a) - std::sin(a)));
+      error = std::max(error, std::fabs(Trigonometry::fastCos(a) - std::cos(a)));
+    }
+
+    test.boolean("fastSinCos error over fast range", error < 3e-16);
+  }
+
+  {
+    double big = 1e9;
+    double s, c;
+    Trigonometry::fastSinCos(big, s, c);
+    test.boolean("fastSinCos large argument", s == std::sin(big) && c == std::cos(big));
+  }
+
+  {
+    double error = 0.0;
+    for (int i = 0; i < 360000; ++i)
+    {
+      double a = (i / 1000.0) * Math::c_pi / 180.0 - Math::c_pi;
+      double r = 1e-3 + (i % 1000);
+      double y = r * std::sin(a);
+      double x = r * std::cos(a);
+      error = std::max(error, std::fabs(Trigonometry::fastAtan2(y, x) - std::atan2(y, x)));
+    }
+
+    test.boolean("fastAtan2 error", error < 5e-16);
+  }
+
+  {
+    const double inf = HUGE_VAL;
+    bool ok = true;
+    ok = ok && Trigonometry::fastAtan2(0.0, 0.0) == std::atan2(0.0, 0.0);
+    ok = ok && Trigonometry::fastAtan2(1.0, 0.0) == std::atan2(1.0, 0.0);
+    ok = ok && Trigonometry::fastAtan2(-1.0, 0.0) == std::atan2(-1.0, 0.0);
+    ok = ok && Trigonometry::fastAtan2(0.0, -1.0) == std::atan2(0.0, -1.0);
+    ok = ok && Trigonometry::fastAtan2(inf, 1.0) == std::atan2(inf, 1.0);
+    ok = ok && Trigonometry::fastAtan2(1.0, -inf) == std::atan2(1.0, -inf);
+    ok = ok && Trigonometry::fastAtan2(inf, -inf) == std::atan2(inf, -inf);
+    test.boolean("fastAtan2 special values", ok);
+  }
+
+  {
+    std::vector<double> a(10000);
+    std::vector<double> n(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+      a[i] = (static_cast<double>(i) - 5000.0) * 0.0123;
+    a[0] = Math::c_pi;
+    a[1] = -Math::c_pi;
+
+    Angles::normalizeRadian(&a[0], a.size(), &n[0]);
+
+    double error = 0.0;
+    bool range = true;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+      error = std::max(error, std::fabs(n[i] - Angles::normalizeRadian(a[i])));
+      range = range && (n[i] > -Math::c_pi) && (n[i] <= Math::c_pi);
+    }
+
+    test.boolean("normalizeRadian batch", error < 1e-12 && range);
+  }
+
+  return test.getReturnValue();
+}
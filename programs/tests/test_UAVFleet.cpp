@@ -0,0 +1,186 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/UAVFleet.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE_NAMESPACES;
+using DUNE::Simulation::Integrator;
+using DUNE::Simulation::UAVFleet;
+
+//! Give each vehicle of a fleet a different initial state and commands.
+static void
+initialize(UAVFleet& fleet)
+{
+  for (size_t i = 0; i < fleet.size(); ++i)
+  {
+    fleet.setState(i, 10.0 * i, -5.0 * i, -100.0 - i, 0.0, 0.1 * i, 18.0);
+    fleet.commandBank(i, 0.5 - 0.05 * i);
+    fleet.commandAirspeed(i, 16.0 + 0.2 * i);
+    if (i % 2)
+      fleet.commandAltitude(i, 120.0);
+    else
+      fleet.commandFPA(i, -0.05);
+  }
+}
+
+int
+main(void)
+{
+  Test test("UAVFleet");
+
+  {
+    // Coordinated turn at constant bank and airspeed.
+    UAVFleet::Parameters params;
+    params.model = UAVFleet::FM_3DOF;
+    UAVFleet fleet(1, params);
+    fleet.setIntegrator(Integrator::IM_RK4, 1e-6, 0.01);
+
+    double bank = 0.3;
+    double speed = 20.0;
+    fleet.setState(0, 0.0, 0.0, -100.0, bank, 0.0, speed);
+
+    for (unsigned i = 0; i < 100; ++i)
+      fleet.update(0.1);
+
+    double rate = params.gaccel * std::tan(bank) / speed;
+    double radius = speed / rate;
+    UAVFleet::State s;
+    fleet.getState(0, s);
+
+    double error = std::fabs(s.x - radius * std::sin(rate * 10.0))
+    + std::fabs(s.y - radius * (1.0 - std::cos(rate * 10.0)))
+    + std::fabs(s.r - rate);
+    test.boolean("3DOF coordinated turn", error < 1e-6);
+  }
+
+  {
+    UAVFleet::Parameters params;
+    params.model = UAVFleet::FM_4DOF_BANK;
+    params.speed_time_cst = 2.0;
+    UAVFleet fleet(1, params);
+    fleet.setIntegrator(Integrator::IM_RK4, 1e-6, 0.01);
+    fleet.setState(0, 0.0, 0.0, -100.0, 0.0, 0.0, 18.0);
+    fleet.commandAirspeed(0, 22.0);
+    fleet.commandBank(0, 0.2);
+
+    fleet.update(4.0);
+    UAVFleet::State s;
+    fleet.getState(0, s);
+    double expected = 22.0 - 4.0 * std::exp(-2.0);
+    test.boolean("4DOF_bank airspeed response",
+                 std::fabs(s.airspeed - expected) < 1e-6 && std::fabs(s.phi - 0.2 * (1.0 - std::exp(-4.0))) < 1e-6);
+  }
+
+  {
+    UAVFleet::Parameters params;
+    params.model = UAVFleet::FM_5DOF;
+    params.alt_time_cst = 2.0;
+    params.vert_slope_lim = 0.1;
+    UAVFleet fleet(2, params);
+    fleet.setIntegrator(Integrator::IM_DORMAND_PRINCE, 1e-8, 0.0);
+    fleet.setState(0, 0.0, 0.0, -100.0, 0.0, 0.0, 20.0);
+    fleet.setState(1, 0.0, 0.0, -100.0, 0.0, 0.0, 20.0);
+    fleet.commandAltitude(0, 150.0);
+    fleet.commandFPA(1, -0.05);
+
+    for (unsigned i = 0; i < 120; ++i)
+      fleet.update(0.5);
+
+    UAVFleet::State climb;
+    UAVFleet::State descent;
+    fleet.getState(0, climb);
+    fleet.getState(1, descent);
+    test.boolean("5DOF altitude and flight path angle commands",
+                 std::fabs(climb.z + 150.0) < 1e-3 && std::fabs(descent.theta + 0.05) < 1e-9
+                 && std::fabs(descent.z + 100.0 - 20.0 * std::sin(0.05) * 60.0) < 1e-6);
+  }
+
+  {
+    // Groups and threads do not change the results.
+    UAVFleet::Parameters params;
+    params.model = UAVFleet::FM_5DOF;
+    params.bank_rate_lim = 0.2;
+    params.wind[0] = 3.0;
+
+    UAVFleet single(37, params, 64);
+    UAVFleet grouped(37, params, 4);
+    UAVFleet threaded(37, params, 4, 3);
+    single.setIntegrator(Integrator::IM_RK4, 1e-6, 0.05);
+    grouped.setIntegrator(Integrator::IM_RK4, 1e-6, 0.05);
+    threaded.setIntegrator(Integrator::IM_RK4, 1e-6, 0.05);
+    initialize(single);
+    initialize(grouped);
+    initialize(threaded);
+
+    for (unsigned i = 0; i < 200; ++i)
+    {
+      single.update(0.1);
+      grouped.update(0.1);
+      threaded.update(0.1);
+    }
+
+    bool equal = grouped.getGroupCount() == 10;
+    for (size_t i = 0; i < single.size(); ++i)
+    {
+      UAVFleet::State a, b, c;
+      single.getState(i, a);
+      grouped.getState(i, b);
+      threaded.getState(i, c);
+      equal = equal && a.x == b.x && a.y == b.y && a.z == b.z && a.psi == b.psi
+      && b.x == c.x && b.y == c.y && b.z == c.z && b.psi == c.psi && b.airspeed == c.airspeed;
+    }
+
+    test.boolean("groups and threads are independent", equal);
+  }
+
+  {
+    bool ok = UAVFleet::parseModel("3DOF") == UAVFleet::FM_3DOF
+    && UAVFleet::parseModel("4DOF_alt") == UAVFleet::FM_4DOF_ALT
+    && UAVFleet::parseModel("4DOF_bank") == UAVFleet::FM_4DOF_BANK
+    && UAVFleet::parseModel("5DOF") == UAVFleet::FM_5DOF;
+
+    try
+    {
+      UAVFleet::parseModel("6DOF_geom");
+      ok = false;
+    }
+    catch (UAVFleet::Error&)
+    { }
+
+    test.boolean("model names", ok);
+  }
+
+  return test.getReturnValue();
+}
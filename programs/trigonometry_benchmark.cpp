@@ -0,0 +1,140 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to benchmark the cost per call of the trigonometric      *
+// kernels of Math::Trigonometry against the standard library.              *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Print one result line.
+static void
+report(const char* name, double time, size_t calls, double sum)
+{
+  std::printf("%-28s %10.2f %16.6g\n", name, time * 1e9 / calls, sum);
+}
+
+int
+main(int argc, char** argv)
+{
+  size_t count = 4096;
+  int iterations = argc >= 2 ? std::atoi(argv[1]) : 2000;
+
+  std::vector<double> a(count), x(count), y(count), s(count), c(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    a[i] = 4.0 * std::sin(0.731 * i);
+    x[i] = std::cos(0.37 * i) * (1.0 + i % 13);
+    y[i] = std::sin(0.53 * i) * (1.0 + i % 7);
+  }
+
+  size_t calls = count * iterations;
+  std::printf("%-28s %10s %16s\n", "function", "ns/call", "checksum");
+
+  double sum = 0.0;
+  double start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+      sum += std::sin(a[i]) + std::cos(a[i]);
+  }
+  report("std::sin + std::cos", Clock::get() - start, calls, sum);
+
+  sum = 0.0;
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      double sv, cv;
+      Trigonometry::fastSinCos(a[i], sv, cv);
+      sum += sv + cv;
+    }
+  }
+  report("Trigonometry::fastSinCos", Clock::get() - start, calls, sum);
+
+  sum = 0.0;
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    Trigonometry::fastSinCos(&a[0], count, &s[0], &c[0]);
+    sum += s[k % count] + c[k % count];
+  }
+  report("fastSinCos (array)", Clock::get() - start, calls, sum);
+
+  sum = 0.0;
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+      sum += std::atan2(y[i], x[i]);
+  }
+  report("std::atan2", Clock::get() - start, calls, sum);
+
+  sum = 0.0;
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+      sum += Trigonometry::fastAtan2(y[i], x[i]);
+  }
+  report("Trigonometry::fastAtan2", Clock::get() - start, calls, sum);
+
+  // Angles drifting a few turns, as integrated headings do.
+  for (size_t i = 0; i < count; ++i)
+    a[i] *= 3.0;
+
+  sum = 0.0;
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    for (size_t i = 0; i < count; ++i)
+      s[i] = Angles::normalizeRadian(a[i]);
+    sum += s[k % count];
+  }
+  report("Angles::normalizeRadian", Clock::get() - start, calls, sum);
+
+  sum = 0.0;
+  start = Clock::get();
+  for (int k = 0; k < iterations; ++k)
+  {
+    Angles::normalizeRadian(&a[0], count, &s[0]);
+    sum += s[k % count];
+  }
+  report("normalizeRadian (array)", Clock::get() - start, calls, sum);
+
+  return 0;
+}
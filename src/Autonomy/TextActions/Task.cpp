@@ -43,6 +43,8 @@ namespace Autonomy
         DUNE::Tasks::Task(name, ctx)
       {
         bind<IMC::TextMessage>(this);
+
+        setCooperative();
       }
 
       void
@@ -120,6 +120,8 @@ namespace Control
           bind<IMC::DesiredControl>(this);
           bind<IMC::ControlLoops>(this);
           bind<IMC::ServoPosition>(this);
+
+          setCooperative();
         }
 
         void
@@ -188,6 +188,8 @@ namespace Control
           bind<IMC::DesiredSpeed>(this);
           bind<IMC::ControlLoops>(this);
           bind<IMC::EstimatedState>(this);
+
+          setCooperative();
         }
 
         void
@@ -77,6 +77,8 @@ namespace Control
         bind<IMC::EstimatedState>(this);
         bind<IMC::EulerAngles>(this);
         bind<IMC::GpsFix>(this);
+
+        setCooperative();
       }
 
       void
@@ -104,6 +104,8 @@ namespace Control
         bind<IMC::EstimatedState>(this);
         bind<IMC::EulerAngles>(this);
         bind<IMC::Target>(this);
+
+        setCooperative();
       }
 
       void
@@ -0,0 +1,252 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Jose Pinto                                                       *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Algorithms/ReedSolomon.hpp>
+
+namespace DUNE
+{
+  namespace Algorithms
+  {
+    //! Logarithm and exponential tables of GF(2^8).
+    struct GaloisTables
+    {
+      uint8_t exp[512];
+      uint8_t log[256];
+
+      GaloisTables(void)
+      {
+        unsigned x = 1;
+        for (unsigned i = 0; i < 255; ++i)
+        {
+          exp[i] = x;
+          log[x] = i;
+          x <<= 1;
+          if (x & 0x100)
+            x ^= 0x11d;
+        }
+
+        for (unsigned i = 255; i < 512; ++i)
+          exp[i] = exp[i - 255];
+
+        log[0] = 0;
+      }
+    };
+
+    static const GaloisTables s_gf;
+
+    uint8_t
+    ReedSolomon::multiply(uint8_t a, uint8_t b)
+    {
+      if (a == 0 || b == 0)
+        return 0;
+
+      return s_gf.exp[s_gf.log[a] + s_gf.log[b]];
+    }
+
+    uint8_t
+    ReedSolomon::inverse(uint8_t a)
+    {
+      return s_gf.exp[255 - s_gf.log[a]];
+    }
+
+    void
+    ReedSolomon::multiplyAdd(uint8_t* dst, const uint8_t* src, uint8_t c, unsigned size)
+    {
+      if (c == 0)
+        return;
+
+      if (c == 1)
+      {
+        for (unsigned i = 0; i < size; ++i)
+          dst[i] ^= src[i];
+        return;
+      }
+
+      unsigned lc = s_gf.log[c];
+
+      // Building a multiplication table only pays off for large blocks.
+      if (size < 256)
+      {
+        for (unsigned i = 0; i < size; ++i)
+        {
+          if (src[i] != 0)
+            dst[i] ^= s_gf.exp[s_gf.log[src[i]] + lc];
+        }
+        return;
+      }
+
+      // Multiplication table for c.
+      uint8_t row[256];
+      row[0] = 0;
+      for (unsigned i = 1; i < 256; ++i)
+        row[i] = s_gf.exp[s_gf.log[i] + lc];
+
+      for (unsigned i = 0; i < size; ++i)
+        dst[i] ^= row[src[i]];
+    }
+
+    ReedSolomon::ReedSolomon(unsigned data_blocks, unsigned parity_blocks):
+      m_k(data_blocks),
+      m_m(parity_blocks)
+    {
+      if (m_k == 0 || m_k + m_m > 256)
+        throw std::invalid_argument("invalid Reed-Solomon code parameters");
+
+      // Cauchy matrix: c(j, i) = 1 / (x_j + y_i), x_j = k + j, y_i = i.
+      m_coeffs.resize(m_k * m_m);
+      for (unsigned j = 0; j < m_m; ++j)
+      {
+        for (unsigned i = 0; i < m_k; ++i)
+          m_coeffs[j * m_k + i] = inverse((m_k + j) ^ i);
+      }
+    }
+
+    void
+    ReedSolomon::encode(const uint8_t* const* data, uint8_t* const* parity, unsigned size) const
+    {
+      for (unsigned j = 0; j < m_m; ++j)
+      {
+        std::memset(parity[j], 0, size);
+
+        for (unsigned i = 0; i < m_k; ++i)
+          multiplyAdd(parity[j], data[i], m_coeffs[j * m_k + i], size);
+      }
+    }
+
+    bool
+    ReedSolomon::decode(uint8_t* const* blocks, const bool* present, unsigned size) const
+    {
+      // Missing data blocks.
+      std::vector<unsigned> missing;
+      for (unsigned i = 0; i < m_k; ++i)
+      {
+        if (!present[i])
+          missing.push_back(i);
+      }
+
+      if (missing.empty())
+        return true;
+
+      // Pick one parity block per missing data block.
+      std::vector<unsigned> parity;
+      for (unsigned j = 0; j < m_m && parity.size() < missing.size(); ++j)
+      {
+        if (present[m_k + j])
+          parity.push_back(j);
+      }
+
+      if (parity.size() < missing.size())
+        return false;
+
+      // Remove the contribution of the known data blocks from the
+      // selected parity blocks, leaving a square system in the
+      // missing blocks: sum_e c(p, e) * d_e = s_p.
+      unsigned e = missing.size();
+      std::vector<uint8_t> syndromes(e * size);
+      std::vector<uint8_t> a(e * e);
+
+      for (unsigned r = 0; r < e; ++r)
+      {
+        const uint8_t* coeffs = &m_coeffs[parity[r] * m_k];
+        uint8_t* s = &syndromes[r * size];
+        std::memcpy(s, blocks[m_k + parity[r]], size);
+
+        for (unsigned i = 0; i < m_k; ++i)
+        {
+          if (present[i])
+            multiplyAdd(s, blocks[i], coeffs[i], size);
+        }
+
+        for (unsigned c = 0; c < e; ++c)
+          a[r * e + c] = coeffs[missing[c]];
+      }
+
+      // Invert the (Cauchy, hence non-singular) system matrix with
+      // Gauss-Jordan elimination.
+      std::vector<uint8_t> inv(e * e, 0);
+      for (unsigned i = 0; i < e; ++i)
+        inv[i * e + i] = 1;
+
+      for (unsigned c = 0; c < e; ++c)
+      {
+        unsigned pivot = c;
+        while (pivot < e && a[pivot * e + c] == 0)
+          ++pivot;
+
+        if (pivot == e)
+          return false;
+
+        if (pivot != c)
+        {
+          for (unsigned k = 0; k < e; ++k)
+          {
+            std::swap(a[pivot * e + k], a[c * e + k]);
+            std::swap(inv[pivot * e + k], inv[c * e + k]);
+          }
+        }
+
+        uint8_t f = inverse(a[c * e + c]);
+        for (unsigned k = 0; k < e; ++k)
+        {
+          a[c * e + k] = multiply(a[c * e + k], f);
+          inv[c * e + k] = multiply(inv[c * e + k], f);
+        }
+
+        for (unsigned r = 0; r < e; ++r)
+        {
+          uint8_t g = a[r * e + c];
+          if (r == c || g == 0)
+            continue;
+
+          for (unsigned k = 0; k < e; ++k)
+          {
+            a[r * e + k] ^= multiply(g, a[c * e + k]);
+            inv[r * e + k] ^= multiply(g, inv[c * e + k]);
+          }
+        }
+      }
+
+      // Recover missing blocks.
+      for (unsigned r = 0; r < e; ++r)
+      {
+        uint8_t* dst = blocks[missing[r]];
+        std::memset(dst, 0, size);
+
+        for (unsigned c = 0; c < e; ++c)
+          multiplyAdd(dst, &syndromes[c * size], inv[r * e + c], size);
+      }
+
+      return true;
+    }
+  }
+}
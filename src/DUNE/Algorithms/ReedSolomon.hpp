@@ -0,0 +1,113 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Jose Pinto                                                       *
+//***************************************************************************
+
+#ifndef DUNE_ALGORITHMS_REED_SOLOMON_HPP_INCLUDED_
+#define DUNE_ALGORITHMS_REED_SOLOMON_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Algorithms
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM ReedSolomon;
+
+    //! Systematic Reed-Solomon erasure code over GF(2^8).
+    //!
+    //! Data is split in k blocks of equal size and m parity blocks
+    //! are computed using a Cauchy matrix, so that the original data
+    //! can be recovered from any k of the k + m blocks. The field
+    //! uses the primitive polynomial x^8 + x^4 + x^3 + x^2 + 1
+    //! (0x11d) and k + m must not exceed 256.
+    class ReedSolomon
+    {
+    public:
+      //! Constructor.
+      //! @param[in] data_blocks number of data blocks (k).
+      //! @param[in] parity_blocks number of parity blocks (m).
+      ReedSolomon(unsigned data_blocks, unsigned parity_blocks);
+
+      //! Compute parity blocks.
+      //! @param[in] data k pointers to data blocks.
+      //! @param[out] parity m pointers to parity blocks.
+      //! @param[in] size size of every block in bytes.
+      void
+      encode(const uint8_t* const* data, uint8_t* const* parity, unsigned size) const;
+
+      //! Recover missing data blocks.
+      //! @param[in,out] blocks k + m pointers to blocks (data blocks
+      //! first). Missing data blocks are written in place, so their
+      //! pointers must reference writable memory.
+      //! @param[in] present k + m flags telling which blocks are valid.
+      //! @param[in] size size of every block in bytes.
+      //! @return true if the data blocks were recovered, false if
+      //! fewer than k blocks are present.
+      bool
+      decode(uint8_t* const* blocks, const bool* present, unsigned size) const;
+
+      unsigned
+      getDataBlocks(void) const
+      {
+        return m_k;
+      }
+
+      unsigned
+      getParityBlocks(void) const
+      {
+        return m_m;
+      }
+
+      //! Multiply two elements of GF(2^8).
+      static uint8_t
+      multiply(uint8_t a, uint8_t b);
+
+      //! Compute the multiplicative inverse of a non-zero element of
+      //! GF(2^8).
+      static uint8_t
+      inverse(uint8_t a);
+
+    private:
+      //! Number of data blocks.
+      unsigned m_k;
+      //! Number of parity blocks.
+      unsigned m_m;
+      //! Cauchy coefficients (m rows of k columns).
+      std::vector<uint8_t> m_coeffs;
+
+      //! Compute dst ^= c * src over a block.
+      static void
+      multiplyAdd(uint8_t* dst, const uint8_t* src, uint8_t c, unsigned size);
+    };
+  }
+}
+
+#endif
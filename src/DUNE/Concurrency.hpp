@@ -53,6 +53,8 @@ namespace DUNE
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Concurrency/Process.hpp>
 #include <DUNE/Concurrency/SharedMemory.hpp>
+#include <DUNE/Concurrency/SharedRingBuffer.hpp>
 #include <DUNE/Concurrency/Semaphore.hpp>
+#include <DUNE/Concurrency/Snapshot.hpp>
 
 #endif
@@ -94,6 +94,24 @@ namespace DUNE
 #endif
       }
 
+      //! Atomically read the current value.
+      //! @return current value.
+      inline int
+      value(void)
+      {
+        // GCC implementation.
+#if defined(__ATOMIC_ACQUIRE)
+        return __atomic_load_n(&m_value, __ATOMIC_ACQUIRE);
+#elif defined(DUNE_CONCURRENCY_ATOMIC_COUNTER_GCC)
+        return __sync_add_and_fetch(&m_value, 0);
+
+        // Generic implementation.
+#else
+        ScopedMutex lock(m_lock);
+        return m_value;
+#endif
+      }
+
     private:
       //! Internal value.
       volatile int m_value;
@@ -153,5 +153,11 @@ namespace DUNE
       (void)policy;
       (void)priority;
     }
+
+    void
+    Process::setAffinityImpl(const std::vector<unsigned>& cpus)
+    {
+      (void)cpus;
+    }
   }
 }
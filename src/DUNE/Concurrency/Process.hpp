@@ -77,6 +77,9 @@ namespace DUNE
       void
       setPriorityImpl(Scheduler::Policy policy, unsigned priority);
 
+      void
+      setAffinityImpl(const std::vector<unsigned>& cpus);
+
       Runnable::State
       getStateImpl(void);
 
@@ -28,6 +28,9 @@
 #ifndef DUNE_CONCURRENCY_RUNNABLE_HPP_INCLUDED_
 #define DUNE_CONCURRENCY_RUNNABLE_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
@@ -93,6 +96,12 @@ namespace DUNE
         setPriorityImpl(policy, priority);
       }
 
+      void
+      setAffinity(const std::vector<unsigned>& cpus)
+      {
+        setAffinityImpl(cpus);
+      }
+
       State
       getState(void)
       {
@@ -152,6 +161,9 @@ namespace DUNE
       virtual void
       setPriorityImpl(Scheduler::Policy policy, unsigned priority) = 0;
 
+      virtual void
+      setAffinityImpl(const std::vector<unsigned>& cpus) = 0;
+
     private:
       bool m_created;
       Mutex m_created_lock;
@@ -27,11 +27,18 @@
 
 // ISO C++ 98 headers.
 #include <cstring>
+#include <cstdio>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Concurrency/Scheduler.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Utils/String.hpp>
 
 // System headers.
 #if defined(DUNE_SYS_HAS_SCHED_H)
@@ -50,6 +57,8 @@ namespace DUNE
     static Scheduler::Policy g_policy = Scheduler::POLICY_OTHER;
     //! Lock for default scheduling policy.
     static Mutex g_policy_mtx;
+    //! Maximum number of processors in a processor list.
+    static const unsigned c_max_processors = 1024;
 
     void
     Scheduler::set(Scheduler::Policy policy)
@@ -117,5 +126,83 @@ namespace DUNE
       sched_yield();
 #endif
     }
+
+    std::vector<unsigned>
+    Scheduler::getIsolatedProcessors(void)
+    {
+      std::string list;
+
+#if defined(DUNE_OS_LINUX)
+      std::ifstream ifs("/sys/devices/system/cpu/isolated");
+      std::getline(ifs, list);
+#endif
+
+      try
+      {
+        return parseProcessors(list);
+      }
+      catch (std::runtime_error&)
+      {
+        return std::vector<unsigned>();
+      }
+    }
+
+    std::vector<unsigned>
+    Scheduler::parseProcessors(const std::string& list)
+    {
+      std::vector<unsigned> cpus;
+      std::vector<std::string> parts;
+      Utils::String::split(list, ",", parts);
+
+      for (size_t i = 0; i < parts.size(); ++i)
+      {
+        if (parts[i].empty())
+          continue;
+
+        unsigned first = 0;
+        unsigned last = 0;
+        char extra = 0;
+        int rv = std::sscanf(parts[i].c_str(), "%u - %u %c", &first, &last, &extra);
+        if (rv == 1)
+          last = first;
+        else if (rv != 2)
+          throw std::runtime_error("invalid processor list: " + list);
+
+        if (last < first || last >= c_max_processors || !std::isdigit(parts[i][0])
+            || parts[i].find_first_not_of("0123456789- \t") != std::string::npos)
+          throw std::runtime_error("invalid processor list: " + list);
+
+        for (unsigned cpu = first; cpu <= last; ++cpu)
+          cpus.push_back(cpu);
+      }
+
+      std::sort(cpus.begin(), cpus.end());
+      cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+      return cpus;
+    }
+
+    std::string
+    Scheduler::formatProcessors(const std::vector<unsigned>& cpus)
+    {
+      std::ostringstream os;
+
+      for (size_t i = 0; i < cpus.size(); ++i)
+      {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+          ++j;
+
+        if (i > 0)
+          os << ",";
+
+        os << cpus[i];
+        if (j > i)
+          os << "-" << cpus[j];
+
+        i = j;
+      }
+
+      return os.str();
+    }
   }
 }
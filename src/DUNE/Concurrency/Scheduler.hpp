@@ -28,6 +28,10 @@
 #ifndef DUNE_CONCURRENCY_SCHEDULER_HPP_INCLUDED_
 #define DUNE_CONCURRENCY_SCHEDULER_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -38,7 +42,8 @@ namespace DUNE
     // Export DLL Symbol.
     class DUNE_DLL_SYM Scheduler;
 
-    //! Class to manage the default scheduling policy.
+    //! Class to manage the default scheduling policy and the
+    //! processors available to threads.
     class Scheduler
     {
     public:
@@ -93,6 +98,28 @@ namespace DUNE
       //! policy.
       static unsigned
       maximumPriority(void);
+
+      //! Get the processors isolated from the kernel scheduler (e.g.,
+      //! with the 'isolcpus' boot option). Only threads explicitly
+      //! pinned to these processors run on them.
+      //! @return sorted list of processors.
+      static std::vector<unsigned>
+      getIsolatedProcessors(void);
+
+      //! Parse a list of processors in the format used by the Linux
+      //! kernel, e.g., "0-2,5".
+      //! @param[in] list list of processors.
+      //! @return sorted list of processors without duplicates.
+      //! @throw std::runtime_error if the list is invalid.
+      static std::vector<unsigned>
+      parseProcessors(const std::string& list);
+
+      //! Format a list of processors in the format used by the Linux
+      //! kernel, e.g., "0-2,5".
+      //! @param[in] cpus sorted list of processors.
+      //! @return list of processors.
+      static std::string
+      formatProcessors(const std::vector<unsigned>& cpus);
     };
   }
 }
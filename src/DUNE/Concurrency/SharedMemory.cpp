@@ -131,10 +131,18 @@ namespace DUNE
       if (fd == -1)
         throw System::Error(errno, "failed to open shared memory area");
 
-      if (ftruncate(fd, m_size) == -1)
+      // Do not resize an area that is already in use by its creator.
+      struct stat st;
+      if (fstat(fd, &st) == -1)
       {
         ::close(fd);
-        throw System::Error(errno, "failed to initialize shared memory area");
+        throw System::Error(errno, "failed to inspect shared memory area");
+      }
+
+      if (st.st_size < (off_t)m_size)
+      {
+        ::close(fd);
+        throw System::Error(EINVAL, "shared memory area is too small");
       }
 
       m_ptr = mmap(0, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
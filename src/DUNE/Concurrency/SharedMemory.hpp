@@ -69,6 +69,14 @@ namespace DUNE
         return m_name;
       }
 
+      //! Keep the memory area when this instance is destroyed, even
+      //! if it was created by it.
+      void
+      disown(void)
+      {
+        m_creator = false;
+      }
+
       //! Get pointer to shared memory area.
       //! @return pointer to shared memory area.
       void*
@@ -0,0 +1,452 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/SharedRingBuffer.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Delay.hpp>
+
+#if defined(DUNE_SYS_HAS_LINUX_FUTEX_H) && defined(DUNE_SYS_HAS_SYS_SYSCALL_H)
+#  include <unistd.h>
+#  include <ctime>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  define DUNE_SHARED_RING_BUFFER_FUTEX
+#endif
+
+#if defined(DUNE_SYS_HAS_SIGNAL_H) && defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <cerrno>
+#  include <signal.h>
+#  include <unistd.h>
+#  define DUNE_SHARED_RING_BUFFER_PID
+#endif
+
+// Full memory barrier.
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  define DUNE_SHARED_RING_BUFFER_BARRIER() __sync_synchronize()
+#else
+#  define DUNE_SHARED_RING_BUFFER_BARRIER() __asm__ __volatile__("" ::: "memory")
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Ring identification.
+    static const uint32_t c_magic = 0x474e5244;
+    //! Consumer is serving the ring.
+    static const uint32_t c_state_open = 1;
+    //! Consumer is gone.
+    static const uint32_t c_state_closed = 2;
+    //! Record length marking the end of the usable ring space.
+    static const uint32_t c_wrap_marker = 0xffffffff;
+    //! Polling interval when futexes are not available.
+    static const double c_poll_period = 0.001;
+
+    //! Shared ring header. Producer and consumer indices live on
+    //! separate cache lines to avoid false sharing.
+    struct SharedRingBuffer::Header
+    {
+      uint32_t magic;
+      uint32_t capacity;
+      volatile uint32_t state;
+      //! Futex word, incremented on every commit.
+      volatile int32_t signal;
+      //! Non-zero while the consumer is sleeping.
+      volatile int32_t waiting;
+      //! Incremented every time a consumer creates the ring.
+      volatile uint32_t generation;
+      //! Process identifier of the consumer.
+      volatile int32_t pid;
+      uint8_t pad0[64 - 7 * sizeof(uint32_t)];
+      //! Write index (free running).
+      volatile uint32_t head;
+      uint8_t pad1[64 - sizeof(uint32_t)];
+      //! Read index (free running).
+      volatile uint32_t tail;
+      uint8_t pad2[64 - sizeof(uint32_t)];
+    };
+
+    //! Round record size to a multiple of the record header size.
+    static inline unsigned
+    align(unsigned size)
+    {
+      return (size + 3) & ~3u;
+    }
+
+    //! Get the identifier of the calling process.
+    //! @return process identifier.
+    static int32_t
+    getProcessId(void)
+    {
+#if defined(DUNE_SHARED_RING_BUFFER_PID)
+      return getpid();
+#else
+      return 0;
+#endif
+    }
+
+    //! Test if a process is running.
+    //! @param[in] pid process identifier.
+    //! @return true if the process is running or if this cannot be
+    //! determined, false otherwise.
+    static bool
+    isProcessAlive(int32_t pid)
+    {
+#if defined(DUNE_SHARED_RING_BUFFER_PID)
+      if (pid <= 0)
+        return false;
+
+      return kill(pid, 0) == 0 || errno == EPERM;
+#else
+      (void)pid;
+      return true;
+#endif
+    }
+
+    SharedRingBuffer::SharedRingBuffer(const char* name, unsigned capacity):
+      m_name(name),
+      m_capacity(64),
+      m_smem(NULL),
+      m_header(NULL),
+      m_data(NULL),
+      m_consumer(false),
+      m_generation(0),
+      m_skip(0),
+      m_pending(0)
+    {
+      while (m_capacity < capacity)
+        m_capacity <<= 1;
+    }
+
+    SharedRingBuffer::~SharedRingBuffer(void)
+    {
+      unmap();
+    }
+
+    unsigned
+    SharedRingBuffer::getMemorySize(void) const
+    {
+      return sizeof(Header) + m_capacity;
+    }
+
+    void
+    SharedRingBuffer::map(bool create)
+    {
+      unmap();
+
+      m_smem = new SharedMemory(m_name.c_str(), getMemorySize());
+
+      try
+      {
+        if (create)
+          m_smem->create();
+        else
+          m_smem->open();
+      }
+      catch (...)
+      {
+        delete m_smem;
+        m_smem = NULL;
+        throw;
+      }
+
+      m_header = static_cast<Header*>(**m_smem);
+      m_data = static_cast<uint8_t*>(**m_smem) + sizeof(Header);
+      m_consumer = create;
+    }
+
+    void
+    SharedRingBuffer::unmap(void)
+    {
+      if (m_smem == NULL)
+        return;
+
+      if (m_consumer)
+      {
+        // The name now belongs to the ring of a newer consumer.
+        if (m_header->generation != m_generation)
+        {
+          m_smem->disown();
+        }
+        else
+        {
+          m_header->state = c_state_closed;
+          DUNE_SHARED_RING_BUFFER_BARRIER();
+        }
+      }
+
+      delete m_smem;
+      m_smem = NULL;
+      m_header = NULL;
+      m_data = NULL;
+    }
+
+    uint32_t
+    SharedRingBuffer::retire(void)
+    {
+      SharedMemory smem(m_name.c_str(), sizeof(Header));
+
+      try
+      {
+        smem.open();
+      }
+      catch (...)
+      {
+        return 0;
+      }
+
+      Header* header = static_cast<Header*>(*smem);
+      if (header->magic != c_magic)
+        return 0;
+
+      uint32_t generation = header->generation + 1;
+      header->generation = generation;
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      header->state = c_state_closed;
+      return generation;
+    }
+
+    void
+    SharedRingBuffer::create(void)
+    {
+      // Producers may still be attached to the ring of a previous
+      // consumer: detach them instead of touching their indices.
+      uint32_t generation = retire();
+
+      // The new area is not visible to producers until the magic
+      // number is set.
+      map(true);
+      std::memset(m_header, 0, sizeof(Header));
+      m_header->capacity = m_capacity;
+      m_header->generation = generation + 1;
+      m_header->pid = getProcessId();
+      m_generation = m_header->generation;
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      m_header->magic = c_magic;
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      m_header->state = c_state_open;
+    }
+
+    void
+    SharedRingBuffer::open(void)
+    {
+      map(false);
+
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      if (m_header->magic != c_magic || m_header->capacity != m_capacity)
+      {
+        unmap();
+        throw std::runtime_error("shared memory area is not a compatible ring");
+      }
+
+      m_generation = m_header->generation;
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      if (m_header->state != c_state_open || !isProcessAlive(m_header->pid))
+      {
+        unmap();
+        throw std::runtime_error("ring is not served by a consumer");
+      }
+
+      m_skip = 0;
+      m_pending = 0;
+    }
+
+    bool
+    SharedRingBuffer::isOpen(void) const
+    {
+      if (m_header == NULL)
+        return false;
+
+      return m_header->state == c_state_open && m_header->generation == m_generation;
+    }
+
+    bool
+    SharedRingBuffer::checkConsumer(void)
+    {
+      if (!isOpen())
+        return false;
+
+      if (m_consumer || isProcessAlive(m_header->pid))
+        return true;
+
+      unmap();
+      return false;
+    }
+
+    uint8_t*
+    SharedRingBuffer::reserve(unsigned size)
+    {
+      if (size > getMaximumRecordSize())
+        return NULL;
+
+      unsigned need = align(c_record_header + size);
+      uint32_t head = m_header->head;
+      uint32_t tail = m_header->tail;
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+
+      unsigned pos = head & (m_capacity - 1);
+      unsigned contiguous = m_capacity - pos;
+      m_skip = (need > contiguous) ? contiguous : 0;
+
+      if (m_skip + need > m_capacity - (head - tail))
+        return NULL;
+
+      m_pending = need;
+
+      if (m_skip)
+      {
+        *reinterpret_cast<uint32_t*>(m_data + pos) = c_wrap_marker;
+        pos = 0;
+      }
+
+      return m_data + pos + c_record_header;
+    }
+
+    void
+    SharedRingBuffer::commit(unsigned size)
+    {
+      uint32_t head = m_header->head;
+      unsigned pos = (head + m_skip) & (m_capacity - 1);
+      *reinterpret_cast<uint32_t*>(m_data + pos) = size;
+
+      // Record contents must be visible before the new head.
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      m_header->head = head + m_skip + align(c_record_header + size);
+      m_skip = 0;
+      m_pending = 0;
+
+      notify();
+    }
+
+    bool
+    SharedRingBuffer::write(const uint8_t* data, unsigned size)
+    {
+      uint8_t* ptr = reserve(size);
+      if (ptr == NULL)
+        return false;
+
+      std::memcpy(ptr, data, size);
+      commit(size);
+      return true;
+    }
+
+    const uint8_t*
+    SharedRingBuffer::peek(unsigned& size)
+    {
+      uint32_t tail = m_header->tail;
+      uint32_t head = m_header->head;
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+
+      if (tail == head)
+        return NULL;
+
+      unsigned pos = tail & (m_capacity - 1);
+      uint32_t length = *reinterpret_cast<uint32_t*>(m_data + pos);
+      m_skip = 0;
+
+      if (length == c_wrap_marker)
+      {
+        m_skip = m_capacity - pos;
+        pos = 0;
+        length = *reinterpret_cast<uint32_t*>(m_data);
+      }
+
+      m_pending = align(c_record_header + length);
+      size = length;
+      return m_data + pos + c_record_header;
+    }
+
+    void
+    SharedRingBuffer::release(void)
+    {
+      // Record must be fully consumed before its space is reused.
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+      m_header->tail = m_header->tail + m_skip + m_pending;
+      m_skip = 0;
+      m_pending = 0;
+    }
+
+    void
+    SharedRingBuffer::notify(void)
+    {
+#if defined(DUNE_SYS_HAS___SYNC_ADD_AND_FETCH)
+      __sync_add_and_fetch(&m_header->signal, 1);
+#else
+      m_header->signal = m_header->signal + 1;
+#endif
+      DUNE_SHARED_RING_BUFFER_BARRIER();
+
+#if defined(DUNE_SHARED_RING_BUFFER_FUTEX)
+      if (m_header->waiting)
+        syscall(SYS_futex, &m_header->signal, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+    }
+
+    bool
+    SharedRingBuffer::wait(double timeout)
+    {
+      double deadline = Time::Clock::get() + timeout;
+
+      while (true)
+      {
+        if (m_header->tail != m_header->head)
+          return true;
+
+        double remaining = deadline - Time::Clock::get();
+        if (remaining <= 0)
+          return false;
+
+#if defined(DUNE_SHARED_RING_BUFFER_FUTEX)
+        m_header->waiting = 1;
+        DUNE_SHARED_RING_BUFFER_BARRIER();
+        int32_t signal = m_header->signal;
+
+        // Producer may have committed before we announced ourselves.
+        if (m_header->tail != m_header->head)
+        {
+          m_header->waiting = 0;
+          return true;
+        }
+
+        timespec ts;
+        ts.tv_sec = (time_t)remaining;
+        ts.tv_nsec = (long)((remaining - ts.tv_sec) * 1e9);
+        syscall(SYS_futex, &m_header->signal, FUTEX_WAIT, signal, &ts, NULL, 0);
+        m_header->waiting = 0;
+#else
+        Time::Delay::wait(c_poll_period);
+#endif
+      }
+    }
+  }
+}
@@ -0,0 +1,216 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_SHARED_RING_BUFFER_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_SHARED_RING_BUFFER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/SharedMemory.hpp>
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM SharedRingBuffer;
+
+    //! Single-producer single-consumer queue of variable size
+    //! records living in a named shared memory area. It allows two
+    //! processes on the same host to exchange data without system
+    //! calls in the common case: records are written in place by the
+    //! producer (reserve/commit) and read in place by the consumer
+    //! (peek/release). A consumer with no pending records sleeps
+    //! until the producer signals new data (futex on Linux, polling
+    //! elsewhere).
+    //!
+    //! The consumer owns the memory area: it creates it and marks it
+    //! as closed upon destruction, so that producers can detect that
+    //! they must reattach. Every ring created with the same name has
+    //! a new generation, and records the process identifier of its
+    //! consumer, so that producers also detect consumers that were
+    //! restarted or that terminated without closing the ring.
+    class SharedRingBuffer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] name name of the shared memory area.
+      //! @param[in] capacity ring capacity in bytes, rounded up to
+      //! the next power of two.
+      SharedRingBuffer(const char* name, unsigned capacity);
+
+      //! Destructor. If this instance is the consumer the ring is
+      //! marked as closed.
+      ~SharedRingBuffer(void);
+
+      //! Create the memory area and initialize an empty ring (consumer
+      //! side). An existing area with the same name is marked as
+      //! closed and replaced by a new area of the next generation.
+      void
+      create(void);
+
+      //! Attach to an existing ring (producer side).
+      //! @throw System::Error if the memory area does not exist.
+      //! @throw std::runtime_error if the area is not a ring with the
+      //! expected capacity, or if its consumer is gone.
+      void
+      open(void);
+
+      //! Test if the ring is still served by its consumer. This only
+      //! reads the shared header and is cheap enough to be called
+      //! before every record.
+      //! @return true if the consumer did not close or replace the
+      //! ring, false otherwise.
+      bool
+      isOpen(void) const;
+
+      //! Check if the consumer process is still running, detaching
+      //! from the ring if it is not. This takes a system call and
+      //! should be called periodically by producers.
+      //! @return true if the ring is open and its consumer is
+      //! running, false otherwise.
+      bool
+      checkConsumer(void);
+
+      //! Get ring capacity.
+      //! @return capacity in bytes.
+      unsigned
+      getCapacity(void) const
+      {
+        return m_capacity;
+      }
+
+      //! Get the largest record that fits in an empty ring.
+      //! @return maximum record size in bytes.
+      unsigned
+      getMaximumRecordSize(void) const
+      {
+        return m_capacity / 2 - c_record_header;
+      }
+
+      //! Reserve space for a record (producer side). The record is
+      //! not visible to the consumer until commit() is called.
+      //! @param[in] size record size in bytes.
+      //! @return pointer to record storage or NULL if the ring does
+      //! not have enough free space.
+      uint8_t*
+      reserve(unsigned size);
+
+      //! Publish the record previously obtained with reserve() and
+      //! wake up the consumer if it is sleeping.
+      //! @param[in] size actual record size, must not be larger than
+      //! the reserved size.
+      void
+      commit(unsigned size);
+
+      //! Convenience function to copy a record into the ring.
+      //! @param[in] data record data.
+      //! @param[in] size record size in bytes.
+      //! @return true if the record was written, false if the ring is
+      //! full.
+      bool
+      write(const uint8_t* data, unsigned size);
+
+      //! Access the oldest record (consumer side).
+      //! @param[out] size record size in bytes.
+      //! @return pointer to record data or NULL if the ring is empty.
+      const uint8_t*
+      peek(unsigned& size);
+
+      //! Discard the record returned by the last call to peek().
+      void
+      release(void);
+
+      //! Wait for records (consumer side).
+      //! @param[in] timeout maximum amount of time to wait in seconds.
+      //! @return true if there are records available, false otherwise.
+      bool
+      wait(double timeout);
+
+    private:
+      //! Shared ring header.
+      struct Header;
+      //! Size of record length prefix.
+      static const unsigned c_record_header = 4;
+      //! Name of the memory area.
+      std::string m_name;
+      //! Ring capacity.
+      unsigned m_capacity;
+      //! Shared memory area.
+      SharedMemory* m_smem;
+      //! Pointer to ring header.
+      Header* m_header;
+      //! Pointer to ring data.
+      uint8_t* m_data;
+      //! True if this instance is the consumer.
+      bool m_consumer;
+      //! Generation of the ring this instance is attached to.
+      uint32_t m_generation;
+      //! Bytes skipped at the end of the ring by the pending record.
+      unsigned m_skip;
+      //! Size of the pending record (including length prefix and
+      //! padding).
+      unsigned m_pending;
+
+      //! Get size of the memory area.
+      //! @return size in bytes.
+      unsigned
+      getMemorySize(void) const;
+
+      //! Map memory area.
+      void
+      map(bool create);
+
+      //! Release memory area.
+      void
+      unmap(void);
+
+      //! Mark the ring of a previous consumer as closed.
+      //! @return generation of the previous ring or zero if there is
+      //! none.
+      uint32_t
+      retire(void);
+
+      //! Wake up consumer if it is sleeping.
+      void
+      notify(void);
+
+      //! Non-copyable.
+      SharedRingBuffer(const SharedRingBuffer&);
+
+      //! Non-assignable.
+      SharedRingBuffer&
+      operator=(const SharedRingBuffer&);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,187 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_SNAPSHOT_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_SNAPSHOT_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+
+// Check if we can use GCC's atomic functions.
+#if defined(DUNE_SYS_HAS___SYNC_ADD_AND_FETCH) && defined(DUNE_SYS_HAS___SYNC_SUB_AND_FETCH)
+#  ifndef DUNE_CONCURRENCY_SNAPSHOT_GCC
+#    define DUNE_CONCURRENCY_SNAPSHOT_GCC
+#  endif
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Immutable value shared by many readers and replaced as a whole
+    //! by writers. Readers take no locks: they only increment and
+    //! decrement a counter of active readers. Replaced values are
+    //! deleted when a later replacement finds no active readers, or
+    //! when the snapshot is destroyed.
+    template <typename T>
+    class Snapshot
+    {
+    public:
+      //! Read access to the current value, which remains valid while
+      //! the reader exists.
+      class Reader
+      {
+      public:
+        //! Constructor.
+        //! @param[in] snapshot snapshot to read.
+        Reader(const Snapshot& snapshot):
+          m_snapshot(snapshot),
+          m_value(snapshot.enter())
+        { }
+
+        //! Destructor.
+        ~Reader(void)
+        {
+          m_snapshot.leave();
+        }
+
+        const T&
+        operator*(void) const
+        {
+          return *m_value;
+        }
+
+        const T*
+        operator->(void) const
+        {
+          return m_value;
+        }
+
+      private:
+        //! Snapshot.
+        const Snapshot& m_snapshot;
+        //! Value being read.
+        const T* m_value;
+
+        // Non-copyable.
+        Reader(const Reader&);
+
+        // Non-assignable.
+        Reader&
+        operator=(const Reader&);
+      };
+
+      //! Constructor.
+      //! @param[in] value initial value (the snapshot takes ownership).
+      Snapshot(T* value = new T()):
+        m_value(value),
+        m_readers(0)
+      { }
+
+      //! Destructor.
+      ~Snapshot(void)
+      {
+        delete m_value;
+        for (size_t i = 0; i < m_retired.size(); ++i)
+          delete m_retired[i];
+      }
+
+      //! Replace the current value. Concurrent writers are serialized.
+      //! @param[in] value new value (the snapshot takes ownership).
+      void
+      publish(T* value)
+      {
+        ScopedMutex l(m_lock);
+
+        m_retired.push_back(const_cast<T*>(m_value));
+
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+        // Readers that enter after the replacement see the new value.
+        __sync_synchronize();
+        m_value = value;
+        __sync_synchronize();
+
+        if (__sync_add_and_fetch(&m_readers, 0) != 0)
+          return;
+#else
+        m_value = value;
+#endif
+
+        for (size_t i = 0; i < m_retired.size(); ++i)
+          delete m_retired[i];
+        m_retired.clear();
+      }
+
+    private:
+      //! Current value.
+      const T* volatile m_value;
+      //! Number of active readers.
+      mutable volatile int m_readers;
+      //! Replaced values that may still be in use.
+      std::vector<T*> m_retired;
+      //! Writers lock (also readers lock if atomic functions are not
+      //! available).
+      mutable Mutex m_lock;
+
+      const T*
+      enter(void) const
+      {
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+        __sync_add_and_fetch(&m_readers, 1);
+#else
+        m_lock.lock();
+#endif
+        return m_value;
+      }
+
+      void
+      leave(void) const
+      {
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+        __sync_sub_and_fetch(&m_readers, 1);
+#else
+        m_lock.unlock();
+#endif
+      }
+
+      // Non-copyable.
+      Snapshot(const Snapshot&);
+
+      // Non-assignable.
+      Snapshot&
+      operator=(const Snapshot&);
+    };
+  }
+}
+
+#endif
@@ -27,6 +27,9 @@
 
 // ISO C++ 98 headers.
 #include <cassert>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
 #include <iostream>
 #include <limits>
 
@@ -40,6 +43,10 @@
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 
 // System headers.
+#if defined(DUNE_SYS_HAS_SCHED_H)
+#  include <sched.h>
+#endif
+
 #if defined(DUNE_SYS_HAS_PTHREAD_H)
 #  include <pthread.h>
 #endif
@@ -193,6 +200,33 @@ namespace DUNE
 #endif
     }
 
+    void
+    Thread::setAffinityImpl(const std::vector<unsigned>& cpus)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_SETAFFINITY_NP)
+      cpu_set_t set;
+      CPU_ZERO(&set);
+
+      for (size_t i = 0; i < cpus.size(); ++i)
+      {
+        if (cpus[i] >= CPU_SETSIZE)
+          throw ThreadError("unable to set thread affinity", EINVAL);
+        CPU_SET(cpus[i], &set);
+      }
+
+      int rv = 0;
+      if (isRunning())
+        rv = pthread_setaffinity_np(m_handle, sizeof(set), &set);
+      else
+        rv = pthread_attr_setaffinity_np(&m_attr, sizeof(set), &set);
+
+      if (rv != 0)
+        throw ThreadError("unable to set thread affinity", rv);
+#else
+      (void)cpus;
+#endif
+    }
+
     Runnable::State
     Thread::getStateImpl(void)
     {
@@ -263,6 +297,67 @@ namespace DUNE
       // Not implemented.
 #else
       return -1;
+#endif
+    }
+
+    bool
+    Thread::getUsage(Usage& usage)
+    {
+      // Linux v2.6 implementation.
+#if defined(DUNE_OS_LINUX)
+      if (m_id == -1)
+        return false;
+
+      // Retrieve CPU time, skipping the command name, that may
+      // contain spaces.
+      {
+        std::ifstream ifs(m_proc_file.c_str());
+        std::string line;
+        std::getline(ifs, line);
+
+        size_t pos = line.rfind(')');
+        if (pos == std::string::npos)
+          return false;
+
+        std::istringstream is(line.substr(pos + 1));
+        std::string field;
+        for (unsigned i = 0; i < c_proc_self_stat_skips - 2; ++i)
+          is >> field;
+
+        uint64_t utime = 0;
+        uint64_t stime = 0;
+        is >> utime >> stime;
+        if (is.fail())
+          return false;
+
+        usage.cpu_time = (utime + stime) / (double)sysconf(_SC_CLK_TCK);
+      }
+
+      // Retrieve context switches.
+      {
+        std::string file = m_proc_file.substr(0, m_proc_file.size() - 4) + "status";
+        std::ifstream ifs(file.c_str());
+        std::string key;
+
+        usage.voluntary_switches = 0;
+        usage.involuntary_switches = 0;
+        while (ifs >> key)
+        {
+          if (key == "voluntary_ctxt_switches:")
+            ifs >> usage.voluntary_switches;
+          else if (key == "nonvoluntary_ctxt_switches:")
+            ifs >> usage.involuntary_switches;
+          else
+            ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+      }
+
+      return true;
+
+      // Not implemented.
+#else
+      (void)usage;
+      return false;
 #endif
     }
   }
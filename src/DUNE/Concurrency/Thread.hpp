@@ -57,6 +57,17 @@ namespace DUNE
       ::dune_concurrency_thread_entry_point(void*);
 
     public:
+      //! Processor usage counters of a thread.
+      struct Usage
+      {
+        //! Processor time in user and kernel mode (s).
+        double cpu_time;
+        //! Number of times the thread gave up the processor.
+        uint64_t voluntary_switches;
+        //! Number of times the thread was preempted.
+        uint64_t involuntary_switches;
+      };
+
       // Constructor.
       Thread(void);
 
@@ -72,6 +83,13 @@ namespace DUNE
       int
       getProcessorUsage(void);
 
+      //! Retrieve the processor usage counters of this thread since
+      //! it started.
+      //! @param[out] usage usage counters.
+      //! @return true if the counters are available, false otherwise.
+      bool
+      getUsage(Usage& usage);
+
     protected:
       void
       startImpl(void);
@@ -85,6 +103,9 @@ namespace DUNE
       void
       setPriorityImpl(Scheduler::Policy policy, unsigned priority);
 
+      void
+      setAffinityImpl(const std::vector<unsigned>& cpus);
+
     private:
       //! Thread state.
       Runnable::State m_state;
@@ -74,6 +74,8 @@ namespace DUNE
       bind<IMC::DesiredPitch>(this);
       bind<IMC::DesiredVelocity>(this);
       bind<IMC::ControlLoops>(this);
+
+      setCooperative();
     }
 
     BasicAutopilot::~BasicAutopilot(void)
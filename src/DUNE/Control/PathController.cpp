@@ -32,6 +32,7 @@
 #include <DUNE/Control/PathController.hpp>
 #include <DUNE/Math/General.hpp>
 #include <DUNE/Math/Angles.hpp>
+#include <DUNE/Math/Trigonometry.hpp>
 #include <DUNE/Time.hpp>
 #include <DUNE/Utils/String.hpp>
 
@@ -81,6 +82,11 @@ namespace DUNE
       .defaultValue("true")
       .description("Enable course control");
 
+      param("Fast Trigonometry", m_fast_trig)
+      .defaultValue("false")
+      .description("Use polynomial approximations to compute the course"
+                   " and the along/cross-track velocities");
+
       param("Along-track -- Monitor", m_atm.enabled)
       .defaultValue("true")
       .description("Enable along-track error monitoring");
@@ -210,6 +216,8 @@ namespace DUNE
       bind<IMC::Distance>(this);
       bind<IMC::DesiredZ>(this);
       bind<IMC::DesiredSpeed>(this);
+
+      setCooperative();
     }
 
     PathController::~PathController(void)
@@ -730,7 +738,12 @@ namespace DUNE
       getBearingAndRange(m_estate, m_ts.end, &m_ts.los_angle, &m_ts.range);
 
       // Ground course and speed
-      m_ts.course = m_ts.cc ? std::atan2(m_estate.vy, m_estate.vx) : m_estate.psi;
+      if (m_ts.cc)
+        m_ts.course = m_fast_trig ? Math::Trigonometry::fastAtan2(m_estate.vy, m_estate.vx)
+        : std::atan2(m_estate.vy, m_estate.vx);
+      else
+        m_ts.course = m_estate.psi;
+
       m_ts.speed = m_ts.cc ? Math::norm(m_estate.vx, m_estate.vy) : m_estate.u;
 
       if (!m_ts.loitering)
@@ -778,8 +791,14 @@ namespace DUNE
       }
 
       m_ts.track_pos.z = m_estate.z - m_ts.end.z; // vertical-track
-      m_ts.track_vel.x = m_ts.speed * std::cos(m_ts.course_error); // along-track
-      m_ts.track_vel.y = m_ts.speed * std::sin(m_ts.course_error); // cross-track
+      double sin_err, cos_err;
+      if (m_fast_trig)
+        Math::Trigonometry::fastSinCos(m_ts.course_error, sin_err, cos_err);
+      else
+        Math::Trigonometry::sincos(m_ts.course_error, sin_err, cos_err);
+
+      m_ts.track_vel.x = m_ts.speed * cos_err; // along-track
+      m_ts.track_vel.y = m_ts.speed * sin_err; // cross-track
       m_ts.track_vel.z = std::sin(m_estate.theta) * m_estate.vz; // vertical-track
     }
 
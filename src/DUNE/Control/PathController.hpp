@@ -396,6 +396,8 @@ namespace DUNE
       bool m_running_monitors;
       //! Enable or disable course control
       bool m_course_ctl;
+      //! Use polynomial approximations in the tracking state.
+      bool m_fast_trig;
       //! True when already tracking path
       bool m_tracking;
       //! True if there is some error
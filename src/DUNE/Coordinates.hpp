@@ -38,6 +38,7 @@ namespace DUNE
 #include <DUNE/Coordinates/General.hpp>
 #include <DUNE/Coordinates/BodyFixedFrame.hpp>
 #include <DUNE/Coordinates/WGS84.hpp>
+#include <DUNE/Coordinates/LocalFrame.hpp>
 #include <DUNE/Coordinates/WMM.hpp>
 #include <DUNE/Coordinates/UTM.hpp>
 
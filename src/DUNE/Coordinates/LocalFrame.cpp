@@ -0,0 +1,139 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Coordinates/LocalFrame.hpp>
+#include <DUNE/Coordinates/WGS84.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    LocalFrame::LocalFrame(double lat, double lon, double hae)
+    {
+      setReference(lat, lon, hae);
+    }
+
+    void
+    LocalFrame::setReference(double lat, double lon, double hae)
+    {
+      WGS84::toECEF(&lat, &lon, &hae, 1, &m_x, &m_y, &m_z);
+
+      double slat = std::sin(lat);
+      double clat = std::cos(lat);
+      double slon = std::sin(lon);
+      double clon = std::cos(lon);
+
+      m_nx = -slat * clon;
+      m_ny = slat * slon;
+      m_nz = clat;
+      m_ex = -slon;
+      m_ey = clon;
+      m_dx = -clat * clon;
+      m_dy = clat * slon;
+      m_dz = slat;
+
+      // Displacements use the geocentric latitude.
+      double phi = std::atan2(m_z, std::sqrt(m_x * m_x + m_y * m_y));
+      double sphi = std::sin(phi);
+      double cphi = std::cos(phi);
+
+      m_xe = -slon;
+      m_xn = clon * sphi;
+      m_xd = clon * cphi;
+      m_ye = clon;
+      m_yn = slon * sphi;
+      m_yd = slon * cphi;
+      m_zn = cphi;
+      m_zd = sphi;
+    }
+
+    void
+    LocalFrame::toNED(const double* lat, const double* lon, const double* hae, size_t count,
+                      double* n, double* e, double* d) const
+    {
+      double x[c_block];
+      double y[c_block];
+      double z[c_block];
+
+      for (size_t i = 0; i < count; i += c_block)
+      {
+        size_t size = count - i;
+        if (size > c_block)
+          size = c_block;
+
+        WGS84::toECEF(lat + i, lon + i, (hae == NULL) ? NULL : hae + i, size, x, y, z);
+
+        for (size_t j = 0; j < size; ++j)
+        {
+          double ox = x[j] - m_x;
+          double oy = y[j] - m_y;
+          double oz = z[j] - m_z;
+
+          n[i + j] = m_nx * ox - m_ny * oy + m_nz * oz;
+          e[i + j] = m_ex * ox + m_ey * oy;
+
+          if (d != NULL)
+            d[i + j] = m_dx * ox - m_dy * oy - m_dz * oz;
+        }
+      }
+    }
+
+    void
+    LocalFrame::fromNED(const double* n, const double* e, const double* d, size_t count,
+                        double* lat, double* lon, double* hae) const
+    {
+      double x[c_block];
+      double y[c_block];
+      double z[c_block];
+
+      for (size_t i = 0; i < count; i += c_block)
+      {
+        size_t size = count - i;
+        if (size > c_block)
+          size = c_block;
+
+        for (size_t j = 0; j < size; ++j)
+        {
+          double dn = n[i + j];
+          double de = e[i + j];
+          double dd = (d == NULL) ? 0.0 : d[i + j];
+
+          x[j] = m_x + (m_xe * de - m_xn * dn - m_xd * dd);
+          y[j] = m_y + (m_ye * de - m_yn * dn - m_yd * dd);
+          z[j] = m_z + (m_zn * dn - m_zd * dd);
+        }
+
+        WGS84::fromECEF(x, y, z, size, lat + i, lon + i, (hae == NULL) ? NULL : hae + i);
+      }
+    }
+  }
+}
@@ -0,0 +1,104 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_COORDINATES_LOCAL_FRAME_HPP_INCLUDED_
+#define DUNE_COORDINATES_LOCAL_FRAME_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LocalFrame;
+
+    //! North-East-Down frame with origin at a WGS-84 reference
+    //! coordinate. The constants of the reference are computed once,
+    //! so that many coordinates, given as separate arrays of each
+    //! component, can be converted with the same results as
+    //! WGS84::displacement() and WGS84::displace().
+    class LocalFrame
+    {
+    public:
+      //! Constructor.
+      //! @param[in] lat reference WGS-84 latitude (rad).
+      //! @param[in] lon reference WGS-84 longitude (rad).
+      //! @param[in] hae reference WGS-84 height (m).
+      LocalFrame(double lat, double lon, double hae = 0.0);
+
+      //! Change the reference coordinate.
+      //! @param[in] lat reference WGS-84 latitude (rad).
+      //! @param[in] lon reference WGS-84 longitude (rad).
+      //! @param[in] hae reference WGS-84 height (m).
+      void
+      setReference(double lat, double lon, double hae = 0.0);
+
+      //! Compute the North-East-Down displacement of WGS-84
+      //! coordinates relative to the reference.
+      //! @param[in] lat WGS-84 latitudes (rad).
+      //! @param[in] lon WGS-84 longitudes (rad).
+      //! @param[in] hae WGS-84 heights (m), NULL for zero height.
+      //! @param[in] count number of coordinates.
+      //! @param[out] n storage for North offsets (m).
+      //! @param[out] e storage for East offsets (m).
+      //! @param[out] d storage for Down offsets (m), may be NULL.
+      void
+      toNED(const double* lat, const double* lon, const double* hae, size_t count,
+            double* n, double* e, double* d = NULL) const;
+
+      //! Compute the WGS-84 coordinates of North-East-Down
+      //! displacements relative to the reference.
+      //! @param[in] n North offsets (m).
+      //! @param[in] e East offsets (m).
+      //! @param[in] d Down offsets (m), NULL for zero offset.
+      //! @param[in] count number of coordinates.
+      //! @param[out] lat storage for WGS-84 latitudes (rad).
+      //! @param[out] lon storage for WGS-84 longitudes (rad).
+      //! @param[out] hae storage for WGS-84 heights (m), may be NULL.
+      void
+      fromNED(const double* n, const double* e, const double* d, size_t count,
+              double* lat, double* lon, double* hae = NULL) const;
+
+    private:
+      //! Number of coordinates converted at a time.
+      static const size_t c_block = 64;
+      //! Reference in ECEF coordinates.
+      double m_x, m_y, m_z;
+      //! Rotation from ECEF to NED (geodetic latitude).
+      double m_nx, m_ny, m_nz, m_ex, m_ey, m_dx, m_dy, m_dz;
+      //! Rotation from NED to ECEF (geocentric latitude).
+      double m_xe, m_xn, m_xd, m_ye, m_yn, m_yd, m_zn, m_zd;
+    };
+  }
+}
+
+#endif
@@ -25,7 +25,11 @@
 // Author: Joao Fortuna                                                     *
 //***************************************************************************
 
-// Local headers.
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+
+// DUNE headers.
 #include <DUNE/Math/Constants.hpp>
 #include <DUNE/Coordinates/WGS84.hpp>
 #include <DUNE/Coordinates/UTM.hpp>
@@ -45,127 +49,147 @@ namespace DUNE
         return -1;
     }
 
+    //! Scale factor on the central meridian.
+    static const double c_k0 = 0.9996;
+    //! False easting.
+    static const double c_ref_easting = 500000.0;
+    //! False northing of the southern hemisphere.
+    static const double c_south_northing = 10000000.0;
+    //! Third flattening.
+    static const double c_tn = (c_wgs84_a - c_wgs84_b) / (c_wgs84_a + c_wgs84_b);
+    //! Meridian arc coefficients (inverse projection).
+    static const double c_ap = c_wgs84_a * (1.0 - c_tn + 5.0 * ((c_tn * c_tn) - (c_tn * c_tn * c_tn)) / 4.0 + 81.0 *
+                                            ((c_tn * c_tn * c_tn * c_tn) - (c_tn * c_tn * c_tn * c_tn * c_tn)) / 64.0);
+    static const double c_bp = 3.0 * c_wgs84_a * (c_tn - (c_tn * c_tn) + 7.0 * ((c_tn * c_tn * c_tn)
+                                                  - (c_tn * c_tn * c_tn * c_tn)) / 8.0 + 55.0 * (c_tn * c_tn * c_tn * c_tn * c_tn) / 64.0) / 2.0;
+    static const double c_cp = 15.0 * c_wgs84_a * ((c_tn * c_tn) - (c_tn * c_tn * c_tn) + 3.0 * ((c_tn * c_tn * c_tn * c_tn)
+                                                   - (c_tn * c_tn * c_tn * c_tn * c_tn)) / 4.0) / 16.0;
+    static const double c_dp = 35.0 * c_wgs84_a * ((c_tn * c_tn * c_tn) - (c_tn * c_tn * c_tn * c_tn) + 11.0
+                                                   * (c_tn * c_tn * c_tn * c_tn * c_tn) / 16.0) / 48.0;
+    static const double c_ep = 315.0 * c_wgs84_a * ((c_tn * c_tn * c_tn * c_tn) - (c_tn * c_tn * c_tn * c_tn * c_tn)) / 512.0;
+    //! Meridian arc coefficients (forward projection).
+    static const double c_m0 = 1 - c_wgs84_e2 / 4 - 3 * (c_wgs84_e2 * c_wgs84_e2) / 64
+    - 5 * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 256;
+    static const double c_m2 = 3 * c_wgs84_e2 / 8 + 3 * (c_wgs84_e2 * c_wgs84_e2) / 32 + 45
+    * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 1024;
+    static const double c_m4 = 15 * (c_wgs84_e2 * c_wgs84_e2) / 256 + 45 * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 1024;
+    static const double c_m6 = 35 * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 3072;
+
     void
     UTM::toWGS84(double north, double east, int zone, bool in_north_hem, double* lat, double* lon)
     {
-        double c_k0 = 0.9996;
-        double c_ref_easting = 500000;
-
-        double b = c_wgs84_b;
-        double eSquared = c_wgs84_e2;
-        double e2Squared = c_wgs84_ep2;
-        double tn;
-        double ap;
-        double bp;
-        double cp;
-        double dp;
-        double ep;
-        double tmd;
-        double sr;
-        double sn;
-        double ftphi;
-        double s;
-        double c;
-        double t;
-        double eta;
-        double de;
-        double dlam;
-        double olam;
-        double dn;
-
-        tn = (c_wgs84_a - b) / (c_wgs84_a + b);
-        ap = c_wgs84_a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 *
-                        ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
-        bp = 3.0 * c_wgs84_a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn)
-                        - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
-        cp = 15.0 * c_wgs84_a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn)
-                        - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
-        dp = 35.0 * c_wgs84_a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0
-                        * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
-        ep = 315.0 * c_wgs84_a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
-
-        if(!in_north_hem)
-                north -= 10000000.0;
-
-        tmd = north / c_k0;
-
-        sr = c_wgs84_a * (1.0 - eSquared);
-
-        ftphi = tmd / sr;
-
-        double t10, t11, t14, t15;
-        for (int i = 0; i < 5; i++) {
-                t10 = (ap * ftphi) - (bp * std::sin(2.0 * ftphi)) + (cp * std::sin(4.0 * ftphi)) - (dp * std::sin(6.0 * ftphi)) + (ep * std::sin(8.0 * ftphi));
-                dn = std::sqrt(1.0 - eSquared * (std::sin(ftphi) * std::sin(ftphi)));
-                sr = c_wgs84_a * (1.0 - eSquared) / (dn * dn * dn);
-                ftphi = ftphi + (tmd - t10) / sr;
+      toWGS84(&north, &east, 1, zone, in_north_hem, lat, lon);
+    }
+
+    void
+    UTM::toWGS84(const double* north, const double* east, size_t count, int zone, bool in_north_hem,
+                 double* lat, double* lon)
+    {
+      const double olam = (zone * 6 - 183.0) * DUNE::Math::c_pi / 180;
+      const double offset = in_north_hem ? 0.0 : c_south_northing;
+      const double sr0 = c_wgs84_a * (1.0 - c_wgs84_e2);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        double tmd = (north[i] - offset) / c_k0;
+        double ftphi = tmd / sr0;
+        double s = 0;
+        double c = 0;
+        double dn = 0;
+        double sr = 0;
+
+        // Multiple angles are obtained by recurrence from the sine and
+        // cosine of the footprint latitude.
+        for (int j = 0; j < 5; j++)
+        {
+          s = std::sin(ftphi);
+          c = std::cos(ftphi);
+
+          double s2 = 2.0 * s * c;
+          double c2 = c * c - s * s;
+          double s4 = 2.0 * s2 * c2;
+          double c4 = c2 * c2 - s2 * s2;
+          double s6 = s4 * c2 + c4 * s2;
+          double s8 = 2.0 * s4 * c4;
+
+          double t10 = (c_ap * ftphi) - (c_bp * s2) + (c_cp * s4) - (c_dp * s6) + (c_ep * s8);
+          dn = std::sqrt(1.0 - c_wgs84_e2 * (s * s));
+          sr = sr0 / (dn * dn * dn);
+          ftphi = ftphi + (tmd - t10) / sr;
         }
-        dn = std::sqrt(1.0 - eSquared * (std::sin(ftphi) * std::sin(ftphi)));
-        sr = c_wgs84_a * (1.0 - eSquared) / (dn * dn * dn);
-        sn = c_wgs84_a / std::sqrt(1.0 - eSquared * (std::sin(ftphi) * std::sin(ftphi)));
 
         s = std::sin(ftphi);
         c = std::cos(ftphi);
-        t = s / c;
-        eta = e2Squared * (c * c);
-        de = east - c_ref_easting;
-        t10 = t / (2.0 * sr * sn * (c_k0 * c_k0));
-        t11 = t * (5.0 + 3.0 * (t * t) + eta - 4.0 * (eta * eta) - 9.0 * (t * t)
-                        * eta) / (24.0 * sr * (sn * sn * sn) * (c_k0 * c_k0 * c_k0 * c_k0));
-        *lat = ftphi - (de * de) * t10 + (de * de * de * de) * t11;
-        t14 = 1.0 / (sn * c * c_k0);
-        t15 = (1.0 + 2.0 * (t * t) + eta) / (6 * (sn * sn * sn) * c
-                        * (c_k0 * c_k0 * c_k0));
-        dlam = de * t14 - (de * de * de) * t15;
-        olam = (zone * 6 - 183.0) * DUNE::Math::c_pi/180;
-        *lon = olam + dlam;
+        dn = std::sqrt(1.0 - c_wgs84_e2 * (s * s));
+        sr = sr0 / (dn * dn * dn);
+        double sn = c_wgs84_a / dn;
+
+        double t = s / c;
+        double eta = c_wgs84_ep2 * (c * c);
+        double de = east[i] - c_ref_easting;
+        double t10 = t / (2.0 * sr * sn * (c_k0 * c_k0));
+        double t11 = t * (5.0 + 3.0 * (t * t) + eta - 4.0 * (eta * eta) - 9.0 * (t * t)
+                          * eta) / (24.0 * sr * (sn * sn * sn) * (c_k0 * c_k0 * c_k0 * c_k0));
+        lat[i] = ftphi - (de * de) * t10 + (de * de * de * de) * t11;
+        double t14 = 1.0 / (sn * c * c_k0);
+        double t15 = (1.0 + 2.0 * (t * t) + eta) / (6 * (sn * sn * sn) * c
+                                                     * (c_k0 * c_k0 * c_k0));
+        double dlam = de * t14 - (de * de * de) * t15;
+        lon[i] = olam + dlam;
+      }
     }
 
     void
     UTM::fromWGS84(double lat, double lon, double* north, double* east, int* zone, bool* in_north_hem)
     {
-      double c_k0 = 0.9996; // scale on central meridian
-      double c_ref_easting = 500000; // false easting
-
-      double ref_lon;
-      double hemi_northing;
-
-      ref_lon = std::floor((lon * 180 / DUNE::Math::c_pi) / 6) * 6 + 3;
-      // UTM zone
-      *zone = (int)std::floor(ref_lon / 6) + 31;
-
-      ref_lon *= DUNE::Math::c_pi / 180;
-
-      *in_north_hem = (lat > 0);
+      fromWGS84(&lat, &lon, 1, north, east, zone, in_north_hem);
+    }
 
-      if(lat < 0)
-        hemi_northing = 10000000.0;
-      else
-        hemi_northing = 0.0;
-
-      // Equations parameters
-      double eqn_n = c_wgs84_a / std::sqrt(1 - c_wgs84_e2 * (std::sin(lat) * std::sin(lat)));
-      // eqn_n: radius of curvature of the earth perpendicular to meridian plane
-      double eqn_t = std::tan(lat) * std::tan(lat);
-      double eqn_c = ((c_wgs84_e2) / (1 - c_wgs84_e2)) * std::cos(lat) * std::cos(lat);
-      double eqn_a = (lon - ref_lon) * std::cos(lat);
-
-      // M: true distance along the central meridian from the equator to lat
-      double eqn_m = c_wgs84_a * ((1 - c_wgs84_e2 / 4 - 3 * (c_wgs84_e2 * c_wgs84_e2) / 64
-          - 5 * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 256) * lat
-          - (3 * c_wgs84_e2 / 8 + 3 * (c_wgs84_e2 * c_wgs84_e2) / 32 + 45
-          * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 1024) * std::sin(2 * lat)
-          + (15 * (c_wgs84_e2 * c_wgs84_e2) / 256 + 45 * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 1024)
-          * std::sin(4 * lat) - (35 * (c_wgs84_e2 * c_wgs84_e2 * c_wgs84_e2) / 3072) * std::sin(6 * lat));
-
-      // easting
-      *east = c_ref_easting + c_k0 * eqn_n * (eqn_a + (1 - eqn_t + eqn_c) * (eqn_a * eqn_a * eqn_a) / 6
-          + (5 - 18 * eqn_t + (eqn_t * eqn_t) + 72 * eqn_c - 58 * c_wgs84_ep2) * (eqn_a * eqn_a * eqn_a * eqn_a * eqn_a) / 120);
-
-      // northing
-      *north = hemi_northing + c_k0 * eqn_m + c_k0 * eqn_n * std::tan(lat) * ((eqn_a * eqn_a) / 2 + (5 - eqn_t + 9 * eqn_c + 4 * (eqn_c * eqn_c))
-          * (eqn_a * eqn_a * eqn_a * eqn_a) / 24 + (61 - 58 * eqn_t + (eqn_t * eqn_t) + 600 * eqn_c - 330 * c_wgs84_ep2)
-          * (eqn_a * eqn_a * eqn_a * eqn_a * eqn_a * eqn_a) / 720);
+    void
+    UTM::fromWGS84(const double* lat, const double* lon, size_t count,
+                   double* north, double* east, int* zone, bool* in_north_hem)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        double ref_lon = std::floor((lon[i] * 180 / DUNE::Math::c_pi) / 6) * 6 + 3;
+        // UTM zone
+        zone[i] = (int)std::floor(ref_lon / 6) + 31;
+
+        ref_lon *= DUNE::Math::c_pi / 180;
+
+        in_north_hem[i] = (lat[i] > 0);
+        double hemi_northing = (lat[i] < 0) ? c_south_northing : 0.0;
+
+        double s = std::sin(lat[i]);
+        double c = std::cos(lat[i]);
+        double tn = s / c;
+
+        // Multiple angles for the meridian arc.
+        double s2 = 2.0 * s * c;
+        double c2 = c * c - s * s;
+        double s4 = 2.0 * s2 * c2;
+        double c4 = c2 * c2 - s2 * s2;
+        double s6 = s4 * c2 + c4 * s2;
+
+        // Equations parameters
+        double eqn_n = c_wgs84_a / std::sqrt(1 - c_wgs84_e2 * (s * s));
+        // eqn_n: radius of curvature of the earth perpendicular to meridian plane
+        double eqn_t = tn * tn;
+        double eqn_c = ((c_wgs84_e2) / (1 - c_wgs84_e2)) * c * c;
+        double eqn_a = (lon[i] - ref_lon) * c;
+
+        // M: true distance along the central meridian from the equator to lat
+        double eqn_m = c_wgs84_a * (c_m0 * lat[i] - c_m2 * s2 + c_m4 * s4 - c_m6 * s6);
+
+        // easting
+        east[i] = c_ref_easting + c_k0 * eqn_n * (eqn_a + (1 - eqn_t + eqn_c) * (eqn_a * eqn_a * eqn_a) / 6
+            + (5 - 18 * eqn_t + (eqn_t * eqn_t) + 72 * eqn_c - 58 * c_wgs84_ep2) * (eqn_a * eqn_a * eqn_a * eqn_a * eqn_a) / 120);
+
+        // northing
+        north[i] = hemi_northing + c_k0 * eqn_m + c_k0 * eqn_n * tn * ((eqn_a * eqn_a) / 2 + (5 - eqn_t + 9 * eqn_c + 4 * (eqn_c * eqn_c))
+            * (eqn_a * eqn_a * eqn_a * eqn_a) / 24 + (61 - 58 * eqn_t + (eqn_t * eqn_t) + 600 * eqn_c - 330 * c_wgs84_ep2)
+            * (eqn_a * eqn_a * eqn_a * eqn_a * eqn_a * eqn_a) / 720);
+      }
     }
 
     double
@@ -30,6 +30,7 @@
 
 // ISO C++ 98 headers.
 #include <cmath>
+#include <cstddef>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -69,6 +70,32 @@ namespace DUNE
       //! true if UTM coordinate is in the north hemisphere, false otherwise
       static void
       fromWGS84(double lat, double lon, double* north, double* east, int* zone, bool* in_north_hem);
+
+      //! Converts a batch of UTM coordinates of the same zone and
+      //! hemisphere to WGS84.
+      //! @param[in] north northings of the UTM coordinates.
+      //! @param[in] east eastings of the UTM coordinates.
+      //! @param[in] count number of coordinates.
+      //! @param[in] zone zone of the UTM coordinates.
+      //! @param[in] in_north_hem true if the UTM coordinates are in the
+      //! north hemisphere, false otherwise.
+      //! @param[out] lat array to store the latitudes.
+      //! @param[out] lon array to store the longitudes.
+      static void
+      toWGS84(const double* north, const double* east, size_t count, int zone, bool in_north_hem,
+              double* lat, double* lon);
+
+      //! Converts a batch of WGS84 coordinates to UTM.
+      //! @param[in] lat latitudes.
+      //! @param[in] lon longitudes.
+      //! @param[in] count number of coordinates.
+      //! @param[out] north array to store the northings.
+      //! @param[out] east array to store the eastings.
+      //! @param[out] zone array to store the zones.
+      //! @param[out] in_north_hem array to store the hemispheres.
+      static void
+      fromWGS84(const double* lat, const double* lon, size_t count,
+                double* north, double* east, int* zone, bool* in_north_hem);
     };
 
     // Export DLL Symbol.
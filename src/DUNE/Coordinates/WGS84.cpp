@@ -0,0 +1,71 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Coordinates/WGS84.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    void
+    WGS84::toECEF(const double* lat, const double* lon, const double* hae, size_t count,
+                  double* x, double* y, double* z)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        double h = (hae == NULL) ? 0.0 : hae[i];
+        double cos_lat = std::cos(lat[i]);
+        double sin_lat = std::sin(lat[i]);
+        double rn = c_wgs84_a / std::sqrt(1 - c_wgs84_e2 * (sin_lat * sin_lat));
+        double r = (rn + h) * cos_lat;
+
+        x[i] = r * std::cos(lon[i]);
+        y[i] = r * std::sin(lon[i]);
+        z[i] = (((1.0 - c_wgs84_e2) * rn) + h) * sin_lat;
+      }
+    }
+
+    void
+    WGS84::fromECEF(const double* x, const double* y, const double* z, size_t count,
+                    double* lat, double* lon, double* hae)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        double h = 0.0;
+        fromECEF(x[i], y[i], z[i], &lat[i], &lon[i], &h);
+
+        if (hae != NULL)
+          hae[i] = h;
+      }
+    }
+  }
+}
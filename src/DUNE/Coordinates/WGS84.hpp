@@ -283,6 +283,37 @@ namespace DUNE
         getNEBearingAndRange(lat1, lon1, lat2, lon2, azimuth, &tmp);
       }
 
+      //! Convert arrays of WGS-84 coordinates to ECEF (Earth Center
+      //! Earth Fixed) coordinates. Results are the same as converting
+      //! one coordinate at a time.
+      //!
+      //! @param[in] lat WGS-84 latitudes (rad).
+      //! @param[in] lon WGS-84 longitudes (rad).
+      //! @param[in] hae WGS-84 heights (m), NULL for zero height.
+      //! @param[in] count number of coordinates.
+      //! @param[out] x storage for ECEF x coordinates (m).
+      //! @param[out] y storage for ECEF y coordinates (m).
+      //! @param[out] z storage for ECEF z coordinates (m).
+      static void
+      toECEF(const double* lat, const double* lon, const double* hae, size_t count,
+             double* x, double* y, double* z);
+
+      //! Convert arrays of ECEF (Earth Center Earth Fixed) coordinates
+      //! to WGS-84 coordinates. Results are the same as converting one
+      //! coordinate at a time.
+      //!
+      //! @param[in] x ECEF x coordinates (m).
+      //! @param[in] y ECEF y coordinates (m).
+      //! @param[in] z ECEF z coordinates (m).
+      //! @param[in] count number of coordinates.
+      //! @param[out] lat storage for WGS-84 latitudes (rad).
+      //! @param[out] lon storage for WGS-84 longitudes (rad).
+      //! @param[out] hae storage for heights above WGS-84 ellipsoid
+      //!             (m), may be NULL.
+      static void
+      fromECEF(const double* x, const double* y, const double* z, size_t count,
+               double* lat, double* lon, double* hae);
+
     private:
       //! Convert WGS-84 coordinates to ECEF (Earch Center Earth Fixed) coordinates.
       //!
@@ -26,9 +26,11 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <cstddef>
+#include <ctime>
 
 // DUNE headers.
 #include <DUNE/Daemon.hpp>
@@ -43,7 +45,10 @@ namespace DUNE
   Daemon::Daemon(DUNE::Tasks::Context& ctx, const std::string& profiles):
     DUNE::Tasks::Task("Daemon", ctx),
     m_tman(NULL),
-    m_fs_capacity(0)
+    m_fs_capacity(0),
+    m_startup_reported(false),
+    m_duration(0),
+    m_finished(false)
   {
     // Retrieve known IMC addresses.
     std::vector<std::string> addrs = m_ctx.config.options("IMC Addresses");
@@ -127,10 +132,17 @@ namespace DUNE
 
     m_tman = new DUNE::Tasks::Manager(m_ctx);
 
+    if (m_tman->isDeterministic())
+    {
+      m_ctx.config.get("General", "Deterministic Duration", "0", m_duration);
+      inf(DTR("deterministic run: %0.1f s"), m_duration);
+    }
+
     bind<IMC::RestartSystem>(this);
     bind<IMC::EntityList>(this);
     bind<IMC::SaveEntityParameters>(this);
     bind<IMC::EntityParameters>(this);
+    bind<IMC::Event>(this);
   }
 
   Daemon::~Daemon(void)
@@ -144,8 +156,10 @@ namespace DUNE
   Daemon::onResourceInitialization(void)
   {
     m_ctx.mbus.resume();
+
     m_tman->start();
     m_periodic_counter.setTop(1.0);
+    m_startup_counter.setTop(60.0);
     setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
   }
 
@@ -186,6 +200,91 @@ namespace DUNE
     dispatch(query);
   }
 
+  void
+  Daemon::consume(const IMC::Event* msg)
+  {
+    if (msg->topic == "Reload Configuration")
+      reloadConfig();
+  }
+
+  void
+  Daemon::reloadConfig(void)
+  {
+    Parsers::Config::Changes changes;
+    try
+    {
+      changes = m_ctx.config.reload();
+    }
+    catch (std::exception& e)
+    {
+      err(DTR("failed to reload configuration: %s"), e.what());
+      return;
+    }
+
+    if (changes.empty())
+    {
+      inf(DTR("configuration unchanged"));
+      return;
+    }
+
+    std::map<std::string, Task*>::iterator itr = m_tman->begin();
+    for ( ; itr != m_tman->end(); ++itr)
+    {
+      Parsers::Config::Changes::iterator citr = changes.find(itr->first);
+      if (citr == changes.end())
+        continue;
+
+      std::vector<std::string> keys;
+      keys.swap(citr->second);
+      changes.erase(citr);
+
+      IMC::SetEntityParameters params;
+      try
+      {
+        params.name = m_ctx.entities.resolve(itr->second->getEntityId());
+      }
+      catch (std::exception& e)
+      {
+        err("%s", e.what());
+        continue;
+      }
+
+      std::map<std::string, std::string> options = m_ctx.config.getSection(itr->first);
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        if (keys[i] == "Enabled")
+        {
+          war(DTR("option '%s' of '%s' changed, restart needed to apply it"),
+              keys[i].c_str(), itr->first.c_str());
+          continue;
+        }
+
+        std::map<std::string, std::string>::const_iterator oitr = options.find(keys[i]);
+        if (oitr == options.end())
+        {
+          war(DTR("option '%s' of '%s' removed, restart needed to restore its default"),
+              keys[i].c_str(), itr->first.c_str());
+          continue;
+        }
+
+        IMC::EntityParameter param;
+        param.name = oitr->first;
+        param.value = oitr->second;
+        params.params.push_back(param);
+      }
+
+      if (params.params.size() == 0)
+        continue;
+
+      inf(DTR("reloading configuration of %s"), itr->first.c_str());
+      dispatch(params, Tasks::DF_LOOP_BACK);
+    }
+
+    Parsers::Config::Changes::const_iterator sitr = changes.begin();
+    for ( ; sitr != changes.end(); ++sitr)
+      war(DTR("section '%s' changed, restart needed to apply it"), sitr->first.c_str());
+  }
+
   void
   Daemon::consume(const IMC::RestartSystem* msg)
   {
@@ -278,11 +377,55 @@ namespace DUNE
     // Dispatch query power channel state.
     IMC::QueryPowerChannelState qpcs;
     dispatch(qpcs);
+
+    // Report startup timeline.
+    if (!m_startup_reported && (m_tman->isReady() || m_startup_counter.overflow()))
+    {
+      m_startup_reported = true;
+      inf(DTR("startup timeline: %s"), m_tman->getTimeline().c_str());
+    }
+  }
+
+  void
+  Daemon::runDeterministic(void)
+  {
+    double start = Time::Clock::get();
+    std::clock_t cpu_start = std::clock();
+
+    while (!stopping())
+    {
+      consumeMessages();
+
+      if (m_periodic_counter.overflow())
+      {
+        m_periodic_counter.reset();
+        dispatchPeriodic();
+      }
+
+      // Keep time flowing when no task is waiting for it.
+      if (!m_tman->step())
+      {
+        double remaining = std::max(0.0, m_periodic_counter.getRemaining());
+        Time::Clock::setVirtualNsec(Time::Clock::getNsec() + (uint64_t)(remaining * Time::c_nsec_per_sec));
+      }
+
+      double elapsed = Time::Clock::get() - start;
+      if (m_duration > 0 && elapsed >= m_duration)
+      {
+        double cpu = (std::clock() - cpu_start) / (double)CLOCKS_PER_SEC;
+        inf(DTR("deterministic run finished: %0.1f s in %0.1f s of processor time"), elapsed, cpu);
+        m_finished = true;
+        break;
+      }
+    }
   }
 
   void
   Daemon::onMain(void)
   {
+    if (m_tman->isDeterministic())
+      runDeterministic();
+
     while (!stopping())
     {
       waitForMessages(1.0);
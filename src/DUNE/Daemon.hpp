@@ -68,12 +68,23 @@ namespace DUNE
     void
     consume(const DUNE::IMC::SaveEntityParameters* msg);
 
+    void
+    consume(const DUNE::IMC::Event* msg);
+
     void
     onMain(void);
 
     void
     writeParamsXML(std::ostream& os) const;
 
+    //! Test if a deterministic run reached its duration.
+    //! @return true if the run is finished, false otherwise.
+    bool
+    isFinished(void) const
+    {
+      return m_finished;
+    }
+
   private:
     //! System resources.
     System::Resources m_sys_resources;
@@ -83,6 +94,14 @@ namespace DUNE
     uint64_t m_fs_capacity;
     //! Periodic counter.
     Time::Counter<double> m_periodic_counter;
+    //! Startup timeline report timeout.
+    Time::Counter<double> m_startup_counter;
+    //! True if the startup timeline was already reported.
+    bool m_startup_reported;
+    //! Duration of deterministic runs in simulated time (0 for unlimited).
+    double m_duration;
+    //! True if a deterministic run reached its duration.
+    volatile bool m_finished;
     //! Save configuration file name.
     std::string m_scfg_file;
     //! Saved configuration parameters.
@@ -90,6 +109,16 @@ namespace DUNE
 
     void
     dispatchPeriodic(void);
+
+    //! Reload the configuration files that changed and update the
+    //! parameters of the tasks whose sections changed.
+    void
+    reloadConfig(void);
+
+    //! Step all cooperative tasks in this thread until the run
+    //! reaches its duration.
+    void
+    runDeterministic(void);
   };
 }
 
@@ -29,11 +29,15 @@
 #define DUNE_ENTITIES_ENTITY_DATA_BASE_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <algorithm>
+#include <cstddef>
 #include <stdexcept>
 #include <map>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Concurrency/Snapshot.hpp>
 #include <DUNE/Utils/String.hpp>
 
 namespace DUNE
@@ -97,31 +101,28 @@ namespace DUNE
       {
         Concurrency::ScopedMutex l(m_lock);
 
-        EntitiesById::iterator itr = m_by_id.begin();
-        for (; itr != m_by_id.end(); ++itr)
-          delete itr->second;
+        for (size_t i = 0; i < m_entities.size(); ++i)
+          delete m_entities[i];
       }
 
       //! Determine if an entity identified by a given label exists in the database.
       //! @param[in] name entity label to use.
       //! @return true if an entity with the provided label exists in the database, false otherwise.
       bool
-      labelExists(const std::string& name)
+      labelExists(const std::string& name) const
       {
-        Concurrency::ScopedMutex l(m_lock);
-        EntitiesByLabel::iterator itr = m_by_label.find(name);
-        return (itr != m_by_label.end());
+        Concurrency::Snapshot<Index>::Reader index(m_index);
+        return index->find(name) != NULL;
       }
 
       //! Determine if an entity identified by a given numeric id exists in the database.
       //! @param[in] id numeric id to use.
       //! @return true if an entity with the provided id exists in the database, false otherwise.
       bool
-      idExists(unsigned int id)
+      idExists(unsigned int id) const
       {
-        Concurrency::ScopedMutex l(m_lock);
-        EntitiesById::iterator itr = m_by_id.find(id);
-        return (itr != m_by_id.end());
+        Concurrency::Snapshot<Index>::Reader index(m_index);
+        return id < index->by_id.size();
       }
 
       //! Add an entity to the database, identified by a unique label, and retrieve the reserved numerical id.
@@ -135,18 +136,28 @@ namespace DUNE
           throw InvalidLabel();
 
         Concurrency::ScopedMutex l(m_lock);
-        EntitiesByLabel::iterator itr = m_by_label.find(label);
 
-        if (itr != m_by_label.end())
-          throw ReservedUnique(label);
+        Index* index = NULL;
+        {
+          Concurrency::Snapshot<Index>::Reader current(m_index);
+          if (current->find(label) != NULL)
+            throw ReservedUnique(label);
+
+          index = new Index(*current);
+        }
 
         unsigned int id = m_next_id++;
         Entity* entry = new Entity;
         entry->label = label;
         entry->id = id;
         entry->task_name = task_name;
-        m_by_id[id] = entry;
-        m_by_label[label] = entry;
+        m_entities.push_back(entry);
+
+        index->by_id.push_back(entry);
+        index->by_label.insert(std::lower_bound(index->by_label.begin(), index->by_label.end(),
+                                                entry, lessByLabel),
+                               entry);
+        m_index.publish(index);
 
         return id;
       }
@@ -155,87 +166,119 @@ namespace DUNE
       //! The NonexistentLabel exception is thrown if there is no matching entity in the database.
       //! @return numerical entity id.
       unsigned int
-      resolve(const std::string& label)
+      resolve(const std::string& label) const
       {
-        Concurrency::ScopedMutex l(m_lock);
+        Concurrency::Snapshot<Index>::Reader index(m_index);
 
-        EntitiesByLabel::iterator itr = m_by_label.find(label);
-
-        if (itr == m_by_label.end())
+        const Entity* entity = index->find(label);
+        if (entity == NULL)
           throw NonexistentLabel(label);
 
-        return itr->second->id;
+        return entity->id;
       }
 
       //! Get the task name for the entity identified by the given label
       //! The NonexistentLabel exception is thrown if there is no matching entity in the database.
       //! @return task name.
-      std::string
-      resolveTaskName(const std::string& label)
+      const std::string&
+      resolveTaskName(const std::string& label) const
       {
-        Concurrency::ScopedMutex l(m_lock);
+        Concurrency::Snapshot<Index>::Reader index(m_index);
 
-        EntitiesByLabel::iterator itr = m_by_label.find(label);
-
-        if (itr == m_by_label.end())
+        const Entity* entity = index->find(label);
+        if (entity == NULL)
           throw NonexistentLabel(label);
 
-        return itr->second->task_name;
+        return entity->task_name;
       }
 
       //! Get the label for the entity identified by the given numeric id.
       //! The InvalidId exception is thrown if there is no matching entity in the database.
       //! @return entity label.
       const std::string&
-      resolve(unsigned int id)
+      resolve(unsigned int id) const
       {
-        Concurrency::ScopedMutex l(m_lock);
+        Concurrency::Snapshot<Index>::Reader index(m_index);
 
-        EntitiesById::iterator itr = m_by_id.find(id);
-
-        if (itr == m_by_id.end())
+        if (id >= index->by_id.size())
           throw InvalidId(id);
 
-        return itr->second->label;
+        return index->by_id[id]->label;
       }
 
       //! Fill a vector with pointers to the existing Entity records.
       //! @param[out] devs vector to be filled.
       void
-      contents(std::vector<Entity*>& devs)
+      contents(std::vector<Entity*>& devs) const
       {
-        Concurrency::ScopedMutex l(m_lock);
-
-        for (EntitiesById::iterator itr = m_by_id.begin(); itr != m_by_id.end(); ++itr)
-          devs.push_back(itr->second);
+        Concurrency::Snapshot<Index>::Reader index(m_index);
+        devs.insert(devs.end(), index->by_id.begin(), index->by_id.end());
       }
 
       //! Produce a map between the existing numeric entity ids and the entity labels.
       //! @return the produced map.
       std::map<unsigned, std::string>
-      entries(void)
+      entries(void) const
       {
         std::map<unsigned, std::string> ent;
 
-        Concurrency::ScopedMutex l(m_lock);
+        Concurrency::Snapshot<Index>::Reader index(m_index);
 
-        for (EntitiesById::iterator itr = m_by_id.begin(); itr != m_by_id.end(); ++itr)
-          ent[itr->first] = itr->second->label;
+        for (size_t i = 0; i < index->by_id.size(); ++i)
+          ent[index->by_id[i]->id] = index->by_id[i]->label;
 
         return ent;
       }
 
     private:
-      //! Mutex for accessing the database.
+      //! Immutable index of the entities at a given time. Entity
+      //! records are never modified after being indexed, so lookups
+      //! only need the index that was current when they started.
+      struct Index
+      {
+        //! Entities by numeric id (ids are reserved sequentially).
+        std::vector<Entity*> by_id;
+        //! Entities sorted by label.
+        std::vector<Entity*> by_label;
+
+        //! Find an entity by label.
+        //! @param[in] label entity label.
+        //! @return entity or NULL if it does not exist.
+        const Entity*
+        find(const std::string& label) const
+        {
+          size_t lo = 0;
+          size_t hi = by_label.size();
+          while (lo < hi)
+          {
+            size_t mid = lo + (hi - lo) / 2;
+            int cmp = by_label[mid]->label.compare(label);
+            if (cmp == 0)
+              return by_label[mid];
+            if (cmp < 0)
+              lo = mid + 1;
+            else
+              hi = mid;
+          }
+
+          return NULL;
+        }
+      };
+
+      static bool
+      lessByLabel(const Entity* a, const Entity* b)
+      {
+        return a->label < b->label;
+      }
+
+      //! Writers lock.
       Concurrency::Mutex m_lock;
       //! Next vacant numeric id.
       unsigned int m_next_id;
-      //! Mapping between numeric id's and Entity records.
-      typedef std::map<unsigned, Entity*> EntitiesById;
-      EntitiesById m_by_id;
-      //! Mapping between labels and Entity records.
-      typedef std::map<std::string, Entity*> EntitiesByLabel;
-      EntitiesByLabel m_by_label;
+      //! Entity records.
+      std::vector<Entity*> m_entities;
+      //! Current index.
+      Concurrency::Snapshot<Index> m_index;
     };
   }
 }
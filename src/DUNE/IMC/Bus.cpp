@@ -40,36 +40,18 @@ namespace DUNE
 {
   namespace IMC
   {
-    struct BackLogEntry
-    {
-      BackLogEntry(const Message* msg, Tasks::AbstractTask* exc):
-        message(msg->clone()),
-        exclude(exc)
-      {  }
-
-      ~BackLogEntry(void)
-      {
-        delete message;
-      }
+    //! Number of messages the back log holds without growing.
+    static const size_t c_back_log_size = 4096;
 
-      //! Message.
-      Message* message;
-      //! Exclude this task.
-      Tasks::AbstractTask* exclude;
-    };
-
-    Bus::Bus(void):
-      m_paused(false)
-    { }
+    Bus::Bus(void)
+    {
+      m_back_log.reserve(c_back_log_size);
+    }
 
     Bus::~Bus(void)
     {
-      while (!m_back_log.empty())
-      {
-        BackLogEntry* entry = m_back_log.pop();
-        if (entry != NULL)
-          delete entry;
-      }
+      for (size_t i = 0; i < m_back_log.size(); ++i)
+        delete m_back_log[i].message;
 
       for (unsigned i = 0; i < m_bind_msgs.size(); ++i)
         delete m_bind_msgs[i];
@@ -101,15 +83,47 @@ namespace DUNE
     void
     Bus::dispatch(const Message* msg, Tasks::AbstractTask* task)
     {
+      if (isPaused())
       {
         Concurrency::ScopedMutex lock(m_paused_lock);
-        if (m_paused)
+        if (isPaused())
         {
-          m_back_log.push(new BackLogEntry(msg, task));
+          // Senders keep ownership of their messages (often on the
+          // stack), so the back log needs its own copy.
+          BackLogEntry entry = {msg->clone(), task};
+          m_back_log.push_back(entry);
           return;
         }
       }
 
+      deliver(msg, task);
+    }
+
+    void
+    Bus::pause(void)
+    {
+      Concurrency::ScopedMutex lock(m_paused_lock);
+      if (!isPaused())
+        m_epoch.add(1);
+    }
+
+    void
+    Bus::resume(void)
+    {
+      Concurrency::ScopedMutex lock(m_paused_lock);
+      if (!isPaused())
+        return;
+
+      for (size_t i = 0; i < m_back_log.size(); ++i)
+        handOver(m_back_log[i].message, m_back_log[i].exclude);
+
+      m_back_log.clear();
+      m_epoch.add(1);
+    }
+
+    void
+    Bus::deliver(const Message* msg, Tasks::AbstractTask* task)
+    {
       uint16_t id = msg->getId();
       Concurrency::ScopedRWLock l(m_lock);
       TransportList& dlst(m_recipients[id]);
@@ -121,21 +135,25 @@ namespace DUNE
     }
 
     void
-    Bus::resume(void)
+    Bus::handOver(Message* msg, Tasks::AbstractTask* task)
     {
-      m_paused_lock.lock();
-      m_paused = false;
-      m_paused_lock.unlock();
-
-      while (!m_back_log.empty())
+      Tasks::AbstractTask* last = NULL;
+      Concurrency::ScopedRWLock l(m_lock);
+      TransportList& dlst(m_recipients[msg->getId()]);
+      for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
       {
-        BackLogEntry* entry = m_back_log.pop();
-        if (entry != NULL)
-        {
-          dispatch(entry->message, entry->exclude);
-          delete entry;
-        }
+        if (*itr == task)
+          continue;
+
+        if (last != NULL)
+          last->receive(msg);
+        last = *itr;
       }
+
+      if (last != NULL)
+        last->adopt(msg);
+      else
+        delete msg;
     }
 
     const std::vector<TransportBindings*>
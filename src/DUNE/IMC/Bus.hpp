@@ -35,11 +35,10 @@
 #include <string>
 #include <utility>
 #include <vector>
-#include <queue>
 
 // DUNE headers.
 #include <DUNE/Tasks/AbstractTask.hpp>
-#include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/Concurrency/AtomicCounter.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Concurrency/ScopedRWLock.hpp>
 
@@ -48,7 +47,6 @@ namespace DUNE
   namespace IMC
   {
     // Forward declarations.
-    struct BackLogEntry;
     class TransportBindings;
 
     // Export DLL Symbol.
@@ -83,33 +81,70 @@ namespace DUNE
       void
       dispatch(const Message* msg, Tasks::AbstractTask* task = NULL);
 
-      inline void
-      pause(void)
-      {
-        Concurrency::ScopedMutex lock(m_paused_lock);
-        m_paused = true;
-      }
+      //! Pause the bus. Messages dispatched while the bus is paused
+      //! are kept in a back log and delivered when the bus is
+      //! resumed, so that tasks registered in the meantime receive
+      //! them too. The back log keeps one copy of each message and
+      //! hands it over to a recipient on resume, so held messages
+      //! cost no more copies than messages delivered right away.
+      void
+      pause(void);
 
+      //! Resume the bus, delivering the messages in the back log in
+      //! the order they were dispatched. Messages dispatched while
+      //! the back log is being delivered wait for it to finish.
       void
       resume(void);
 
+      //! Test if the bus is paused.
+      //! @return true if the bus is paused, false otherwise.
+      bool
+      isPaused(void)
+      {
+        return (m_epoch.value() & 1) != 0;
+      }
+
       const std::vector<TransportBindings*>
       getBindings(void);
 
     private:
+      //! Message dispatched while the bus was paused.
+      struct BackLogEntry
+      {
+        //! Copy of the message, handed over on resume.
+        Message* message;
+        //! Exclude this task.
+        Tasks::AbstractTask* exclude;
+      };
+
       typedef std::list<Tasks::AbstractTask*> TransportList;
       //! Table of recipients.
       std::map<uint16_t, TransportList> m_recipients;
       //! Internal list lock.
       Concurrency::RWLock m_lock;
-      //! Bus is paused.
-      bool m_paused;
-      //! Pause lock.
+      //! Pause epoch, odd while the bus is paused. Dispatching only
+      //! takes the pause lock when the epoch is odd.
+      Concurrency::AtomicCounter m_epoch;
+      //! Pause lock, guards the back log.
       Concurrency::Mutex m_paused_lock;
       //! List containing all generated TransportBindings for future logging/reference.
       std::vector<TransportBindings*> m_bind_msgs;
-      //! Back log queue. Saves messages when Bus is paused.
-      Concurrency::TSQueue<BackLogEntry*> m_back_log;
+      //! Back log, with storage for its usual size reserved
+      //! beforehand. Saves messages while the bus is paused.
+      std::vector<BackLogEntry> m_back_log;
+
+      //! Deliver a message to registered listeners.
+      //! @param msg message to deliver.
+      //! @param task do not deliver message to this task.
+      void
+      deliver(const Message* msg, Tasks::AbstractTask* task);
+
+      //! Deliver a message to registered listeners, handing it over
+      //! to the last one.
+      //! @param msg message to deliver, owned by the bus.
+      //! @param task do not deliver message to this task.
+      void
+      handOver(Message* msg, Tasks::AbstractTask* task);
 
       //! Non - copyable.
       Bus(Bus const&);
@@ -44,6 +44,8 @@ namespace DUNE
     {
       bind<IMC::StopManeuver>(this);
       bind<IMC::PathControlState>(this);
+
+      setCooperative();
     }
 
     Maneuver::~Maneuver(void)
@@ -236,7 +238,7 @@ namespace DUNE
     }
 
     void
-    Maneuver::onMain(void)
+    Maneuver::registerManeuvers(void)
     {
       std::set<uint16_t>::const_iterator it;
       for (it = m_reg_man.begin(); it != m_reg_man.end(); it++)
@@ -245,6 +247,26 @@ namespace DUNE
         rm.mid = *it;
         dispatch(rm);
       }
+    }
+
+    double
+    Maneuver::onJob(bool restarted)
+    {
+      if (restarted)
+        registerManeuvers();
+
+      consumeMessages();
+
+      if (isActive())
+        onStateReport();
+
+      return Time::Clock::get() + 1.0;
+    }
+
+    void
+    Maneuver::onMain(void)
+    {
+      registerManeuvers();
 
       while (!stopping())
       {
@@ -285,10 +285,19 @@ namespace DUNE
         signalProgress("");
       }
 
+      //! Register maneuvers at startup and report the state of the
+      //! active maneuver every second.
+      double
+      onJob(bool restarted);
+
       void
       onMain(void);
 
     private:
+      //! Announce the maneuvers handled by this task.
+      void
+      registerManeuvers(void);
+
       //! Update the scope reference
       //! @return new sequence number for the scope
       uint32_t
@@ -39,7 +39,10 @@ namespace DUNE
 #include <DUNE/Math/Derivative.hpp>
 #include <DUNE/Math/General.hpp>
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/FixedMatrix.hpp>
+#include <DUNE/Math/MatrixKernels.hpp>
 #include <DUNE/Math/Angles.hpp>
+#include <DUNE/Math/Trigonometry.hpp>
 #include <DUNE/Math/Random.hpp>
 #include <DUNE/Math/Optimization.hpp>
 #include <DUNE/Math/QPSolver.hpp>
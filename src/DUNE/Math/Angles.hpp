@@ -30,6 +30,7 @@
 
 // ISO C++ 98 headers.
 #include <cmath>
+#include <cstddef>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -60,6 +61,26 @@ namespace DUNE
         return a;
       }
 
+      //! Normalize an array of radians so that the values fall between
+      //! -pi and +pi. Unlike the scalar version the cost does not depend
+      //! on the number of turns, but angles must be below 1e9 radian.
+      //! The output array may be the input array.
+      //! @param a angles in radian.
+      //! @param count number of angles.
+      //! @param out array to store the normalized angles.
+      inline static void
+      normalizeRadian(const fp64_t* a, size_t count, fp64_t* out)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          // Number of turns to remove, rounded up.
+          fp64_t t = (a[i] - c_pi) / c_two_pi;
+          int k = static_cast<int>(t);
+          k += (t > k) ? 1 : 0;
+          out[i] = a[i] - c_two_pi * k;
+        }
+      }
+
       //! Convert a value given in degree to radian.
       //! @param d value in degree.
       //! @return value converted to radian.
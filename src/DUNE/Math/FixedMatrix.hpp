@@ -0,0 +1,616 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_FIXED_MATRIX_HPP_INCLUDED_
+#define DUNE_MATH_FIXED_MATRIX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Matrix with dimensions known at compile time.
+    //!
+    //! Elements are stored by row in the object itself, so instances
+    //! can live on the stack or inside other objects without any heap
+    //! allocation or reference counting. Element access is not bounds
+    //! checked and dimension mismatches are caught by the compiler.
+    //! Besides the usual operators, fused routines that write into a
+    //! caller supplied result (multiply(), multiplyTransposed(),
+    //! multiplyAPAT()) are provided to avoid temporaries in hot paths.
+    //!
+    //! Conversion from and to Math::Matrix is explicit.
+    //!
+    //! @tparam R number of rows.
+    //! @tparam C number of columns.
+    template <size_t R, size_t C>
+    class FixedMatrix
+    {
+    public:
+      //! Constructor.
+      //! Construct a matrix filled with zeros.
+      FixedMatrix(void)
+      {
+        fill(0.0);
+      }
+
+      //! Constructor.
+      //! Construct a matrix filled with a constant value.
+      //! @param[in] value value used to initialize elements.
+      explicit
+      FixedMatrix(double value)
+      {
+        fill(value);
+      }
+
+      //! Constructor.
+      //! Construct a matrix from an array of R * C values stored by row.
+      //! @param[in] data pointer to data.
+      explicit
+      FixedMatrix(const double* data)
+      {
+        std::memcpy(m_data, data, sizeof(m_data));
+      }
+
+      //! Constructor.
+      //! Construct a matrix from a Math::Matrix with the same dimensions.
+      //! @param[in] m matrix.
+      //! @throw Matrix::Error if dimensions do not match.
+      explicit
+      FixedMatrix(const Matrix& m)
+      {
+        if ((size_t)m.rows() != R || (size_t)m.columns() != C)
+          throw Matrix::Error("fixed matrix dimension mismatch");
+
+        for (size_t i = 0; i < R; ++i)
+          for (size_t j = 0; j < C; ++j)
+            m_data[i * C + j] = m.element(i, j);
+      }
+
+      //! Retrieve the number of rows of the matrix.
+      //! @return number of rows of the matrix.
+      static size_t
+      rows(void)
+      {
+        return R;
+      }
+
+      //! Retrieve the number of columns of the matrix.
+      //! @return number of columns of the matrix.
+      static size_t
+      columns(void)
+      {
+        return C;
+      }
+
+      //! Retrieve the number of elements of the matrix.
+      //! @return number of elements of the matrix.
+      static size_t
+      size(void)
+      {
+        return R * C;
+      }
+
+      //! Fill the matrix with a constant value.
+      //! @param[in] value constant value.
+      void
+      fill(double value)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] = value;
+      }
+
+      //! Turn the matrix into an identity matrix (or the leading
+      //! identity block if the matrix is not square).
+      void
+      identity(void)
+      {
+        fill(0.0);
+        for (size_t i = 0; i < R && i < C; ++i)
+          m_data[i * C + i] = 1.0;
+      }
+
+      //! Access element.
+      //! @param[in] i row index.
+      //! @param[in] j column index.
+      //! @return reference to element.
+      double&
+      operator()(size_t i, size_t j)
+      {
+        return m_data[i * C + j];
+      }
+
+      //! Access element.
+      //! @param[in] i row index.
+      //! @param[in] j column index.
+      //! @return element value.
+      double
+      operator()(size_t i, size_t j) const
+      {
+        return m_data[i * C + j];
+      }
+
+      //! Access element by linear (row major) index.
+      //! @param[in] i element index.
+      //! @return reference to element.
+      double&
+      operator()(size_t i)
+      {
+        return m_data[i];
+      }
+
+      //! Access element by linear (row major) index.
+      //! @param[in] i element index.
+      //! @return element value.
+      double
+      operator()(size_t i) const
+      {
+        return m_data[i];
+      }
+
+      //! Get pointer to elements stored by row.
+      //! @return pointer to elements.
+      double*
+      data(void)
+      {
+        return m_data;
+      }
+
+      //! Get pointer to elements stored by row.
+      //! @return pointer to elements.
+      const double*
+      data(void) const
+      {
+        return m_data;
+      }
+
+      //! Retrieve a submatrix.
+      //! @tparam SR number of rows of the submatrix.
+      //! @tparam SC number of columns of the submatrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @param[out] m submatrix.
+      template <size_t SR, size_t SC>
+      void
+      get(size_t i, size_t j, FixedMatrix<SR, SC>& m) const
+      {
+        for (size_t r = 0; r < SR; ++r)
+          for (size_t c = 0; c < SC; ++c)
+            m(r, c) = m_data[(i + r) * C + j + c];
+      }
+
+      //! Set a submatrix.
+      //! @tparam SR number of rows of the submatrix.
+      //! @tparam SC number of columns of the submatrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @param[in] m submatrix.
+      template <size_t SR, size_t SC>
+      void
+      put(size_t i, size_t j, const FixedMatrix<SR, SC>& m)
+      {
+        for (size_t r = 0; r < SR; ++r)
+          for (size_t c = 0; c < SC; ++c)
+            m_data[(i + r) * C + j + c] = m(r, c);
+      }
+
+      //! Copy elements into a Math::Matrix, resizing it if needed.
+      //! @param[out] m destination matrix.
+      void
+      toMatrix(Matrix& m) const
+      {
+        m.fill(R, C, m_data);
+      }
+
+      //! Convert to a Math::Matrix.
+      //! @return matrix with the same elements.
+      Matrix
+      toMatrix(void) const
+      {
+        Matrix m(R, C);
+        m.fill(R, C, m_data);
+        return m;
+      }
+
+      //! Add another matrix.
+      //! @param[in] m matrix.
+      //! @return reference to this matrix.
+      FixedMatrix&
+      operator+=(const FixedMatrix& m)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] += m.m_data[i];
+        return *this;
+      }
+
+      //! Subtract another matrix.
+      //! @param[in] m matrix.
+      //! @return reference to this matrix.
+      FixedMatrix&
+      operator-=(const FixedMatrix& m)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] -= m.m_data[i];
+        return *this;
+      }
+
+      //! Multiply by a scalar.
+      //! @param[in] x scalar.
+      //! @return reference to this matrix.
+      FixedMatrix&
+      operator*=(double x)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] *= x;
+        return *this;
+      }
+
+      //! Divide by a scalar.
+      //! @param[in] x scalar.
+      //! @return reference to this matrix.
+      FixedMatrix&
+      operator/=(double x)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] /= x;
+        return *this;
+      }
+
+      //! Unary minus.
+      //! @return negated matrix.
+      FixedMatrix
+      operator-(void) const
+      {
+        FixedMatrix m(*this);
+        m *= -1.0;
+        return m;
+      }
+
+      //! Compare matrices for equality.
+      //! @param[in] m matrix.
+      //! @return true if all elements are equal, false otherwise.
+      bool
+      operator==(const FixedMatrix& m) const
+      {
+        for (size_t i = 0; i < R * C; ++i)
+        {
+          if (m_data[i] != m.m_data[i])
+            return false;
+        }
+        return true;
+      }
+
+      //! Compute the sum of the diagonal elements.
+      //! @return trace.
+      double
+      trace(void) const
+      {
+        double t = 0.0;
+        for (size_t i = 0; i < R && i < C; ++i)
+          t += m_data[i * C + i];
+        return t;
+      }
+
+      //! Compute the element-wise 2-norm (euclidean norm for vectors,
+      //! Frobenius norm for matrices).
+      //! @return norm.
+      double
+      norm_2(void) const
+      {
+        double s = 0.0;
+        for (size_t i = 0; i < R * C; ++i)
+          s += m_data[i] * m_data[i];
+        return std::sqrt(s);
+      }
+
+    private:
+      //! Elements stored by row.
+      double m_data[R * C];
+    };
+
+    //! Compute the product of two matrices into a result matrix.
+    //! @param[in] a left operand.
+    //! @param[in] b right operand.
+    //! @param[out] out result (must not alias a or b).
+    template <size_t R, size_t K, size_t C>
+    inline void
+    multiply(const FixedMatrix<R, K>& a, const FixedMatrix<K, C>& b, FixedMatrix<R, C>& out)
+    {
+      // Row oriented (i-k-j) so that the inner loop has unit stride.
+      const double* pb = b.data();
+      double* po = out.data();
+
+      for (size_t i = 0; i < R; ++i)
+      {
+        double* row = po + i * C;
+        double f = a(i, 0);
+        for (size_t j = 0; j < C; ++j)
+          row[j] = f * pb[j];
+
+        for (size_t k = 1; k < K; ++k)
+        {
+          f = a(i, k);
+          const double* brow = pb + k * C;
+          for (size_t j = 0; j < C; ++j)
+            row[j] += f * brow[j];
+        }
+      }
+    }
+
+    //! Compute a * b^T into a result matrix without forming b^T.
+    //! @param[in] a left operand.
+    //! @param[in] b right operand (transposed).
+    //! @param[out] out result (must not alias a or b).
+    template <size_t R, size_t K, size_t C>
+    inline void
+    multiplyTransposed(const FixedMatrix<R, K>& a, const FixedMatrix<C, K>& b, FixedMatrix<R, C>& out)
+    {
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t j = 0; j < C; ++j)
+        {
+          double s = 0.0;
+          for (size_t k = 0; k < K; ++k)
+            s += a(i, k) * b(j, k);
+          out(i, j) = s;
+        }
+      }
+    }
+
+    //! Compute a * p * a^T for a symmetric p, as used to propagate
+    //! covariances. Only the upper triangle of the result is
+    //! computed, the lower triangle is mirrored.
+    //! @param[in] a transformation.
+    //! @param[in] p symmetric matrix.
+    //! @param[out] out result (must not alias a or p).
+    template <size_t R, size_t N>
+    inline void
+    multiplyAPAT(const FixedMatrix<R, N>& a, const FixedMatrix<N, N>& p, FixedMatrix<R, R>& out)
+    {
+      FixedMatrix<R, N> ap;
+      multiply(a, p, ap);
+
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t j = i; j < R; ++j)
+        {
+          double s = 0.0;
+          for (size_t k = 0; k < N; ++k)
+            s += ap(i, k) * a(j, k);
+          out(i, j) = s;
+          out(j, i) = s;
+        }
+      }
+    }
+
+    //! Compute the product of two matrices.
+    //! @param[in] a left operand.
+    //! @param[in] b right operand.
+    //! @return product.
+    template <size_t R, size_t K, size_t C>
+    inline FixedMatrix<R, C>
+    operator*(const FixedMatrix<R, K>& a, const FixedMatrix<K, C>& b)
+    {
+      FixedMatrix<R, C> out;
+      multiply(a, b, out);
+      return out;
+    }
+
+    //! Compute the sum of two matrices.
+    //! @param[in] a matrix.
+    //! @param[in] b matrix.
+    //! @return sum.
+    template <size_t R, size_t C>
+    inline FixedMatrix<R, C>
+    operator+(const FixedMatrix<R, C>& a, const FixedMatrix<R, C>& b)
+    {
+      FixedMatrix<R, C> out(a);
+      out += b;
+      return out;
+    }
+
+    //! Compute the difference of two matrices.
+    //! @param[in] a matrix.
+    //! @param[in] b matrix.
+    //! @return difference.
+    template <size_t R, size_t C>
+    inline FixedMatrix<R, C>
+    operator-(const FixedMatrix<R, C>& a, const FixedMatrix<R, C>& b)
+    {
+      FixedMatrix<R, C> out(a);
+      out -= b;
+      return out;
+    }
+
+    //! Multiply a matrix by a scalar.
+    //! @param[in] x scalar.
+    //! @param[in] a matrix.
+    //! @return scaled matrix.
+    template <size_t R, size_t C>
+    inline FixedMatrix<R, C>
+    operator*(double x, const FixedMatrix<R, C>& a)
+    {
+      FixedMatrix<R, C> out(a);
+      out *= x;
+      return out;
+    }
+
+    //! Multiply a matrix by a scalar.
+    //! @param[in] a matrix.
+    //! @param[in] x scalar.
+    //! @return scaled matrix.
+    template <size_t R, size_t C>
+    inline FixedMatrix<R, C>
+    operator*(const FixedMatrix<R, C>& a, double x)
+    {
+      return x * a;
+    }
+
+    //! Divide a matrix by a scalar.
+    //! @param[in] a matrix.
+    //! @param[in] x scalar.
+    //! @return scaled matrix.
+    template <size_t R, size_t C>
+    inline FixedMatrix<R, C>
+    operator/(const FixedMatrix<R, C>& a, double x)
+    {
+      FixedMatrix<R, C> out(a);
+      out /= x;
+      return out;
+    }
+
+    //! Compute the transpose of a matrix.
+    //! @param[in] a matrix.
+    //! @return transposed matrix.
+    template <size_t R, size_t C>
+    inline FixedMatrix<C, R>
+    transpose(const FixedMatrix<R, C>& a)
+    {
+      FixedMatrix<C, R> out;
+      for (size_t i = 0; i < R; ++i)
+        for (size_t j = 0; j < C; ++j)
+          out(j, i) = a(i, j);
+      return out;
+    }
+
+    //! Compute the inverse of a square matrix using Gauss-Jordan
+    //! elimination with partial pivoting.
+    //! @param[in] a matrix.
+    //! @return inverse of a.
+    //! @throw Matrix::Error if the matrix is singular with the
+    //! precision given by Matrix::get_precision().
+    template <size_t N>
+    inline FixedMatrix<N, N>
+    inverse(const FixedMatrix<N, N>& a)
+    {
+      FixedMatrix<N, N> m(a);
+      FixedMatrix<N, N> inv;
+      inv.identity();
+
+      for (size_t c = 0; c < N; ++c)
+      {
+        size_t pivot = c;
+        for (size_t r = c + 1; r < N; ++r)
+        {
+          if (std::fabs(m(r, c)) > std::fabs(m(pivot, c)))
+            pivot = r;
+        }
+
+        if (std::fabs(m(pivot, c)) < Matrix::get_precision())
+          throw Matrix::Error("trying to invert a singular matrix");
+
+        if (pivot != c)
+        {
+          for (size_t k = 0; k < N; ++k)
+          {
+            std::swap(m(c, k), m(pivot, k));
+            std::swap(inv(c, k), inv(pivot, k));
+          }
+        }
+
+        double d = 1.0 / m(c, c);
+        for (size_t k = 0; k < N; ++k)
+        {
+          m(c, k) *= d;
+          inv(c, k) *= d;
+        }
+
+        for (size_t r = 0; r < N; ++r)
+        {
+          if (r == c || m(r, c) == 0.0)
+            continue;
+
+          double f = m(r, c);
+          for (size_t k = 0; k < N; ++k)
+          {
+            m(r, k) -= f * m(c, k);
+            inv(r, k) -= f * inv(c, k);
+          }
+        }
+      }
+
+      return inv;
+    }
+
+    //! Compute the dot product of two column vectors.
+    //! @param[in] a vector.
+    //! @param[in] b vector.
+    //! @return dot product.
+    template <size_t N>
+    inline double
+    dot(const FixedMatrix<N, 1>& a, const FixedMatrix<N, 1>& b)
+    {
+      double s = 0.0;
+      for (size_t i = 0; i < N; ++i)
+        s += a(i) * b(i);
+      return s;
+    }
+
+    //! Compute the cross product of two 3D column vectors.
+    //! @param[in] a vector.
+    //! @param[in] b vector.
+    //! @return cross product.
+    inline FixedMatrix<3, 1>
+    cross(const FixedMatrix<3, 1>& a, const FixedMatrix<3, 1>& b)
+    {
+      FixedMatrix<3, 1> out;
+      out(0) = a(1) * b(2) - a(2) * b(1);
+      out(1) = a(2) * b(0) - a(0) * b(2);
+      out(2) = a(0) * b(1) - a(1) * b(0);
+      return out;
+    }
+
+    //! Write a matrix to an output stream, one row per line.
+    //! @param[in] os output stream.
+    //! @param[in] a matrix.
+    //! @return output stream.
+    template <size_t R, size_t C>
+    inline std::ostream&
+    operator<<(std::ostream& os, const FixedMatrix<R, C>& a)
+    {
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t j = 0; j < C; ++j)
+          os << a(i, j) << " ";
+        os << std::endl;
+      }
+      return os;
+    }
+  }
+}
+
+#endif
@@ -46,6 +46,7 @@
 #include <DUNE/Utils/String.hpp>
 #include <DUNE/Math/Matrix.hpp>
 #include <DUNE/Math/General.hpp>
+#include <DUNE/Math/MatrixKernels.hpp>
 #include <DUNE/Parsers/Config.hpp>
 
 #define ALLOCD(count) (double*)std::malloc(sizeof(double) * (count))
@@ -191,6 +192,15 @@ namespace DUNE
       *m_counter = 1;
     }
 
+    void
+    Matrix::prepare(size_t r, size_t c)
+    {
+      if (m_size && m_nrows == r && m_ncols == c)
+        split();
+      else
+        resize(r, c);
+    }
+
     int
     Matrix::rows(void) const
     {
@@ -619,6 +629,19 @@ namespace DUNE
       return m_data[i];
     }
 
+    double*
+    Matrix::data(void)
+    {
+      split();
+      return m_data;
+    }
+
+    const double*
+    Matrix::data(void) const
+    {
+      return m_data;
+    }
+
     double
     Matrix::element(size_t i, size_t j) const
     {
@@ -1350,32 +1373,64 @@ namespace DUNE
         throw Matrix::Error("incompatible dimensions");
 
       Matrix s(m1.m_nrows, m2.m_ncols);
+      Kernels::multiply(m1.m_data, m2.m_data, s.m_data, m1.m_nrows, m1.m_ncols, m2.m_ncols);
+      return s;
+    }
 
-      int n = m1.m_nrows;
-      int m = m1.m_ncols;
-      int r = m2.m_ncols;
+    void
+    multiply(const Matrix& a, const Matrix& b, Matrix& out)
+    {
+      if (a.m_ncols != b.m_nrows)
+        throw Matrix::Error("incompatible dimensions");
 
-      double* m1_p = m1.m_data;
+      if (&out == &a || &out == &b)
+      {
+        out = a * b;
+        return;
+      }
 
-      for (int i = 0; i < n; i++)
+      out.prepare(a.m_nrows, b.m_ncols);
+      Kernels::multiply(a.m_data, b.m_data, out.m_data, a.m_nrows, a.m_ncols, b.m_ncols);
+    }
+
+    void
+    multiplyTransposed(const Matrix& a, const Matrix& b, Matrix& out)
+    {
+      if (a.m_ncols != b.m_ncols)
+        throw Matrix::Error("incompatible dimensions");
+
+      if (&out == &a || &out == &b)
       {
-        for (int k = 0; k < m; k++)
-        {
-          double v = *m1_p++; // <-> v = m1(i,k)
-          double* m2_p = m2.m_data + k * r;
-          double* s_p = s.m_data + i * r;
+        Matrix tmp;
+        multiplyTransposed(a, b, tmp);
+        out = tmp;
+        return;
+      }
 
-          for (int j = 0; j < r; j++)
-          {
-            if (!k)
-              *s_p = 0;
-            *s_p += v * (*m2_p); // <-> s(i,j) += m1(i,k) * m2(k,j)
-            s_p++;
-            m2_p++;
-          }
-        }
+      out.prepare(a.m_nrows, b.m_nrows);
+      Kernels::multiplyTransposed(a.m_data, b.m_data, out.m_data, a.m_nrows, a.m_ncols, b.m_nrows);
+    }
+
+    void
+    multiplyAPAT(const Matrix& a, const Matrix& p, Matrix& out, Matrix& work)
+    {
+      if (p.m_nrows != p.m_ncols || a.m_ncols != p.m_nrows)
+        throw Matrix::Error("incompatible dimensions");
+
+      if (&work == &a || &work == &p || &work == &out)
+        throw Matrix::Error("work matrix aliases an operand");
+
+      if (&out == &a || &out == &p)
+      {
+        Matrix tmp;
+        multiplyAPAT(a, p, tmp, work);
+        out = tmp;
+        return;
       }
-      return s;
+
+      work.prepare(a.m_nrows, a.m_ncols);
+      out.prepare(a.m_nrows, a.m_nrows);
+      Kernels::multiplyAPAT(a.m_data, p.m_data, out.m_data, work.m_data, a.m_nrows, a.m_ncols);
     }
 
     Matrix
@@ -1514,11 +1569,7 @@ namespace DUNE
       int m = a.m_ncols;
 
       Matrix t(m, n);
-
-      for (int i = 0; i < n; i++)
-        for (int j = 0; j < m; j++)
-          (t.m_data + j * n)[i] = (a.m_data + i * m)[j];
-
+      Kernels::transpose(a.m_data, t.m_data, n, m);
       return t;
     }
 
@@ -1800,50 +1851,60 @@ namespace DUNE
       if (a.m_nrows != a.m_ncols)
         throw Matrix::Error("inversion of a nonsquare Matrix");
 
-      int n = a.m_nrows;
+      return lu_solve(a, Matrix(a.m_nrows));
+    }
 
-      Matrix L(n);
-      Matrix U(n);
-      Matrix P(n);
+    Matrix
+    cholesky(const Matrix& a)
+    {
+      if (a.m_nrows != a.m_ncols)
+        throw Matrix::Error("factorization of a nonsquare Matrix");
 
-      a.lup(L, U, P);
+      Matrix l(a.m_data, a.m_nrows, a.m_ncols);
+      if (!Kernels::cholesky(l.m_data, l.m_nrows))
+        throw Matrix::Error("matrix is not positive definite");
 
-      double* y = ALLOCD(n);
-      double* l = L.m_data;
-      double* u = U.m_data;
-      double* p = P.m_data;
+      return l;
+    }
 
-      Matrix Minv(n, n);
-      double* m = Minv.m_data;
+    Matrix
+    cholesky_solve(const Matrix& l, const Matrix& b)
+    {
+      if (l.m_nrows != l.m_ncols || l.m_nrows != b.m_nrows)
+        throw Matrix::Error("incompatible dimensions");
 
-      for (int k = 0; k < n; k++)
-      {
-        for (int j = 0; j < n; j++)
-        {
-          y[j] = p[j * n + k];
+      Matrix x(b.m_data, b.m_nrows, b.m_ncols);
+      Kernels::choleskySolve(l.m_data, x.m_data, l.m_nrows, x.m_ncols);
+      return x;
+    }
 
-          for (int i = 0; i < j; i++)
-            y[j] -= l[j * n + i] * y[i];
+    Matrix
+    lu_solve(const Matrix& a, const Matrix& b)
+    {
+      if (a.m_nrows != a.m_ncols)
+        throw Matrix::Error("inversion of a nonsquare Matrix");
 
-          y[j] /= l[j * n + j];
-        }
+      if (a.m_nrows != b.m_nrows)
+        throw Matrix::Error("incompatible dimensions");
 
-        for (int j = n - 1; j >= 0; j--)
-        {
-          m[j * n + k] = y[j];
-          for (int i = j + 1; i < n; i++)
-            m[j * n + k] -= u[j * n + i] * m[i * n + k];
+      size_t n = a.m_nrows;
+      double* lu = ALLOCD(a.m_size);
+      size_t* piv = (size_t*)std::malloc(sizeof(size_t) * n);
+      std::memcpy(lu, a.m_data, a.m_size * sizeof(double));
 
-          if (Matrix::precision >= std::fabs(u[j * n + j]))
-            throw Matrix::Error("matrix is not invertible");
-          else
-            m[j * n + k] /= u[j * n + j];
-        }
+      if (!Kernels::lu(lu, piv, n, Matrix::precision))
+      {
+        std::free(piv);
+        std::free(lu);
+        throw Matrix::Error("matrix is not invertible");
       }
 
-      std::free(y);
+      Matrix x(b.m_data, b.m_nrows, b.m_ncols);
+      Kernels::luSolve(lu, piv, x.m_data, n, x.m_ncols);
 
-      return Minv;
+      std::free(piv);
+      std::free(lu);
+      return x;
     }
 
     Matrix
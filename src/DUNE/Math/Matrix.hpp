@@ -344,6 +344,17 @@ namespace DUNE
       double
       operator()(size_t i) const;
 
+      //! Get a pointer to the (row-major) storage of the matrix,
+      //! making sure the data is not shared by other matrices.
+      //! @return pointer to the first entry.
+      double*
+      data(void);
+
+      //! Get a pointer to the (row-major) storage of the matrix.
+      //! @return pointer to the first entry.
+      const double*
+      data(void) const;
+
       //! This method returns the value of an entry of a Matrix.
       //! As this is a reading method it does not care if the data is shared by
       //! other matrices.
@@ -759,6 +770,55 @@ namespace DUNE
       friend Matrix
       inverse_lup(const Matrix& a);
 
+      //! Compute the product of two matrices into an existing
+      //! matrix. The storage of 'out' is reused when it already has
+      //! the right dimensions and is not shared.
+      //! @param[in] a left operand.
+      //! @param[in] b right operand.
+      //! @param[out] out resultant matrix.
+      friend DUNE_DLL_SYM void
+      multiply(const Matrix& a, const Matrix& b, Matrix& out);
+
+      //! Compute a * b^T into an existing matrix without forming b^T.
+      //! @param[in] a left operand.
+      //! @param[in] b right operand (transposed).
+      //! @param[out] out resultant matrix.
+      friend DUNE_DLL_SYM void
+      multiplyTransposed(const Matrix& a, const Matrix& b, Matrix& out);
+
+      //! Compute a * p * a^T for a symmetric 'p' into an existing
+      //! matrix, as used to propagate covariances.
+      //! @param[in] a transformation matrix.
+      //! @param[in] p symmetric square matrix.
+      //! @param[out] out resultant (symmetric) matrix.
+      //! @param[out] work scratch matrix, resized to the dimensions
+      //! of 'a' if needed. Reusing it across calls avoids allocations.
+      friend DUNE_DLL_SYM void
+      multiplyAPAT(const Matrix& a, const Matrix& p, Matrix& out, Matrix& work);
+
+      //! This function computes the Cholesky factor of a symmetric
+      //! positive definite matrix (a = l * l^T).
+      //! @param[in] a symmetric positive definite matrix.
+      //! @return lower triangular factor.
+      friend DUNE_DLL_SYM Matrix
+      cholesky(const Matrix& a);
+
+      //! This function solves the system 'l * l^T * x = b' given the
+      //! Cholesky factor 'l' computed by cholesky().
+      //! @param[in] l lower triangular factor.
+      //! @param[in] b right hand side.
+      //! @return solution.
+      friend DUNE_DLL_SYM Matrix
+      cholesky_solve(const Matrix& l, const Matrix& b);
+
+      //! This function solves the system 'a * x = b' using LU
+      //! decomposition with partial pivoting.
+      //! @param[in] a square matrix.
+      //! @param[in] b right hand side.
+      //! @return solution.
+      friend DUNE_DLL_SYM Matrix
+      lu_solve(const Matrix& a, const Matrix& b);
+
       //! This function returns a Matrix with the absolute
       //! values of the entries of a given Matrix.
       //! @param[in] a matrix
@@ -843,6 +903,13 @@ namespace DUNE
       //! This method creates a unique copy of the data of a Matrix.
       void
       split(void);
+
+      //! Prepare matrix to be overwritten with a result of the given
+      //! dimensions, keeping the current storage if possible.
+      //! @param[in] r number of rows.
+      //! @param[in] c number of columns.
+      void
+      prepare(size_t r, size_t c);
     };
   }
 }
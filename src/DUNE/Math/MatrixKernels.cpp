@@ -0,0 +1,526 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/MatrixKernels.hpp>
+
+#if defined(DUNE_CPU_HAS_AVX2)
+#  include <immintrin.h>
+#endif
+
+#if defined(DUNE_CPU_HAS_NEON)
+#  include <arm_neon.h>
+#endif
+
+namespace DUNE
+{
+  namespace Math
+  {
+    namespace Kernels
+    {
+      //! Columns of the right hand operand kept in cache by products.
+      static const size_t c_block_cols = 256;
+      //! Inner dimension block of products.
+      static const size_t c_block_inner = 128;
+      //! Tile size of transpositions.
+      static const size_t c_block_tile = 16;
+
+      //! Vector primitives every implementation provides.
+      struct Primitives
+      {
+        //! Implementation name.
+        const char* name;
+        //! y += a * x.
+        void (*axpy)(size_t n, double a, const double* x, double* y);
+        //! y += a[0] * x0 + a[1] * x1 + a[2] * x2 + a[3] * x3.
+        void (*axpy4)(size_t n, const double* a, const double* x0, const double* x1,
+                      const double* x2, const double* x3, double* y);
+        //! Return x . y.
+        double (*dot)(size_t n, const double* x, const double* y);
+      };
+
+      static void
+      axpyGeneric(size_t n, double a, const double* x, double* y)
+      {
+        for (size_t i = 0; i < n; ++i)
+          y[i] += a * x[i];
+      }
+
+      static void
+      axpy4Generic(size_t n, const double* a, const double* x0, const double* x1,
+                   const double* x2, const double* x3, double* y)
+      {
+        for (size_t i = 0; i < n; ++i)
+          y[i] += a[0] * x0[i] + a[1] * x1[i] + a[2] * x2[i] + a[3] * x3[i];
+      }
+
+      static double
+      dotGeneric(size_t n, const double* x, const double* y)
+      {
+        double s0 = 0.0;
+        double s1 = 0.0;
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+          s0 += x[i] * y[i];
+          s1 += x[i + 1] * y[i + 1];
+        }
+        if (i < n)
+          s0 += x[i] * y[i];
+        return s0 + s1;
+      }
+
+      static const Primitives c_generic = {"generic", axpyGeneric, axpy4Generic, dotGeneric};
+
+#if defined(DUNE_CPU_HAS_AVX2) || defined(DUNE_CPU_HAS_NEON)
+      //! Scalar tail of the vector axpy4: the same fused operations in
+      //! the same order as one vector lane, so every element is
+      //! rounded alike regardless of its position.
+#  if defined(DUNE_CPU_HAS_AVX2)
+      __attribute__((target("avx2,fma")))
+#  endif
+      static inline double
+      fma4(const double* a, double x0, double x1, double x2, double x3, double y)
+      {
+        y = __builtin_fma(a[0], x0, y);
+        y = __builtin_fma(a[1], x1, y);
+        y = __builtin_fma(a[2], x2, y);
+        return __builtin_fma(a[3], x3, y);
+      }
+#endif
+
+#if defined(DUNE_CPU_HAS_AVX2)
+      __attribute__((target("avx2,fma"))) static void
+      axpyAVX2(size_t n, double a, const double* x, double* y)
+      {
+        __m256d va = _mm256_set1_pd(a);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+          _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        for (; i < n; ++i)
+          y[i] = __builtin_fma(a, x[i], y[i]);
+      }
+
+      __attribute__((target("avx2,fma"))) static void
+      axpy4AVX2(size_t n, const double* a, const double* x0, const double* x1,
+                const double* x2, const double* x3, double* y)
+      {
+        __m256d a0 = _mm256_set1_pd(a[0]);
+        __m256d a1 = _mm256_set1_pd(a[1]);
+        __m256d a2 = _mm256_set1_pd(a[2]);
+        __m256d a3 = _mm256_set1_pd(a[3]);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          __m256d v = _mm256_loadu_pd(y + i);
+          v = _mm256_fmadd_pd(a0, _mm256_loadu_pd(x0 + i), v);
+          v = _mm256_fmadd_pd(a1, _mm256_loadu_pd(x1 + i), v);
+          v = _mm256_fmadd_pd(a2, _mm256_loadu_pd(x2 + i), v);
+          v = _mm256_fmadd_pd(a3, _mm256_loadu_pd(x3 + i), v);
+          _mm256_storeu_pd(y + i, v);
+        }
+        for (; i < n; ++i)
+          y[i] = fma4(a, x0[i], x1[i], x2[i], x3[i], y[i]);
+      }
+
+      __attribute__((target("avx2,fma"))) static double
+      dotAVX2(size_t n, const double* x, const double* y)
+      {
+        __m256d s0 = _mm256_setzero_pd();
+        __m256d s1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+          s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+          s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+        }
+        for (; i + 4 <= n; i += 4)
+          s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(s0, s1));
+        double s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for (; i < n; ++i)
+          s += x[i] * y[i];
+        return s;
+      }
+
+      static const Primitives c_avx2 = {"avx2", axpyAVX2, axpy4AVX2, dotAVX2};
+#endif
+
+#if defined(DUNE_CPU_HAS_NEON)
+      static void
+      axpyNEON(size_t n, double a, const double* x, double* y)
+      {
+        float64x2_t va = vdupq_n_f64(a);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+          vst1q_f64(y + i, vfmaq_f64(vld1q_f64(y + i), va, vld1q_f64(x + i)));
+        for (; i < n; ++i)
+          y[i] = __builtin_fma(a, x[i], y[i]);
+      }
+
+      static void
+      axpy4NEON(size_t n, const double* a, const double* x0, const double* x1,
+                const double* x2, const double* x3, double* y)
+      {
+        float64x2_t a0 = vdupq_n_f64(a[0]);
+        float64x2_t a1 = vdupq_n_f64(a[1]);
+        float64x2_t a2 = vdupq_n_f64(a[2]);
+        float64x2_t a3 = vdupq_n_f64(a[3]);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+          float64x2_t v = vld1q_f64(y + i);
+          v = vfmaq_f64(v, a0, vld1q_f64(x0 + i));
+          v = vfmaq_f64(v, a1, vld1q_f64(x1 + i));
+          v = vfmaq_f64(v, a2, vld1q_f64(x2 + i));
+          v = vfmaq_f64(v, a3, vld1q_f64(x3 + i));
+          vst1q_f64(y + i, v);
+        }
+        for (; i < n; ++i)
+          y[i] = fma4(a, x0[i], x1[i], x2[i], x3[i], y[i]);
+      }
+
+      static double
+      dotNEON(size_t n, const double* x, const double* y)
+      {
+        float64x2_t s0 = vdupq_n_f64(0.0);
+        float64x2_t s1 = vdupq_n_f64(0.0);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          s0 = vfmaq_f64(s0, vld1q_f64(x + i), vld1q_f64(y + i));
+          s1 = vfmaq_f64(s1, vld1q_f64(x + i + 2), vld1q_f64(y + i + 2));
+        }
+        double s = vaddvq_f64(vaddq_f64(s0, s1));
+        for (; i < n; ++i)
+          s += x[i] * y[i];
+        return s;
+      }
+
+      static const Primitives c_neon = {"neon", axpyNEON, axpy4NEON, dotNEON};
+#endif
+
+      //! Pick the best implementation supported by the running CPU.
+      static const Primitives*
+      detect(void)
+      {
+#if defined(DUNE_CPU_HAS_AVX2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+          return &c_avx2;
+#endif
+
+#if defined(DUNE_CPU_HAS_NEON)
+        return &c_neon;
+#endif
+
+        return &c_generic;
+      }
+
+      //! Selected implementation, set once during static
+      //! initialization (and by setImplementation()).
+      static const Primitives* s_primitives = detect();
+
+      static inline const Primitives&
+      primitives(void)
+      {
+        // Kernels called from other static initializers may run
+        // before s_primitives is set.
+        if (s_primitives == NULL)
+          return *detect();
+        return *s_primitives;
+      }
+
+      const char*
+      getImplementation(void)
+      {
+        return primitives().name;
+      }
+
+      bool
+      setImplementation(const char* name)
+      {
+        const Primitives* candidates[] = {detect(), &c_generic};
+        for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); ++i)
+        {
+          if (std::strcmp(candidates[i]->name, name) == 0)
+          {
+            s_primitives = candidates[i];
+            return true;
+          }
+        }
+
+        return false;
+      }
+
+      void
+      multiply(const double* a, const double* b, double* c, size_t n, size_t m, size_t r)
+      {
+        std::memset(c, 0, n * r * sizeof(double));
+
+        // Tiny products: vector primitives would not pay off.
+        if (r < 4)
+        {
+          for (size_t i = 0; i < n; ++i)
+            for (size_t k = 0; k < m; ++k)
+              for (size_t j = 0; j < r; ++j)
+                c[i * r + j] += a[i * m + k] * b[k * r + j];
+          return;
+        }
+
+        const Primitives& ops = primitives();
+
+        for (size_t kb = 0; kb < m; kb += c_block_inner)
+        {
+          size_t ke = std::min(m, kb + c_block_inner);
+
+          for (size_t jb = 0; jb < r; jb += c_block_cols)
+          {
+            size_t jn = std::min(r, jb + c_block_cols) - jb;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+              const double* arow = a + i * m;
+              double* crow = c + i * r + jb;
+              size_t k = kb;
+
+              for (; k + 4 <= ke; k += 4)
+              {
+                const double* brow = b + k * r + jb;
+                ops.axpy4(jn, arow + k, brow, brow + r, brow + 2 * r, brow + 3 * r, crow);
+              }
+
+              for (; k < ke; ++k)
+                ops.axpy(jn, arow[k], b + k * r + jb, crow);
+            }
+          }
+        }
+      }
+
+      void
+      multiplyTransposed(const double* a, const double* b, double* c, size_t n, size_t m, size_t r)
+      {
+        const Primitives& ops = primitives();
+
+        // Rows of b are reused for every row of a: walk them in blocks
+        // that fit in cache.
+        size_t block = std::max((size_t)1, (c_block_inner * c_block_cols) / std::max((size_t)1, m));
+
+        for (size_t jb = 0; jb < r; jb += block)
+        {
+          size_t je = std::min(r, jb + block);
+
+          for (size_t i = 0; i < n; ++i)
+            for (size_t j = jb; j < je; ++j)
+              c[i * r + j] = ops.dot(m, a + i * m, b + j * m);
+        }
+      }
+
+      void
+      multiplyAPAT(const double* a, const double* p, double* c, double* work, size_t n, size_t m)
+      {
+        const Primitives& ops = primitives();
+
+        multiply(a, p, work, n, m, m);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          for (size_t j = i; j < n; ++j)
+          {
+            double s = ops.dot(m, work + i * m, a + j * m);
+            c[i * n + j] = s;
+            c[j * n + i] = s;
+          }
+        }
+      }
+
+      void
+      transpose(const double* a, double* t, size_t n, size_t m)
+      {
+        for (size_t ib = 0; ib < n; ib += c_block_tile)
+        {
+          size_t ie = std::min(n, ib + c_block_tile);
+
+          for (size_t jb = 0; jb < m; jb += c_block_tile)
+          {
+            size_t je = std::min(m, jb + c_block_tile);
+
+            for (size_t i = ib; i < ie; ++i)
+              for (size_t j = jb; j < je; ++j)
+                t[j * n + i] = a[i * m + j];
+          }
+        }
+      }
+
+      bool
+      cholesky(double* a, size_t n)
+      {
+        const Primitives& ops = primitives();
+
+        for (size_t j = 0; j < n; ++j)
+        {
+          double* rj = a + j * n;
+          double d = rj[j] - ops.dot(j, rj, rj);
+
+          if (!(d > 0.0))
+            return false;
+
+          d = std::sqrt(d);
+          rj[j] = d;
+
+          for (size_t i = j + 1; i < n; ++i)
+          {
+            double* ri = a + i * n;
+            ri[j] = (ri[j] - ops.dot(j, ri, rj)) / d;
+          }
+
+          for (size_t k = j + 1; k < n; ++k)
+            rj[k] = 0.0;
+        }
+
+        return true;
+      }
+
+      void
+      choleskySolve(const double* l, double* b, size_t n, size_t m)
+      {
+        const Primitives& ops = primitives();
+
+        // Forward substitution: l * y = b.
+        for (size_t i = 0; i < n; ++i)
+        {
+          double* bi = b + i * m;
+          for (size_t k = 0; k < i; ++k)
+            ops.axpy(m, -l[i * n + k], b + k * m, bi);
+
+          double d = 1.0 / l[i * n + i];
+          for (size_t j = 0; j < m; ++j)
+            bi[j] *= d;
+        }
+
+        // Back substitution: l^T * x = y.
+        for (size_t i = n; i-- > 0; )
+        {
+          double* bi = b + i * m;
+          for (size_t k = i + 1; k < n; ++k)
+            ops.axpy(m, -l[k * n + i], b + k * m, bi);
+
+          double d = 1.0 / l[i * n + i];
+          for (size_t j = 0; j < m; ++j)
+            bi[j] *= d;
+        }
+      }
+
+      bool
+      lu(double* a, size_t* piv, size_t n, double tolerance)
+      {
+        const Primitives& ops = primitives();
+
+        for (size_t k = 0; k < n; ++k)
+        {
+          size_t p = k;
+          for (size_t i = k + 1; i < n; ++i)
+          {
+            if (std::fabs(a[i * n + k]) > std::fabs(a[p * n + k]))
+              p = i;
+          }
+
+          piv[k] = p;
+
+          if (std::fabs(a[p * n + k]) < tolerance)
+            return false;
+
+          if (p != k)
+            std::swap_ranges(a + k * n, a + (k + 1) * n, a + p * n);
+
+          double* rk = a + k * n;
+          double d = 1.0 / rk[k];
+
+          for (size_t i = k + 1; i < n; ++i)
+          {
+            double* ri = a + i * n;
+            ri[k] *= d;
+            ops.axpy(n - k - 1, -ri[k], rk + k + 1, ri + k + 1);
+          }
+        }
+
+        return true;
+      }
+
+      void
+      axpy(double a, const double* x, double* y, size_t n)
+      {
+        primitives().axpy(n, a, x, y);
+      }
+
+      void
+      axpy4(const double* a, const double* x0, const double* x1, const double* x2,
+            const double* x3, double* y, size_t n)
+      {
+        primitives().axpy4(n, a, x0, x1, x2, x3, y);
+      }
+
+      void
+      luSolve(const double* lu, const size_t* piv, double* b, size_t n, size_t m)
+      {
+        const Primitives& ops = primitives();
+
+        // Apply row permutation.
+        for (size_t k = 0; k < n; ++k)
+        {
+          if (piv[k] != k)
+            std::swap_ranges(b + k * m, b + (k + 1) * m, b + piv[k] * m);
+        }
+
+        // Forward substitution with unit lower triangle.
+        for (size_t i = 0; i < n; ++i)
+          for (size_t k = 0; k < i; ++k)
+            ops.axpy(m, -lu[i * n + k], b + k * m, b + i * m);
+
+        // Back substitution with upper triangle.
+        for (size_t i = n; i-- > 0; )
+        {
+          double* bi = b + i * m;
+          for (size_t k = i + 1; k < n; ++k)
+            ops.axpy(m, -lu[i * n + k], b + k * m, bi);
+
+          double d = 1.0 / lu[i * n + i];
+          for (size_t j = 0; j < m; ++j)
+            bi[j] *= d;
+        }
+      }
+    }
+  }
+}
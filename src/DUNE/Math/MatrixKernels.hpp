@@ -0,0 +1,171 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_MATRIX_KERNELS_HPP_INCLUDED_
+#define DUNE_MATH_MATRIX_KERNELS_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Dense linear algebra kernels operating on row major arrays of
+    //! doubles. They back Math::Matrix and can be used directly by
+    //! code that manages its own storage.
+    //!
+    //! Products are cache blocked and their inner loops run on
+    //! vector units: AVX2/FMA on x86 processors that support it
+    //! (detected at runtime), NEON on 64-bit ARM and portable scalar
+    //! code elsewhere. Unless otherwise stated outputs must not alias
+    //! inputs.
+    //!
+    //! The vector implementations use fused multiply-add and a
+    //! different summation order, so their results may differ from
+    //! the generic ones in the last bits. Code that must produce the
+    //! same results on every CPU (e.g., deterministic runs) should
+    //! select the generic implementation.
+    namespace Kernels
+    {
+      //! Get the name of the implementation in use.
+      //! @return implementation name ("generic", "avx2" or "neon").
+      DUNE_DLL_SYM const char*
+      getImplementation(void);
+
+      //! Select an implementation by name. Intended for benchmarking
+      //! and testing, must not be called while kernels are running.
+      //! @param[in] name implementation name.
+      //! @return true if the implementation is available on this
+      //! CPU, false otherwise.
+      DUNE_DLL_SYM bool
+      setImplementation(const char* name);
+
+      //! Compute c = a * b.
+      //! @param[in] a n x m matrix.
+      //! @param[in] b m x r matrix.
+      //! @param[out] c n x r matrix.
+      //! @param[in] n number of rows of a.
+      //! @param[in] m number of columns of a.
+      //! @param[in] r number of columns of b.
+      DUNE_DLL_SYM void
+      multiply(const double* a, const double* b, double* c, size_t n, size_t m, size_t r);
+
+      //! Compute c = a * b^T.
+      //! @param[in] a n x m matrix.
+      //! @param[in] b r x m matrix.
+      //! @param[out] c n x r matrix.
+      //! @param[in] n number of rows of a.
+      //! @param[in] m number of columns of a and b.
+      //! @param[in] r number of rows of b.
+      DUNE_DLL_SYM void
+      multiplyTransposed(const double* a, const double* b, double* c, size_t n, size_t m, size_t r);
+
+      //! Compute c = a * p * a^T for a symmetric p. Only the upper
+      //! triangle is computed, the lower one is mirrored.
+      //! @param[in] a n x m matrix.
+      //! @param[in] p m x m symmetric matrix.
+      //! @param[out] c n x n matrix.
+      //! @param[out] work n x m scratch area.
+      //! @param[in] n number of rows of a.
+      //! @param[in] m number of columns of a.
+      DUNE_DLL_SYM void
+      multiplyAPAT(const double* a, const double* p, double* c, double* work, size_t n, size_t m);
+
+      //! Compute y += a * x. Elements are computed independently and
+      //! alike, so results do not depend on their position in the
+      //! arrays.
+      //! @param[in] a scale factor.
+      //! @param[in] x vector of n elements.
+      //! @param[in,out] y vector of n elements.
+      //! @param[in] n number of elements.
+      DUNE_DLL_SYM void
+      axpy(double a, const double* x, double* y, size_t n);
+
+      //! Compute y += a[0] * x0 + a[1] * x1 + a[2] * x2 + a[3] * x3,
+      //! element by element like axpy().
+      //! @param[in] a four scale factors.
+      //! @param[in] x0 vector of n elements.
+      //! @param[in] x1 vector of n elements.
+      //! @param[in] x2 vector of n elements.
+      //! @param[in] x3 vector of n elements.
+      //! @param[in,out] y vector of n elements.
+      //! @param[in] n number of elements.
+      DUNE_DLL_SYM void
+      axpy4(const double* a, const double* x0, const double* x1, const double* x2,
+            const double* x3, double* y, size_t n);
+
+      //! Compute t = a^T.
+      //! @param[in] a n x m matrix.
+      //! @param[out] t m x n matrix.
+      //! @param[in] n number of rows of a.
+      //! @param[in] m number of columns of a.
+      DUNE_DLL_SYM void
+      transpose(const double* a, double* t, size_t n, size_t m);
+
+      //! Cholesky factorization a = l * l^T, in place. The lower
+      //! triangle of a is replaced by l and the upper one is zeroed.
+      //! @param[in,out] a n x n symmetric matrix.
+      //! @param[in] n matrix order.
+      //! @return true on success, false if a is not positive definite.
+      DUNE_DLL_SYM bool
+      cholesky(double* a, size_t n);
+
+      //! Solve l * l^T * x = b in place using a Cholesky factor.
+      //! @param[in] l n x n lower triangular factor.
+      //! @param[in,out] b n x m right hand side, replaced by x.
+      //! @param[in] n order of l.
+      //! @param[in] m number of columns of b.
+      DUNE_DLL_SYM void
+      choleskySolve(const double* l, double* b, size_t n, size_t m);
+
+      //! LU factorization with partial pivoting (p * a = l * u), in
+      //! place. Unit diagonal of l is implicit.
+      //! @param[in,out] a n x n matrix, replaced by l and u.
+      //! @param[out] piv row permutation (n entries).
+      //! @param[in] n matrix order.
+      //! @param[in] tolerance smallest acceptable pivot magnitude.
+      //! @return true on success, false if a is singular.
+      DUNE_DLL_SYM bool
+      lu(double* a, size_t* piv, size_t n, double tolerance);
+
+      //! Solve a * x = b in place using an LU factorization.
+      //! @param[in] lu factorization computed by lu().
+      //! @param[in] piv row permutation computed by lu().
+      //! @param[in,out] b n x m right hand side, replaced by x.
+      //! @param[in] n order of a.
+      //! @param[in] m number of columns of b.
+      DUNE_DLL_SYM void
+      luSolve(const double* lu, const size_t* piv, double* b, size_t n, size_t m);
+    }
+  }
+}
+
+#endif
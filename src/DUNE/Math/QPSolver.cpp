@@ -41,9 +41,11 @@
 // --------------------------------------------------------------------------
 
 #include "QPSolver.hpp"
+#include "MatrixKernels.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <sstream>
 #include <stdexcept>
@@ -53,30 +55,6 @@ namespace DUNE
 {
   namespace Math
   {
-    // Template class just to encapsulate operator() in access to a std::vector
-    // (for pedantic syntactic sugar in consistencty with DUNE::Math::Matrix
-    //  and DUNE::Math::Matrix)
-    template <typename T>
-    class tvector: public std::vector<T>
-    {
-    public:
-      tvector(size_t n):
-        std::vector<T>(n)
-      { }
-
-      inline T&
-      operator()(size_t index)
-      {
-        return std::vector<T>::operator[](index);
-      }
-
-      inline const T&
-      operator()(size_t index) const
-      {
-        return std::vector<T>::operator[](index);
-      }
-    };
-
     // Utility functions
     static void
     compute_d(Matrix& d, const Matrix& J, const Matrix& np);
@@ -91,23 +69,22 @@ namespace DUNE
     add_constraint(Matrix& R, Matrix& J, Matrix& d, int& iq, double& rnorm);
 
     static void
-    delete_constraint(Matrix& R, Matrix& J, tvector<int>& A, Matrix& u, int n, int p, int& iq, int l);
-
-    static void
-    cholesky_decomposition(Matrix& A);
-
-    static void
-    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b);
+    delete_constraint(Matrix& R, Matrix& J, std::vector<int>& A, Matrix& u, int n, int p, int& iq, int l);
 
     static void
     forward_elimination(const Matrix& L, Matrix& y, const Matrix& b);
 
-    static void
-    backward_elimination(const Matrix& U, Matrix& x, const Matrix& y);
-
     static double
     distance(double a, double b);
 
+    // Resize a workspace matrix only if its dimensions differ.
+    static inline void
+    ensure(Matrix& m, int r, int c)
+    {
+      if (m.rows() != r || m.columns() != c)
+        m.resize(r, c);
+    }
+
 #ifdef __QPDBG__
     // Utility functions for printing vectors and matrices
     static void
@@ -115,7 +92,7 @@ namespace DUNE
 
     template <typename T>
     static void
-    print_vector(const char* name, const tvector<T>& v, int n = -1);
+    print_vector(const char* name, const std::vector<T>& v, int n = -1);
 
     static void
     print_vector(const char* name, const Matrix& v, int n = -1)
@@ -125,6 +102,65 @@ namespace DUNE
 
 #endif
 
+    QPSolver::QPSolver(void):
+      m_cond(0.0),
+      m_warm(true),
+      m_active_m(0)
+    { }
+
+    void
+    QPSolver::setHessian(const Matrix& H)
+    {
+      if (!H.isSquare())
+        throw Error("'H' is not a square matrix");
+
+      int i, j, n = H.columns();
+
+      /* compute the trace of the original matrix G */
+      double c1 = 0.0;
+      for (i = 0; i < n; i++)
+        c1 += H(i, i);
+
+      /* decompose the matrix H in the form L L^T */
+      try
+      {
+        m_l = cholesky(H);
+      }
+      catch (Matrix::Error&)
+      {
+        throw Error("error in Cholesky decomposition");
+      }
+
+      /* compute the inverse of the factorized matrix G^-1, this is the initial value for H */
+      Matrix d(n, 1, 0.0);
+      Matrix z(n, 1);
+      ensure(m_j0, n, n);
+      double c2 = 0.0;
+      for (i = 0; i < n; i++)
+      {
+        d(i) = 1.0;
+        forward_elimination(m_l, z, d);
+        for (j = 0; j < n; j++)
+          m_j0(i, j) = z(j);
+        c2 += z(i);
+        d(i) = 0.0;
+      }
+#ifdef __QPDBG__
+      print_matrix("J", m_j0);
+#endif
+
+      /* c1 * c2 is an estimate for cond(H0) */
+      m_cond = c1 * c2;
+      m_active.clear();
+
+      ensure(m_R, n, n);
+      ensure(m_J, n, n);
+      ensure(m_z, n, 1);
+      ensure(m_d, n, 1);
+      ensure(m_np, n, 1);
+      ensure(m_x_old, n, 1);
+    }
+
     double
     QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
     {
@@ -136,17 +172,37 @@ namespace DUNE
 
     double
     QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
+    {
+      QPSolver qp;
+      qp.setHessian(H);
+      return qp.solve(f, Aeq, beq, A, b, x);
+    }
+
+    double
+    QPSolver::solve(const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
+    {
+      // Zero-size matrix and vector
+      Matrix Aeq;
+      Matrix beq;
+      return solve(f, Aeq, beq, A, b, x);
+    }
+
+    double
+    QPSolver::solve(const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
     {
       // Validate parameter dimensions
       // n: number of vars
       // p: number of equality constraints
       // m: number of inequality constraints
-      int n = H.columns();
+      int n = m_l.columns();
       int p = Aeq.rows();
       int m = A.rows();
 
-      if (!H.isSquare())
-        throw Error("'H' is not a square matrix");
+      if (m_l.size() == 0)
+        throw Error("'H' is not defined");
+
+      if (!f.isColumnVector(n))
+        throw Error("'f' has an invalid size");
 
       if (A.columns() != n)
         throw Error("'A' has an invalid number of rows");
@@ -162,28 +218,68 @@ namespace DUNE
           throw Error("'beq' has an invalid size");
       }
 
-      // Resize output vector
-      x.resize(n, 1);
+      // Previous active set only applies to the same constraints.
+      if (m != m_active_m)
+        m_active.clear();
 
-      // Working variables
+      try
+      {
+        double f_value = run(f, Aeq, beq, A, b, x, m_warm && !m_active.empty());
+        m_active_m = m;
+        return f_value;
+      }
+      catch (...)
+      {
+        m_active.clear();
+        throw;
+      }
+    }
+
+    double
+    QPSolver::run(const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x, bool warm)
+    {
+      int n = m_l.columns();
+      int p = Aeq.rows();
+      int m = A.rows();
+      int mp = std::max(m + p, 1);
+
+      // Working variables (kept between calls).
       int i, j, k, l, ip;
-      Matrix R(n, n), J(n, n);
-      Matrix s(m + p, 1), z(n, 1), r(m + p, 1), d(n, 1), np(n, 1), u(m + p, 1), x_old(n, 1), u_old(m + p, 1);
-      double f_value, psi, c1, c2, sum, ss, R_norm;
+      Matrix& R = m_R;
+      Matrix& J = m_J;
+      Matrix& z = m_z;
+      Matrix& d = m_d;
+      Matrix& np = m_np;
+      Matrix& x_old = m_x_old;
+      ensure(m_s, mp, 1);
+      ensure(m_r, mp, 1);
+      ensure(m_u, mp, 1);
+      ensure(m_u_old, mp, 1);
+      Matrix& s = m_s;
+      Matrix& r = m_r;
+      Matrix& u = m_u;
+      Matrix& u_old = m_u_old;
+      double f_value, psi, sum, ss, R_norm;
       double inf = std::numeric_limits<double>::has_infinity ?
                    std::numeric_limits<double>::infinity() : 1.0E300;
 
       double t, t1, t2; /* t is the step lenght, which is the minimum of the partial step length t1
       * and the full step length t2 */
 
-      tvector<int> Aset(m + p), Aset_old(m + p), iai(m + p);
+      m_aset.resize(mp);
+      m_aset_old.resize(mp);
+      m_iai.resize(mp);
+      m_iaexcl.resize(mp);
+      std::vector<int>& Aset = m_aset;
+      std::vector<int>& Aset_old = m_aset_old;
+      std::vector<int>& iai = m_iai;
+      std::vector<uint8_t>& iaexcl = m_iaexcl;
       int iq;
       int iter = 0;
-      tvector<uint8_t> iaexcl(m + p);
 
 #ifdef __QPDBG__
       std::cout << std::endl << "Starting solve_quadprog" << std::endl;
-      print_matrix("H", H);
+      print_matrix("L", m_l);
       print_vector("f", f);
       print_matrix("Aeq", Aeq);
       print_vector("beq", beq);
@@ -192,49 +288,25 @@ namespace DUNE
 #endif
 
       /*
-       * Preprocessing phase
+       * Preprocessing phase (factorization done by setHessian)
        */
 
-      /* compute the trace of the original matrix G */
-      Matrix H0(H);
-      c1 = 0.0;
-      for (i = 0; i < n; i++)
-        c1 += H0(i, i);
-
-      /* decompose the matrix H0 in the form L^T L */
-      cholesky_decomposition(H0);
-#ifdef __QPDBG__
-      print_matrix("H0", H0);
-#endif
-      /* initialize the matrix R */
+      /* initialize the matrices R and J */
       d.fill(0);
       R.fill(0);
+      std::memcpy(J.data(), static_cast<const Matrix&>(m_j0).data(), n * n * sizeof(double));
       R_norm = 1.0; /* this variable will hold the norm of the matrix R */
-      /* compute the inverse of the factorized matrix G^-1, this is the initial value for H */
-      c2 = 0.0;
-      for (i = 0; i < n; i++)
-      {
-        d(i) = 1.0;
-        forward_elimination(H0, z, d);
-        for (j = 0; j < n; j++)
-          J(i, j) = z(j);
-        c2 += z(i);
-        d(i) = 0.0;
-      }
-#ifdef __QPDBG__
-      print_matrix("J", J);
-#endif
-
-      /* c1 * c2 is an estimate for cond(H0) */
 
       /*
         * Find the unconstrained minimizer of the quadratic form 0.5 * x G x + f x
        * this is a feasible point in the dual space
        * x = G^-1 * f
        */
-      cholesky_solve(H0, x, f);
+      ensure(x, n, 1);
+      double* xv = x.data();
       for (i = 0; i < n; i++)
-        x(i) = -x(i);
+        xv[i] = -f(i);
+      Kernels::choleskySolve(static_cast<const Matrix&>(m_l).data(), xv, n, 1);
       /* and compute the current solution value */
       f_value = 0.5 * Matrix::dot(f, x);
 #ifdef __QPDBG__
@@ -275,16 +347,57 @@ namespace DUNE
 
         /* compute the new solution value */
         f_value += 0.5 * (t2 * t2) * Matrix::dot(z, np);
-        Aset(i) = -i - 1;
+        Aset[i] = -i - 1;
 
         if (!add_constraint(R, J, d, iq, R_norm))
           // Equality constraints are linearly dependent
           throw Error("Constraints are linearly dependent");
       }
 
+      /* Warm start: make the previously active inequality constraints
+         active again, in the same way as equality constraints */
+      if (warm)
+      {
+        for (size_t w = 0; w < m_active.size(); w++)
+        {
+          ip = m_active[w];
+          for (j = 0; j < n; j++)
+            np(j) = A(ip, j);
+          compute_d(d, J, np);
+          update_z(z, J, d, iq);
+          update_r(R, r, d, iq);
+
+          if (std::fabs(Matrix::dot(z, z)) <= std::numeric_limits<double>::epsilon())
+            return run(f, Aeq, beq, A, b, x, false);
+
+          t2 = (-Matrix::dot(np, x) - b(ip)) / Matrix::dot(z, np);
+
+          for (k = 0; k < n; k++)
+            x(k) += t2 * z(k);
+
+          u(iq) = t2;
+          for (k = 0; k < iq; k++)
+            u(k) -= t2 * r(k);
+
+          f_value += 0.5 * (t2 * t2) * Matrix::dot(z, np);
+          Aset[iq] = ip;
+
+          if (!add_constraint(R, J, d, iq, R_norm))
+            return run(f, Aeq, beq, A, b, x, false);
+        }
+
+        /* the multipliers of the inequality constraints must be
+           non-negative (dual feasibility), otherwise start over */
+        for (k = p; k < iq; k++)
+        {
+          if (u(k) < 0.0)
+            return run(f, Aeq, beq, A, b, x, false);
+        }
+      }
+
       /* set iai = K \ A */
       for (i = 0; i < m; i++)
-        iai(i) = i;
+        iai[i] = i;
 
 l1:  iter++;
     #ifdef __QPDBG__
@@ -293,8 +406,8 @@ l1:  iter++;
       /* step 1: choose a violated constraint */
       for (i = p; i < iq; i++)
       {
-        ip = Aset(i);
-        iai(ip) = -1;
+        ip = Aset[i];
+        iai[ip] = -1;
       }
 
       /* compute s(x) = A^T * x + b for all elements of K \ A */
@@ -303,7 +416,7 @@ l1:  iter++;
       ip = 0; /* ip will be the index of the chosen violated constraint */
       for (i = 0; i < m; i++)
       {
-        iaexcl(i) = true;
+        iaexcl[i] = true;
         sum = 0.0;
         for (j = 0; j < n; j++)
           sum += A(i, j) * x(j);
@@ -315,9 +428,10 @@ l1:  iter++;
       print_vector("s", s, m);
     #endif
 
-      if (std::fabs(psi) <= m * std::numeric_limits<double>::epsilon() * c1 * c2 * 100.0)
+      if (std::fabs(psi) <= m * std::numeric_limits<double>::epsilon() * m_cond * 100.0)
       {
         /* numerically there are not infeasibilities anymore */
+        m_active.assign(Aset.begin() + p, Aset.begin() + iq);
         return f_value;
       }
 
@@ -325,15 +439,15 @@ l1:  iter++;
       for (i = 0; i < iq; i++)
       {
         u_old(i) = u(i);
-        Aset_old(i) = Aset(i);
+        Aset_old[i] = Aset[i];
       }
       /* and for x */
-      x_old = x;
+      std::memcpy(x_old.data(), x.data(), n * sizeof(double));
 
 l2:     /* Step 2: check for feasibility and determine a new S-pair */
       for (i = 0; i < m; i++)
       {
-        if (s(i) < ss && iai(i) != -1 && iaexcl(i))
+        if (s(i) < ss && iai[i] != -1 && iaexcl[i])
         {
           ss = s(i);
           ip = i;
@@ -341,6 +455,7 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
       }
       if (ss >= 0.0)
       {
+        m_active.assign(Aset.begin() + p, Aset.begin() + iq);
         return f_value;
       }
 
@@ -350,7 +465,7 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
       /* set u = (u 0)^T */
       u(iq) = 0.0;
       /* add ip to the active set A */
-      Aset(iq) = ip;
+      Aset[iq] = ip;
 
     #ifdef __QPDBG__
       std::cout << "Trying with constraint " << ip << std::endl;
@@ -381,7 +496,7 @@ l2a:    /* Step 2a: determine step direction */
           if (u(k) / r(k) < t1)
           {
             t1 = u(k) / r(k);
-            l = Aset(k);
+            l = Aset[k];
           }
         }
       }
@@ -414,7 +529,7 @@ l2a:    /* Step 2a: determine step direction */
         for (k = 0; k < iq; k++)
           u(k) -= t * r(k);
         u(iq) += t;
-        iai(l) = l;
+        iai[l] = l;
         delete_constraint(R, J, Aset, u, n, p, iq, l);
     #ifdef __QPDBG__
         std::cout << " in dual space: "
@@ -457,7 +572,7 @@ l2a:    /* Step 2a: determine step direction */
         if (!add_constraint(R, J, d, iq, R_norm))
         {
           std::cout << "not iaexcl " << ip << std::endl;
-          iaexcl(ip) = false;
+          iaexcl[ip] = false;
           delete_constraint(R, J, Aset, u, n, p, iq, ip);
     #ifdef __QPDBG__
           print_matrix("R", R);
@@ -465,18 +580,18 @@ l2a:    /* Step 2a: determine step direction */
           print_vector("iai", iai);
     #endif
           for (i = 0; i < m; i++)
-            iai(i) = i;
+            iai[i] = i;
           for (i = p; i < iq; i++)
           {
-            Aset(i) = Aset_old(i);
+            Aset[i] = Aset_old[i];
             u(i) = u_old(i);
-            iai(Aset(i)) = -1;
+            iai[Aset[i]] = -1;
           }
-          x = x_old;
+          std::memcpy(x.data(), x_old.data(), n * sizeof(double));
           goto l2; /* go to step 2 */
         }
         else
-          iai(ip) = -1;
+          iai[ip] = -1;
     #ifdef __QPDBG__
         print_matrix("R", R);
         print_vector("Aset", Aset, iq);
@@ -491,7 +606,7 @@ l2a:    /* Step 2a: determine step direction */
       print_vector("x", x);
     #endif
       /* drop constraint l */
-      iai(l) = l;
+      iai[l] = l;
       delete_constraint(R, J, Aset, u, n, p, iq, l);
     #ifdef __QPDBG__
       print_matrix("R", R);
@@ -629,7 +744,7 @@ l2a:    /* Step 2a: determine step direction */
     }
 
     static void
-    delete_constraint(Matrix& R, Matrix& J, tvector<int>& Aset, Matrix& u, int n, int p, int& iq, int l)
+    delete_constraint(Matrix& R, Matrix& J, std::vector<int>& Aset, Matrix& u, int n, int p, int& iq, int l)
     {
     #ifdef __QPDBG__
       std::cout << "Delete constraint " << l << ' ' << iq;
@@ -639,7 +754,7 @@ l2a:    /* Step 2a: determine step direction */
 
       /* Find the index qq for active constraint l to be removed */
       for (i = p; i < iq; i++)
-        if (Aset(i) == l)
+        if (Aset[i] == l)
         {
           qq = i;
           break;
@@ -648,15 +763,15 @@ l2a:    /* Step 2a: determine step direction */
       /* remove the constraint from the active set and the duals */
       for (i = qq; i < iq - 1; i++)
       {
-        Aset(i) = Aset(i + 1);
+        Aset[i] = Aset[i + 1];
         u(i) = u(i + 1);
         for (j = 0; j < n; j++)
           R(j, i) = R(j, i + 1);
       }
 
-      Aset(iq - 1) = Aset(iq);
+      Aset[iq - 1] = Aset[iq];
       u(iq - 1) = u(iq);
-      Aset(iq) = 0;
+      Aset[iq] = 0;
       u(iq) = 0.0;
       for (j = 0; j < iq; j++)
         R(j, iq - 1) = 0.0;
@@ -725,46 +840,6 @@ l2a:    /* Step 2a: determine step direction */
       return a1 * ::std::sqrt(2.0);
     }
 
-    static void
-    cholesky_decomposition(Matrix& A)
-    {
-      int i, j, k, n = A.rows();
-      double sum;
-
-      for (i = 0; i < n; i++)
-      {
-        for (j = i; j < n; j++)
-        {
-          sum = A(j, i);
-          for (k = i - 1; k >= 0; k--)
-            sum -= A(k, i) * A(k, j);
-          if (i == j)
-          {
-            if (sum <= 0.0)
-              throw QPSolver::Error("error in Cholesky decomposition");
-            A(i, i) = ::std::sqrt(sum);
-          }
-          else
-          {
-            A(i, j) = sum / A(i, i);
-          }
-        }
-        for (k = i + 1; k < n; k++)
-          A(k, i) = A(i, k);
-      }
-    }
-
-    static void
-    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b)
-    {
-      Matrix y(L.rows(), 1);
-
-      /* Solve L * y = b */
-      forward_elimination(L, y, b);
-      /* Solve L^T * x = y */
-      backward_elimination(L, x, y);
-    }
-
     static void
     forward_elimination(const Matrix& L, Matrix& y, const Matrix& b)
     {
@@ -780,21 +855,6 @@ l2a:    /* Step 2a: determine step direction */
       }
     }
 
-    static void
-    backward_elimination(const Matrix& U, Matrix& x, const Matrix& y)
-    {
-      int i, j, n = U.rows();
-
-      x(n - 1) = y(n - 1) / U(n - 1, n - 1);
-      for (i = n - 2; i >= 0; i--)
-      {
-        x(i) = y(i);
-        for (j = i + 1; j < n; j++)
-          x(i) -= U(i, j) * x(j);
-        x(i) = x(i) / U(i, i);
-      }
-    }
-
     #ifdef __QPDBG__
     static void
     print_matrix(const char* name, const Matrix& A, int n, int m)
@@ -822,7 +882,7 @@ l2a:    /* Step 2a: determine step direction */
 
     template <typename T>
     static void
-    print_vector(const char* name, const tvector<T>& v, int n)
+    print_vector(const char* name, const std::vector<T>& v, int n)
     {
       std::ostringstream s;
       std::string t;
@@ -832,7 +892,7 @@ l2a:    /* Step 2a: determine step direction */
       s << name << ": " << std::endl << " ";
       for (int i = 0; i < n; i++)
       {
-        s << v(i) << ", ";
+        s << v[i] << ", ";
       }
       t = s.str();
       t = t.substr(0, t.size() - 2); // To remove the trailing space and comma
@@ -28,6 +28,9 @@
 #ifndef DUNE_MATH_QP_SOLVER_HPP_INCLUDED_
 #define DUNE_MATH_QP_SOLVER_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Math/Matrix.hpp>
@@ -52,6 +55,44 @@ namespace DUNE
         { }
       };
 
+      //! Create a solver without an Hessian. The static solve()
+      //! functions below are a shortcut for setHessian() followed by
+      //! solve() on a temporary solver.
+      QPSolver(void);
+
+      //! Set the Hessian of the problems to solve. Its factorization is
+      //! kept between calls to solve() and the active set of the
+      //! previous solution is forgotten.
+      //! @param H symmetric positive definite matrix.
+      void
+      setHessian(const Matrix& H);
+
+      //! Enable or disable warm start, i.e., starting from the
+      //! constraints active at the previous solution (enabled by
+      //! default). The previous active set is discarded whenever it
+      //! is not dual feasible for the new problem.
+      //! @param enable true to enable warm start.
+      inline void
+      setWarmStart(bool enable)
+      {
+        m_warm = enable;
+        m_active.clear();
+      }
+
+      //! Minimize, with the Hessian given to setHessian(),
+      //!   0.5 x' H x + f' x
+      //! subject to:
+      //!   A x <= b
+      double
+      solve(const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x);
+
+      //! Minimize, with the Hessian given to setHessian(),
+      //!   0.5 x' H x + f' x
+      //! subject to:
+      //!   A x <= b  and Aeq x = beq
+      double
+      solve(const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x);
+
       //! Minimize
       //!   0.5 x' H x + f' x
       //! subject to:
@@ -65,6 +106,32 @@ namespace DUNE
       //!   A x <= b  and Aeq x = beq
       static double
       solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x);
+
+    private:
+      //! Cholesky factor of the Hessian.
+      Matrix m_l;
+      //! Initial value of J (inverse of the transposed factor).
+      Matrix m_j0;
+      //! Estimate of the condition number of the Hessian.
+      double m_cond;
+      //! True if warm start is enabled.
+      bool m_warm;
+      //! Inequality constraints active at the previous solution.
+      std::vector<int> m_active;
+      //! Number of inequality constraints of the previous problem.
+      int m_active_m;
+      //! Workspace matrices.
+      Matrix m_R, m_J, m_s, m_z, m_r, m_d, m_np, m_u, m_x_old, m_u_old;
+      //! Workspace index vectors.
+      std::vector<int> m_aset, m_aset_old, m_iai;
+      //! Workspace flags.
+      std::vector<uint8_t> m_iaexcl;
+
+      //! Goldfarb-Idnani dual method.
+      //! @param warm true to start from the previous active set.
+      //! @return optimal value.
+      double
+      run(const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x, bool warm);
     };
   }
 }
@@ -0,0 +1,229 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_TRIGONOMETRY_HPP_INCLUDED_
+#define DUNE_MATH_TRIGONOMETRY_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Constants.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Trigonometry;
+
+    //! Trigonometric kernels for control and simulation loops.
+    //!
+    //! The fast variants evaluate minimax polynomials (Cephes) after a
+    //! Cody-Waite reduction to [-pi/4, pi/4]. For |a| <= c_fast_range
+    //! the absolute error of fastSin/fastCos is below 3e-16. The
+    //! absolute error of fastAtan2 is below 5e-16 rad for finite
+    //! arguments. Other arguments (including infinities and NaN) are
+    //! handed to the standard library.
+    class Trigonometry
+    {
+    public:
+      //! Largest argument magnitude handled by the polynomial path.
+      static const int c_fast_range = 65536;
+
+      //! Compute the sine and cosine of an angle with the standard
+      //! library. Compilers merge both calls into a single evaluation.
+      //! @param[in] a angle in radian.
+      //! @param[out] s sine of a.
+      //! @param[out] c cosine of a.
+      inline static void
+      sincos(fp64_t a, fp64_t& s, fp64_t& c)
+      {
+        s = std::sin(a);
+        c = std::cos(a);
+      }
+
+      //! Compute the sine and cosine of an angle sharing the argument
+      //! reduction.
+      //! @param[in] a angle in radian.
+      //! @param[out] s sine of a.
+      //! @param[out] c cosine of a.
+      inline static void
+      fastSinCos(fp64_t a, fp64_t& s, fp64_t& c)
+      {
+        if (!(std::fabs(a) <= c_fast_range))
+        {
+          sincos(a, s, c);
+          return;
+        }
+
+        // Nearest multiple of pi/2, subtracted in three parts.
+        fp64_t t = a * (2.0 / c_pi);
+        int k = static_cast<int>(t + ((t < 0.0) ? -0.5 : 0.5));
+        fp64_t q = k;
+        fp64_t r = ((a - q * 1.57079625129699707031e+00)
+                    - q * 7.54978941586159635336e-08)
+        - q * 5.39030285815811905290e-15;
+
+        fp64_t ps = 0;
+        fp64_t pc = 0;
+        evaluate(r, ps, pc);
+
+        // Quadrant selection without branches.
+        bool swap = (k & 1) != 0;
+        s = (swap ? pc : ps) * (1 - (k & 2));
+        c = (swap ? ps : pc) * (1 - ((k + 1) & 2));
+      }
+
+      //! Compute the sine of an angle.
+      //! @param[in] a angle in radian.
+      //! @return sine of a.
+      inline static fp64_t
+      fastSin(fp64_t a)
+      {
+        fp64_t s, c;
+        fastSinCos(a, s, c);
+        return s;
+      }
+
+      //! Compute the cosine of an angle.
+      //! @param[in] a angle in radian.
+      //! @return cosine of a.
+      inline static fp64_t
+      fastCos(fp64_t a)
+      {
+        fp64_t s, c;
+        fastSinCos(a, s, c);
+        return c;
+      }
+
+      //! Compute the arc tangent of y/x using the signs of both
+      //! arguments to determine the quadrant. Unlike std::atan2 the
+      //! sign of a zero y is ignored.
+      //! @param[in] y ordinate.
+      //! @param[in] x abscissa.
+      //! @return angle in the interval [-pi, pi].
+      inline static fp64_t
+      fastAtan2(fp64_t y, fp64_t x)
+      {
+        fp64_t ax = std::fabs(x);
+        fp64_t ay = std::fabs(y);
+
+        fp64_t r = ay / ax;
+
+        // Zero or NaN abscissa, NaN ordinate or both infinite.
+        if (!(ax > 0.0) || (r != r))
+          return std::atan2(y, x);
+
+        fp64_t t = atanPositive(r);
+
+        if (x < 0.0)
+          t = c_pi - t;
+
+        return (y < 0.0) ? -t : t;
+      }
+
+      //! Compute the sine and cosine of an array of angles.
+      //! @param[in] a angles in radian.
+      //! @param[in] count number of angles.
+      //! @param[out] s array to store the sines.
+      //! @param[out] c array to store the cosines.
+      inline static void
+      fastSinCos(const fp64_t* a, size_t count, fp64_t* s, fp64_t* c)
+      {
+        for (size_t i = 0; i < count; ++i)
+          fastSinCos(a[i], s[i], c[i]);
+      }
+
+    private:
+      //! Evaluate the sine and cosine polynomials for |r| <= pi/4.
+      inline static void
+      evaluate(fp64_t r, fp64_t& s, fp64_t& c)
+      {
+        fp64_t z = r * r;
+
+        fp64_t ps = 1.58962301576546568060e-10;
+        ps = ps * z - 2.50507477628578072866e-08;
+        ps = ps * z + 2.75573136213857245213e-06;
+        ps = ps * z - 1.98412698295895385996e-04;
+        ps = ps * z + 8.33333333332211858878e-03;
+        ps = ps * z - 1.66666666666666307295e-01;
+        s = r + r * z * ps;
+
+        fp64_t pc = -1.13585365213876817300e-11;
+        pc = pc * z + 2.08757008419747316778e-09;
+        pc = pc * z - 2.75573141792967388112e-07;
+        pc = pc * z + 2.48015872888517045348e-05;
+        pc = pc * z - 1.38888888888730564116e-03;
+        pc = pc * z + 4.16666666666665929218e-02;
+        c = 1.0 - 0.5 * z + z * z * pc;
+      }
+
+      //! Arc tangent of a non-negative value.
+      inline static fp64_t
+      atanPositive(fp64_t x)
+      {
+        fp64_t y = 0.0;
+        fp64_t extra = 0.0;
+
+        // Reduce to |x| <= 0.66.
+        if (x > 2.41421356237309504880)
+        {
+          y = c_half_pi;
+          extra = 6.123233995736765886130e-17;
+          x = -1.0 / x;
+        }
+        else if (x > 0.66)
+        {
+          y = c_quarter_pi;
+          extra = 0.5 * 6.123233995736765886130e-17;
+          x = (x - 1.0) / (x + 1.0);
+        }
+
+        fp64_t z = x * x;
+
+        fp64_t p = -8.750608600031904122785e-01;
+        p = p * z - 1.615753718733365076637e+01;
+        p = p * z - 7.500855792314704667340e+01;
+        p = p * z - 1.228866684490136173410e+02;
+        p = p * z - 6.485021904942025371773e+01;
+
+        fp64_t q = z + 2.485846490142306297962e+01;
+        q = q * z + 1.650270098316988542046e+02;
+        q = q * z + 4.328810604912902668951e+02;
+        q = q * z + 4.853903996359136964868e+02;
+        q = q * z + 1.945506571482613964425e+02;
+
+        return y + ((x * (z * p / q) + x) + extra);
+      }
+    };
+  }
+}
+
+#endif
@@ -47,6 +47,7 @@ namespace DUNE
       Tasks::Periodic(name, ctx),
       m_active(false),
       m_origin(NULL),
+      m_history_steps(0),
       m_avg_heave(NULL),
       m_avg_gps(NULL)
     {
@@ -154,6 +155,17 @@ namespace DUNE
       .minimumValue("2.0")
       .description("LBL Threshold value for the LBL level check rejection scheme");
 
+      param("Delayed Measurements History", m_history_length)
+      .units(Units::Second)
+      .defaultValue("0.0")
+      .minimumValue("0.0")
+      .description("Length of the filter history used to fuse delayed LBL ranges at their measurement time"
+                   " (0 disables fusion at measurement time)");
+
+      param("Delayed Measurements Replay Limit", m_replay_limit)
+      .defaultValue("200")
+      .description("Maximum number of filter steps replayed per cycle to fuse delayed measurements");
+
       param("GPS Maximum HDOP", m_max_hdop)
       .defaultValue("5.0")
       .minimumValue("3.0")
@@ -257,6 +269,18 @@ namespace DUNE
       m_time_without_euler.setTop(m_without_euler_timeout);
       m_dvl_sanity_timer.setTop(m_dvl_sanity_timeout);
 
+      // Filter history for delayed measurements, only cleared when
+      // its length changes.
+      size_t steps = (size_t)(m_history_length * getFrequency());
+      if (steps != m_history_steps)
+      {
+        m_history_steps = steps;
+        m_kal.setHistorySize(steps);
+        m_heading_history.clear();
+      }
+
+      m_kal.setReplayLimit(m_replay_limit);
+
       // Distance DVL to vehicle Center of Gravity is 0 in Simulation.
       if (m_ctx.profiles.isSelected("Simulation"))
       {
@@ -436,6 +460,19 @@ namespace DUNE
       if (m_declination_defined && m_use_declination)
         m_euler_bfr[AXIS_Z] += m_declination;
 
+      if (m_history_steps > 0)
+      {
+        HeadingSample sample;
+        sample.time = msg->getTimeStamp();
+        sample.psi = msg->psi;
+        if (m_declination_defined && m_use_declination)
+          sample.psi += m_declination;
+
+        m_heading_history.push_back(sample);
+        while (m_heading_history.front().time < sample.time - m_history_length)
+          m_heading_history.pop_front();
+      }
+
       m_time_without_euler.reset();
     }
 
@@ -686,6 +723,10 @@ namespace DUNE
         return;
       }
 
+      // Fuse range at the time it was measured.
+      if (runDelayedKalmanLBL((int)beacon, range, msg->getTimeStamp()))
+        return;
+
       double x = 0.0;
       double y = 0.0;
       double z = 0.0;
@@ -895,6 +936,80 @@ namespace DUNE
       }
     }
 
+    bool
+    BasicNavigation::runDelayedKalmanLBL(int beacon, float range, double time)
+    {
+      Math::Matrix x;
+      Math::Matrix p;
+      if (!m_kal.getPastState(time, x, p))
+        return false;
+
+      double psi = 0.0;
+      if (!getPastHeading(time, psi))
+        return false;
+
+      double bx = 0.0;
+      double by = 0.0;
+      double bz = 0.0;
+
+      m_ranging.getLocation(beacon, &bx, &by, &bz);
+
+      // Compute expected range with the state at measurement time.
+      double dx = x(STATE_X) + m_dist_lbl_gps * std::cos(psi) - bx;
+      double dy = x(STATE_Y) + m_dist_lbl_gps * std::sin(psi) - by;
+      double dz = getDepth() - bz;
+      double exp_range = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+      // Same rejection scheme as runKalmanLBL().
+      Math::Matrix H(1, 2, 0.0);
+      H(0, 0) = dx / exp_range;
+      H(0, 1) = dy / exp_range;
+      Math::Matrix P = p.get(STATE_X, STATE_Y, STATE_X, STATE_Y);
+
+      double k = getLblRejectionValue(exp_range);
+      double R = std::max(k, (H * P * transpose(H))(0));
+
+      double d = range - exp_range;
+      m_navdata.lbl_rej_level = (d * (1 / ((H * P * transpose(H))(0) + R)) * d);
+
+      if (m_navdata.lbl_rej_level >= m_lbl_threshold)
+      {
+        m_lbl_ac.acceptance = IMC::LblRangeAcceptance::RR_ABOVE_THRESHOLD;
+        dispatch(m_lbl_ac, DF_KEEP_TIME);
+        return true;
+      }
+
+      Math::Matrix c(1, x.rows(), 0.0);
+      c(0, STATE_X) = H(0, 0);
+      c(0, STATE_Y) = H(0, 1);
+
+      Math::Matrix r(1, 1, m_kal.getMeasurementNoise(getNumberOutputs() + beacon));
+      Math::Matrix innov(1, 1, d);
+
+      if (m_kal.updateDelayed(time, c, r, innov) != 0)
+        return false;
+
+      m_lbl_ac.acceptance = IMC::LblRangeAcceptance::RR_ACCEPTED;
+      dispatch(m_lbl_ac, DF_KEEP_TIME);
+      return true;
+    }
+
+    bool
+    BasicNavigation::getPastHeading(double time, double& psi) const
+    {
+      std::deque<HeadingSample>::const_reverse_iterator itr = m_heading_history.rbegin();
+      for (; itr != m_heading_history.rend(); ++itr)
+      {
+        if (itr->time <= time)
+        {
+          psi = itr->psi;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
     void
     BasicNavigation::runKalmanDVL(void)
     {
@@ -30,6 +30,7 @@
 
 // ISO C++ 98 headers.
 #include <cmath>
+#include <deque>
 
 // DUNE headers.
 #include <DUNE/Coordinates/BodyFixedFrame.hpp>
@@ -438,6 +439,24 @@ namespace DUNE
       virtual void
       runKalmanLBL(int beacon, float range, double dx, double dy, double exp_range);
 
+      //! Routine to fuse a delayed LBL range at the time it was measured.
+      //! @param[in] beacon beacon id.
+      //! @param[in] range range to beacon.
+      //! @param[in] time time of measurement.
+      //! @return true if the range was handled, false if it must be
+      //! fused with the current state.
+      bool
+      runDelayedKalmanLBL(int beacon, float range, double time);
+
+      //! Get the heading measured at a past time, i.e., the last
+      //! heading sample not after 'time'.
+      //! @param[in] time time of interest.
+      //! @param[out] psi heading.
+      //! @return true if 'time' is covered by the heading history,
+      //! false otherwise.
+      bool
+      getPastHeading(double time, double& psi) const;
+
       //! Routine to assign EKF filter output variables when a DVL velocity message is received.
       virtual void
       runKalmanDVL(void);
@@ -627,6 +646,23 @@ namespace DUNE
       bool m_reject_all_lbl;
       //! LBL rejection constants.
       std::vector<float> m_lbl_reject_constants;
+      //! Heading sample kept to fuse delayed measurements.
+      struct HeadingSample
+      {
+        //! Time of the sample.
+        double time;
+        //! Heading.
+        double psi;
+      };
+
+      //! Length of the filter history used to fuse delayed measurements (s).
+      float m_history_length;
+      //! Number of steps of the filter history.
+      size_t m_history_steps;
+      //! Headings measured during the filter history.
+      std::deque<HeadingSample> m_heading_history;
+      //! Maximum number of filter steps replayed per cycle.
+      unsigned m_replay_limit;
       //! Displacement between DVL and vehicle center of gravity.
       float m_dist_dvl_cg;
       //! Displacement between GPS and vehicle center of gravity.
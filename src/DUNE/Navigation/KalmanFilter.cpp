@@ -26,19 +26,187 @@
 // Author: José Braga                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 // DUNE headers.
 #include <DUNE/Navigation/KalmanFilter.hpp>
+#include <DUNE/Time/Clock.hpp>
 
 namespace DUNE
 {
   namespace Navigation
   {
+    //! Resize a workspace matrix only if its dimensions differ.
+    static inline void
+    ensure(Math::Matrix& m, size_t r, size_t c)
+    {
+      if ((size_t)m.rows() != r || (size_t)m.columns() != c)
+        m.resize(r, c);
+    }
+
+    //! Get read-only access to the storage of a matrix (does not
+    //! unshare its data).
+    static inline const double*
+    values(const Math::Matrix& m)
+    {
+      return m.data();
+    }
+
+    //! Copy the contents of a matrix, reusing the storage of the
+    //! destination when dimensions match.
+    static inline void
+    assign(Math::Matrix& dst, const Math::Matrix& src)
+    {
+      ensure(dst, src.rows(), src.columns());
+      std::memcpy(dst.data(), values(src), src.size() * sizeof(double));
+    }
+
+    //! Get a scratch area of at least a given number of entries,
+    //! growing the backing matrix if needed.
+    static inline double*
+    scratch(Math::Matrix& m, size_t count)
+    {
+      if ((size_t)m.size() < count)
+        m.resize(count, 1);
+      return m.data();
+    }
+
+    //! Compute the U-D factorization (a = u * d * u^T) of a symmetric
+    //! positive semidefinite matrix. D is stored on the diagonal, the
+    //! strictly upper part holds U (unit diagonal is implicit). Pivots
+    //! that are not positive are treated as zero.
+    //! @param[in] a symmetric matrix (only the upper part is used).
+    //! @param[out] ud factors.
+    //! @param[in] n matrix order.
+    static void
+    factorizeUD(const double* a, double* ud, size_t n)
+    {
+      for (size_t j = n; j-- > 0; )
+      {
+        double d = a[j * n + j];
+        for (size_t k = j + 1; k < n; ++k)
+          d -= ud[k * n + k] * ud[j * n + k] * ud[j * n + k];
+
+        if (d <= 0.0)
+        {
+          ud[j * n + j] = 0.0;
+          for (size_t i = 0; i < j; ++i)
+            ud[i * n + j] = 0.0;
+          continue;
+        }
+
+        ud[j * n + j] = d;
+        for (size_t i = 0; i < j; ++i)
+        {
+          double v = a[i * n + j];
+          for (size_t k = j + 1; k < n; ++k)
+            v -= ud[k * n + k] * ud[i * n + k] * ud[j * n + k];
+          ud[i * n + j] = v / d;
+        }
+      }
+
+      for (size_t i = 1; i < n; ++i)
+        std::memset(ud + i * n, 0, i * sizeof(double));
+    }
+
+    //! Build a sparsity pattern from a mask.
+    //! @param[in] mask matrix with non-zero values at used entries.
+    //! @param[out] pattern list of non-zero columns of each row.
+    static void
+    buildPattern(const Math::Matrix& mask, std::vector<std::vector<size_t> >& pattern)
+    {
+      pattern.clear();
+      pattern.resize(mask.rows());
+
+      for (int i = 0; i < mask.rows(); ++i)
+      {
+        for (int j = 0; j < mask.columns(); ++j)
+        {
+          if (mask(i, j) != 0.0)
+            pattern[i].push_back(j);
+        }
+      }
+    }
+
+    //! Multiply a sparse n x k matrix by a dense k x r matrix.
+    //! @param[in] a sparse matrix (row-major, k columns).
+    //! @param[in] pattern sparsity pattern of a.
+    //! @param[in] b dense k x r matrix.
+    //! @param[out] c n x r matrix.
+    //! @param[in] k number of columns of a.
+    //! @param[in] r number of columns of b.
+    static void
+    multiplySparse(const double* a, const std::vector<std::vector<size_t> >& pattern,
+                   const double* b, double* c, size_t k, size_t r)
+    {
+      for (size_t i = 0; i < pattern.size(); ++i)
+      {
+        double* ci = c + i * r;
+        std::memset(ci, 0, r * sizeof(double));
+
+        const std::vector<size_t>& cols = pattern[i];
+        for (size_t l = 0; l < cols.size(); ++l)
+        {
+          double v = a[i * k + cols[l]];
+          const double* bl = b + cols[l] * r;
+          for (size_t j = 0; j < r; ++j)
+            ci[j] += v * bl[j];
+        }
+      }
+    }
+
+    //! Multiply a dense n x k matrix by the transpose of a sparse
+    //! m x k matrix. If the result is known to be symmetric only the
+    //! upper triangle is computed.
+    //! @param[in] t dense n x k matrix.
+    //! @param[in] a sparse matrix (row-major, k columns).
+    //! @param[in] pattern sparsity pattern of a (m rows).
+    //! @param[out] c n x m matrix.
+    //! @param[in] n number of rows of t.
+    //! @param[in] k number of columns of t and a.
+    //! @param[in] symmetric true if c is symmetric (n == m).
+    static void
+    multiplyTransposedSparse(const double* t, const double* a, const std::vector<std::vector<size_t> >& pattern,
+                             double* c, size_t n, size_t k, bool symmetric)
+    {
+      size_t m = pattern.size();
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        const double* ti = t + i * k;
+
+        for (size_t j = symmetric ? i : 0; j < m; ++j)
+        {
+          const std::vector<size_t>& cols = pattern[j];
+          double v = 0.0;
+          for (size_t l = 0; l < cols.size(); ++l)
+            v += ti[cols[l]] * a[j * k + cols[l]];
+
+          c[i * m + j] = v;
+          if (symmetric)
+            c[j * m + i] = v;
+        }
+      }
+    }
+
     KalmanFilter::KalmanFilter(void)
     {
       m_state_count = 1;
       Math::Matrix I(1);
       I(0) = 0;
       m_x = m_y = m_ax = m_ap = m_c = m_p = m_q = m_r = m_innov = I;
+      m_form = CF_STANDARD;
+      m_sequential = false;
+      m_ud_valid = false;
+      m_model_head = 0;
+      m_model_dirty = true;
+      m_history_head = 0;
+      m_history_count = 0;
+      m_replay_limit = std::numeric_limits<size_t>::max();
+      m_replay_budget = m_replay_limit;
     }
 
     KalmanFilter::KalmanFilter(Math::Matrix& A, Math::Matrix& C, Math::Matrix& P, Math::Matrix& Q)
@@ -50,6 +218,15 @@ namespace DUNE
       m_q = Q;
       m_state_count = m_ax.rows();
       m_x.resizeAndFill(m_state_count, 1, 0.0);
+      m_form = CF_STANDARD;
+      m_sequential = false;
+      m_ud_valid = false;
+      m_model_head = 0;
+      m_model_dirty = true;
+      m_history_head = 0;
+      m_history_count = 0;
+      m_replay_limit = std::numeric_limits<size_t>::max();
+      m_replay_budget = m_replay_limit;
     }
 
     void
@@ -68,6 +245,11 @@ namespace DUNE
 
       m_ax.identity();
       m_ap.identity();
+      m_a_pattern.clear();
+      m_c_pattern.clear();
+      m_ud_valid = false;
+      m_model_dirty = true;
+      m_history_count = 0;
     }
 
     bool
@@ -80,6 +262,18 @@ namespace DUNE
         m_c.resizeAndKeep(num_outputs, num_states);
         m_r.resizeAndKeep(num_outputs, num_outputs);
         m_innov.resizeAndKeep(num_outputs, 1);
+
+        if (!m_c_pattern.empty())
+        {
+          size_t first = m_c_pattern.size();
+          m_c_pattern.resize(num_outputs);
+          for (size_t i = first; i < (size_t)num_outputs; ++i)
+          {
+            for (size_t j = 0; j < m_state_count; ++j)
+              m_c_pattern[i].push_back(j);
+          }
+        }
+
         return true;
       }
       else
@@ -97,12 +291,16 @@ namespace DUNE
 
       m_x = x0;
       m_p = P0;
+      m_ud_valid = false;
+      m_history_count = 0;
     }
 
     void
     KalmanFilter::normalize(void)
     {
       m_p = 0.5 * (m_p + transpose(m_p));
+      m_ud_valid = false;
+      syncHistory();
     }
 
     void
@@ -111,15 +309,167 @@ namespace DUNE
       if (u.rows() != b.columns() || u.columns() != 1)
         throw std::runtime_error(DTR("invalid dimensions"));
 
-      m_x = m_ax * m_x + b * u;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+      if ((size_t)b.rows() != m_state_count)
+        throw std::runtime_error(DTR("invalid dimensions"));
+
+      size_t n = m_state_count;
+      predictState();
+      Math::Kernels::multiply(values(b), values(u), m_x.data(), n, b.columns(), 1);
+
+      double* x = m_x.data();
+      const double* v = m_v.data();
+      for (size_t i = 0; i < n; ++i)
+        x[i] += v[i];
+
+      predictCovariance();
+      recordPrediction();
     }
 
     void
     KalmanFilter::predict(void)
     {
-      m_x = m_ax * m_x;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+      predictState();
+      std::memcpy(m_x.data(), m_v.data(), m_state_count * sizeof(double));
+
+      predictCovariance();
+      recordPrediction();
+    }
+
+    void
+    KalmanFilter::predictState(void)
+    {
+      size_t n = m_state_count;
+      ensure(m_v, n, 1);
+
+      if (m_a_pattern.empty())
+        Math::Kernels::multiply(values(m_ax), values(m_x), m_v.data(), n, n, 1);
+      else
+        multiplySparse(values(m_ax), m_a_pattern, values(m_x), m_v.data(), n, 1);
+    }
+
+    void
+    KalmanFilter::predictCovariance(void)
+    {
+      size_t n = m_state_count;
+
+      if (m_form != CF_UD)
+      {
+        ensure(m_pt, n, n);
+
+        if (m_a_pattern.empty())
+        {
+          Math::Kernels::multiplyAPAT(values(m_ap), values(m_p), m_pt.data(), scratch(m_work, n * n), n, n);
+        }
+        else
+        {
+          double* ap = scratch(m_work, n * n);
+          multiplySparse(values(m_ap), m_a_pattern, values(m_p), ap, n, n);
+          multiplyTransposedSparse(ap, values(m_ap), m_a_pattern, m_pt.data(), n, n, true);
+        }
+
+        double* p = m_p.data();
+        const double* pt = m_pt.data();
+        const double* q = values(m_q);
+        for (size_t i = 0; i < n * n; ++i)
+          p[i] = pt[i] + q[i];
+
+        return;
+      }
+
+      // Thornton's modified weighted Gram-Schmidt propagation of the
+      // U-D factors: W = [A * U, G], Dw = diag(D, Dq), Q = G Dq G^T.
+      factorize();
+
+      size_t w = 2 * n;
+      ensure(m_pt, n, n);
+      double* wm = scratch(m_work, n * w + w);
+      double* ud = m_ud.data();
+      double* u = m_pt.data();
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = 0; j < n; ++j)
+          u[i * n + j] = (j > i) ? ud[i * n + j] : (i == j ? 1.0 : 0.0);
+      }
+
+      // A * U.
+      ensure(m_k, n, n);
+      if (m_a_pattern.empty())
+        Math::Kernels::multiply(values(m_ap), u, m_k.data(), n, n, n);
+      else
+        multiplySparse(values(m_ap), m_a_pattern, u, m_k.data(), n, n);
+
+      // Factorize process noise (G is the identity if Q is diagonal).
+      ensure(m_kt, n, n);
+      double* gq = m_kt.data();
+      const double* q = values(m_q);
+      bool diagonal = true;
+      for (size_t i = 0; i < n && diagonal; ++i)
+      {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+          if (q[i * n + j] != 0.0)
+          {
+            diagonal = false;
+            break;
+          }
+        }
+      }
+
+      if (diagonal)
+      {
+        std::memset(gq, 0, n * n * sizeof(double));
+        for (size_t i = 0; i < n; ++i)
+          gq[i * n + i] = q[i * n + i];
+      }
+      else
+      {
+        factorizeUD(q, gq, n);
+      }
+
+      // Weights are stored in the last row of the work area.
+      double* dw = wm + n * w;
+      const double* au = m_k.data();
+      for (size_t i = 0; i < n; ++i)
+      {
+        dw[i] = ud[i * n + i];
+        dw[n + i] = gq[i * n + i];
+
+        for (size_t j = 0; j < n; ++j)
+        {
+          wm[i * w + j] = au[i * n + j];
+          wm[i * w + n + j] = (j > i) ? gq[i * n + j] : (i == j ? 1.0 : 0.0);
+        }
+      }
+
+      for (size_t j = n; j-- > 0; )
+      {
+        const double* wj = wm + j * w;
+        double d = 0.0;
+        for (size_t k = 0; k < w; ++k)
+          d += wj[k] * wj[k] * dw[k];
+
+        ud[j * n + j] = d;
+
+        for (size_t i = 0; i < j; ++i)
+        {
+          double* wi = wm + i * w;
+          double uij = 0.0;
+
+          if (d > 0.0)
+          {
+            for (size_t k = 0; k < w; ++k)
+              uij += wi[k] * dw[k] * wj[k];
+            uij /= d;
+          }
+
+          ud[i * n + j] = uij;
+          for (size_t k = 0; k < w; ++k)
+            wi[k] -= uij * wj[k];
+        }
+      }
+
+      compose();
     }
 
     int
@@ -137,40 +487,794 @@ namespace DUNE
       if (m_r.rows() != m_r.columns() || m_r.rows() != m_innov.rows())
         throw std::runtime_error(DTR("invalid dimensions"));
 
-      // Measurement prediction covariance.
-      Math::Matrix S = (m_c * m_p * transpose(m_c)) + m_r;
-      Math::Matrix S_1;
+      // Check if innovation is above a threshold value.
+      // Set threshold to 0 to accept everything.
+      if (threshold != 0 && !gate(threshold))
+        return -1;
+
+      correct();
+
+      if (m_history_count > 0)
+      {
+        Snapshot& s = getSnapshot(0);
+
+        // Only one update per step can be replayed.
+        if (s.updated)
+        {
+          s.frozen = true;
+        }
+        else
+        {
+          s.updated = true;
+          assign(s.c, m_c);
+          assign(s.r, m_r);
+          assign(s.innov, m_innov);
+        }
+
+        assign(s.x, m_x);
+        assign(s.p, m_p);
+      }
+
+      return 0;
+    }
+
+    void
+    KalmanFilter::correct(void)
+    {
+      if (m_form == CF_UD)
+        updateFactorized();
+      else if (m_sequential && isNoiseDiagonal())
+        updateSequential();
+      else
+        updateBatch();
+    }
+
+    void
+    KalmanFilter::setHistorySize(size_t steps)
+    {
+      // Each step records at most one new model, so a ring as long as
+      // the history never overwrites a model that is still referenced.
+      m_history.resize(steps);
+      m_models.resize(steps);
+
+      size_t n = m_state_count;
+      for (size_t i = 0; i < steps; ++i)
+      {
+        Snapshot& s = m_history[i];
+        ensure(s.x_prior, n, 1);
+        ensure(s.bu, n, 1);
+        ensure(s.x, n, 1);
+        ensure(s.p, n, n);
+        ensure(m_models[i].ax, n, n);
+        ensure(m_models[i].ap, n, n);
+        ensure(m_models[i].q, n, n);
+      }
+
+      m_model_head = 0;
+      m_model_dirty = true;
+      m_history_head = 0;
+      m_history_count = 0;
+    }
+
+    KalmanFilter::Snapshot&
+    KalmanFilter::getSnapshot(size_t age)
+    {
+      size_t size = m_history.size();
+      return m_history[(m_history_head + size - age) % size];
+    }
+
+    const KalmanFilter::Snapshot&
+    KalmanFilter::getSnapshot(size_t age) const
+    {
+      size_t size = m_history.size();
+      return m_history[(m_history_head + size - age) % size];
+    }
+
+    int
+    KalmanFilter::findSnapshot(double time) const
+    {
+      for (size_t i = 0; i < m_history_count; ++i)
+      {
+        if (getSnapshot(i).time <= time)
+          return (int)i;
+      }
+
+      return -1;
+    }
+
+    void
+    KalmanFilter::recordPrediction(void)
+    {
+      if (m_history.empty())
+        return;
+
+      m_history_head = (m_history_head + 1) % m_history.size();
+      m_history_count = std::min(m_history_count + 1, m_history.size());
+      m_replay_budget = m_replay_limit;
+
+      Snapshot& s = m_history[m_history_head];
+      s.time = Time::Clock::getSinceEpoch();
+      s.updated = false;
+      s.frozen = false;
+
+      // Models rarely change: record them only when they do.
+      if (m_model_dirty || m_history_count == 1)
+      {
+        m_model_head = (m_model_head + 1) % m_models.size();
+        Model& model = m_models[m_model_head];
+        assign(model.ax, m_ax);
+        assign(model.ap, m_ap);
+        assign(model.q, m_q);
+        m_model_dirty = false;
+      }
+
+      s.model = m_model_head;
+      assign(s.x_prior, m_x);
+      assign(s.x, m_x);
+      assign(s.p, m_p);
+
+      // Input term, i.e., what the transition alone does not explain.
+      ensure(s.bu, m_state_count, 1);
+      double* bu = s.bu.data();
+      const double* x = values(m_x);
+      const double* v = values(m_v);
+      for (size_t i = 0; i < m_state_count; ++i)
+        bu[i] = x[i] - v[i];
+    }
+
+    void
+    KalmanFilter::syncHistory(void)
+    {
+      if (m_history_count == 0)
+        return;
+
+      Snapshot& s = getSnapshot(0);
+      assign(s.x, m_x);
+      assign(s.p, m_p);
+    }
+
+    bool
+    KalmanFilter::getPastState(double time, Math::Matrix& x, Math::Matrix& p) const
+    {
+      int age = findSnapshot(time);
+      if (age <= 0)
+        return false;
+
+      const Snapshot& s = getSnapshot(age);
+      assign(x, s.x);
+      assign(p, s.p);
+      return true;
+    }
+
+    int
+    KalmanFilter::updateDelayed(double time, const Math::Matrix& c, const Math::Matrix& r,
+                                const Math::Matrix& innov, float threshold)
+    {
+      if (c.rows() != innov.rows() || (size_t)c.columns() != m_state_count)
+        throw std::runtime_error(DTR("invalid dimensions"));
+
+      if (innov.columns() != 1)
+        throw std::runtime_error(DTR("invalid dimensions"));
+
+      if (r.rows() != r.columns() || r.rows() != innov.rows())
+        throw std::runtime_error(DTR("invalid dimensions"));
+
+      int age = findSnapshot(time);
+      if (age <= 0 || (size_t)age > m_replay_budget)
+        return -2;
+
+      // Steps with more than one update cannot be replayed.
+      for (int i = 0; i < age; ++i)
+      {
+        if (getSnapshot(i).frozen)
+          return -2;
+      }
 
-      // Inverse of the measurement prediction covariance.
+      // Keep the current model and outputs (shared, no copies).
+      Math::Matrix ax = m_ax;
+      Math::Matrix ap = m_ap;
+      Math::Matrix q = m_q;
+      Math::Matrix cc = m_c;
+      Math::Matrix rc = m_r;
+      Math::Matrix ic = m_innov;
+      Pattern pattern;
+      pattern.swap(m_c_pattern);
+
+      m_c = c;
+      m_r = r;
+      m_innov = innov;
+
+      Snapshot& past = getSnapshot(age);
+      bool accept = true;
+
+      if (threshold != 0)
+      {
+        Math::Matrix p = m_p;
+        m_p = past.p;
+        accept = gate(threshold);
+        m_p = p;
+      }
+
+      if (accept)
+      {
+        // Fuse measurement at its time.
+        assign(m_x, past.x);
+        assign(m_p, past.p);
+        m_ud_valid = false;
+        correct();
+        assign(past.x, m_x);
+        assign(past.p, m_p);
+        past.frozen = true;
+
+        // Re-propagate up to the last step.
+        size_t n = m_state_count;
+        for (int i = age - 1; i >= 0; --i)
+        {
+          Snapshot& s = getSnapshot(i);
+          const Model& model = m_models[s.model];
+          m_ax = model.ax;
+          m_ap = model.ap;
+          m_q = model.q;
+
+          predictState();
+          double* x = m_x.data();
+          const double* v = values(m_v);
+          const double* bu = values(s.bu);
+          for (size_t j = 0; j < n; ++j)
+            x[j] = v[j] + bu[j];
+
+          predictCovariance();
+
+          if (s.updated)
+          {
+            // Linearize the innovation around the new prediction.
+            size_t m = s.c.rows();
+            const double* sc = values(s.c);
+            const double* xp = values(s.x_prior);
+            double* si = s.innov.data();
+            for (size_t k = 0; k < m; ++k)
+            {
+              for (size_t j = 0; j < n; ++j)
+                si[k] -= sc[k * n + j] * (x[j] - xp[j]);
+            }
+
+            assign(s.x_prior, m_x);
+
+            m_c = s.c;
+            m_r = s.r;
+            m_innov = s.innov;
+
+            bool sparse = !pattern.empty() && pattern.size() == m;
+            if (sparse)
+              m_c_pattern.swap(pattern);
+
+            correct();
+
+            if (sparse)
+              m_c_pattern.swap(pattern);
+          }
+          else
+          {
+            assign(s.x_prior, m_x);
+          }
+
+          assign(s.x, m_x);
+          assign(s.p, m_p);
+        }
+
+        m_replay_budget -= age;
+      }
+
+      m_ax = ax;
+      m_ap = ap;
+      m_q = q;
+      m_c = cc;
+      m_r = rc;
+      m_innov = ic;
+      m_c_pattern.swap(pattern);
+      m_ud_valid = false;
+
+      return accept ? 0 : -1;
+    }
+
+    bool
+    KalmanFilter::gate(float threshold)
+    {
+      size_t n = m_state_count;
+      size_t m = m_innov.rows();
+
+      // Measurement prediction covariance (S = C * P * C^T + R).
+      ensure(m_s, m, m);
+      Math::Kernels::multiplyAPAT(values(m_c), values(m_p), m_s.data(), scratch(m_work, m * n), m, n);
+
+      double* s = m_s.data();
+      const double* r = values(m_r);
+      for (size_t i = 0; i < m * m; ++i)
+        s[i] += r[i];
+
+      ensure(m_e, m, 1);
+      std::memcpy(m_e.data(), values(m_innov), m * sizeof(double));
+      solve(s, m_e.data(), m, 1);
+
+      double level = 0.0;
+      const double* e = m_e.data();
+      const double* innov = values(m_innov);
+      for (size_t i = 0; i < m; ++i)
+        level += innov[i] * e[i];
+
+      return level < threshold;
+    }
+
+    void
+    KalmanFilter::solve(double* s, double* b, size_t m, size_t cols)
+    {
+      ensure(m_sc, m, m);
+      std::memcpy(m_sc.data(), s, m * m * sizeof(double));
+
+      if (Math::Kernels::cholesky(s, m))
+      {
+        Math::Kernels::choleskySolve(s, b, m, cols);
+        return;
+      }
+
+      // S is not numerically positive definite.
       try
       {
-        S_1 = inverse(S);
+        Math::Matrix x = lu_solve(m_sc, Math::Matrix(b, m, cols));
+        std::memcpy(b, values(x), m * cols * sizeof(double));
       }
       catch (...)
       {
         throw std::runtime_error(DTR("matrix inversion error"));
       }
+    }
 
-      // Check if innovation is above a threshold value.
-      // Set threshold to 0 to accept everything.
-      if (threshold != 0)
+    void
+    KalmanFilter::updateBatch(void)
+    {
+      size_t n = m_state_count;
+      size_t m = m_innov.rows();
+
+      if (!m_c_pattern.empty())
       {
-        double level = (transpose(m_innov) * S_1 * m_innov)(0);
+        updateBatchSparse();
+        return;
+      }
+
+      // Measurement prediction covariance (S = C * P * C^T + R).
+      ensure(m_s, m, m);
+      Math::Kernels::multiplyAPAT(values(m_c), values(m_p), m_s.data(), scratch(m_work, m * n), m, n);
+
+      double* s = m_s.data();
+      const double* r = values(m_r);
+      for (size_t i = 0; i < m * m; ++i)
+        s[i] += r[i];
+
+      // Kalman gain (K^T = S^-1 * C * P, S and P are symmetric).
+      ensure(m_aux, m, n);
+      Math::Kernels::multiply(values(m_c), values(m_p), m_aux.data(), m, n, n);
+
+      ensure(m_kt, m, n);
+      std::memcpy(m_kt.data(), values(m_aux), m * n * sizeof(double));
+      solve(s, m_kt.data(), m, n);
+
+      ensure(m_k, n, m);
+      Math::Kernels::transpose(m_kt.data(), m_k.data(), m, n);
 
-        if (level >= threshold)
-          return -1;
+      // State update.
+      ensure(m_v, n, 1);
+      Math::Kernels::multiply(m_k.data(), values(m_innov), m_v.data(), n, m, 1);
+
+      double* x = m_x.data();
+      const double* v = m_v.data();
+      for (size_t i = 0; i < n; ++i)
+        x[i] += v[i];
+
+      // Standard covariance update: P = P - K * C * P.
+      if (m_form == CF_STANDARD)
+      {
+        ensure(m_pt, n, n);
+        Math::Kernels::multiply(m_k.data(), values(m_aux), m_pt.data(), n, m, n);
+
+        double* p = m_p.data();
+        const double* kcp = m_pt.data();
+        for (size_t i = 0; i < n * n; ++i)
+          p[i] -= kcp[i];
+        return;
       }
 
-      // Kalman Gain.
-      Math::Matrix K = m_p * transpose(m_c) * S_1;
+      // Joseph form covariance update:
+      // P = (I - K * C) * P * (I - K * C)^T + K * R * K^T.
+      ensure(m_pt, n, n);
+      double* ikc = m_pt.data();
+      Math::Kernels::multiply(m_k.data(), values(m_c), ikc, n, m, n);
+      for (size_t i = 0; i < n * n; ++i)
+        ikc[i] = -ikc[i];
+      for (size_t i = 0; i < n; ++i)
+        ikc[i * n + i] += 1.0;
+
+      double* work = scratch(m_work, n * std::max(n, m));
+      ensure(m_aux, n, n);
+      Math::Kernels::multiplyAPAT(ikc, values(m_p), m_aux.data(), work, n, n);
+      Math::Kernels::multiplyAPAT(m_k.data(), r, ikc, work, n, m);
+
+      double* p = m_p.data();
+      const double* a = m_aux.data();
+      for (size_t i = 0; i < n * n; ++i)
+        p[i] = a[i] + ikc[i];
+    }
+
+    void
+    KalmanFilter::updateBatchSparse(void)
+    {
+      size_t n = m_state_count;
+      size_t m = m_innov.rows();
+      const double* c = values(m_c);
+      const double* r = values(m_r);
+
+      // C * P and measurement prediction covariance (S = C * P * C^T + R).
+      ensure(m_aux, m, n);
+      double* cp = m_aux.data();
+      multiplySparse(c, m_c_pattern, values(m_p), cp, n, n);
+
+      ensure(m_s, m, m);
+      double* s = m_s.data();
+      multiplyTransposedSparse(cp, c, m_c_pattern, s, m, n, true);
+      for (size_t i = 0; i < m * m; ++i)
+        s[i] += r[i];
+
+      // Kalman gain (K^T = S^-1 * C * P).
+      ensure(m_kt, m, n);
+      std::memcpy(m_kt.data(), cp, m * n * sizeof(double));
+      solve(s, m_kt.data(), m, n);
+
+      ensure(m_k, n, m);
+      Math::Kernels::transpose(values(m_kt), m_k.data(), m, n);
+      const double* k = values(m_k);
 
       // State update.
-      m_x = m_x + K * m_innov;
+      ensure(m_v, n, 1);
+      Math::Kernels::multiply(k, values(m_innov), m_v.data(), n, m, 1);
 
-      // State Covariance update.
-      m_p = m_p - K * m_c * m_p;
+      double* x = m_x.data();
+      const double* v = m_v.data();
+      for (size_t i = 0; i < n; ++i)
+        x[i] += v[i];
 
-      return 0;
+      // Joseph form covariance update, exploiting the structure of C:
+      // M * P = P - K * C * P
+      // P = M * P * M^T + K * R * K^T = M * P - (M * P * C^T - K * R) * K^T.
+      ensure(m_pt, n, n);
+      double* mp = m_pt.data();
+      Math::Kernels::multiply(k, cp, mp, n, m, n);
+
+      const double* p = values(m_p);
+      for (size_t i = 0; i < n * n; ++i)
+        mp[i] = p[i] - mp[i];
+
+      // Standard covariance update.
+      if (m_form == CF_STANDARD)
+      {
+        std::memcpy(m_p.data(), mp, n * n * sizeof(double));
+        return;
+      }
+
+      double* z = scratch(m_work, n * m);
+      multiplyTransposedSparse(mp, c, m_c_pattern, z, n, n, false);
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = 0; j < m; ++j)
+        {
+          double kr = 0.0;
+          for (size_t l = 0; l < m; ++l)
+            kr += k[i * m + l] * r[l * m + j];
+          z[i * m + j] -= kr;
+        }
+      }
+
+      double* pu = m_p.data();
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = i; j < n; ++j)
+        {
+          double pij = mp[i * n + j];
+          for (size_t l = 0; l < m; ++l)
+            pij -= z[i * m + l] * k[j * m + l];
+          pu[i * n + j] = pij;
+          pu[j * n + i] = pij;
+        }
+      }
+    }
+
+    void
+    KalmanFilter::updateSequential(void)
+    {
+      size_t n = m_state_count;
+      size_t m = m_innov.rows();
+
+      // Workspace: h = P * c^T, k (gain) and dx (accumulated state
+      // correction, used to refer innovations to the updated state).
+      double* h = scratch(m_work, 3 * n);
+      double* k = h + n;
+      double* dx = k + n;
+      std::memset(dx, 0, n * sizeof(double));
+
+      const double* c = values(m_c);
+      const double* r = values(m_r);
+      const double* innov = values(m_innov);
+      double* x = m_x.data();
+      double* p = m_p.data();
+
+      for (size_t o = 0; o < m; ++o)
+      {
+        const double* co = c + o * n;
+
+        // Non-zero columns of this output.
+        m_columns.clear();
+        if (m_c_pattern.empty())
+        {
+          for (size_t j = 0; j < n; ++j)
+          {
+            if (co[j] != 0.0)
+              m_columns.push_back(j);
+          }
+        }
+        else
+        {
+          const std::vector<size_t>& cols = m_c_pattern[o];
+          for (size_t l = 0; l < cols.size(); ++l)
+          {
+            if (co[cols[l]] != 0.0)
+              m_columns.push_back(cols[l]);
+          }
+        }
+
+        if (m_columns.empty())
+          continue;
+
+        double e = innov[o];
+        for (size_t l = 0; l < m_columns.size(); ++l)
+          e -= co[m_columns[l]] * dx[m_columns[l]];
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          double v = 0.0;
+          for (size_t l = 0; l < m_columns.size(); ++l)
+            v += p[i * n + m_columns[l]] * co[m_columns[l]];
+          h[i] = v;
+        }
+
+        double s = r[o * m + o];
+        for (size_t l = 0; l < m_columns.size(); ++l)
+          s += co[m_columns[l]] * h[m_columns[l]];
+
+        if (s <= 0.0)
+          throw std::runtime_error(DTR("matrix inversion error"));
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          k[i] = h[i] / s;
+          x[i] += k[i] * e;
+          dx[i] += k[i] * e;
+        }
+
+        // Standard form: P = P - k * h^T.
+        // Joseph form: P = P - k * h^T - h * k^T + s * k * k^T.
+        bool joseph = (m_form == CF_JOSEPH);
+        for (size_t i = 0; i < n; ++i)
+        {
+          for (size_t j = i; j < n; ++j)
+          {
+            double v = p[i * n + j] - k[i] * h[j];
+            if (joseph)
+              v += s * k[i] * k[j] - h[i] * k[j];
+            p[i * n + j] = v;
+            p[j * n + i] = v;
+          }
+        }
+      }
+    }
+
+    void
+    KalmanFilter::updateFactorized(void)
+    {
+      size_t n = m_state_count;
+      size_t m = m_innov.rows();
+
+      factorize();
+
+      // Decorrelate outputs if needed: R = Ur * Dr * Ur^T, outputs
+      // and observation matrix are premultiplied by Ur^-1.
+      ensure(m_aux, m, n);
+      ensure(m_e, m, 1);
+      ensure(m_s, m, m);
+      double* c = m_aux.data();
+      double* e = m_e.data();
+      double* ur = m_s.data();
+      std::memcpy(c, values(m_c), m * n * sizeof(double));
+      std::memcpy(e, values(m_innov), m * sizeof(double));
+
+      if (isNoiseDiagonal())
+      {
+        const double* r = values(m_r);
+        std::memset(ur, 0, m * m * sizeof(double));
+        for (size_t i = 0; i < m; ++i)
+          ur[i * m + i] = r[i * m + i];
+      }
+      else
+      {
+        factorizeUD(values(m_r), ur, m);
+        for (size_t i = m; i-- > 0; )
+        {
+          for (size_t j = i + 1; j < m; ++j)
+          {
+            double u = ur[i * m + j];
+            if (u == 0.0)
+              continue;
+
+            e[i] -= u * e[j];
+            for (size_t l = 0; l < n; ++l)
+              c[i * n + l] -= u * c[j * n + l];
+          }
+        }
+      }
+
+      // Workspace: f = U^T * c^T, v = D * f, b (unnormalized gain)
+      // and dx (accumulated state correction).
+      double* f = scratch(m_work, 4 * n);
+      double* v = f + n;
+      double* b = v + n;
+      double* dx = b + n;
+      std::memset(dx, 0, n * sizeof(double));
+
+      double* ud = m_ud.data();
+      double* x = m_x.data();
+
+      for (size_t o = 0; o < m; ++o)
+      {
+        const double* co = c + o * n;
+
+        double innov = e[o];
+        bool observed = false;
+        for (size_t j = 0; j < n; ++j)
+        {
+          if (co[j] != 0.0)
+          {
+            innov -= co[j] * dx[j];
+            observed = true;
+          }
+        }
+
+        if (!observed)
+          continue;
+
+        double alpha = ur[o * m + o];
+        if (alpha <= 0.0)
+          throw std::runtime_error(DTR("matrix inversion error"));
+
+        // Bierman's scalar measurement update.
+        for (size_t j = 0; j < n; ++j)
+        {
+          double fj = co[j];
+          for (size_t i = 0; i < j; ++i)
+            fj += ud[i * n + j] * co[i];
+          f[j] = fj;
+          v[j] = ud[j * n + j] * fj;
+        }
+
+        for (size_t j = 0; j < n; ++j)
+        {
+          double previous = alpha;
+          alpha += f[j] * v[j];
+          double lambda = -f[j] / previous;
+          ud[j * n + j] *= previous / alpha;
+          b[j] = v[j];
+
+          for (size_t i = 0; i < j; ++i)
+          {
+            double u = ud[i * n + j];
+            ud[i * n + j] = u + b[i] * lambda;
+            b[i] += u * v[j];
+          }
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          double d = b[i] / alpha * innov;
+          x[i] += d;
+          dx[i] += d;
+        }
+      }
+
+      compose();
+    }
+
+    void
+    KalmanFilter::factorize(void)
+    {
+      if (m_ud_valid)
+        return;
+
+      size_t n = m_state_count;
+      ensure(m_ud, n, n);
+      factorizeUD(values(m_p), m_ud.data(), n);
+      m_ud_valid = true;
+    }
+
+    void
+    KalmanFilter::compose(void)
+    {
+      size_t n = m_state_count;
+      const double* ud = values(m_ud);
+      double* p = m_p.data();
+
+      // P = U * D * U^T, with unit diagonal U.
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = i; j < n; ++j)
+        {
+          double v = (i == j ? 1.0 : ud[i * n + j]) * ud[j * n + j];
+          for (size_t k = j + 1; k < n; ++k)
+            v += ud[i * n + k] * ud[k * n + k] * ud[j * n + k];
+          p[i * n + j] = v;
+          p[j * n + i] = v;
+        }
+      }
+    }
+
+    bool
+    KalmanFilter::isNoiseDiagonal(void) const
+    {
+      size_t m = m_r.rows();
+      const double* r = values(m_r);
+
+      for (size_t i = 0; i < m; ++i)
+      {
+        for (size_t j = 0; j < m; ++j)
+        {
+          if (i != j && r[i * m + j] != 0.0)
+            return false;
+        }
+      }
+
+      return true;
+    }
+
+    void
+    KalmanFilter::setTransitionPattern(const Math::Matrix& mask)
+    {
+      if (mask.size() == 0)
+      {
+        m_a_pattern.clear();
+        return;
+      }
+
+      if ((size_t)mask.rows() != m_state_count || (size_t)mask.columns() != m_state_count)
+        throw std::runtime_error(DTR("invalid dimensions"));
+
+      buildPattern(mask, m_a_pattern);
+    }
+
+    void
+    KalmanFilter::setObservationPattern(const Math::Matrix& mask)
+    {
+      if (mask.size() == 0)
+      {
+        m_c_pattern.clear();
+        return;
+      }
+
+      if (mask.rows() != m_c.rows() || (size_t)mask.columns() != m_state_count)
+        throw std::runtime_error(DTR("invalid dimensions"));
+
+      buildPattern(mask, m_c_pattern);
+    }
+
+    void
+    KalmanFilter::setCovarianceForm(CovarianceForm form)
+    {
+      m_form = form;
+      m_ud_valid = false;
     }
 
     void
@@ -180,12 +1284,14 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid index"));
 
       m_x(pos) = value;
+      syncHistory();
     }
 
     void
     KalmanFilter::resetState(void)
     {
       m_x.fill(0.0);
+      syncHistory();
     }
 
     void
@@ -213,6 +1319,7 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid dimensions"));
 
       m_ax = a;
+      m_model_dirty = true;
     }
 
     void
@@ -225,6 +1332,7 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid dimensions"));
 
       m_ap = a;
+      m_model_dirty = true;
     }
 
     void
@@ -261,6 +1369,7 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid index"));
 
       m_q(ln, cl) = value;
+      m_model_dirty = true;
     }
 
     void
@@ -270,6 +1379,7 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid index"));
 
       m_q(in, in) = value;
+      m_model_dirty = true;
     }
 
     void
@@ -277,6 +1387,7 @@ namespace DUNE
     {
       for (size_t i = 0; i < m_state_count; ++i)
         m_q(i, i) = value;
+      m_model_dirty = true;
     }
 
     void
@@ -311,6 +1422,8 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid index"));
 
       m_p(ln, cl) = value;
+      m_ud_valid = false;
+      syncHistory();
     }
 
     void
@@ -320,6 +1433,8 @@ namespace DUNE
         throw std::runtime_error(DTR("invalid index"));
 
       m_p(in, in) = value;
+      m_ud_valid = false;
+      syncHistory();
     }
 
     void
@@ -327,6 +1442,8 @@ namespace DUNE
     {
       for (size_t i = 0; i < m_state_count; ++i)
         m_p(i, i) = value;
+      m_ud_valid = false;
+      syncHistory();
     }
 
     void
@@ -337,6 +1454,8 @@ namespace DUNE
         m_p(i, in) = 0.0;
         m_p(in, i) = 0.0;
       }
+      m_ud_valid = false;
+      syncHistory();
     }
   }
 }
@@ -43,7 +43,9 @@
 // ISO C++ 98 headers.
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <cmath>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -59,6 +61,19 @@ namespace DUNE
     class KalmanFilter
     {
     public:
+      //! Representations of the state covariance.
+      enum CovarianceForm
+      {
+        //! Full covariance matrix with standard updates
+        //! (P = P - K * C * P).
+        CF_STANDARD,
+        //! Full covariance matrix with Joseph form updates.
+        CF_JOSEPH,
+        //! Square-root (U-D factorized) covariance, propagated with
+        //! Thornton's algorithm and updated with Bierman's algorithm.
+        CF_UD
+      };
+
       //! Constructor.
       KalmanFilter(void);
 
@@ -107,6 +122,92 @@ namespace DUNE
       int
       update(float threshold);
 
+      //! Select the covariance representation (standard updates by
+      //! default). The Joseph and square-root forms are more robust
+      //! to round-off errors, the latter at the cost of recomposing
+      //! the covariance matrix after each step.
+      //! @param form covariance representation.
+      void
+      setCovarianceForm(CovarianceForm form);
+
+      //! Get the covariance representation.
+      //! @return covariance representation.
+      inline CovarianceForm
+      getCovarianceForm(void) const
+      {
+        return m_form;
+      }
+
+      //! Keep a history of the last filter steps, allowing delayed
+      //! measurements to be fused at their true time. Each step is
+      //! stamped with the system clock when predict() is called.
+      //! @param steps number of steps to keep (0 disables history).
+      void
+      setHistorySize(size_t steps);
+
+      //! Set the maximum number of steps that may be replayed, for
+      //! all delayed measurements, between two predictions.
+      //! @param steps maximum number of replayed steps.
+      inline void
+      setReplayLimit(size_t steps)
+      {
+        m_replay_limit = steps;
+        m_replay_budget = std::min(m_replay_budget, steps);
+      }
+
+      //! Get the state and covariance of the filter at a past time,
+      //! i.e., as estimated at the last step not after 'time'.
+      //! @param time time of interest (seconds since epoch).
+      //! @param x state vector.
+      //! @param p state covariance matrix.
+      //! @return true if 'time' is older than the last step and
+      //! covered by the history, false otherwise.
+      bool
+      getPastState(double time, Math::Matrix& x, Math::Matrix& p) const;
+
+      //! Fuse a delayed measurement at its true time and re-propagate
+      //! the filter up to the current step.
+      //! @param time measurement time (seconds since epoch).
+      //! @param c observation matrix (one row per measurement).
+      //! @param r measurement noise covariance matrix.
+      //! @param innov innovation, computed with the state returned by
+      //! getPastState().
+      //! @param threshold threshold to reject large innovations.
+      //! @return 0 if update is successful, -1 if the innovation was
+      //! rejected, -2 if the measurement cannot be fused at its time
+      //! (not covered by the history or replay limit exceeded).
+      int
+      updateDelayed(double time, const Math::Matrix& c, const Math::Matrix& r,
+                    const Math::Matrix& innov, float threshold = 0);
+
+      //! Declare the entries of the state and covariance transition
+      //! matrices that may be non-zero. Prediction only touches these
+      //! entries, others are ignored.
+      //! @param mask matrix with non-zero values at the entries that
+      //! may be non-zero, or an empty matrix for dense transitions.
+      void
+      setTransitionPattern(const Math::Matrix& mask);
+
+      //! Declare the entries of the observation matrix that may be
+      //! non-zero. Update only touches these entries, others are
+      //! ignored. Outputs added by resize() are dense.
+      //! @param mask matrix with non-zero values at the entries that
+      //! may be non-zero, or an empty matrix for a dense observation
+      //! matrix.
+      void
+      setObservationPattern(const Math::Matrix& mask);
+
+      //! Enable or disable sequential scalar updates. When enabled
+      //! and the measurement noise covariance matrix is diagonal,
+      //! outputs are processed one at a time, skipping outputs with
+      //! null observation rows. Disabled by default.
+      //! @param enable true to enable sequential updates.
+      inline void
+      setSequentialUpdates(bool enable)
+      {
+        m_sequential = enable;
+      }
+
       //! Get filter state value.
       //! @param pos matrix index.
       //! @return state matrix value.
@@ -260,6 +361,18 @@ namespace DUNE
         return m_p(in, in);
       }
 
+      //! Get measurement noise covariance matrix value.
+      //! @param in row and column index.
+      //! @return measurement noise covariance matrix value.
+      inline double
+      getMeasurementNoise(short in) const
+      {
+        if (in >= m_r.rows())
+          throw std::runtime_error(DTR("invalid index"));
+
+        return m_r(in, in);
+      }
+
       //! Get state covariance matrix.
       //! @param i1 lower row index.
       //! @param i2 upper row index.
@@ -339,6 +452,121 @@ namespace DUNE
       setMeasurementNoise(double value);
 
     private:
+      //! Process model used by one or more history steps.
+      struct Model
+      {
+        //! State and covariance transition matrices.
+        Math::Matrix ax, ap;
+        //! Process noise covariance matrix.
+        Math::Matrix q;
+      };
+
+      //! Filter step kept in the history.
+      struct Snapshot
+      {
+        //! Time of prediction.
+        double time;
+        //! True if the step includes an update.
+        bool updated;
+        //! True if the step can not be replayed exactly.
+        bool frozen;
+        //! Index of the process model in the model ring.
+        size_t model;
+        //! Observation, measurement noise and innovation.
+        Math::Matrix c, r, innov;
+        //! Predicted state and its input term (B * u).
+        Math::Matrix x_prior, bu;
+        //! State and covariance at the end of the step.
+        Math::Matrix x, p;
+      };
+
+      //! Sparsity pattern: list of non-zero columns of each row.
+      typedef std::vector<std::vector<size_t> > Pattern;
+
+      //! Compute the predicted state into the state workspace.
+      void
+      predictState(void);
+
+      //! Propagate covariance matrix.
+      void
+      predictCovariance(void);
+
+      //! Test innovation against a threshold.
+      //! @param threshold innovation threshold.
+      //! @return true if the innovation is below the threshold.
+      bool
+      gate(float threshold);
+
+      //! Solve the measurement prediction covariance against a set of
+      //! right-hand sides (X = S^-1 * B), using its Cholesky factor
+      //! or, if S is not positive definite, its LU decomposition.
+      //! @param s measurement prediction covariance (overwritten).
+      //! @param b right-hand sides, replaced by the solution.
+      //! @param m number of outputs.
+      //! @param cols number of right-hand sides.
+      void
+      solve(double* s, double* b, size_t m, size_t cols);
+
+      //! Update state and covariance processing all outputs at once.
+      void
+      updateBatch(void);
+
+      //! Update state and covariance processing all outputs at once,
+      //! using the sparsity pattern of the observation matrix.
+      void
+      updateBatchSparse(void);
+
+      //! Update state and covariance one output at a time.
+      void
+      updateSequential(void);
+
+      //! Update U-D factors one (decorrelated) output at a time.
+      void
+      updateFactorized(void);
+
+      //! Update state and covariance with the current outputs.
+      void
+      correct(void);
+
+      //! Get a step of the history.
+      //! @param age number of steps before the last one.
+      //! @return history step.
+      Snapshot&
+      getSnapshot(size_t age);
+
+      //! Get a step of the history.
+      //! @param age number of steps before the last one.
+      //! @return history step.
+      const Snapshot&
+      getSnapshot(size_t age) const;
+
+      //! Find the last step of the history not after a given time.
+      //! @param time time of interest.
+      //! @return age of the step or -1 if not found.
+      int
+      findSnapshot(double time) const;
+
+      //! Add a new step to the history after a prediction.
+      void
+      recordPrediction(void);
+
+      //! Copy state and covariance to the last step of the history.
+      void
+      syncHistory(void);
+
+      //! Compute U-D factors from the covariance matrix, if needed.
+      void
+      factorize(void);
+
+      //! Compute covariance matrix from its U-D factors.
+      void
+      compose(void);
+
+      //! Check if measurement noise covariance matrix is diagonal.
+      //! @return true if matrix is diagonal, false otherwise.
+      bool
+      isNoiseDiagonal(void) const;
+
       //! Kalman filter state count.
       size_t m_state_count;
       //! State vector.
@@ -359,6 +587,54 @@ namespace DUNE
       Math::Matrix m_r;
       //! Innovation vector.
       Math::Matrix m_innov;
+      //! Sparsity pattern of the transition matrices (empty if dense).
+      Pattern m_a_pattern;
+      //! Sparsity pattern of the observation matrix (empty if dense).
+      Pattern m_c_pattern;
+      //! Covariance representation.
+      CovarianceForm m_form;
+      //! True to use sequential scalar updates.
+      bool m_sequential;
+      //! True if U-D factors match the covariance matrix.
+      bool m_ud_valid;
+      //! U-D factors of the covariance (D on the diagonal).
+      Math::Matrix m_ud;
+      //! Workspace: state covariance sized products.
+      Math::Matrix m_pt;
+      //! Workspace: scratch area.
+      Math::Matrix m_work;
+      //! Workspace: innovation covariance and its factors.
+      Math::Matrix m_s;
+      //! Workspace: copy of the innovation covariance.
+      Math::Matrix m_sc;
+      //! Workspace: auxiliary products.
+      Math::Matrix m_aux;
+      //! Workspace: transposed Kalman gain.
+      Math::Matrix m_kt;
+      //! Workspace: Kalman gain.
+      Math::Matrix m_k;
+      //! Workspace: state sized vectors.
+      Math::Matrix m_v;
+      //! Workspace: output sized vectors.
+      Math::Matrix m_e;
+      //! Workspace: non-zero columns of an observation row.
+      std::vector<size_t> m_columns;
+      //! History of filter steps (ring buffer).
+      std::vector<Snapshot> m_history;
+      //! Process models referenced by the history (ring buffer).
+      std::vector<Model> m_models;
+      //! Index of the last recorded process model.
+      size_t m_model_head;
+      //! True if the process model changed since it was last recorded.
+      bool m_model_dirty;
+      //! Index of the last step of the history.
+      size_t m_history_head;
+      //! Number of steps in the history.
+      size_t m_history_count;
+      //! Maximum number of replayed steps between predictions.
+      size_t m_replay_limit;
+      //! Remaining replayed steps until the next prediction.
+      size_t m_replay_budget;
     };
   }
 }
@@ -25,17 +25,31 @@
 // Author: Jose Pinto                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
 // DUNE headers.
+#include <DUNE/Algorithms/ReedSolomon.hpp>
+#include <DUNE/Network/Fragments.hpp>
 #include <DUNE/Network/FragmentedMessage.hpp>
 
 namespace DUNE
 {
   namespace Network
   {
-    FragmentedMessage::FragmentedMessage(void)
+    FragmentedMessage::FragmentedMessage(void):
+      m_parent(NULL),
+      m_num_received(0),
+      m_data_frags(-1),
+      m_parity(false),
+      m_encoded(false),
+      m_complete(false),
+      m_frag_size(0),
+      m_total_size(0)
     {
-      m_parent = NULL;
       m_src = m_uid = m_creation_time = m_num_frags = -1;
+      std::memset(m_received, 0, sizeof(m_received));
     }
 
     void
@@ -44,6 +58,26 @@ namespace DUNE
       m_parent = parent;
     }
 
+    void
+    FragmentedMessage::error(const char* msg)
+    {
+      if (m_parent == NULL)
+        DUNE_ERR("FragmentedMessage", msg);
+      else
+        m_parent->err("%s", DTR(msg));
+    }
+
+    void
+    FragmentedMessage::store(unsigned frag_number, const char* data, unsigned size)
+    {
+      unsigned offset = frag_number * m_frag_size;
+      if (size > 0)
+        std::memcpy(&m_data[offset], data, size);
+
+      if ((int)frag_number == m_num_frags - 1)
+        m_total_size = offset + size;
+    }
+
     IMC::Message*
     FragmentedMessage::setFragment(const IMC::MessagePart* part)
     {
@@ -54,42 +88,171 @@ namespace DUNE
         m_uid = part->uid;
         m_src = part->getSource();
         m_creation_time = Time::Clock::get();
+        m_encoded = m_parity && (part->uid & Fragments::c_fec_flag) != 0;
+        m_data_frags = m_num_frags;
       }
 
       // Check if this is a valid fragment
       if (part->uid != m_uid || part->getSource() != m_src ||
           part->frag_number >= m_num_frags)
       {
-        if (m_parent == NULL)
-          DUNE_ERR("FragmentedMessage", "Invalid fragment received and it won't be processed.");
-        else
-          m_parent->err(DTR("Invalid fragment received and it won't be processed."));
+        error("Invalid fragment received and it won't be processed.");
+        return NULL;
+      }
 
+      // Duplicate fragment (e.g. retransmission).
+      if (m_complete || hasFragment(part->frag_number))
         return NULL;
+
+      if (m_encoded)
+        return setEncodedFragment(part);
+
+      bool last = (part->frag_number == m_num_frags - 1);
+
+      if (!last)
+      {
+        if (m_frag_size == 0)
+        {
+          // First full-sized fragment: allocate the reassembly buffer
+          // and place a previously received last fragment.
+          if (part->data.empty())
+          {
+            error("Invalid fragment received and it won't be processed.");
+            return NULL;
+          }
+
+          m_frag_size = part->data.size();
+          m_data.resize(m_num_frags * m_frag_size);
+
+          if (hasFragment(m_num_frags - 1))
+          {
+            if (m_tail.size() <= m_frag_size)
+            {
+              store(m_num_frags - 1, &m_tail[0], m_tail.size());
+            }
+            else
+            {
+              // Inconsistent last fragment: forget it.
+              m_received[(m_num_frags - 1) >> 5] &= ~(1u << ((m_num_frags - 1) & 31));
+              --m_num_received;
+            }
+
+            m_tail.clear();
+          }
+        }
+        else if (part->data.size() != m_frag_size)
+        {
+          error("Invalid fragment received and it won't be processed.");
+          return NULL;
+        }
+
+        store(part->frag_number, &part->data[0], part->data.size());
       }
+      else
+      {
+        if (part->data.empty())
+        {
+          error("Invalid fragment received and it won't be processed.");
+          return NULL;
+        }
 
-      m_fragments[part->frag_number] = *part;
+        if (m_num_frags == 1)
+        {
+          m_received[0] = 1;
+          m_num_received = 1;
+          return IMC::Packet::deserialize((const uint8_t*)&part->data[0],
+                                          part->data.size());
+        }
 
-      // Message is complete. Let's reassemble and return it.
+        if (m_frag_size == 0)
+        {
+          m_tail.assign(part->data.begin(), part->data.end());
+        }
+        else if (part->data.size() <= m_frag_size)
+        {
+          store(part->frag_number, &part->data[0], part->data.size());
+        }
+        else
+        {
+          error("Invalid fragment received and it won't be processed.");
+          return NULL;
+        }
+      }
+
+      m_received[part->frag_number >> 5] |= (1u << (part->frag_number & 31));
+      ++m_num_received;
+
+      // Message is complete.
       if (getFragmentsMissing() == 0)
       {
-        int i;
-        int total_length = 0;
-        // concatenate all parts into a single array
-        std::vector<char> data;
-        for (i = 0; i < m_num_frags; i++)
+        m_complete = true;
+        return IMC::Packet::deserialize(&m_data[0], m_total_size);
+      }
+
+      return NULL;
+    }
+
+    IMC::Message*
+    FragmentedMessage::setEncodedFragment(const IMC::MessagePart* part)
+    {
+      const unsigned hdr_size = Fragments::c_fec_header_size;
+
+      if (part->data.size() <= hdr_size)
+      {
+        error("Invalid fragment received and it won't be processed.");
+        return NULL;
+      }
+
+      const uint8_t* data = (const uint8_t*)&part->data[0];
+      int data_frags = data[0];
+      unsigned msg_size = data[1] | (data[2] << 8);
+      unsigned block_size = part->data.size() - hdr_size;
+
+      if (m_frag_size == 0)
+      {
+        if (data_frags == 0 || data_frags >= m_num_frags ||
+            msg_size > data_frags * block_size)
         {
-          total_length += m_fragments[i].data.size();
-          data.insert(data.end(), m_fragments[i].data.begin(),
-                      m_fragments[i].data.end());
+          error("Invalid fragment received and it won't be processed.");
+          return NULL;
         }
 
-        return IMC::Packet::deserialize((uint8_t*)&data[0], total_length);
+        m_frag_size = block_size;
+        m_data_frags = data_frags;
+        m_total_size = msg_size;
+        m_data.resize(m_num_frags * m_frag_size);
       }
-      else
+      else if (block_size != m_frag_size || data_frags != m_data_frags ||
+               msg_size != m_total_size)
       {
-        return 0;
+        error("Invalid fragment received and it won't be processed.");
+        return NULL;
       }
+
+      std::memcpy(&m_data[part->frag_number * m_frag_size], data + hdr_size, m_frag_size);
+      m_received[part->frag_number >> 5] |= (1u << (part->frag_number & 31));
+      ++m_num_received;
+
+      if (getFragmentsMissing() > 0)
+        return NULL;
+
+      std::vector<uint8_t*> blocks(m_num_frags);
+      bool present[Fragments::c_max_fragments];
+      for (int i = 0; i < m_num_frags; ++i)
+      {
+        blocks[i] = &m_data[i * m_frag_size];
+        present[i] = hasFragment(i);
+      }
+
+      Algorithms::ReedSolomon rs(m_data_frags, m_num_frags - m_data_frags);
+      if (!rs.decode(&blocks[0], present, m_frag_size))
+      {
+        error("Unable to decode fragmented message.");
+        return NULL;
+      }
+
+      m_complete = true;
+      return IMC::Packet::deserialize(&m_data[0], m_total_size);
     }
 
     double
@@ -104,12 +267,10 @@ namespace DUNE
     int
     FragmentedMessage::getFragmentsMissing(void)
     {
-      return m_num_frags - m_fragments.size();
+      return std::max(0, m_data_frags - m_num_received);
     }
 
     FragmentedMessage::~FragmentedMessage(void)
-    {
-      m_fragments.clear();
-    }
+    { }
   }
 }
@@ -28,6 +28,9 @@
 #ifndef DUNE_NETWORK_FRAGMENTED_MESSAGE_HPP_INCLUDED_
 #define DUNE_NETWORK_FRAGMENTED_MESSAGE_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/IMC.hpp>
 #include <DUNE/Tasks.hpp>
@@ -37,17 +40,49 @@ namespace DUNE
 {
   namespace Network
   {
+    //! Reassembles an IMC message from MessagePart fragments.
+    //!
+    //! Fragments are copied straight into their final position in a
+    //! reassembly buffer, which is allocated once the fragment size
+    //! is known. A bitmap keeps track of received fragments, so
+    //! duplicates are discarded and the list of missing fragments
+    //! can be handed back to the sender for selective
+    //! retransmission.
+    //!
+    //! When parity decoding is enabled, transmissions encoded with
+    //! parity fragments (see Fragments) are detected by their unique
+    //! id and rebuilt as soon as any k of their n fragments are
+    //! received. It is disabled by default, since other
+    //! implementations may send plain fragments with any unique id.
     class FragmentedMessage
     {
     public:
       FragmentedMessage(void);
 
+      //! Enable or disable the decoding of parity fragments. Must be
+      //! called before the first fragment is received.
+      //! @param[in] enabled true to decode parity fragments.
+      void
+      enableParity(bool enabled)
+      {
+        m_parity = enabled;
+      }
+
       double
       getAge(void);
 
       int
       getFragmentsMissing(void);
 
+      //! Check if a given fragment was already received.
+      //! @param[in] frag_number fragment number.
+      //! @return true if received, false otherwise.
+      bool
+      hasFragment(unsigned frag_number) const
+      {
+        return (m_received[frag_number >> 5] & (1u << (frag_number & 31))) != 0;
+      }
+
       IMC::Message*
       setFragment(const IMC::MessagePart* part);
 
@@ -57,12 +92,43 @@ namespace DUNE
       ~FragmentedMessage(void);
 
     private:
+      //! Number of 32-bit words in the reception bitmap.
+      static const unsigned c_bitmap_words = 8;
+
       int m_src;
       int m_uid;
       int m_num_frags;
       double m_creation_time;
       DUNE::Tasks::Task* m_parent;
-      std::map<unsigned int, IMC::MessagePart> m_fragments;
+      //! Number of distinct fragments received.
+      int m_num_received;
+      //! Number of fragments needed to rebuild the message.
+      int m_data_frags;
+      //! True if parity fragments may be decoded.
+      bool m_parity;
+      //! True if parity fragments are used.
+      bool m_encoded;
+      //! True if the message was already rebuilt.
+      bool m_complete;
+      //! Payload size of all but the last fragment.
+      unsigned m_frag_size;
+      //! Size of the reassembled message.
+      unsigned m_total_size;
+      //! Reception bitmap.
+      uint32_t m_received[c_bitmap_words];
+      //! Reassembly buffer.
+      std::vector<uint8_t> m_data;
+      //! Last fragment, kept aside until the fragment size is known.
+      std::vector<char> m_tail;
+
+      void
+      error(const char* msg);
+
+      void
+      store(unsigned frag_number, const char* data, unsigned size);
+
+      IMC::Message*
+      setEncodedFragment(const IMC::MessagePart* part);
     };
   }
 }
@@ -25,7 +25,13 @@
 // Author: Jose Pinto                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 // DUNE headers.
+#include <DUNE/Algorithms/ReedSolomon.hpp>
 #include <DUNE/Network/Fragments.hpp>
 
 namespace DUNE
@@ -34,41 +40,132 @@ namespace DUNE
   {
     int Fragments::s_uid = 0;
 
-    Fragments::Fragments(IMC::Message* msg, int mtu)
+    Fragments::Fragments(const IMC::Message* msg, int mtu, float redundancy):
+      m_num_frags(0),
+      m_data_frags(0),
+      m_frag_size(0)
     {
-      m_uid = s_uid++;
-      m_num_frags = 0;
+      m_uid = s_uid++ & (c_fec_flag - 1);
       int frag_size = mtu - sizeof(IMC::Header) - 5;
+      if (redundancy > 0)
+        frag_size -= c_fec_header_size;
+
       if (frag_size <= 0)
       {
         DUNE_ERR("Fragments", "MTU is too small");
         return;
       }
 
-      Utils::ByteBuffer buff;
-      int size = IMC::Packet::serialize(msg, buff);
-      uint8_t* buffer = buff.getBuffer();
+      // Receivers cannot deserialize larger messages.
+      if (msg->getSerializationSize() > c_max_message_size)
+      {
+        DUNE_ERR("Fragments", "message is too large to be fragmented");
+        return;
+      }
+
+      if (redundancy <= 0)
+      {
+        int size = IMC::Packet::serialize(msg, m_buffer);
+        int num_frags = (size + frag_size - 1) / frag_size;
+
+        if (num_frags > c_max_fragments)
+        {
+          DUNE_ERR("Fragments", "message is too large to be fragmented");
+          return;
+        }
+
+        m_frag_size = frag_size;
+        m_num_frags = num_frags;
+        m_data_frags = num_frags;
+        m_fragments.resize(m_num_frags, NULL);
+        return;
+      }
+
+      Utils::ByteBuffer bfr;
+      int size = IMC::Packet::serialize(msg, bfr);
+      int data_frags = (size + frag_size - 1) / frag_size;
+      int parity_frags = (int)std::ceil(data_frags * redundancy);
+      parity_frags = std::min(parity_frags, c_max_fragments - data_frags);
+
+      if (parity_frags <= 0)
+      {
+        DUNE_ERR("Fragments", "message is too large to be fragmented");
+        return;
+      }
+
+      m_uid |= c_fec_flag;
+      m_data_frags = data_frags;
+      m_num_frags = data_frags + parity_frags;
+      m_frag_size = frag_size + c_fec_header_size;
+      m_buffer.setSize(m_num_frags * m_frag_size);
+      m_fragments.resize(m_num_frags, NULL);
 
-      int part = 0, pos = 0;
-      m_num_frags = (int)std::ceil((float)size / (float)mtu);
+      // Lay out fragments as [k][size (LE)][block], zero padding the
+      // last data block.
+      std::vector<uint8_t*> blocks(m_num_frags);
+      for (int i = 0; i < m_num_frags; ++i)
+      {
+        uint8_t* slot = m_buffer.getBuffer() + i * m_frag_size;
+        slot[0] = data_frags;
+        slot[1] = size & 0xff;
+        slot[2] = (size >> 8) & 0xff;
+        blocks[i] = slot + c_fec_header_size;
+
+        if (i < data_frags)
+        {
+          int pos = i * frag_size;
+          int cur_size = std::min(size - pos, frag_size);
+          std::memcpy(blocks[i], bfr.getBuffer() + pos, cur_size);
+          std::memset(blocks[i] + cur_size, 0, frag_size - cur_size);
+        }
+      }
+
+      Algorithms::ReedSolomon rs(data_frags, parity_frags);
+      rs.encode(&blocks[0], &blocks[data_frags], frag_size);
+    }
 
-      while (pos < size)
+    const uint8_t*
+    Fragments::getFragmentData(int frag_number, unsigned& size) const
+    {
+      if (frag_number < 0 || frag_number >= m_num_frags)
       {
-        int remaining = size - pos;
-        int cur_size = std::min(remaining, mtu);
-        IMC::MessagePart* mpart = new IMC::MessagePart();
-        mpart->frag_number = part++;
-        mpart->num_frags = m_num_frags;
-        mpart->uid = m_uid;
-        mpart->data.assign(buffer + pos, buffer + pos + cur_size);
-        pos += cur_size;
-        m_fragments.push_back(mpart);
+        size = 0;
+        return NULL;
       }
+
+      unsigned pos = frag_number * m_frag_size;
+      size = std::min(m_buffer.getSize() - pos, m_frag_size);
+      return m_buffer.getBuffer() + pos;
+    }
+
+    bool
+    Fragments::getFragment(int frag_number, IMC::MessagePart& part) const
+    {
+      unsigned size = 0;
+      const uint8_t* data = getFragmentData(frag_number, size);
+      if (data == NULL)
+        return false;
+
+      part.uid = m_uid;
+      part.frag_number = frag_number;
+      part.num_frags = m_num_frags;
+      part.data.assign(data, data + size);
+      return true;
     }
 
     IMC::MessagePart*
     Fragments::getFragment(int frag_number)
     {
+      if (frag_number < 0 || frag_number >= m_num_frags)
+        return NULL;
+
+      if (m_fragments[frag_number] == NULL)
+      {
+        IMC::MessagePart* part = new IMC::MessagePart();
+        getFragment(frag_number, *part);
+        m_fragments[frag_number] = part;
+      }
+
       return m_fragments[frag_number];
     }
 
@@ -80,8 +177,10 @@ namespace DUNE
 
     Fragments::~Fragments(void)
     {
+      for (size_t i = 0; i < m_fragments.size(); ++i)
+        delete m_fragments[i];
+
       m_fragments.clear();
     }
-
-  } /* namespace Fragments */
-} /* namespace Transports */
+  } /* namespace Network */
+} /* namespace DUNE */
@@ -28,34 +28,136 @@
 #ifndef DUNE_NETWORK_FRAGMENTS_HPP_INCLUDED_
 #define DUNE_NETWORK_FRAGMENTS_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/IMC.hpp>
 #include <DUNE/Tasks.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
 
 namespace DUNE
 {
   namespace Network
   {
+    //! Splits an IMC message into MessagePart fragments.
+    //!
+    //! The message is serialized once into an internal buffer and
+    //! every fragment is a view (offset and size) into that
+    //! buffer. MessagePart objects are only materialized on demand,
+    //! either into a caller supplied object (no allocation when the
+    //! object is reused) or lazily through getFragment().
+    //!
+    //! Optionally, parity fragments are appended using a systematic
+    //! Reed-Solomon erasure code, so that the message can be
+    //! recovered from any k of the n transmitted fragments. Encoded
+    //! transmissions have the most significant bit of the unique id
+    //! set and every fragment starts with a small header holding k
+    //! and the size of the serialized message. Other implementations
+    //! use the whole range of unique ids for plain transmissions, so
+    //! parity fragments must only be sent to receivers that enabled
+    //! parity decoding (see FragmentedMessage::enableParity).
     class Fragments
     {
     public:
-      Fragments(IMC::Message* message, int mtu);
+      //! Maximum number of fragments per message.
+      static const int c_max_fragments = 255;
+      //! Maximum size of a serialized message.
+      static const unsigned c_max_message_size = 65535;
+      //! Unique id flag of encoded transmissions.
+      static const unsigned c_fec_flag = 0x80;
+      //! Size of the header of encoded fragments.
+      static const unsigned c_fec_header_size = 3;
+
+      //! Constructor.
+      //! @param[in] message message to fragment.
+      //! @param[in] mtu maximum transmission unit of the link.
+      //! @param[in] redundancy number of parity fragments relative to
+      //! the number of data fragments (e.g. 0.5 adds one parity
+      //! fragment per two data fragments). Zero disables encoding.
+      Fragments(const IMC::Message* message, int mtu, float redundancy = 0.0f);
 
+      //! Retrieve a fragment. The returned object is owned by this
+      //! instance and created on first access.
+      //! @param[in] frag_number fragment number.
+      //! @return fragment or NULL if frag_number is out of range.
       IMC::MessagePart*
       getFragment(int frag_number);
 
+      //! Fill a caller supplied MessagePart with a fragment.
+      //! @param[in] frag_number fragment number.
+      //! @param[out] part message part to fill.
+      //! @return true if the fragment exists, false otherwise.
+      bool
+      getFragment(int frag_number, IMC::MessagePart& part) const;
+
+      //! Retrieve a view of a fragment's payload inside the
+      //! serialized message buffer.
+      //! @param[in] frag_number fragment number.
+      //! @param[out] size size of the fragment in bytes.
+      //! @return pointer to the first byte of the fragment or NULL if
+      //! frag_number is out of range.
+      const uint8_t*
+      getFragmentData(int frag_number, unsigned& size) const;
+
       int
       getNumberOfFragments(void);
 
+      //! Retrieve the number of fragments needed to rebuild the
+      //! message (equal to the number of fragments if not encoded).
+      //! @return number of data fragments.
+      int
+      getNumberOfDataFragments(void) const
+      {
+        return m_data_frags;
+      }
+
+      //! Check if parity fragments are present.
+      //! @return true if encoded, false otherwise.
+      bool
+      isEncoded(void) const
+      {
+        return (m_uid & c_fec_flag) != 0;
+      }
+
+      //! Retrieve the payload size of all but the last fragment.
+      //! @return fragment size in bytes.
+      unsigned
+      getFragmentSize(void) const
+      {
+        return m_frag_size;
+      }
+
+      //! Retrieve the transmission unique id.
+      //! @return unique id.
+      int
+      getUid(void) const
+      {
+        return m_uid;
+      }
+
       ~Fragments(void);
 
     private:
       static int s_uid;
       int m_uid;
       int m_num_frags;
+      //! Number of data fragments.
+      int m_data_frags;
+      //! Payload size of all but the last fragment.
+      unsigned m_frag_size;
+      //! Serialized message (or encoded fragments).
+      Utils::ByteBuffer m_buffer;
+      //! Lazily created fragments.
       std::vector<IMC::MessagePart*> m_fragments;
-    };
 
+      //! Non-copyable.
+      Fragments(const Fragments&);
+
+      //! Non-assignable.
+      Fragments&
+      operator=(const Fragments&);
+    };
   }
 }
 
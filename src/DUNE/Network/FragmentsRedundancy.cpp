@@ -22,50 +22,45 @@
 // language governing permissions and limitations at                        *
 // https://www.lsts.pt/dune/licence.                                        *
 //***************************************************************************
-// Author: Eduardo Marques                                                  *
+// Author: Jose Pinto                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <stdexcept>
+
 // DUNE headers.
+#include <DUNE/I18N.hpp>
 #include <DUNE/IMC/Factory.hpp>
-#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Utils/String.hpp>
-#include <DUNE/Tasks/RateLimiters.hpp>
+#include <DUNE/Network/FragmentsRedundancy.hpp>
 
 namespace DUNE
 {
-  namespace Tasks
+  namespace Network
   {
-    RateLimiters::RateLimiters(void)
+    FragmentsRedundancy::FragmentsRedundancy(void):
+      m_fallback(0.0f)
     { }
 
-    RateLimiters::~RateLimiters(void)
+    FragmentsRedundancy::~FragmentsRedundancy(void)
     { }
 
-    bool
-    RateLimiters::filter(const IMC::Message* msg)
+    float
+    FragmentsRedundancy::get(const IMC::Message* msg) const
     {
-      uint32_t mid = msg->getId();
-      RateMap::iterator rmitr = m_rates.find(mid);
-
-      if (rmitr != m_rates.end())
-      {
-        double now = Time::Clock::get();
-        double& stime = m_stimes[MsgKey(mid, msg->getSourceEntity())];
-
-        if (stime + rmitr->second > now)
-          return true;
+      RedundancyMap::const_iterator itr = m_redundancy.find(msg->getId());
+      if (itr == m_redundancy.end())
+        return m_fallback;
 
-        stime = now;
-      }
-
-      return false;
+      return itr->second;
     }
 
     void
-    RateLimiters::setup(const std::vector<std::string>& spec)
+    FragmentsRedundancy::setup(const std::vector<std::string>& spec, float fallback)
     {
-      m_rates.clear();
-      m_stimes.clear();
+      m_redundancy.clear();
+      m_fallback = fallback;
 
       for (unsigned int i = 0; i < spec.size(); ++i)
       {
@@ -75,14 +70,15 @@ namespace DUNE
         if (parts.size() == 2)
         {
           uint32_t id = IMC::Factory::getIdFromAbbrev(parts[0]);
-          double rate = 0;
-          if (std::sscanf(parts[1].c_str(), "%lf", &rate) && rate > 0)
+          float redundancy = 0;
+          if (std::sscanf(parts[1].c_str(), "%f", &redundancy) == 1 && redundancy >= 0)
           {
-            m_rates[id] = 1.0 / rate;
+            m_redundancy[id] = redundancy;
             continue;
           }
         }
-        throw std::runtime_error(Utils::String::str(DTR("invalid rate limiter: %s"), spec[i].c_str()));
+
+        throw std::runtime_error(Utils::String::str(DTR("invalid redundancy: %s"), spec[i].c_str()));
       }
     }
   }
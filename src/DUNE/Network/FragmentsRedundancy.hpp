@@ -22,45 +22,53 @@
 // language governing permissions and limitations at                        *
 // https://www.lsts.pt/dune/licence.                                        *
 //***************************************************************************
-// Author: Eduardo Marques                                                  *
+// Author: Jose Pinto                                                       *
 //***************************************************************************
 
-#ifndef DUNE_TASKS_RATE_LIMITERS_HPP_INCLUDED_
-#define DUNE_TASKS_RATE_LIMITERS_HPP_INCLUDED_
+#ifndef DUNE_NETWORK_FRAGMENTS_REDUNDANCY_HPP_INCLUDED_
+#define DUNE_NETWORK_FRAGMENTS_REDUNDANCY_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
-#include <vector>
 #include <map>
+#include <string>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/IMC/Message.hpp>
 
 namespace DUNE
 {
-  namespace Tasks
+  namespace Network
   {
-    class RateLimiters
+    //! Per message redundancy of fragmented transmissions (see
+    //! Fragments).
+    class FragmentsRedundancy
     {
     public:
-      RateLimiters(void);
+      FragmentsRedundancy(void);
 
-      ~RateLimiters(void);
+      ~FragmentsRedundancy(void);
 
+      //! Configure redundancy.
+      //! @param[in] spec list of "Abbrev:Redundancy" entries, where
+      //! redundancy is the number of parity fragments relative to the
+      //! number of data fragments.
+      //! @param[in] fallback redundancy of unlisted messages.
       void
-      setup(const std::vector<std::string>& spec);
+      setup(const std::vector<std::string>& spec, float fallback = 0.0f);
 
-      bool
-      filter(const IMC::Message* msg);
+      //! Retrieve the redundancy to use for a given message.
+      //! @param[in] msg message.
+      //! @return redundancy.
+      float
+      get(const IMC::Message* msg) const;
 
     private:
-      // Rate limiters.
-      typedef std::map<uint32_t, double> RateMap;
-      RateMap m_rates;
-
-      // Send times.
-      typedef std::pair<uint32_t, unsigned int> MsgKey;
-      typedef std::map<MsgKey, double> STimesMap;
-      STimesMap m_stimes;
+      typedef std::map<uint32_t, float> RedundancyMap;
+      //! Redundancy per message identifier.
+      RedundancyMap m_redundancy;
+      //! Redundancy of unlisted messages.
+      float m_fallback;
     };
   }
 }
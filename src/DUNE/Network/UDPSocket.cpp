@@ -184,6 +184,19 @@ namespace DUNE
         throw NetworkError(DTR("unable to bind to socket"), DUNE_SOCKET_ERROR);
     }
 
+    uint16_t
+    UDPSocket::getBoundPort(void)
+    {
+      sockaddr_in name;
+      socklen_t size = sizeof(name);
+      std::memset((char*)&name, 0, size);
+
+      if (getsockname(m_handle, (::sockaddr*)&name, &size) != 0)
+        throw NetworkError(DTR("unable to get bound port"), DUNE_SOCKET_ERROR);
+
+      return Utils::ByteCopy::fromBE(name.sin_port);
+    }
+
     size_t
     UDPSocket::read(uint8_t* buffer, size_t size, Address* addr)
     {
@@ -71,6 +71,11 @@ namespace DUNE
       void
       bind(uint16_t port = 0, Address add = Address::Any, bool reuse = true);
 
+      //! Retrieve the port the socket is bound to.
+      //! @return bound port.
+      uint16_t
+      getBoundPort(void);
+
       void
       connect(const Address& addr, uint16_t port)
       {
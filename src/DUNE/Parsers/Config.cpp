@@ -35,9 +35,11 @@
 #include <cstdlib>
 #include <fstream>
 #include <algorithm>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/Version.hpp>
+#include <DUNE/Algorithms/MD5.hpp>
 #include <DUNE/System/Error.hpp>
 #include <DUNE/FileSystem/Path.hpp>
 #include <DUNE/Utils/String.hpp>
@@ -53,6 +55,43 @@ namespace DUNE
 
     //! Maximum buffer size.
     static const size_t c_max_bfr_size = 1024;
+    //! Identifier and version of the cache format.
+    static const char c_cache_magic[] = "DUNECFG2";
+    //! Maximum size of a string in the cache.
+    static const uint32_t c_cache_max_string = 1 << 20;
+
+    static void
+    writeCacheSize(std::ostream& os, uint32_t value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static void
+    writeCacheString(std::ostream& os, const std::string& str)
+    {
+      writeCacheSize(os, str.size());
+      os.write(str.data(), str.size());
+    }
+
+    static bool
+    readCacheSize(std::istream& is, uint32_t& value)
+    {
+      is.read(reinterpret_cast<char*>(&value), sizeof(value));
+      return is.good();
+    }
+
+    static bool
+    readCacheString(std::istream& is, std::string& str)
+    {
+      uint32_t size = 0;
+      if (!readCacheSize(is, size) || size > c_cache_max_string)
+        return false;
+
+      str.resize(size);
+      if (size > 0)
+        is.read(&str[0], size);
+      return is.good();
+    }
 
     Config::Config(const char* fname)
     {
@@ -61,6 +100,56 @@ namespace DUNE
 
     void
     Config::parseFile(const char* fname)
+    {
+      parse(fname);
+      m_roots.push_back(fname);
+    }
+
+    bool
+    Config::parseFile(const char* fname, const char* cache)
+    {
+      if (readCache(cache, fname))
+        return true;
+
+      parseFile(fname);
+
+      try
+      {
+        writeCache(cache);
+      }
+      catch (std::exception& e)
+      {
+        DUNE_WRN("Config", e.what());
+      }
+
+      return false;
+    }
+
+    Config::Stamp
+    Config::getStamp(const std::string& fname)
+    {
+      Path path(fname);
+      Stamp stamp;
+      stamp.size = path.isFile() ? path.size() : -1;
+      std::memset(stamp.digest, 0, sizeof(stamp.digest));
+
+      if (stamp.size >= 0)
+      {
+        try
+        {
+          Algorithms::MD5::compute(fname.c_str(), stamp.digest);
+        }
+        catch (std::exception&)
+        {
+          stamp.size = -1;
+        }
+      }
+
+      return stamp;
+    }
+
+    void
+    Config::parse(const char* fname)
     {
       char line[c_max_bfr_size] = {0};
       char section[c_max_bfr_size] = {0};
@@ -71,6 +160,8 @@ namespace DUNE
       char iopt[c_max_bfr_size] = {0};
       size_t line_count = 0;
       size_t section_count = 0;
+      // Changes made while parsing must be seen by isModified().
+      m_stamps[fname] = getStamp(fname);
       std::FILE* fd = std::fopen(fname, "r");
 
       if (fd == 0)
@@ -92,9 +183,10 @@ namespace DUNE
           if (std::strncmp(section, "Include ", 8) == 0)
           {
             Path path = Path(fname).dirname() / String::trim(section + 8);
+            m_includes[fname].push_back(path.str());
             try
             {
-              parseFile(path.c_str());
+              parse(path.c_str());
             }
             catch (FileOpenError& e)
             {
@@ -104,7 +196,8 @@ namespace DUNE
           else if (std::strncmp(section, "Require ", 8) == 0)
           {
             Path path = Path(fname).dirname() / String::trim(section + 8);
-            parseFile(path.c_str());
+            m_includes[fname].push_back(path.str());
+            parse(path.c_str());
           }
 
           ++section_count;
@@ -119,6 +212,7 @@ namespace DUNE
           String::rtrim(arg);
           std::strncpy(tmp, option, c_max_bfr_size);
           m_data[section][option] = arg;
+          m_parsed[section][option] = arg;
 
           if (std::strlen(arg) < 4)
             continue;
@@ -135,6 +229,7 @@ namespace DUNE
             throw InvalidReference(arg);
 
           m_data[section][option] = m_data[isec][iopt];
+          m_parsed[section][option] = m_data[isec][iopt];
         }
         // Multiline argument
         else if (std::sscanf(line, " %[^\n|;|#] ", arg) == 1)
@@ -145,6 +240,8 @@ namespace DUNE
           String::rtrim(arg);
           m_data[section][tmp] += " ";
           m_data[section][tmp] += arg;
+          m_parsed[section][tmp] += " ";
+          m_parsed[section][tmp] += arg;
         }
         // Error
         else
@@ -158,6 +255,247 @@ namespace DUNE
       m_files.push_back(fname);
     }
 
+    void
+    Config::writeCache(const char* fname) const
+    {
+      std::ofstream os(fname, std::ios::binary);
+      if (!os.is_open())
+        throw FileOpenError(fname, System::Error::getLastMessage());
+
+      os.write(c_cache_magic, sizeof(c_cache_magic));
+
+      writeCacheSize(os, m_roots.size());
+      for (size_t i = 0; i < m_roots.size(); ++i)
+        writeCacheString(os, m_roots[i]);
+
+      writeCacheSize(os, m_files.size());
+      for (size_t i = 0; i < m_files.size(); ++i)
+        writeCacheString(os, m_files[i]);
+
+      writeCacheSize(os, m_stamps.size());
+      std::map<std::string, Stamp>::const_iterator sitr = m_stamps.begin();
+      for (; sitr != m_stamps.end(); ++sitr)
+      {
+        writeCacheString(os, sitr->first);
+        os.write(reinterpret_cast<const char*>(&sitr->second.size), sizeof(int64_t));
+        os.write(reinterpret_cast<const char*>(sitr->second.digest), sizeof(sitr->second.digest));
+      }
+
+      writeCacheSize(os, m_includes.size());
+      std::map<std::string, std::vector<std::string> >::const_iterator iitr = m_includes.begin();
+      for (; iitr != m_includes.end(); ++iitr)
+      {
+        writeCacheString(os, iitr->first);
+        writeCacheSize(os, iitr->second.size());
+        for (size_t i = 0; i < iitr->second.size(); ++i)
+          writeCacheString(os, iitr->second[i]);
+      }
+
+      writeCacheSize(os, m_parsed.size());
+      Sections::const_iterator pitr = m_parsed.begin();
+      for (; pitr != m_parsed.end(); ++pitr)
+      {
+        writeCacheString(os, pitr->first);
+        writeCacheSize(os, pitr->second.size());
+        Section::const_iterator oitr = pitr->second.begin();
+        for (; oitr != pitr->second.end(); ++oitr)
+        {
+          writeCacheString(os, oitr->first);
+          writeCacheString(os, oitr->second);
+        }
+      }
+
+      if (!os.good())
+        throw std::runtime_error(String::str(DTR("failed to write configuration cache %s"), fname));
+    }
+
+    bool
+    Config::readCache(const char* fname, const char* root)
+    {
+      std::ifstream is(fname, std::ios::binary);
+      if (!is.is_open())
+        return false;
+
+      char magic[sizeof(c_cache_magic)];
+      is.read(magic, sizeof(magic));
+      if (!is.good() || std::memcmp(magic, c_cache_magic, sizeof(magic)) != 0)
+        return false;
+
+      // The cache must have been produced by parsing the same file.
+      uint32_t count = 0;
+      std::string str;
+      if (!readCacheSize(is, count) || count != 1)
+        return false;
+      if (!readCacheString(is, str) || str != root)
+        return false;
+
+      std::vector<std::string> files;
+      if (!readCacheSize(is, count))
+        return false;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        if (!readCacheString(is, str))
+          return false;
+        files.push_back(str);
+      }
+
+      // All files must be unchanged.
+      std::map<std::string, Stamp> stamps;
+      if (!readCacheSize(is, count))
+        return false;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        Stamp stamp;
+        if (!readCacheString(is, str))
+          return false;
+        is.read(reinterpret_cast<char*>(&stamp.size), sizeof(int64_t));
+        is.read(reinterpret_cast<char*>(stamp.digest), sizeof(stamp.digest));
+        if (!is.good() || !(getStamp(str) == stamp))
+          return false;
+        stamps[str] = stamp;
+      }
+
+      std::map<std::string, std::vector<std::string> > includes;
+      if (!readCacheSize(is, count))
+        return false;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        uint32_t size = 0;
+        std::string file;
+        if (!readCacheString(is, file) || !readCacheSize(is, size))
+          return false;
+
+        for (uint32_t j = 0; j < size; ++j)
+        {
+          if (!readCacheString(is, str))
+            return false;
+          includes[file].push_back(str);
+        }
+      }
+
+      Sections parsed;
+      if (!readCacheSize(is, count))
+        return false;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        uint32_t size = 0;
+        std::string section;
+        if (!readCacheString(is, section) || !readCacheSize(is, size))
+          return false;
+
+        Section& options = parsed[section];
+        for (uint32_t j = 0; j < size; ++j)
+        {
+          std::string value;
+          if (!readCacheString(is, str) || !readCacheString(is, value))
+            return false;
+          options[str] = value;
+        }
+      }
+
+      Sections::const_iterator pitr = parsed.begin();
+      for (; pitr != parsed.end(); ++pitr)
+      {
+        Section::const_iterator oitr = pitr->second.begin();
+        for (; oitr != pitr->second.end(); ++oitr)
+        {
+          m_data[pitr->first][oitr->first] = oitr->second;
+          m_parsed[pitr->first][oitr->first] = oitr->second;
+        }
+      }
+
+      m_files.insert(m_files.end(), files.begin(), files.end());
+      m_roots.push_back(root);
+      m_stamps.insert(stamps.begin(), stamps.end());
+      m_includes.insert(includes.begin(), includes.end());
+      return true;
+    }
+
+    bool
+    Config::isModified(void) const
+    {
+      std::map<std::string, Stamp>::const_iterator itr = m_stamps.begin();
+      for (; itr != m_stamps.end(); ++itr)
+      {
+        if (!(getStamp(itr->first) == itr->second))
+          return true;
+      }
+
+      return false;
+    }
+
+    Config::Changes
+    Config::reload(void)
+    {
+      Changes changed;
+      if (!isModified())
+        return changed;
+
+      Config fresh;
+      for (size_t i = 0; i < m_roots.size(); ++i)
+        fresh.parseFile(m_roots[i].c_str());
+
+      // Sections of both the old and the new files.
+      std::set<std::string> names;
+      Sections::const_iterator sitr = m_parsed.begin();
+      for (; sitr != m_parsed.end(); ++sitr)
+        names.insert(sitr->first);
+      for (sitr = fresh.m_parsed.begin(); sitr != fresh.m_parsed.end(); ++sitr)
+        names.insert(sitr->first);
+
+      const Section empty;
+      std::set<std::string>::const_iterator nitr = names.begin();
+      for (; nitr != names.end(); ++nitr)
+      {
+        Sections::const_iterator old_itr = m_parsed.find(*nitr);
+        Sections::const_iterator new_itr = fresh.m_parsed.find(*nitr);
+        const Section& old_options = (old_itr == m_parsed.end()) ? empty : old_itr->second;
+        const Section& new_options = (new_itr == fresh.m_parsed.end()) ? empty : new_itr->second;
+        if (old_options == new_options)
+          continue;
+
+        std::vector<std::string>& keys = changed[*nitr];
+        Section& options = m_data[*nitr];
+
+        Section::const_iterator itr = old_options.begin();
+        for (; itr != old_options.end(); ++itr)
+        {
+          if (new_options.find(itr->first) == new_options.end())
+          {
+            options.erase(itr->first);
+            keys.push_back(itr->first);
+          }
+        }
+
+        for (itr = new_options.begin(); itr != new_options.end(); ++itr)
+        {
+          Section::const_iterator prev = old_options.find(itr->first);
+          if (prev == old_options.end() || prev->second != itr->second)
+          {
+            options[itr->first] = itr->second;
+            keys.push_back(itr->first);
+          }
+        }
+      }
+
+      m_parsed.swap(fresh.m_parsed);
+      m_files.swap(fresh.m_files);
+      m_includes.swap(fresh.m_includes);
+      m_stamps.swap(fresh.m_stamps);
+
+      return changed;
+    }
+
+    std::vector<std::string>
+    Config::getIncludes(const std::string& fname) const
+    {
+      std::map<std::string, std::vector<std::string> >::const_iterator itr = m_includes.find(fname);
+      if (itr == m_includes.end())
+        return std::vector<std::string>();
+
+      return itr->second;
+    }
+
     void
     Config::writeToFile(const char* file)
     {
@@ -60,6 +60,9 @@ namespace DUNE
     class Config
     {
     public:
+      //! Names of changed options, indexed by section.
+      typedef std::map<std::string, std::vector<std::string> > Changes;
+
       //! Default constructor.
       Config(void)
       { }
@@ -73,6 +76,43 @@ namespace DUNE
       void
       parseFile(const char* fname);
 
+      //! Parse a configuration file, or load its contents from a
+      //! cache if none of the files it includes changed since the
+      //! cache was written. The cache is rewritten if it is stale.
+      //! @param fname name of the configuration file to parse.
+      //! @param cache name of the cache file.
+      //! @return true if the cache was used, false otherwise.
+      bool
+      parseFile(const char* fname, const char* cache);
+
+      //! Write the contents of the parsed configuration files, with
+      //! the modification times of each file, to a binary cache.
+      //! @param fname name of the cache file.
+      //! @throw std::runtime_error if the cache cannot be written.
+      void
+      writeCache(const char* fname) const;
+
+      //! Test if any of the parsed configuration files changed since
+      //! it was parsed.
+      //! @return true if a file changed, false otherwise.
+      bool
+      isModified(void) const;
+
+      //! Parse again the configuration files if any of them changed,
+      //! keeping the values of options that were set after parsing
+      //! unless they changed in the files.
+      //! @return names of the options that changed, were added or
+      //! were removed in the files, indexed by section.
+      Changes
+      reload(void);
+
+      //! Retrieve the files directly included by a configuration
+      //! file.
+      //! @param[in] fname name of the configuration file.
+      //! @return list of included files.
+      std::vector<std::string>
+      getIncludes(const std::string& fname) const;
+
       //! Set a configuration parameter.
       //! @param section section.
       //! @param option option.
@@ -88,9 +128,17 @@ namespace DUNE
       //! @param option option.
       //! @return option value.
       std::string
-      get(const std::string& section, const std::string& option)
+      get(const std::string& section, const std::string& option) const
       {
-        return m_data[section][option];
+        Sections::const_iterator sitr = m_data.find(section);
+        if (sitr == m_data.end())
+          return "";
+
+        Section::const_iterator oitr = sitr->second.find(option);
+        if (oitr == sitr->second.end())
+          return "";
+
+        return oitr->second;
       }
 
       //! Set the option map of a given section.
@@ -106,9 +154,13 @@ namespace DUNE
       //! @param[in] section section name.
       //! @return map of <option, value>.
       std::map<std::string, std::string>
-      getSection(const std::string& section)
+      getSection(const std::string& section) const
       {
-        return m_data[section];
+        Sections::const_iterator sitr = m_data.find(section);
+        if (sitr == m_data.end())
+          return std::map<std::string, std::string>();
+
+        return sitr->second;
       }
 
       //! Retrieve the value of an option in a given section and perform type conversion.
@@ -120,9 +172,11 @@ namespace DUNE
       void
       get(const std::string& sec, const std::string& opt, const std::string& def, Type& var)
       {
-        if (m_data[sec].find(opt) != m_data[sec].end())
+        Sections::const_iterator sitr = m_data.find(sec);
+        if (sitr != m_data.end())
         {
-          if (castLexical(m_data[sec][opt], var))
+          Section::const_iterator oitr = sitr->second.find(opt);
+          if (oitr != sitr->second.end() && castLexical(oitr->second, var))
             return;
         }
 
@@ -194,10 +248,55 @@ namespace DUNE
     private:
       typedef std::map<std::string, std::string> Section;
       typedef std::map<std::string, Section> Sections;
+
+      //! Size and content digest of a parsed file. Modification
+      //! times are too coarse to notice quick edits that keep the
+      //! size of a file.
+      struct Stamp
+      {
+        int64_t size;
+        uint8_t digest[16];
+
+        bool
+        operator==(const Stamp& other) const
+        {
+          return size == other.size && std::memcmp(digest, other.digest, sizeof(digest)) == 0;
+        }
+      };
+
       //! Representation of the configuration file as a map.
       Sections m_data;
+      //! Options as given in the parsed files.
+      Sections m_parsed;
       //! List of parsed files.
       std::vector<std::string> m_files;
+      //! Files given to parseFile().
+      std::vector<std::string> m_roots;
+      //! Files directly included by each parsed file.
+      std::map<std::string, std::vector<std::string> > m_includes;
+      //! Size and content digest of each parsed file.
+      std::map<std::string, Stamp> m_stamps;
+
+      //! Parse a configuration file and the files it includes.
+      //! @param fname name of the configuration file to parse.
+      void
+      parse(const char* fname);
+
+      //! Read the size and content digest of a file.
+      //! @param[in] fname file name.
+      //! @return size and content digest (size is negative if the
+      //! file does not exist).
+      static Stamp
+      getStamp(const std::string& fname);
+
+      //! Load the contents of a cache written by writeCache().
+      //! @param[in] fname name of the cache file.
+      //! @param[in] root name of the configuration file that must
+      //! have been parsed to produce the cache.
+      //! @return true if the cache was valid and loaded, false
+      //! otherwise.
+      bool
+      readCache(const char* fname, const char* root);
 
       // Non - copyable.
       Config(const Config&);
@@ -0,0 +1,301 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/MatrixKernels.hpp>
+#include <DUNE/Simulation/Integrator.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    // Dormand-Prince 5(4) coefficients.
+    static const double c_a21 = 1.0 / 5.0;
+    static const double c_a31 = 3.0 / 40.0;
+    static const double c_a32 = 9.0 / 40.0;
+    static const double c_a41 = 44.0 / 45.0;
+    static const double c_a42 = -56.0 / 15.0;
+    static const double c_a43 = 32.0 / 9.0;
+    static const double c_a51 = 19372.0 / 6561.0;
+    static const double c_a52 = -25360.0 / 2187.0;
+    static const double c_a53 = 64448.0 / 6561.0;
+    static const double c_a54 = -212.0 / 729.0;
+    static const double c_a61 = 9017.0 / 3168.0;
+    static const double c_a62 = -355.0 / 33.0;
+    static const double c_a63 = 46732.0 / 5247.0;
+    static const double c_a64 = 49.0 / 176.0;
+    static const double c_a65 = -5103.0 / 18656.0;
+    static const double c_b1 = 35.0 / 384.0;
+    static const double c_b3 = 500.0 / 1113.0;
+    static const double c_b4 = 125.0 / 192.0;
+    static const double c_b5 = -2187.0 / 6784.0;
+    static const double c_b6 = 11.0 / 84.0;
+    static const double c_e1 = 71.0 / 57600.0;
+    static const double c_e3 = -71.0 / 16695.0;
+    static const double c_e4 = 71.0 / 1920.0;
+    static const double c_e5 = -17253.0 / 339200.0;
+    static const double c_e6 = 22.0 / 525.0;
+    static const double c_e7 = -1.0 / 40.0;
+    //! Step size safety factor.
+    static const double c_safety = 0.9;
+    //! Smallest step size change factor.
+    static const double c_min_factor = 0.2;
+    //! Largest step size change factor.
+    static const double c_max_factor = 5.0;
+
+    Integrator::Integrator(Method method):
+      m_method(method),
+      m_abs_tol(1e-6),
+      m_rel_tol(1e-6),
+      m_min_step(1e-6),
+      m_max_step(0.0),
+      m_step(0.0),
+      m_rejected(0)
+    { }
+
+    void
+    Integrator::setMethod(Method method)
+    {
+      m_method = method;
+      m_step = 0.0;
+    }
+
+    void
+    Integrator::setTolerances(double abs_tol, double rel_tol)
+    {
+      if (abs_tol <= 0.0 && rel_tol <= 0.0)
+        throw Error("at least one tolerance must be positive");
+
+      m_abs_tol = abs_tol;
+      m_rel_tol = rel_tol;
+    }
+
+    void
+    Integrator::setStepLimits(double min_step, double max_step)
+    {
+      if (min_step <= 0.0)
+        throw Error("minimum step must be positive");
+
+      m_min_step = min_step;
+      m_max_step = max_step;
+    }
+
+    Integrator::Method
+    Integrator::parseMethod(const std::string& name)
+    {
+      if (name == "Euler")
+        return IM_EULER;
+
+      if (name == "RK4")
+        return IM_RK4;
+
+      if (name == "Dormand-Prince")
+        return IM_DORMAND_PRINCE;
+
+      throw Error("invalid method: " + name);
+    }
+
+    void
+    Integrator::reserve(size_t size)
+    {
+      if (m_xs.size() == size)
+        return;
+
+      for (unsigned i = 0; i < 7; ++i)
+        m_k[i].resize(size);
+
+      m_xs.resize(size);
+      m_xn.resize(size);
+    }
+
+    unsigned
+    Integrator::integrate(System& system, double* x, size_t size, double t, double timestep)
+    {
+      if (timestep <= 0.0 || size == 0)
+        return 0;
+
+      reserve(size);
+
+      if (m_method == IM_DORMAND_PRINCE)
+        return integrateAdaptive(system, x, size, t, timestep);
+
+      return integrateFixed(system, x, size, t, timestep);
+    }
+
+    unsigned
+    Integrator::integrateFixed(System& system, double* x, size_t size, double t, double timestep)
+    {
+      unsigned steps = 1;
+      if (m_max_step > 0.0 && timestep > m_max_step)
+        steps = static_cast<unsigned>(std::ceil(timestep / m_max_step));
+
+      double h = timestep / steps;
+      const double weights[4] = {h / 6.0, h / 3.0, h / 3.0, h / 6.0};
+      double* k1 = &m_k[0][0];
+      double* k2 = &m_k[1][0];
+      double* k3 = &m_k[2][0];
+      double* k4 = &m_k[3][0];
+      double* xs = &m_xs[0];
+
+      for (unsigned s = 0; s < steps; ++s)
+      {
+        double ts = t + s * h;
+        system.derivatives(ts, x, k1);
+
+        if (m_method == IM_EULER)
+        {
+          Math::Kernels::axpy(h, k1, x, size);
+          continue;
+        }
+
+        std::copy(x, x + size, xs);
+        Math::Kernels::axpy(0.5 * h, k1, xs, size);
+        system.derivatives(ts + 0.5 * h, xs, k2);
+
+        std::copy(x, x + size, xs);
+        Math::Kernels::axpy(0.5 * h, k2, xs, size);
+        system.derivatives(ts + 0.5 * h, xs, k3);
+
+        std::copy(x, x + size, xs);
+        Math::Kernels::axpy(h, k3, xs, size);
+        system.derivatives(ts + h, xs, k4);
+
+        Math::Kernels::axpy4(weights, k1, k2, k3, k4, x, size);
+      }
+
+      return steps;
+    }
+
+    unsigned
+    Integrator::integrateAdaptive(System& system, double* x, size_t size, double t, double timestep)
+    {
+      double* k1 = &m_k[0][0];
+      double* k2 = &m_k[1][0];
+      double* k3 = &m_k[2][0];
+      double* k4 = &m_k[3][0];
+      double* k5 = &m_k[4][0];
+      double* k6 = &m_k[5][0];
+      double* k7 = &m_k[6][0];
+      double* xs = &m_xs[0];
+      double* xn = &m_xn[0];
+
+      double h = (m_step > 0.0) ? m_step : timestep;
+      if (m_max_step > 0.0)
+        h = std::min(h, m_max_step);
+      h = std::max(h, m_min_step);
+
+      // Inputs may have changed since the last call, so the first
+      // stage is always evaluated.
+      system.derivatives(t, x, k1);
+
+      unsigned steps = 0;
+      double elapsed = 0.0;
+
+      while (elapsed < timestep)
+      {
+        double remaining = timestep - elapsed;
+        bool last = (h >= remaining);
+        double hs = last ? remaining : h;
+        double ts = t + elapsed;
+
+        for (size_t i = 0; i < size; ++i)
+          xs[i] = x[i] + hs * c_a21 * k1[i];
+        system.derivatives(ts + hs * (1.0 / 5.0), xs, k2);
+
+        for (size_t i = 0; i < size; ++i)
+          xs[i] = x[i] + hs * (c_a31 * k1[i] + c_a32 * k2[i]);
+        system.derivatives(ts + hs * (3.0 / 10.0), xs, k3);
+
+        for (size_t i = 0; i < size; ++i)
+          xs[i] = x[i] + hs * (c_a41 * k1[i] + c_a42 * k2[i] + c_a43 * k3[i]);
+        system.derivatives(ts + hs * (4.0 / 5.0), xs, k4);
+
+        for (size_t i = 0; i < size; ++i)
+          xs[i] = x[i] + hs * (c_a51 * k1[i] + c_a52 * k2[i] + c_a53 * k3[i] + c_a54 * k4[i]);
+        system.derivatives(ts + hs * (8.0 / 9.0), xs, k5);
+
+        for (size_t i = 0; i < size; ++i)
+          xs[i] = x[i] + hs * (c_a61 * k1[i] + c_a62 * k2[i] + c_a63 * k3[i] + c_a64 * k4[i] + c_a65 * k5[i]);
+        system.derivatives(ts + hs, xs, k6);
+
+        for (size_t i = 0; i < size; ++i)
+          xn[i] = x[i] + hs * (c_b1 * k1[i] + c_b3 * k3[i] + c_b4 * k4[i] + c_b5 * k5[i] + c_b6 * k6[i]);
+        system.derivatives(ts + hs, xn, k7);
+
+        // Scaled RMS norm of the embedded error estimate.
+        double err = 0.0;
+        for (size_t i = 0; i < size; ++i)
+        {
+          double e = hs * (c_e1 * k1[i] + c_e3 * k3[i] + c_e4 * k4[i]
+                           + c_e5 * k5[i] + c_e6 * k6[i] + c_e7 * k7[i]);
+          double sc = m_abs_tol + m_rel_tol * std::max(std::fabs(x[i]), std::fabs(xn[i]));
+          err += (e / sc) * (e / sc);
+        }
+        err = std::sqrt(err / size);
+
+        double factor = c_max_factor;
+        if (err > 0.0)
+          factor = std::min(c_max_factor, std::max(c_min_factor, c_safety * std::pow(err, -0.2)));
+        else if (err != err)
+          factor = c_min_factor;
+
+        if (err <= 1.0 || hs <= m_min_step)
+        {
+          std::copy(xn, xn + size, x);
+          // First same as last.
+          std::swap(m_k[0], m_k[6]);
+          k1 = &m_k[0][0];
+          k7 = &m_k[6][0];
+
+          elapsed = last ? timestep : elapsed + hs;
+          ++steps;
+
+          // A step shortened to reach the end of the interval says
+          // little about the step the dynamics allow.
+          if (!last || hs >= h || factor < 1.0)
+            h = hs * factor;
+        }
+        else
+        {
+          ++m_rejected;
+          h = hs * std::min(1.0, factor);
+        }
+
+        if (m_max_step > 0.0)
+          h = std::min(h, m_max_step);
+        h = std::max(h, m_min_step);
+      }
+
+      m_step = h;
+      return steps;
+    }
+  }
+}
@@ -0,0 +1,183 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_SIMULATION_INTEGRATOR_HPP_INCLUDED_
+#define DUNE_SIMULATION_INTEGRATOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Integrator;
+
+    //! Numerical integrator of ordinary differential equations shared
+    //! by the simulation models.
+    //!
+    //! Fixed step methods split the requested timestep in substeps no
+    //! larger than the maximum step; their state updates run on the
+    //! vector kernels of Math::Kernels. The adaptive Dormand-Prince 5(4)
+    //! method chooses its own steps to keep the local error within
+    //! the configured tolerances, remembering the last step size
+    //! between calls.
+    class Integrator
+    {
+    public:
+      //! Integration methods.
+      enum Method
+      {
+        //! Explicit Euler (first order, fixed step).
+        IM_EULER,
+        //! Classic Runge-Kutta (fourth order, fixed step).
+        IM_RK4,
+        //! Dormand-Prince 5(4) (adaptive step).
+        IM_DORMAND_PRINCE
+      };
+
+      //! Integrator error.
+      class Error: public std::runtime_error
+      {
+      public:
+        Error(const std::string& msg):
+          std::runtime_error("integrator error: " + msg)
+        { }
+      };
+
+      //! Continuous-time system.
+      class System
+      {
+      public:
+        virtual
+        ~System(void)
+        { }
+
+        //! Compute the time derivative of the state.
+        //! @param[in] t time.
+        //! @param[in] x state vector.
+        //! @param[out] dx state derivative.
+        virtual void
+        derivatives(double t, const double* x, double* dx) = 0;
+      };
+
+      //! Constructor.
+      //! @param[in] method integration method.
+      Integrator(Method method = IM_EULER);
+
+      //! Set the integration method.
+      //! @param[in] method integration method.
+      void
+      setMethod(Method method);
+
+      //! Get the integration method.
+      //! @return integration method.
+      Method
+      getMethod(void) const
+      {
+        return m_method;
+      }
+
+      //! Set the error tolerances of the adaptive method.
+      //! @param[in] abs_tol absolute tolerance.
+      //! @param[in] rel_tol relative tolerance.
+      void
+      setTolerances(double abs_tol, double rel_tol);
+
+      //! Set the step size limits.
+      //! @param[in] min_step smallest step of the adaptive method.
+      //! @param[in] max_step largest step (<= 0 for no limit).
+      void
+      setStepLimits(double min_step, double max_step);
+
+      //! Advance the state of a system.
+      //! @param[in] system system to integrate.
+      //! @param[in,out] x state vector.
+      //! @param[in] size number of states.
+      //! @param[in] t initial time.
+      //! @param[in] timestep integration interval.
+      //! @return number of steps taken.
+      unsigned
+      integrate(System& system, double* x, size_t size, double t, double timestep);
+
+      //! Get the number of steps rejected by the adaptive method since
+      //! the integrator was created.
+      //! @return number of rejected steps.
+      unsigned
+      getRejectedSteps(void) const
+      {
+        return m_rejected;
+      }
+
+      //! Convert a method name ("Euler", "RK4" or "Dormand-Prince").
+      //! @param[in] name method name.
+      //! @return integration method.
+      static Method
+      parseMethod(const std::string& name);
+
+    private:
+      //! Integration method.
+      Method m_method;
+      //! Absolute tolerance.
+      double m_abs_tol;
+      //! Relative tolerance.
+      double m_rel_tol;
+      //! Smallest adaptive step.
+      double m_min_step;
+      //! Largest step.
+      double m_max_step;
+      //! Next step of the adaptive method (0 if unknown).
+      double m_step;
+      //! Number of rejected steps.
+      unsigned m_rejected;
+      //! Stage derivatives.
+      std::vector<double> m_k[7];
+      //! Stage state.
+      std::vector<double> m_xs;
+      //! Candidate state.
+      std::vector<double> m_xn;
+
+      void
+      reserve(size_t size);
+
+      unsigned
+      integrateFixed(System& system, double* x, size_t size, double t, double timestep);
+
+      unsigned
+      integrateAdaptive(System& system, double* x, size_t size, double t, double timestep);
+    };
+  }
+}
+
+#endif
@@ -41,6 +41,7 @@
 #include <DUNE/Simulation/UAV.hpp>
 #include <DUNE/Math/Matrix.hpp>
 #include <DUNE/Math/Angles.hpp>
+#include <DUNE/Math/Trigonometry.hpp>
 #include <DUNE/Math/General.hpp>
 
 namespace DUNE
@@ -431,6 +432,9 @@ namespace DUNE
       m_cos_fl_path_ang = model.m_cos_fl_path_ang;
       m_sin_fl_path_ang = model.m_sin_fl_path_ang;
 
+      //! Numerical integrator
+      m_integrator = model.m_integrator;
+
       return *this;
     }
 
@@ -524,7 +528,9 @@ namespace DUNE
 
       //! Time step control
       double d_timestep;
-      if (m_timestep_lim > 0.0 && timestep > m_timestep_lim)
+      //! - Substeps replace the truncation when integrating the model equations
+      if (m_integrator.getMethod() == Integrator::IM_EULER &&
+          m_timestep_lim > 0.0 && timestep > m_timestep_lim)
         d_timestep = m_timestep_lim;
       else
         d_timestep = timestep;
@@ -659,17 +665,14 @@ namespace DUNE
       m_position(3) = DUNE::Math::Angles::normalizeRadian(m_position(3));
       m_position(5) = DUNE::Math::Angles::normalizeRadian(m_position(5));
       // Optimization variables
-      m_cos_yaw = std::cos(m_position(5));
-      m_sin_yaw = std::sin(m_position(5));
+      Math::Trigonometry::sincos(m_position(5), m_sin_yaw, m_cos_yaw);
       if (m_sim_type.compare("5DOF") == 0 || m_sim_type.compare("4DOF_alt") == 0)
       {
-        m_cos_pitch = std::cos(m_position(4));
-        m_sin_pitch = std::sin(m_position(4));
+        Math::Trigonometry::sincos(m_position(4), m_sin_pitch, m_cos_pitch);
       }
       else if (m_sim_type.compare("6DOF_stab") == 0)
       {
-        m_cos_roll = std::cos(m_position(3));
-        m_sin_roll = std::sin(m_position(3));
+        Math::Trigonometry::sincos(m_position(3), m_sin_roll, m_cos_roll);
       }
 
       //! Horizontal position state update
@@ -680,8 +683,10 @@ namespace DUNE
       else
       {
         double d_turn_radius = m_airspeed/m_velocity(5);
-        m_position(0) += d_turn_radius*(m_sin_yaw - std::sin(d_initial_yaw))+m_wind(0)*timestep;
-        m_position(1) += d_turn_radius*(std::cos(d_initial_yaw) - m_cos_yaw)+m_wind(1)*timestep;
+        double d_sin_initial_yaw, d_cos_initial_yaw;
+        Math::Trigonometry::sincos(d_initial_yaw, d_sin_initial_yaw, d_cos_initial_yaw);
+        m_position(0) += d_turn_radius*(m_sin_yaw - d_sin_initial_yaw)+m_wind(0)*timestep;
+        m_position(1) += d_turn_radius*(d_cos_initial_yaw - m_cos_yaw)+m_wind(1)*timestep;
       }
 
       /*
@@ -738,6 +743,12 @@ namespace DUNE
       if (timestep <= 0)
         return;
 
+      if (m_integrator.getMethod() != Integrator::IM_EULER)
+      {
+        integrateModel(timestep);
+        return;
+      }
+
       //! Wind effects
       m_velocity(2) = m_wind(2);
       calcUAV2AirData();
@@ -804,6 +815,12 @@ namespace DUNE
       if (timestep <= 0)
         return;
 
+      if (m_integrator.getMethod() != Integrator::IM_EULER)
+      {
+        integrateModel(timestep);
+        return;
+      }
+
       //! Wind effects
       calcUAV2AirData();
 
@@ -887,6 +904,12 @@ namespace DUNE
       if (timestep <= 0)
         return;
 
+      if (m_integrator.getMethod() != Integrator::IM_EULER)
+      {
+        integrateModel(timestep);
+        return;
+      }
+
       calcUAV2AirData();
 
       //==========================================================================
@@ -964,6 +987,12 @@ namespace DUNE
       if (timestep <= 0)
         return;
 
+      if (m_integrator.getMethod() != Integrator::IM_EULER)
+      {
+        integrateModel(timestep);
+        return;
+      }
+
       //! Wind effects
       calcUAV2AirData();
 
@@ -1025,6 +1054,114 @@ namespace DUNE
       */
     }
 
+    void
+    UAVSimulation::integrateModel(const double& timestep)
+    {
+      //! Wind effects
+      calcUAV2AirData();
+
+      //! Roll and airspeed are states only when their dynamics are modelled
+      bool dynamic = (m_sim_type.compare("4DOF_bank") == 0 || m_sim_type.compare("5DOF") == 0);
+
+      //! State vector [x, y, z, roll, yaw, airspeed]
+      double state[6] = {m_position(0), m_position(1), m_position(2),
+                         dynamic ? m_position(3) : m_bank_cmd, m_position(5),
+                         dynamic ? m_airspeed : m_airspeed_cmd};
+
+      m_integrator.setStepLimits(1e-6, m_timestep_lim);
+      m_integrator.integrate(*this, state, 6, 0.0, timestep);
+
+      m_position(0) = state[0];
+      m_position(1) = state[1];
+      m_position(2) = state[2];
+      m_position(3) = DUNE::Math::Angles::normalizeRadian(state[3]);
+      m_position(5) = DUNE::Math::Angles::normalizeRadian(state[4]);
+      m_airspeed = state[5];
+
+      //! Rates and flight path angle at the final state
+      double rates[6];
+      double sin_pitch = m_sin_pitch;
+      double cos_pitch = m_cos_pitch;
+      computeRates(state, rates, sin_pitch, cos_pitch);
+
+      if (dynamic)
+        m_velocity(3) = rates[3];
+      m_velocity(5) = rates[4];
+
+      if (m_sim_type.compare("4DOF_alt") == 0 || m_sim_type.compare("5DOF") == 0)
+      {
+        m_sin_pitch = sin_pitch;
+        m_cos_pitch = cos_pitch;
+        m_position(4) = Angles::normalizeRadian(std::asin(m_sin_pitch)*2)/2;
+      }
+
+      Math::Trigonometry::sincos(m_position(5), m_sin_yaw, m_cos_yaw);
+      updateVelocity();
+    }
+
+    void
+    UAVSimulation::computeRates(const double* x, double* dx, double& sin_pitch, double& cos_pitch)
+    {
+      double d_roll = x[3];
+      double d_airspeed = x[5];
+
+      //! Roll and airspeed dynamics
+      dx[3] = 0.0;
+      dx[5] = 0.0;
+      if (m_sim_type.compare("4DOF_bank") == 0 || m_sim_type.compare("5DOF") == 0)
+      {
+        dx[3] = (m_bank_cmd - d_roll)/m_bank_time_cst;
+        if (m_bank_rate_lim_f)
+          dx[3] = DUNE::Math::trimValue(dx[3], -m_bank_rate_lim, m_bank_rate_lim);
+
+        dx[5] = (m_airspeed_cmd - d_airspeed)/m_speed_time_cst;
+        if (m_lon_accel_lim_f)
+          dx[5] = DUNE::Math::trimValue(dx[5], -m_lon_accel_lim, m_lon_accel_lim);
+      }
+
+      //! Vertical rate and flight path angle
+      if (m_sim_type.compare("4DOF_alt") == 0 || m_sim_type.compare("5DOF") == 0)
+      {
+        double d_vert_rate;
+        if (m_altitude_cmd_ini)
+          d_vert_rate = (-m_altitude_cmd - x[2])/m_alt_time_cst;
+        else
+          d_vert_rate = -std::sin(m_fpa_cmd)*d_airspeed;
+
+        double d_vert_rate_lim = m_vert_slope_lim_f ? m_vert_slope_lim*d_airspeed : d_airspeed;
+        d_vert_rate = DUNE::Math::trimValue(d_vert_rate, -d_vert_rate_lim, d_vert_rate_lim);
+
+        sin_pitch = -d_vert_rate/d_airspeed;
+        cos_pitch = std::sqrt(1 - sin_pitch*sin_pitch);
+      }
+
+      //! Turn rate
+      dx[4] = m_g * std::tan(d_roll)/d_airspeed;
+
+      //! Ground velocity
+      double d_sin_yaw, d_cos_yaw;
+      Math::Trigonometry::sincos(x[4], d_sin_yaw, d_cos_yaw);
+      dx[0] = d_airspeed * d_cos_yaw*cos_pitch + m_wind(0);
+      dx[1] = d_airspeed * d_sin_yaw*cos_pitch + m_wind(1);
+      dx[2] = -d_airspeed * sin_pitch + m_wind(2);
+    }
+
+    void
+    UAVSimulation::derivatives(double t, const double* x, double* dx)
+    {
+      (void)t;
+      double sin_pitch = m_sin_pitch;
+      double cos_pitch = m_cos_pitch;
+      computeRates(x, dx, sin_pitch, cos_pitch);
+    }
+
+    void
+    UAVSimulation::setIntegrator(Integrator::Method method, double tolerance)
+    {
+      m_integrator.setMethod(method);
+      m_integrator.setTolerances(tolerance, tolerance);
+    }
+
     void
     UAVSimulation::setPosition(const DUNE::Math::Matrix& pos)
     {
@@ -1039,12 +1176,9 @@ namespace DUNE
       if (m_sim_type.compare("3DOF") == 0 || m_sim_type.compare("4DOF_bank") == 0)
         m_position(4) = 0;
       // Simulation variables
-      m_cos_course = std::cos(m_position(5));
-      m_sin_course = std::sin(m_position(5));
-      m_cos_pitch = std::cos(m_position(4));
-      m_sin_pitch = std::sin(m_position(4));
-      m_cos_roll = std::cos(m_position(3));
-      m_sin_roll = std::sin(m_position(3));
+      Math::Trigonometry::sincos(m_position(5), m_sin_course, m_cos_course);
+      Math::Trigonometry::sincos(m_position(4), m_sin_pitch, m_cos_pitch);
+      Math::Trigonometry::sincos(m_position(3), m_sin_roll, m_cos_roll);
     }
 
     void
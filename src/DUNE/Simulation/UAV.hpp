@@ -36,6 +36,7 @@
 
 // DUNE headers.
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Simulation/Integrator.hpp>
 #include <DUNE/Tasks/Task.hpp>
 
 namespace DUNE
@@ -48,7 +49,7 @@ namespace DUNE
     // Export DLL Symbol.
     class DUNE_DLL_SYM UAVSimulation;
 
-    class UAVSimulation
+    class UAVSimulation: private Integrator::System
     {
     public:
       class Error: public std::runtime_error
@@ -335,6 +336,14 @@ namespace DUNE
       void
       setVertSlopeLim(const double& vert_slope_lim);
 
+      //! This method selects the numerical integration method. Euler
+      //! keeps the legacy update equations, the other methods integrate
+      //! the model equations with substeps limited by m_timestep_lim.
+      //! @param[in] method - integration method
+      //! @param[in] tolerance - error tolerance of adaptive methods
+      void
+      setIntegrator(Integrator::Method method, double tolerance = 1e-6);
+
       //! This method gets the vehicle state.
       //! @returns pos - current position vector
       DUNE::Math::Matrix
@@ -501,6 +510,9 @@ namespace DUNE
       double m_cos_fl_path_ang;
       double m_sin_fl_path_ang;
 
+      //! Numerical integrator
+      Integrator m_integrator;
+
       //! Simulation update functions
       void
       integratePosition(const double& timestep);
@@ -523,6 +535,17 @@ namespace DUNE
       void
       update5DOF(const double& timestep);
 
+      //! Integrate the model equations with the selected integrator
+      void
+      integrateModel(const double& timestep);
+
+      //! Compute the model rates for state [x, y, z, roll, yaw, airspeed]
+      void
+      computeRates(const double* x, double* dx, double& sin_pitch, double& cos_pitch);
+
+      void
+      derivatives(double t, const double* x, double* dx);
+
       /*
       //! This method acts as destructor.
       void
@@ -0,0 +1,465 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Math/Angles.hpp>
+#include <DUNE/Math/Trigonometry.hpp>
+#include <DUNE/Simulation/UAVFleet.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    //! Number of states of each vehicle.
+    static const size_t c_states = 6;
+
+    //! Group of vehicles integrated as a single system. The state
+    //! vector holds each state of all vehicles contiguously:
+    //! [x(0..n), y(0..n), z(0..n), roll(0..n), yaw(0..n), airspeed(0..n)].
+    class UAVFleet::Group: public Integrator::System
+    {
+    public:
+      //! Number of vehicles.
+      size_t m_size;
+      //! State vector.
+      std::vector<double> m_state;
+      //! State derivatives at the last evaluated state.
+      std::vector<double> m_rates;
+      //! Sine of the flight path angle at the last evaluated state.
+      std::vector<double> m_sin_pitch;
+      //! Bank commands.
+      std::vector<double> m_bank_cmd;
+      //! Airspeed commands.
+      std::vector<double> m_airspeed_cmd;
+      //! Altitude commands.
+      std::vector<double> m_alt_cmd;
+      //! Sine of the flight path angle commands.
+      std::vector<double> m_fpa_cmd;
+      //! 1 if following the altitude command, 0 if following the
+      //! flight path angle command.
+      std::vector<double> m_alt_mode;
+      //! Integrator.
+      Integrator m_integrator;
+
+      Group(const Parameters& params, size_t size):
+        m_size(size),
+        m_state(c_states * size, 0.0),
+        m_rates(c_states * size, 0.0),
+        m_sin_pitch(size, 0.0),
+        m_bank_cmd(size, 0.0),
+        m_airspeed_cmd(size, 0.0),
+        m_alt_cmd(size, 0.0),
+        m_fpa_cmd(size, 0.0),
+        m_alt_mode(size, 1.0),
+        m_params(params),
+        m_sin_yaw(size),
+        m_cos_yaw(size),
+        m_sin_roll(size),
+        m_cos_roll(size),
+        m_cos_pitch(size, 1.0)
+      { }
+
+      double*
+      getState(size_t state)
+      {
+        return &m_state[state * m_size];
+      }
+
+      void
+      integrate(double timestep)
+      {
+        double* roll = getState(3);
+        double* yaw = getState(4);
+        double* airspeed = getState(5);
+
+        // Roll and airspeed follow their commands instantaneously.
+        if (!isDynamic())
+        {
+          std::copy(m_bank_cmd.begin(), m_bank_cmd.end(), roll);
+          std::copy(m_airspeed_cmd.begin(), m_airspeed_cmd.end(), airspeed);
+        }
+
+        m_integrator.integrate(*this, &m_state[0], m_state.size(), 0.0, timestep);
+
+        Math::Angles::normalizeRadian(roll, m_size, roll);
+        Math::Angles::normalizeRadian(yaw, m_size, yaw);
+
+        // Rates and flight path angle at the final state.
+        computeRates(&m_state[0], &m_rates[0]);
+      }
+
+      void
+      derivatives(double t, const double* x, double* dx)
+      {
+        (void)t;
+        computeRates(x, dx);
+      }
+
+    private:
+      //! Model parameters.
+      const Parameters& m_params;
+      //! Scratch arrays.
+      std::vector<double> m_sin_yaw;
+      std::vector<double> m_cos_yaw;
+      std::vector<double> m_sin_roll;
+      std::vector<double> m_cos_roll;
+      std::vector<double> m_cos_pitch;
+
+      bool
+      isDynamic(void) const
+      {
+        return m_params.model == FM_4DOF_BANK || m_params.model == FM_5DOF;
+      }
+
+      bool
+      isVertical(void) const
+      {
+        return m_params.model == FM_4DOF_ALT || m_params.model == FM_5DOF;
+      }
+
+      static double
+      limit(double value, double lim)
+      {
+        return std::min(std::max(value, -lim), lim);
+      }
+
+      void
+      computeRates(const double* x, double* dx)
+      {
+        const size_t n = m_size;
+        const double* z = x + 2 * n;
+        const double* roll = x + 3 * n;
+        const double* yaw = x + 4 * n;
+        const double* airspeed = x + 5 * n;
+        double* dx_n = dx;
+        double* dx_e = dx + n;
+        double* dx_d = dx + 2 * n;
+        double* dx_roll = dx + 3 * n;
+        double* dx_yaw = dx + 4 * n;
+        double* dx_airspeed = dx + 5 * n;
+
+        double* sin_yaw = &m_sin_yaw[0];
+        double* cos_yaw = &m_cos_yaw[0];
+        double* sin_roll = &m_sin_roll[0];
+        double* cos_roll = &m_cos_roll[0];
+        double* sin_pitch = &m_sin_pitch[0];
+        double* cos_pitch = &m_cos_pitch[0];
+
+        Math::Trigonometry::fastSinCos(yaw, n, sin_yaw, cos_yaw);
+        Math::Trigonometry::fastSinCos(roll, n, sin_roll, cos_roll);
+
+        // Roll and airspeed dynamics.
+        if (isDynamic())
+        {
+          const double* bank_cmd = &m_bank_cmd[0];
+          const double* airspeed_cmd = &m_airspeed_cmd[0];
+          double bank_gain = 1.0 / m_params.bank_time_cst;
+          double speed_gain = 1.0 / m_params.speed_time_cst;
+          double bank_lim = (m_params.bank_rate_lim > 0.0) ? m_params.bank_rate_lim : std::numeric_limits<double>::max();
+          double accel_lim = (m_params.lon_accel_lim > 0.0) ? m_params.lon_accel_lim : std::numeric_limits<double>::max();
+
+          for (size_t i = 0; i < n; ++i)
+          {
+            dx_roll[i] = limit((bank_cmd[i] - roll[i]) * bank_gain, bank_lim);
+            dx_airspeed[i] = limit((airspeed_cmd[i] - airspeed[i]) * speed_gain, accel_lim);
+          }
+        }
+        else
+        {
+          std::fill(dx_roll, dx_roll + n, 0.0);
+          std::fill(dx_airspeed, dx_airspeed + n, 0.0);
+        }
+
+        // Vertical rate and flight path angle.
+        if (isVertical())
+        {
+          const double* alt_cmd = &m_alt_cmd[0];
+          const double* fpa_cmd = &m_fpa_cmd[0];
+          const double* alt_mode = &m_alt_mode[0];
+          double alt_gain = 1.0 / m_params.alt_time_cst;
+          double slope = (m_params.vert_slope_lim > 0.0) ? m_params.vert_slope_lim : 1.0;
+
+          for (size_t i = 0; i < n; ++i)
+          {
+            double alt_rate = (-alt_cmd[i] - z[i]) * alt_gain;
+            double fpa_rate = -fpa_cmd[i] * airspeed[i];
+            double vert_rate = alt_mode[i] * alt_rate + (1.0 - alt_mode[i]) * fpa_rate;
+            vert_rate = limit(vert_rate, slope * airspeed[i]);
+            sin_pitch[i] = -vert_rate / airspeed[i];
+            cos_pitch[i] = std::sqrt(1.0 - sin_pitch[i] * sin_pitch[i]);
+          }
+        }
+
+        // Turn rate and ground velocity.
+        double g = m_params.gaccel;
+        double wind_n = m_params.wind[0];
+        double wind_e = m_params.wind[1];
+        double wind_d = m_params.wind[2];
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          dx_yaw[i] = g * sin_roll[i] / (cos_roll[i] * airspeed[i]);
+          dx_n[i] = airspeed[i] * cos_yaw[i] * cos_pitch[i] + wind_n;
+          dx_e[i] = airspeed[i] * sin_yaw[i] * cos_pitch[i] + wind_e;
+          dx_d[i] = -airspeed[i] * sin_pitch[i] + wind_d;
+        }
+      }
+    };
+
+    //! Worker thread integrating a subset of the groups.
+    class UAVFleet::Worker: public Concurrency::Thread
+    {
+    public:
+      Worker(UAVFleet& fleet, size_t index):
+        m_fleet(fleet),
+        m_index(index)
+      { }
+
+    private:
+      //! Fleet.
+      UAVFleet& m_fleet;
+      //! Thread index.
+      size_t m_index;
+
+      void
+      run(void)
+      {
+        while (true)
+        {
+          m_fleet.m_start->wait();
+
+          if (m_fleet.m_quit)
+            break;
+
+          m_fleet.integrate(m_index);
+          m_fleet.m_done->wait();
+        }
+      }
+    };
+
+    UAVFleet::UAVFleet(size_t count, const Parameters& params, size_t group_size, unsigned threads):
+      m_params(params),
+      m_count(count),
+      m_group_size(group_size),
+      m_start(NULL),
+      m_done(NULL),
+      m_timestep(0.0),
+      m_quit(false)
+    {
+      if (count == 0)
+        throw Error("fleet has no vehicles");
+
+      if (group_size == 0)
+        throw Error("group size must be positive");
+
+      if (params.bank_time_cst <= 0.0 || params.speed_time_cst <= 0.0 || params.alt_time_cst <= 0.0)
+        throw Error("time constants must be positive");
+
+      for (size_t i = 0; i < count; i += group_size)
+        m_groups.push_back(new Group(m_params, std::min(group_size, count - i)));
+
+      // Workers beyond the number of groups would have nothing to do.
+      threads = std::min(threads, (unsigned)(m_groups.size() - 1));
+      if (threads == 0)
+        return;
+
+      m_start = new Concurrency::Barrier(threads + 1);
+      m_done = new Concurrency::Barrier(threads + 1);
+
+      for (unsigned i = 0; i < threads; ++i)
+      {
+        m_workers.push_back(new Worker(*this, i + 1));
+        m_workers.back()->start();
+      }
+    }
+
+    UAVFleet::~UAVFleet(void)
+    {
+      if (!m_workers.empty())
+      {
+        m_quit = true;
+        m_start->wait();
+
+        for (size_t i = 0; i < m_workers.size(); ++i)
+        {
+          m_workers[i]->stopAndJoin();
+          delete m_workers[i];
+        }
+
+        delete m_start;
+        delete m_done;
+      }
+
+      for (size_t i = 0; i < m_groups.size(); ++i)
+        delete m_groups[i];
+    }
+
+    void
+    UAVFleet::setIntegrator(Integrator::Method method, double tolerance, double max_step)
+    {
+      for (size_t i = 0; i < m_groups.size(); ++i)
+      {
+        Integrator& integrator = m_groups[i]->m_integrator;
+        integrator.setMethod(method);
+        integrator.setTolerances(tolerance, tolerance);
+        integrator.setStepLimits(1e-6, max_step);
+      }
+    }
+
+    void
+    UAVFleet::setWind(double north, double east, double down)
+    {
+      m_params.wind[0] = north;
+      m_params.wind[1] = east;
+      m_params.wind[2] = down;
+    }
+
+    void
+    UAVFleet::setState(size_t index, double x, double y, double z, double roll, double yaw, double airspeed)
+    {
+      Group& group = *m_groups[index / m_group_size];
+      size_t i = index % m_group_size;
+
+      group.getState(0)[i] = x;
+      group.getState(1)[i] = y;
+      group.getState(2)[i] = z;
+      group.getState(3)[i] = roll;
+      group.getState(4)[i] = yaw;
+      group.getState(5)[i] = airspeed;
+
+      group.m_bank_cmd[i] = roll;
+      group.m_airspeed_cmd[i] = airspeed;
+      group.m_alt_cmd[i] = -z;
+      group.m_alt_mode[i] = 1.0;
+      group.m_sin_pitch[i] = 0.0;
+    }
+
+    void
+    UAVFleet::getState(size_t index, State& state) const
+    {
+      const Group& group = *m_groups[index / m_group_size];
+      size_t i = index % m_group_size;
+      size_t n = group.m_size;
+      const double* x = &group.m_state[0];
+      const double* dx = &group.m_rates[0];
+
+      state.x = x[i];
+      state.y = x[n + i];
+      state.z = x[2 * n + i];
+      state.phi = x[3 * n + i];
+      state.theta = std::asin(group.m_sin_pitch[i]);
+      state.psi = x[4 * n + i];
+      state.vx = dx[i];
+      state.vy = dx[n + i];
+      state.vz = dx[2 * n + i];
+      state.p = dx[3 * n + i];
+      state.q = 0.0;
+      state.r = dx[4 * n + i];
+      state.airspeed = x[5 * n + i];
+    }
+
+    void
+    UAVFleet::commandBank(size_t index, double bank)
+    {
+      m_groups[index / m_group_size]->m_bank_cmd[index % m_group_size] = bank;
+    }
+
+    void
+    UAVFleet::commandAirspeed(size_t index, double airspeed)
+    {
+      if (airspeed <= 0.0)
+        throw Error("airspeed command must be positive");
+
+      m_groups[index / m_group_size]->m_airspeed_cmd[index % m_group_size] = airspeed;
+    }
+
+    void
+    UAVFleet::commandAltitude(size_t index, double altitude)
+    {
+      Group& group = *m_groups[index / m_group_size];
+      group.m_alt_cmd[index % m_group_size] = altitude;
+      group.m_alt_mode[index % m_group_size] = 1.0;
+    }
+
+    void
+    UAVFleet::commandFPA(size_t index, double fpa)
+    {
+      Group& group = *m_groups[index / m_group_size];
+      group.m_fpa_cmd[index % m_group_size] = std::sin(fpa);
+      group.m_alt_mode[index % m_group_size] = 0.0;
+    }
+
+    void
+    UAVFleet::update(double timestep)
+    {
+      if (timestep <= 0.0)
+        return;
+
+      m_timestep = timestep;
+
+      if (m_workers.empty())
+      {
+        integrate(0);
+        return;
+      }
+
+      m_start->wait();
+      integrate(0);
+      m_done->wait();
+    }
+
+    void
+    UAVFleet::integrate(size_t thread)
+    {
+      size_t stride = m_workers.size() + 1;
+      for (size_t i = thread; i < m_groups.size(); i += stride)
+        m_groups[i]->integrate(m_timestep);
+    }
+
+    UAVFleet::Model
+    UAVFleet::parseModel(const std::string& name)
+    {
+      if (name == "3DOF")
+        return FM_3DOF;
+      if (name == "4DOF_alt")
+        return FM_4DOF_ALT;
+      if (name == "4DOF_bank")
+        return FM_4DOF_BANK;
+      if (name == "5DOF")
+        return FM_5DOF;
+
+      throw Error("invalid model: " + name);
+    }
+  }
+}
@@ -0,0 +1,277 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef DUNE_SIMULATION_UAV_FLEET_HPP_INCLUDED_
+#define DUNE_SIMULATION_UAV_FLEET_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Barrier.hpp>
+#include <DUNE/Simulation/Integrator.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM UAVFleet;
+
+    //! Simulation of a fleet of UAVs sharing the same kinematic model.
+    //!
+    //! Vehicles are stored in structure-of-arrays form and split in
+    //! groups of consecutive vehicles. Each group is integrated as a
+    //! single system, so the model equations are evaluated by loops
+    //! over contiguous arrays that the compiler can vectorize, the
+    //! fixed step integrator updates the states with the vector
+    //! kernels of Math::Kernels (AVX2, NEON or generic, chosen at run
+    //! time), and groups may be distributed over worker threads.
+    //!
+    //! The model equations are the ones of UAVSimulation: the state of
+    //! each vehicle is [x, y, z, roll, yaw, airspeed], roll and
+    //! airspeed follow first order responses to their commands in the
+    //! 4DOF_bank and 5DOF models and the vertical rate follows the
+    //! altitude or flight path angle command in the 4DOF_alt and 5DOF
+    //! models.
+    class UAVFleet
+    {
+    public:
+      //! Kinematic models.
+      enum Model
+      {
+        //! Commanded bank and airspeed.
+        FM_3DOF,
+        //! Commanded bank and airspeed, altitude dynamics.
+        FM_4DOF_ALT,
+        //! Bank and airspeed dynamics.
+        FM_4DOF_BANK,
+        //! Bank, airspeed and altitude dynamics.
+        FM_5DOF
+      };
+
+      //! Fleet error.
+      class Error: public std::runtime_error
+      {
+      public:
+        Error(const std::string& msg):
+          std::runtime_error("UAV fleet simulation error: " + msg)
+        { }
+      };
+
+      //! Model parameters shared by all vehicles.
+      struct Parameters
+      {
+        //! Kinematic model.
+        Model model;
+        //! Bank time constant (s).
+        double bank_time_cst;
+        //! Airspeed time constant (s).
+        double speed_time_cst;
+        //! Altitude time constant (s).
+        double alt_time_cst;
+        //! Bank rate limit (rad/s, <= 0 for no limit).
+        double bank_rate_lim;
+        //! Longitudinal acceleration limit (m/s^2, <= 0 for no limit).
+        double lon_accel_lim;
+        //! Vertical slope limit (<= 0 for no limit).
+        double vert_slope_lim;
+        //! Wind velocity in the NED frame (m/s).
+        double wind[3];
+        //! Gravity acceleration (m/s^2).
+        double gaccel;
+
+        Parameters(void):
+          model(FM_4DOF_BANK),
+          bank_time_cst(1.0),
+          speed_time_cst(1.0),
+          alt_time_cst(1.0),
+          bank_rate_lim(0.0),
+          lon_accel_lim(0.0),
+          vert_slope_lim(0.0),
+          gaccel(9.80665)
+        {
+          wind[0] = 0.0;
+          wind[1] = 0.0;
+          wind[2] = 0.0;
+        }
+      };
+
+      //! State of one vehicle.
+      struct State
+      {
+        //! Position in the NED frame (m).
+        double x, y, z;
+        //! Euler angles (rad).
+        double phi, theta, psi;
+        //! Velocity relative to the ground in the NED frame (m/s).
+        double vx, vy, vz;
+        //! Euler angle rates (rad/s).
+        double p, q, r;
+        //! Airspeed (m/s).
+        double airspeed;
+      };
+
+      //! Constructor.
+      //! @param[in] count number of vehicles.
+      //! @param[in] params model parameters.
+      //! @param[in] group_size number of vehicles per group.
+      //! @param[in] threads number of worker threads (0 to integrate
+      //! every group in the calling thread).
+      UAVFleet(size_t count, const Parameters& params, size_t group_size = 64, unsigned threads = 0);
+
+      //! Destructor.
+      ~UAVFleet(void);
+
+      //! Get the number of vehicles.
+      //! @return number of vehicles.
+      size_t
+      size(void) const
+      {
+        return m_count;
+      }
+
+      //! Get the number of groups.
+      //! @return number of groups.
+      size_t
+      getGroupCount(void) const
+      {
+        return m_groups.size();
+      }
+
+      //! Set the integration method of all groups.
+      //! @param[in] method integration method.
+      //! @param[in] tolerance error tolerance of the adaptive method.
+      //! @param[in] max_step largest integration step (<= 0 for no limit).
+      void
+      setIntegrator(Integrator::Method method, double tolerance, double max_step);
+
+      //! Set the wind velocity.
+      //! @param[in] north wind velocity towards North (m/s).
+      //! @param[in] east wind velocity towards East (m/s).
+      //! @param[in] down wind velocity downwards (m/s).
+      void
+      setWind(double north, double east, double down);
+
+      //! Set the state of a vehicle. The commands are set to hold the
+      //! given bank, airspeed and altitude.
+      //! @param[in] index vehicle index.
+      //! @param[in] x North position (m).
+      //! @param[in] y East position (m).
+      //! @param[in] z down position (m).
+      //! @param[in] roll bank angle (rad).
+      //! @param[in] yaw heading (rad).
+      //! @param[in] airspeed airspeed (m/s).
+      void
+      setState(size_t index, double x, double y, double z, double roll, double yaw, double airspeed);
+
+      //! Get the state of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[out] state vehicle state.
+      void
+      getState(size_t index, State& state) const;
+
+      //! Command the bank angle of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] bank bank angle (rad).
+      void
+      commandBank(size_t index, double bank);
+
+      //! Command the airspeed of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] airspeed airspeed (m/s).
+      void
+      commandAirspeed(size_t index, double airspeed);
+
+      //! Command the altitude of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] altitude altitude (m).
+      void
+      commandAltitude(size_t index, double altitude);
+
+      //! Command the flight path angle of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] fpa flight path angle (rad).
+      void
+      commandFPA(size_t index, double fpa);
+
+      //! Advance the state of all vehicles.
+      //! @param[in] timestep integration interval (s).
+      void
+      update(double timestep);
+
+      //! Convert a model name ("3DOF", "4DOF_alt", "4DOF_bank" or "5DOF").
+      //! @param[in] name model name.
+      //! @return kinematic model.
+      static Model
+      parseModel(const std::string& name);
+
+    private:
+      class Group;
+      class Worker;
+      friend class Worker;
+
+      //! Model parameters.
+      Parameters m_params;
+      //! Number of vehicles.
+      size_t m_count;
+      //! Number of vehicles per group.
+      size_t m_group_size;
+      //! Vehicle groups.
+      std::vector<Group*> m_groups;
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Barrier releasing the workers.
+      Concurrency::Barrier* m_start;
+      //! Barrier waiting for the workers.
+      Concurrency::Barrier* m_done;
+      //! Timestep of the current update.
+      double m_timestep;
+      //! True to terminate the workers.
+      bool m_quit;
+
+      //! Integrate the groups assigned to a thread.
+      //! @param[in] thread thread index (0 for the calling thread).
+      void
+      integrate(size_t thread);
+
+      // Non-copyable.
+      UAVFleet(const UAVFleet&);
+
+      // Non-assignable.
+      UAVFleet&
+      operator=(const UAVFleet&);
+    };
+  }
+}
+
+#endif
@@ -178,6 +178,18 @@ namespace DUNE
       return proc_delta * 100 / global_delta;
     }
 
+    unsigned
+    Resources::getProcessorCount(void)
+    {
+#if defined(DUNE_SYS_HAS_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+      long count = sysconf(_SC_NPROCESSORS_ONLN);
+      if (count > 0)
+        return (unsigned)count;
+#endif
+
+      return 1;
+    }
+
     void
     Resources::lockMemory(void)
     {
@@ -55,6 +55,12 @@ namespace DUNE
       int
       getProcessorUsage(void);
 
+      //! Retrieve the number of processors currently online.
+      //! @return number of processors (1 if not implemented in the
+      //! current platform).
+      static unsigned
+      getProcessorCount(void);
+
       //! Make all memory pages mapped by the address space of the
       //! current process to be memory-resident until unlocked or until
       //! the process exits.
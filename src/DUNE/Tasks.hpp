@@ -43,11 +43,14 @@ namespace DUNE
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Manager.hpp>
+#include <DUNE/Tasks/Executor.hpp>
+#include <DUNE/Tasks/TimerWheel.hpp>
+#include <DUNE/Tasks/Profiler.hpp>
 #include <DUNE/Tasks/AbstractConsumer.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
 #include <DUNE/Tasks/AbstractCreator.hpp>
 #include <DUNE/Tasks/ParameterTable.hpp>
 #include <DUNE/Tasks/SimpleTransport.hpp>
-#include <DUNE/Tasks/RateLimiters.hpp>
+#include <DUNE/Tasks/MessageFilter.hpp>
 
 #endif
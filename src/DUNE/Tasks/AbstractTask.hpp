@@ -59,6 +59,16 @@ namespace DUNE
       virtual void
       receive(const IMC::Message* msg) = 0;
 
+      //! Queue a message for later consumption, taking ownership of
+      //! it instead of making a copy.
+      //! @param msg message object, deleted by the task.
+      virtual void
+      adopt(IMC::Message* msg)
+      {
+        receive(msg);
+        delete msg;
+      }
+
       //! Retrieve task name.
       //! @return task name.
       virtual const char*
@@ -0,0 +1,401 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Scheduler.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/System/Resources.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Constants.hpp>
+#include <DUNE/Tasks/Task.hpp>
+#include <DUNE/Tasks/Executor.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! Worker thread with its own job queue.
+    class Executor::Worker: public Concurrency::Thread
+    {
+    public:
+      Worker(Executor& executor):
+        m_executor(executor)
+      { }
+
+      //! Add a job to the back of the queue.
+      //! @param[in] job job.
+      void
+      push(Job* job)
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        m_queue.push_back(job);
+      }
+
+      //! Take the oldest job of the queue.
+      //! @return job or NULL if the queue is empty.
+      Job*
+      pop(void)
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        if (m_queue.empty())
+          return NULL;
+
+        Job* job = m_queue.front();
+        m_queue.pop_front();
+        return job;
+      }
+
+      //! Take the newest job of the queue on behalf of another worker.
+      //! @return job or NULL if the queue is empty.
+      Job*
+      steal(void)
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        if (m_queue.empty())
+          return NULL;
+
+        Job* job = m_queue.back();
+        m_queue.pop_back();
+        return job;
+      }
+
+    private:
+      //! Executor.
+      Executor& m_executor;
+      //! Job queue.
+      std::deque<Job*> m_queue;
+      //! Job queue lock.
+      Concurrency::Mutex m_lock;
+
+      void
+      run(void)
+      {
+        m_executor.m_current.set(this);
+
+        Job* job = NULL;
+        while ((job = m_executor.next(*this)) != NULL)
+          m_executor.execute(job, *this);
+
+        m_executor.m_current.set(NULL);
+      }
+    };
+
+    //! Resolution of the timer wheel (nanoseconds).
+    static const uint64_t c_timer_resolution = 100000;
+
+    //! Enable the virtual clock before it is first read.
+    static uint64_t
+    getOrigin(bool deterministic)
+    {
+      if (deterministic)
+        Time::Clock::enableVirtual();
+
+      return Time::Clock::getNsec();
+    }
+
+    Executor::Executor(unsigned threads, bool deterministic):
+      m_pending(0),
+      m_timers(getOrigin(deterministic), c_timer_resolution),
+      m_next(0),
+      m_stopping(false),
+      m_deterministic(deterministic)
+    {
+      // The queue of a deterministic executor is kept by a worker
+      // that is never started.
+      if (m_deterministic)
+      {
+        m_workers.push_back(new Worker(*this));
+        return;
+      }
+
+      if (threads == 0)
+        threads = System::Resources::getProcessorCount();
+
+      for (unsigned i = 0; i < threads; ++i)
+        m_workers.push_back(new Worker(*this));
+
+      for (unsigned i = 0; i < threads; ++i)
+        m_workers[i]->start();
+    }
+
+    Executor::~Executor(void)
+    {
+      stop();
+
+      for (size_t i = 0; i < m_workers.size(); ++i)
+        delete m_workers[i];
+
+      for (size_t i = 0; i < m_jobs.size(); ++i)
+        delete m_jobs[i];
+    }
+
+    void
+    Executor::setAffinity(const std::vector<unsigned>& cpus)
+    {
+      for (size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->setAffinity(cpus);
+    }
+
+    void
+    Executor::add(Task* task)
+    {
+      Job* job = new Job(*this, task);
+      job->m_state = Job::JS_QUEUED;
+      job->m_defer = task->defersMessages();
+      task->setJob(job);
+
+      m_cond.lock();
+      m_jobs.push_back(job);
+      m_cond.unlock();
+
+      enqueue(job);
+    }
+
+    void
+    Executor::stop(void)
+    {
+      m_cond.lock();
+      bool stopped = m_stopping;
+      m_stopping = true;
+      m_cond.broadcast();
+      m_cond.unlock();
+
+      if (stopped)
+        return;
+
+      for (size_t i = 0; i < m_workers.size() && !m_deterministic; ++i)
+        m_workers[i]->stopAndJoin();
+
+      for (size_t i = 0; i < m_jobs.size(); ++i)
+        m_jobs[i]->m_task->stopJob();
+    }
+
+    void
+    Executor::notify(Job* job)
+    {
+      {
+        Concurrency::ScopedMutex l(job->m_lock);
+        switch (job->m_state)
+        {
+          case Job::JS_IDLE:
+            job->m_state = Job::JS_QUEUED;
+            break;
+
+          case Job::JS_RUNNING:
+            job->m_state = Job::JS_NOTIFIED;
+            return;
+
+          case Job::JS_DELAYED:
+            if (job->m_defer)
+              return;
+
+            // Run now, the pending timer is ignored.
+            job->m_state = Job::JS_QUEUED;
+            ++job->m_timer;
+            break;
+
+          default:
+            return;
+        }
+      }
+
+      enqueue(job);
+    }
+
+    void
+    Executor::enqueue(Job* job, Worker* worker)
+    {
+      if (worker == NULL)
+        worker = static_cast<Worker*>(m_current.get());
+
+      m_cond.lock();
+
+      // Jobs queued from outside the pool are spread over the workers.
+      if (worker == NULL)
+      {
+        worker = m_workers[m_next];
+        m_next = (m_next + 1) % m_workers.size();
+      }
+
+      worker->push(job);
+      ++m_pending;
+      m_cond.signal();
+      m_cond.unlock();
+    }
+
+    bool
+    Executor::step(void)
+    {
+      Worker& worker = *m_workers[0];
+      Job* job = worker.pop();
+
+      m_cond.lock();
+
+      if (m_stopping)
+      {
+        m_cond.unlock();
+        return false;
+      }
+
+      if (job != NULL)
+      {
+        --m_pending;
+        m_cond.unlock();
+        execute(job, worker);
+        return true;
+      }
+
+      if (m_timers.empty())
+      {
+        m_cond.unlock();
+        return false;
+      }
+
+      // Jump to the next deadline.
+      Time::Clock::setVirtualNsec(m_timers.getNextDeadline());
+      expire(Time::Clock::getNsec(), worker);
+      m_cond.unlock();
+      return true;
+    }
+
+    void
+    Executor::expire(uint64_t now, Worker& worker)
+    {
+      m_timers.advance(now, m_expired);
+      for (size_t i = 0; i < m_expired.size(); ++i)
+      {
+        Job* delayed = m_expired[i].first;
+        delayed->m_lock.lock();
+        bool current = (delayed->m_state == Job::JS_DELAYED && delayed->m_timer == m_expired[i].second);
+        if (current)
+          delayed->m_state = Job::JS_QUEUED;
+        delayed->m_lock.unlock();
+
+        if (current)
+        {
+          worker.push(delayed);
+          ++m_pending;
+        }
+      }
+      m_expired.clear();
+    }
+
+    Executor::Job*
+    Executor::next(Worker& worker)
+    {
+      while (true)
+      {
+        Job* job = worker.pop();
+        for (size_t i = 0; job == NULL && i < m_workers.size(); ++i)
+        {
+          if (m_workers[i] != &worker)
+            job = m_workers[i]->steal();
+        }
+
+        m_cond.lock();
+
+        if (job != NULL)
+        {
+          --m_pending;
+          m_cond.unlock();
+          return job;
+        }
+
+        if (m_stopping)
+        {
+          m_cond.unlock();
+          return NULL;
+        }
+
+        uint64_t now = Time::Clock::getNsec();
+        expire(now, worker);
+
+        if (m_pending == 0)
+        {
+          double timeout = -1.0;
+          if (!m_timers.empty())
+          {
+            uint64_t deadline = m_timers.getNextDeadline();
+            timeout = (deadline > now) ? (deadline - now) / Time::c_nsec_per_sec_fp : 0.0;
+          }
+
+          m_cond.wait(timeout);
+          m_cond.unlock();
+        }
+        else
+        {
+          // Another worker is about to take the pending job.
+          m_cond.unlock();
+          Concurrency::Scheduler::yield();
+        }
+      }
+    }
+
+    void
+    Executor::execute(Job* job, Worker& worker)
+    {
+      job->m_lock.lock();
+      job->m_state = Job::JS_RUNNING;
+      job->m_lock.unlock();
+
+      double deadline = job->m_task->runJob();
+
+      job->m_lock.lock();
+      bool requeue = false;
+      unsigned timer = 0;
+      if (job->m_state == Job::JS_NOTIFIED && (deadline < 0.0 || !job->m_defer))
+        requeue = true;
+      else if (deadline >= 0.0)
+        timer = ++job->m_timer;
+
+      if (requeue)
+        job->m_state = Job::JS_QUEUED;
+      else if (deadline >= 0.0)
+        job->m_state = Job::JS_DELAYED;
+      else
+        job->m_state = Job::JS_IDLE;
+      job->m_lock.unlock();
+
+      if (requeue)
+      {
+        enqueue(job, &worker);
+      }
+      else if (deadline >= 0.0)
+      {
+        m_cond.lock();
+        m_timers.add((uint64_t)(deadline * Time::c_nsec_per_sec_fp), Timer(job, timer));
+        m_cond.broadcast();
+        m_cond.unlock();
+      }
+    }
+  }
+}
@@ -0,0 +1,260 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_EXECUTOR_HPP_INCLUDED_
+#define DUNE_TASKS_EXECUTOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+#include <utility>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/RawTLS.hpp>
+#include <DUNE/Tasks/TimerWheel.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Executor;
+
+    // Forward declarations.
+    class Task;
+
+    //! Pool of worker threads running cooperative tasks.
+    //!
+    //! Cooperative tasks do not have a thread of their own: each one
+    //! is a job that is queued when the task receives messages and
+    //! that consumes all pending messages when run. A job never runs
+    //! in more than one worker at a time. Each worker keeps its own
+    //! queue, where the jobs notified from that worker are placed,
+    //! and idle workers steal jobs from the queues of the others.
+    //! Jobs that must run again at a given time, like those of
+    //! periodic tasks, wait in a timer wheel shared by all workers;
+    //! new messages run them earlier unless their task defers
+    //! messages (see Task::deferMessages()).
+    //!
+    //! In deterministic mode there are no worker threads: jobs run
+    //! one at a time, in the order they were queued, in the thread
+    //! that calls step(), and time is given by the virtual clock
+    //! (see Time::Clock::enableVirtual()), which jumps to the next
+    //! timer deadline whenever no job is queued.
+    class Executor
+    {
+    public:
+      //! Job of a cooperative task.
+      class Job
+      {
+      public:
+        //! Queue the job to consume the pending messages of its task.
+        void
+        notify(void)
+        {
+          m_executor.notify(this);
+        }
+
+        //! Test if the executor is stopping.
+        //! @return true if the executor is stopping, false otherwise.
+        bool
+        isStopping(void) const
+        {
+          return m_executor.isStopping();
+        }
+
+      private:
+        friend class Executor;
+
+        //! Scheduling states.
+        enum State
+        {
+          //! Waiting for messages.
+          JS_IDLE,
+          //! Queued to run.
+          JS_QUEUED,
+          //! Running.
+          JS_RUNNING,
+          //! Running with new messages pending.
+          JS_NOTIFIED,
+          //! Waiting for its next run time.
+          JS_DELAYED
+        };
+
+        //! Executor.
+        Executor& m_executor;
+        //! Task.
+        Task* m_task;
+        //! Scheduling state.
+        State m_state;
+        //! Sequence number of the current timer, older timers are
+        //! ignored when they expire.
+        unsigned m_timer;
+        //! True if new messages wait for the timer.
+        bool m_defer;
+        //! Scheduling state lock.
+        Concurrency::Mutex m_lock;
+
+        Job(Executor& executor, Task* task):
+          m_executor(executor),
+          m_task(task),
+          m_state(JS_IDLE),
+          m_timer(0),
+          m_defer(false)
+        { }
+      };
+
+      //! Constructor.
+      //! @param[in] threads number of worker threads (0 for one per
+      //! processor), ignored in deterministic mode.
+      //! @param[in] deterministic true to create a deterministic
+      //! executor, which also enables the virtual clock.
+      Executor(unsigned threads = 0, bool deterministic = false);
+
+      //! Destructor.
+      ~Executor(void);
+
+      //! Get the number of worker threads.
+      //! @return number of worker threads.
+      unsigned
+      getThreadCount(void) const
+      {
+        return m_deterministic ? 0 : m_workers.size();
+      }
+
+      //! Test if the executor is deterministic.
+      //! @return true if the executor is deterministic, false otherwise.
+      bool
+      isDeterministic(void) const
+      {
+        return m_deterministic;
+      }
+
+      //! Run the next queued job in the calling thread or, if no job
+      //! is queued, move the virtual clock to the next timer deadline
+      //! and queue the jobs whose run time has come. Only available
+      //! in deterministic mode.
+      //! @return false if there was nothing to do or the executor is
+      //! stopping, true otherwise.
+      bool
+      step(void);
+
+      //! Pin the worker threads to a set of processors.
+      //! @param[in] cpus list of processors.
+      void
+      setAffinity(const std::vector<unsigned>& cpus);
+
+      //! Add a cooperative task and schedule its initialization.
+      //! @param[in] task task.
+      void
+      add(Task* task);
+
+      //! Test if the executor is stopping.
+      //! @return true if the executor is stopping, false otherwise.
+      bool
+      isStopping(void) const
+      {
+        return m_stopping;
+      }
+
+      //! Stop the worker threads, waiting for running jobs to finish,
+      //! and release the resources of all tasks.
+      void
+      stop(void);
+
+    private:
+      class Worker;
+      friend class Worker;
+
+      //! Timer of a job and its sequence number.
+      typedef std::pair<Job*, unsigned> Timer;
+
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Jobs.
+      std::vector<Job*> m_jobs;
+      //! Lock and condition of the idle workers. Protects the pending
+      //! count, the timers and the stopping flag.
+      Concurrency::Condition m_cond;
+      //! Number of queued jobs.
+      unsigned m_pending;
+      //! Jobs waiting for their next run time.
+      TimerWheel<Timer> m_timers;
+      //! Timers that expired.
+      std::vector<Timer> m_expired;
+      //! Worker of the calling thread.
+      Concurrency::RawTLS m_current;
+      //! Next worker to receive jobs queued from outside the pool.
+      unsigned m_next;
+      //! True if the executor is stopping.
+      bool m_stopping;
+      //! True if the executor is deterministic.
+      bool m_deterministic;
+
+      //! Schedule a job after its task received messages.
+      //! @param[in] job job.
+      void
+      notify(Job* job);
+
+      //! Place a job in a worker queue.
+      //! @param[in] job job.
+      //! @param[in] worker preferred worker (NULL for the calling one).
+      void
+      enqueue(Job* job, Worker* worker = NULL);
+
+      //! Queue the jobs whose run time has come. Must be called with
+      //! the idle workers lock held.
+      //! @param[in] now current time (nanoseconds).
+      //! @param[in] worker worker that receives the jobs.
+      void
+      expire(uint64_t now, Worker& worker);
+
+      //! Get the next job of a worker, waiting if there is none.
+      //! @param[in] worker worker.
+      //! @return job or NULL if the executor is stopping.
+      Job*
+      next(Worker& worker);
+
+      //! Run a job.
+      //! @param[in] job job.
+      //! @param[in] worker worker running the job.
+      void
+      execute(Job* job, Worker& worker);
+
+      // Non-copyable.
+      Executor(const Executor&);
+
+      // Non-assignable.
+      Executor&
+      operator=(const Executor&);
+    };
+  }
+}
+
+#endif
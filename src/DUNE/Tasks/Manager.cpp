@@ -30,23 +30,79 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <set>
+#include <utility>
 #include <cstddef>
 
 // DUNE headers.
+#include <DUNE/Math/MatrixKernels.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Delay.hpp>
+#include <DUNE/Utils/String.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Factory.hpp>
 #include <DUNE/Tasks/Exceptions.hpp>
+#include <DUNE/Tasks/Executor.hpp>
+#include <DUNE/Tasks/Profiler.hpp>
 #include <DUNE/Tasks/Manager.hpp>
 
 namespace DUNE
 {
   namespace Tasks
   {
+    //! Dependency graph: names of the tasks each task depends on.
+    typedef std::map<std::string, std::vector<std::string> > DependencyGraph;
+
+    //! Test if a task depends, directly or not, on another task.
+    //! @param[in] deps dependency graph.
+    //! @param[in] from dependent task.
+    //! @param[in] to dependency.
+    //! @return true if there is a path from 'from' to 'to'.
+    static bool
+    reaches(DependencyGraph& deps, const std::string& from, const std::string& to)
+    {
+      std::set<std::string> visited;
+      std::vector<std::string> stack(1, from);
+
+      while (!stack.empty())
+      {
+        std::string name = stack.back();
+        stack.pop_back();
+
+        if (name == to)
+          return true;
+
+        if (!visited.insert(name).second)
+          continue;
+
+        std::vector<std::string>& next = deps[name];
+        stack.insert(stack.end(), next.begin(), next.end());
+      }
+
+      return false;
+    }
+
     Manager::Manager(Context& ctx):
-      m_ctx(ctx)
+      m_ctx(ctx),
+      m_executor(NULL),
+      m_start_time(0)
     {
+      // Deterministic runs use the virtual clock from the start.
+      bool deterministic = false;
+      m_ctx.config.get("General", "Deterministic Executor", "false", deterministic);
+      if (deterministic)
+      {
+        uint64_t epoch = Time::Clock::c_virtual_epoch;
+        m_ctx.config.get("General", "Deterministic Epoch", Utils::String::str(epoch), epoch);
+        Time::Clock::enableVirtual(epoch);
+
+        // Fused multiply-add rounds differently, results must not
+        // depend on the CPU.
+        Math::Kernels::setImplementation("generic");
+      }
+
       // Get all sections.
       std::vector<std::string> vec = m_ctx.config.sections();
 
@@ -64,6 +120,214 @@ namespace DUNE
         if (ctx.profiles.isSelected(profiles))
           createTask(vec[i]);
       }
+
+      // Profile tasks if enabled.
+      bool profiler = false;
+      m_ctx.config.get("General", "Task Profiler", "false", profiler);
+      if (profiler)
+        createProfiler();
+
+      resolveDependencies();
+
+      // Cooperative tasks share a pool of worker threads if enabled.
+      bool cooperative = false;
+      m_ctx.config.get("General", "Cooperative Executor", "false", cooperative);
+      if (deterministic)
+      {
+        m_executor = new Executor(0, true);
+        checkCooperative();
+      }
+      else if (cooperative)
+      {
+        unsigned threads = 0;
+        m_ctx.config.get("General", "Executor Threads", "0", threads);
+        m_executor = new Executor(threads);
+
+        std::string affinity;
+        m_ctx.config.get("General", "Executor CPU Affinity", "", affinity);
+        if (!affinity.empty())
+          m_executor->setAffinity(Concurrency::Scheduler::parseProcessors(affinity));
+      }
+    }
+
+    void
+    Manager::checkCooperative(void)
+    {
+      // Tasks with threads of their own (mostly network I/O) keep
+      // running outside the deterministic schedule, reading the
+      // virtual clock as it jumps.
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        if (!itr->second->isCooperative())
+          itr->second->war(DTR("task is not cooperative, running outside the deterministic schedule"));
+      }
+    }
+
+    bool
+    Manager::isDeterministic(void) const
+    {
+      return m_executor != NULL && m_executor->isDeterministic();
+    }
+
+    bool
+    Manager::step(void)
+    {
+      if (!isDeterministic())
+        return false;
+
+      return m_executor->step();
+    }
+
+    void
+    Manager::createProfiler(void)
+    {
+      std::vector<Task*> tasks;
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        itr->second->setProfiling(true);
+        tasks.push_back(itr->second);
+      }
+
+      Task* task = new Profiler("Profiler", m_ctx, tasks);
+
+      try
+      {
+        task->loadConfig();
+        task->reserveEntities();
+        m_tasks["Profiler"] = task;
+        m_list.push_back("Profiler");
+      }
+      catch (std::exception& e)
+      {
+        task->err("%s", e.what());
+        delete task;
+      }
+    }
+
+    void
+    Manager::resolveDependencies(void)
+    {
+      DependencyGraph deps;
+      DependencyGraph dependents;
+      std::map<std::string, unsigned> pending;
+
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        const std::vector<std::string>& names = itr->second->getDependencyNames();
+        pending[itr->first] = 0;
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+          if (m_tasks.find(names[i]) == m_tasks.end() || names[i] == itr->first)
+          {
+            itr->second->war(DTR("ignoring unknown dependency '%s'"), names[i].c_str());
+            continue;
+          }
+
+          deps[itr->first].push_back(names[i]);
+          dependents[names[i]].push_back(itr->first);
+          ++pending[itr->first];
+        }
+      }
+
+      // Tasks left with pending dependencies after a topological
+      // sort are part of a cycle or depend on one.
+      std::vector<std::string> ready;
+      std::map<std::string, unsigned>::iterator pitr = pending.begin();
+      for (; pitr != pending.end(); ++pitr)
+      {
+        if (pitr->second == 0)
+          ready.push_back(pitr->first);
+      }
+
+      while (!ready.empty())
+      {
+        std::string name = ready.back();
+        ready.pop_back();
+
+        std::vector<std::string>& next = dependents[name];
+        for (size_t i = 0; i < next.size(); ++i)
+        {
+          if (--pending[next[i]] == 0)
+            ready.push_back(next[i]);
+        }
+      }
+
+      // Only dependencies that lead back to the task itself are
+      // dropped, tasks downstream of a cycle keep theirs.
+      DependencyGraph kept;
+      for (itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+      {
+        std::vector<std::string>& names = deps[itr->first];
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+          if (pending[itr->first] > 0 && reaches(deps, names[i], itr->first))
+            itr->second->err(DTR("ignoring circular dependency on '%s'"), names[i].c_str());
+          else
+            kept[itr->first].push_back(names[i]);
+        }
+      }
+
+      for (itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+      {
+        std::vector<Task*> tasks;
+        std::vector<std::string>& names = kept[itr->first];
+        for (size_t i = 0; i < names.size(); ++i)
+          tasks.push_back(m_tasks[names[i]]);
+
+        itr->second->setDependencies(tasks);
+      }
+    }
+
+    bool
+    Manager::isReady(void)
+    {
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        if (!itr->second->isReady())
+          return false;
+      }
+
+      return true;
+    }
+
+    std::string
+    Manager::getTimeline(void)
+    {
+      std::vector<std::pair<double, std::string> > entries;
+
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        if (!itr->second->isReady())
+        {
+          entries.push_back(std::make_pair(std::numeric_limits<double>::max(),
+                                           itr->first + ": " + DTR("not ready")));
+          continue;
+        }
+
+        Task::Timeline timeline = itr->second->getTimeline();
+        double ready = timeline.ready - m_start_time;
+        entries.push_back(std::make_pair(ready, Utils::String::str(DTR("%s: wait %0.2f s, acquire %0.2f s, initialize %0.2f s, ready at %0.2f s"),
+                                                            itr->first.c_str(), timeline.wait, timeline.acquire,
+                                                            timeline.initialize, ready)));
+      }
+
+      std::sort(entries.begin(), entries.end());
+
+      std::string str;
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+        if (i > 0)
+          str += "; ";
+        str += entries[i].second;
+      }
+
+      return str;
     }
 
     void
@@ -97,6 +361,10 @@ namespace DUNE
 
     Manager::~Manager(void)
     {
+      // Stop cooperative tasks.
+      if (m_executor != NULL)
+        m_executor->stop();
+
       // Request all tasks to stop.
       for (unsigned int i = 0; i < m_list.size(); ++i)
       {
@@ -116,6 +384,8 @@ namespace DUNE
         delete m_tasks[m_list[i]];
         m_tasks[m_list[i]] = NULL;
       }
+
+      delete m_executor;
     }
 
     void
@@ -144,6 +414,7 @@ namespace DUNE
     Manager::start(void)
     {
       std::map<std::string, Task*>::iterator itr;
+      m_start_time = Time::Clock::get();
 
       for (itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
         start(itr->first);
@@ -160,8 +431,40 @@ namespace DUNE
 
       try
       {
-        task->inf(DTR("starting"));
-        task->start();
+        if (m_executor != NULL && task->isCooperative())
+        {
+          // Cooperative tasks run on the executor's threads.
+          bool affinity = true;
+          try
+          {
+            affinity = !task->getProcessorAffinity().empty();
+          }
+          catch (std::exception&)
+          { }
+
+          if (affinity)
+            task->war(DTR("task is cooperative, ignoring its processor affinity"));
+
+          task->inf(DTR("starting (cooperative)"));
+          m_executor->add(task);
+        }
+        else
+        {
+          std::vector<unsigned> cpus;
+          try
+          {
+            cpus = task->getProcessorAffinity();
+          }
+          catch (std::exception&)
+          { }
+
+          if (cpus.empty())
+            task->inf(DTR("starting"));
+          else
+            task->inf(DTR("starting (processors %s)"),
+                      Concurrency::Scheduler::formatProcessors(cpus).c_str());
+          task->start();
+        }
       }
       catch (std::exception& e)
       {
@@ -46,6 +46,7 @@ namespace DUNE
     // Forward declarations
     struct Context;
     class Task;
+    class Executor;
 
     class Manager
     {
@@ -84,6 +85,30 @@ namespace DUNE
       void
       writeParamsXML(std::ostream& os) const;
 
+      //! Test if all tasks initialized their resources.
+      //! @return true if all tasks are ready, false otherwise.
+      bool
+      isReady(void);
+
+      //! Get the startup timeline of all tasks, ordered by the time at
+      //! which they became ready. Tasks that are not ready are listed
+      //! last.
+      //! @return startup timeline.
+      std::string
+      getTimeline(void);
+
+      //! Test if cooperative tasks run in a deterministic executor.
+      //! @return true if tasks run in a deterministic executor, false
+      //! otherwise.
+      bool
+      isDeterministic(void) const;
+
+      //! Run one step of the deterministic executor in the calling
+      //! thread (see Executor::step()).
+      //! @return false if there was nothing to do, true otherwise.
+      bool
+      step(void);
+
       std::map<std::string, Task*>::iterator
       begin(void)
       {
@@ -103,9 +128,27 @@ namespace DUNE
       std::map<std::string, Task*> m_tasks;
       //! Task context.
       Context& m_ctx;
+      //! Executor of cooperative tasks (NULL if disabled).
+      Executor* m_executor;
+      //! Time at which tasks were started (monotonic clock).
+      double m_start_time;
 
       void
       createTask(const std::string& section);
+
+      //! Create the task profiler and enable profiling of all tasks.
+      void
+      createProfiler(void);
+
+      //! Warn about tasks that are not cooperative, which run on
+      //! threads of their own outside the deterministic schedule.
+      void
+      checkCooperative(void);
+
+      //! Resolve the dependencies between tasks, ignoring unknown
+      //! tasks and circular dependencies.
+      void
+      resolveDependencies(void);
     };
   }
 }
@@ -0,0 +1,220 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Eduardo Marques                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Utils/String.hpp>
+#include <DUNE/Tasks/MessageFilter.hpp>
+#include <DUNE/Tasks/Task.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! Tolerance of the number of tokens needed to send a message.
+    static const double c_token_tolerance = 1e-9;
+
+    MessageFilter::MessageFilter(void):
+      m_sub_ids(false)
+    { }
+
+    void
+    MessageFilter::setup(const std::vector<std::string>& rates)
+    {
+      m_rules.clear();
+      m_index.clear();
+
+      for (size_t i = 0; i < rates.size(); ++i)
+      {
+        // Lists ending with a comma have an empty last entry.
+        if (Utils::String::trim(rates[i]).empty())
+          continue;
+
+        std::vector<std::string> parts;
+        Utils::String::split(rates[i], ":", parts);
+
+        double rate = 0;
+        double burst = 1;
+        bool valid = (parts.size() == 2 || parts.size() == 3)
+        && std::sscanf(parts[1].c_str(), "%lf", &rate) == 1 && rate >= 0;
+
+        if (valid && parts.size() == 3)
+          valid = std::sscanf(parts[2].c_str(), "%lf", &burst) == 1 && burst >= 1;
+
+        if (!valid)
+          throw std::runtime_error(Utils::String::str(DTR("invalid rate limiter: %s"), rates[i].c_str()));
+
+        Rule& rule = getRule(IMC::Factory::getIdFromAbbrev(parts[0]));
+        rule.limited = true;
+        rule.rate = rate;
+        rule.burst = burst;
+        rule.buckets.assign(c_max_entities, std::vector<Bucket>());
+      }
+    }
+
+    void
+    MessageFilter::setup(const std::vector<std::string>& rates,
+                         const std::vector<std::string>& entities,
+                         const Entities::EntityDataBase& db)
+    {
+      setup(rates);
+
+      for (size_t i = 0; i < entities.size(); ++i)
+      {
+        if (Utils::String::trim(entities[i]).empty())
+          continue;
+
+        std::vector<std::string> parts;
+        Utils::String::split(entities[i], ":", parts);
+        if (parts.size() != 2)
+          throw std::runtime_error(Utils::String::str(DTR("invalid entity filter: %s"), entities[i].c_str()));
+
+        Rule& rule = getRule(IMC::Factory::getIdFromAbbrev(parts[0]));
+        rule.restricted = true;
+
+        std::vector<std::string> labels;
+        Utils::String::split(parts[1], "+", labels);
+        for (size_t j = 0; j < labels.size(); ++j)
+        {
+          try
+          {
+            unsigned id = db.resolve(labels[j]);
+            if (id < c_max_entities)
+              rule.entities.set(id);
+          }
+          catch (Entities::EntityDataBase::NonexistentLabel&)
+          { }
+        }
+      }
+    }
+
+    std::vector<MessageFilter::Statistics>
+    MessageFilter::getStatistics(void) const
+    {
+      std::vector<Statistics> stats;
+      for (size_t i = 0; i < m_index.size(); ++i)
+      {
+        if (m_index[i] != 0)
+          stats.push_back(m_rules[m_index[i] - 1].stats);
+      }
+
+      return stats;
+    }
+
+    void
+    MessageFilter::report(Task& task)
+    {
+      for (size_t i = 0; i < m_rules.size(); ++i)
+      {
+        Statistics& stats = m_rules[i].stats;
+        if (stats.passed == 0 && stats.limited == 0 && stats.filtered == 0)
+          continue;
+
+        task.debug("message filter: %s: passed %llu, limited %llu, filtered %llu",
+                   IMC::Factory::getAbbrevFromId(stats.id).c_str(),
+                   (unsigned long long)stats.passed,
+                   (unsigned long long)stats.limited,
+                   (unsigned long long)stats.filtered);
+
+        stats.passed = 0;
+        stats.limited = 0;
+        stats.filtered = 0;
+      }
+    }
+
+    MessageFilter::Rule&
+    MessageFilter::getRule(uint32_t id)
+    {
+      if (id >= m_index.size())
+        m_index.resize(id + 1, 0);
+
+      if (m_index[id] == 0)
+      {
+        Rule rule;
+        rule.stats.id = id;
+        rule.stats.passed = 0;
+        rule.stats.limited = 0;
+        rule.stats.filtered = 0;
+        rule.limited = false;
+        rule.rate = 0;
+        rule.burst = 1;
+        rule.restricted = false;
+        m_rules.push_back(rule);
+        m_index[id] = m_rules.size();
+      }
+
+      return m_rules[m_index[id] - 1];
+    }
+
+    bool
+    MessageFilter::filter(Rule& rule, const IMC::Message* msg)
+    {
+      unsigned entity = msg->getSourceEntity() % c_max_entities;
+
+      if (rule.restricted && !rule.entities.test(entity))
+      {
+        ++rule.stats.filtered;
+        return true;
+      }
+
+      if (rule.limited)
+      {
+        std::vector<Bucket>& slots = rule.buckets[entity];
+        unsigned slot = m_sub_ids ? (msg->getSubId() % c_max_sub_ids) : 0;
+        if (slot >= slots.size())
+        {
+          Bucket fresh = {rule.burst, -1.0};
+          slots.resize(slot + 1, fresh);
+        }
+
+        Bucket& bucket = slots[slot];
+        double now = Time::Clock::get();
+
+        if (bucket.last >= 0)
+          bucket.tokens = std::min(rule.burst, bucket.tokens + (now - bucket.last) * rule.rate);
+        bucket.last = now;
+
+        if (bucket.tokens < 1.0 - c_token_tolerance)
+        {
+          ++rule.stats.limited;
+          return true;
+        }
+
+        bucket.tokens = std::max(0.0, bucket.tokens - 1.0);
+      }
+
+      ++rule.stats.passed;
+      return false;
+    }
+  }
+}
@@ -0,0 +1,195 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Eduardo Marques                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_MESSAGE_FILTER_HPP_INCLUDED_
+#define DUNE_TASKS_MESSAGE_FILTER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <bitset>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/Entities/EntityDataBase.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Forward declarations.
+    class Task;
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM MessageFilter;
+
+    //! Filter of outgoing messages shared by transports and loggers.
+    //!
+    //! Each message with a rule may be limited in rate, with a token
+    //! bucket per source entity (and optionally per sub-identifier),
+    //! and restricted to a set of source entities. Rules are kept in a table indexed by message
+    //! identifier, so filtering a message takes no lookups in
+    //! associative containers.
+    //!
+    //! Rate limiters are given as "Message:Frequency[:Burst]", where
+    //! frequency is the maximum rate (Hz) and burst the number of
+    //! messages that may be sent back to back (1 by default). A
+    //! frequency of zero lets only the first burst through. Entity
+    //! filters are given as "Message:Entity+Entity+...".
+    class MessageFilter
+    {
+    public:
+      //! Counters of a rule.
+      struct Statistics
+      {
+        //! Message identifier.
+        uint32_t id;
+        //! Number of messages that passed.
+        uint64_t passed;
+        //! Number of messages dropped by the rate limiter.
+        uint64_t limited;
+        //! Number of messages dropped by the entity filter.
+        uint64_t filtered;
+      };
+
+      //! Constructor.
+      MessageFilter(void);
+
+      //! Key token buckets by source entity and the lower eight bits
+      //! of the sub-identifier, so that messages of different
+      //! sub-identifiers are limited separately. Applies to rules
+      //! configured afterwards.
+      //! @param[in] enabled true to key buckets by sub-identifier.
+      void
+      setKeyBySubId(bool enabled)
+      {
+        m_sub_ids = enabled;
+      }
+
+      //! Configure the rate limiters, removing all rules.
+      //! @param[in] rates rate limiters.
+      //! @throw std::runtime_error if a rate limiter is invalid.
+      void
+      setup(const std::vector<std::string>& rates);
+
+      //! Configure the rate limiters and entity filters, removing all
+      //! rules. Unknown entities never match.
+      //! @param[in] rates rate limiters.
+      //! @param[in] entities entity filters.
+      //! @param[in] db entity database used to resolve entity labels.
+      //! @throw std::runtime_error if a rule is invalid.
+      void
+      setup(const std::vector<std::string>& rates,
+            const std::vector<std::string>& entities,
+            const Entities::EntityDataBase& db);
+
+      //! Test if a message must be dropped.
+      //! @param[in] msg message.
+      //! @return true if the message must be dropped, false otherwise.
+      bool
+      filter(const IMC::Message* msg)
+      {
+        uint32_t id = msg->getId();
+        if (id >= m_index.size() || m_index[id] == 0)
+          return false;
+
+        return filter(m_rules[m_index[id] - 1], msg);
+      }
+
+      //! Retrieve the counters of all rules.
+      //! @return rule counters, ordered by message identifier.
+      std::vector<Statistics>
+      getStatistics(void) const;
+
+      //! Log the counters of the rules that saw messages since the
+      //! last report as debug messages of a task, and reset them.
+      //! @param[in] task task.
+      void
+      report(Task& task);
+
+    private:
+      //! Maximum number of source entities.
+      static const unsigned c_max_entities = 256;
+      //! Maximum number of sub-identifiers per source entity.
+      static const unsigned c_max_sub_ids = 256;
+
+      //! Token bucket.
+      struct Bucket
+      {
+        //! Available tokens.
+        double tokens;
+        //! Time of the last refill.
+        double last;
+      };
+
+      //! Rule of a message.
+      struct Rule
+      {
+        //! Counters.
+        Statistics stats;
+        //! True if the message is rate limited.
+        bool limited;
+        //! Maximum rate (Hz).
+        double rate;
+        //! Bucket capacity.
+        double burst;
+        //! Token buckets by source entity and, if keyed by
+        //! sub-identifier, by sub-identifier. Buckets of a source
+        //! entity are only allocated when it sends the message.
+        std::vector<std::vector<Bucket> > buckets;
+        //! True if the message is restricted to some entities.
+        bool restricted;
+        //! Entities that may send the message.
+        std::bitset<c_max_entities> entities;
+      };
+
+      //! True to key token buckets by sub-identifier.
+      bool m_sub_ids;
+      //! Rules.
+      std::vector<Rule> m_rules;
+      //! Index of the rule (plus one) of each message identifier, or
+      //! zero if the message has no rule.
+      std::vector<unsigned> m_index;
+
+      //! Get the rule of a message, creating it if needed.
+      //! @param[in] id message identifier.
+      //! @return rule.
+      Rule&
+      getRule(uint32_t id);
+
+      //! Apply a rule to a message.
+      //! @param[in] rule rule.
+      //! @param[in] msg message.
+      //! @return true if the message must be dropped, false otherwise.
+      bool
+      filter(Rule& rule, const IMC::Message* msg);
+    };
+  }
+}
+
+#endif
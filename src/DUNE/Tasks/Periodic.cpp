@@ -28,6 +28,7 @@
 // ISO C++ 98 headers.
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Bus.hpp>
@@ -43,43 +44,76 @@ namespace DUNE
     Periodic::Periodic(const std::string& name, Context& ctx):
       Task(name, ctx),
       m_run_count(0),
-      m_run_time(0)
+      m_run_time(0),
+      m_deadline(0)
     {
+      m_stats.overruns = 0;
+      m_stats.jitter_mean = 0;
+      m_stats.jitter_max = 0;
+
       param(DTR_RT("Execution Frequency"), m_frequency)
       .units(Units::Hertz)
       .defaultValue("1.0")
       .description(DTR("Frequency at which task is executed"));
+
+      setCooperative();
+      deferMessages();
     }
 
-    void
-    Periodic::onMain(void)
+    double
+    Periodic::cycle(void)
     {
       double now = Time::Clock::get();
-      double delay = (1 / m_frequency);
-      double next_inv = now + delay;
+      double jitter = std::max(0.0, now - m_deadline);
       m_run_time = now;
 
-      while (!stopping())
+      // Perform job.
+      consumeMessages();
+      if (!stopping())
       {
-        delay = (1.0 / m_frequency);
+        task();
+        ++m_run_count;
 
-        if (next_inv > now)
-          Time::Delay::wait(next_inv - now);
+        m_stats.jitter_mean += (jitter - m_stats.jitter_mean) / m_run_count;
+        m_stats.jitter_max = std::max(m_stats.jitter_max, jitter);
+      }
+
+      double period = 1.0 / m_frequency;
+      m_deadline += period;
+
+      // Skip missed cycles instead of running them back to back.
+      now = Time::Clock::get();
+      if (m_deadline < now)
+      {
+        ++m_stats.overruns;
+        m_deadline += std::ceil((now - m_deadline) / period) * period;
+      }
 
-        next_inv += delay;
-        now = Time::Clock::get();
-        m_run_time = now;
+      return m_deadline;
+    }
 
-        // Perform job.
-        consumeMessages();
-        if (!stopping())
-        {
-          task();
-          ++m_run_count;
-        }
+    void
+    Periodic::onMain(void)
+    {
+      m_run_time = Time::Clock::get();
+      m_deadline = m_run_time + 1.0 / m_frequency;
 
-        now = Time::Clock::get();
+      while (!stopping())
+      {
+        Time::Delay::waitUntil(m_deadline);
+        cycle();
       }
     }
+
+    double
+    Periodic::onJob(bool restarted)
+    {
+      if (!restarted)
+        return cycle();
+
+      m_run_time = Time::Clock::get();
+      m_deadline = m_run_time + 1.0 / m_frequency;
+      return m_deadline;
+    }
   }
 }
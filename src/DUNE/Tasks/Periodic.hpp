@@ -47,10 +47,28 @@ namespace DUNE
     // Forward declarations
     struct Context;
 
-    //! Periodic task.
+    //! Periodic task. Cycles are scheduled at absolute times, so the
+    //! latency of each wakeup does not accumulate, and cycles that
+    //! start after the end of the next period are skipped. Periodic
+    //! tasks are cooperative: if the cooperative executor is enabled
+    //! they run on its worker threads unless the 'Dedicated Thread'
+    //! parameter is set.
     class Periodic: public Task
     {
     public:
+      //! Scheduling statistics.
+      struct Statistics
+      {
+        //! Number of cycles that ended after the start of the next.
+        unsigned overruns;
+        //! Mean delay between the scheduled and actual start of a
+        //! cycle (s).
+        double jitter_mean;
+        //! Maximum delay between the scheduled and actual start of a
+        //! cycle (s).
+        double jitter_max;
+      };
+
       //! Constructor.
       Periodic(const std::string& name, Context& ctx);
 
@@ -93,6 +111,14 @@ namespace DUNE
         return m_run_count;
       }
 
+      //! Retrieve the scheduling statistics of the task.
+      //! @return scheduling statistics.
+      inline const Statistics&
+      getStatistics(void) const
+      {
+        return m_stats;
+      }
+
       //! The task to be executed on each cycle.
       virtual void
       task(void) = 0;
@@ -102,12 +128,25 @@ namespace DUNE
       unsigned m_run_count;
       //! Time of last run.
       double m_run_time;
+      //! Scheduled start of the next cycle (monotonic clock).
+      double m_deadline;
       //! Task frequency (Hz).
       double m_frequency;
+      //! Scheduling statistics.
+      Statistics m_stats;
+
+      //! Run one cycle and schedule the next.
+      //! @return scheduled start of the next cycle.
+      double
+      cycle(void);
 
       //! Task entry point.
       void
       onMain(void);
+
+      //! Executor entry point.
+      double
+      onJob(bool restarted);
     };
   }
 }
@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/Tasks/Context.hpp>
+#include <DUNE/Tasks/Profiler.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Constants.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    Profiler::Profiler(const std::string& name, Context& ctx, const std::vector<Task*>& tasks):
+      Periodic(name, ctx),
+      m_last(0)
+    {
+      param("Dump File", m_dump_file)
+      .defaultValue("TaskProfile.folded")
+      .description("Name of the folded stacks file, relative to the log directory");
+
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        Entry entry;
+        entry.task = tasks[i];
+        entry.has_usage = false;
+        entry.cpu_time = 0;
+        m_entries.push_back(entry);
+      }
+
+      setEntityLabel(name);
+      bind<IMC::Event>(this);
+    }
+
+    void
+    Profiler::onResourceInitialization(void)
+    {
+      m_last = Time::Clock::get();
+
+      for (size_t i = 0; i < m_entries.size(); ++i)
+        m_entries[i].has_usage = m_entries[i].task->getUsage(m_entries[i].usage);
+    }
+
+    void
+    Profiler::sample(Entry& entry, double elapsed)
+    {
+      Recipient::StatisticsMap stats;
+      unsigned max_depth = 0;
+      entry.task->takeConsumerStatistics(stats, max_depth);
+
+      unsigned count = 0;
+      uint64_t time = 0;
+      uint64_t max_time = 0;
+      uint32_t slowest = 0;
+
+      Recipient::StatisticsMap::const_iterator itr = stats.begin();
+      for (; itr != stats.end(); ++itr)
+      {
+        count += itr->second.count;
+        time += itr->second.time;
+        if (itr->second.max_time >= max_time)
+        {
+          max_time = itr->second.max_time;
+          slowest = itr->first;
+        }
+
+        Recipient::Statistics& total = entry.totals[itr->first];
+        total.count += itr->second.count;
+        total.time += itr->second.time;
+        total.max_time = std::max(total.max_time, itr->second.max_time);
+      }
+
+      // Tasks without a thread of their own are charged the time
+      // spent in consumers.
+      double cpu_time = time / Time::c_nsec_per_sec_fp;
+      uint64_t voluntary = 0;
+      uint64_t involuntary = 0;
+
+      Concurrency::Thread::Usage usage;
+      if (entry.task->getUsage(usage))
+      {
+        if (entry.has_usage)
+        {
+          cpu_time = usage.cpu_time - entry.usage.cpu_time;
+          voluntary = usage.voluntary_switches - entry.usage.voluntary_switches;
+          involuntary = usage.involuntary_switches - entry.usage.involuntary_switches;
+        }
+
+        entry.usage = usage;
+        entry.has_usage = true;
+      }
+
+      entry.cpu_time += cpu_time;
+
+      std::ostringstream os;
+      os << std::fixed << std::setprecision(2)
+         << "Task=" << entry.task->getName()
+         << ";CPU=" << cpu_time * 100.0 / elapsed
+         << ";Voluntary Switches=" << voluntary
+         << ";Involuntary Switches=" << involuntary
+         << ";Queue=" << entry.task->getQueueSize()
+         << ";Queue Peak=" << max_depth
+         << ";Messages=" << count
+         << ";Consume Time=" << time / 1e6;
+
+      if (count > 0)
+      {
+        os << ";Slowest Message=" << IMC::Factory::getAbbrevFromId(slowest)
+           << ";Slowest Consume Time=" << max_time / 1e6;
+      }
+
+      IMC::Event event;
+      event.topic = "Task Profile";
+      event.data = os.str();
+      dispatch(event);
+
+      trace("%s", event.data.c_str());
+    }
+
+    void
+    Profiler::writeFoldedStacks(std::ostream& os) const
+    {
+      for (size_t i = 0; i < m_entries.size(); ++i)
+      {
+        const Entry& entry = m_entries[i];
+        uint64_t total = (uint64_t)(entry.cpu_time * 1e6);
+        uint64_t consumed = 0;
+
+        Recipient::StatisticsMap::const_iterator itr = entry.totals.begin();
+        for (; itr != entry.totals.end(); ++itr)
+        {
+          uint64_t usec = itr->second.time / 1000;
+          consumed += usec;
+          if (usec > 0)
+          {
+            os << "dune;" << entry.task->getName() << ";"
+               << IMC::Factory::getAbbrevFromId(itr->first) << " " << usec << "\n";
+          }
+        }
+
+        // Time spent outside consumers (main loop, periodic jobs).
+        if (total > consumed)
+          os << "dune;" << entry.task->getName() << ";[main] " << total - consumed << "\n";
+      }
+    }
+
+    void
+    Profiler::consume(const IMC::Event* msg)
+    {
+      if (msg->topic != "Dump Task Profile")
+        return;
+
+      FileSystem::Path file = m_ctx.dir_log / m_dump_file;
+      std::ofstream ofs(file.c_str());
+      writeFoldedStacks(ofs);
+
+      if (ofs.fail())
+        err(DTR("failed to write task profile to '%s'"), file.c_str());
+      else
+        inf(DTR("wrote task profile to '%s'"), file.c_str());
+    }
+
+    void
+    Profiler::task(void)
+    {
+      double now = Time::Clock::get();
+      double elapsed = now - m_last;
+      if (elapsed <= 0)
+        return;
+
+      m_last = now;
+      for (size_t i = 0; i < m_entries.size(); ++i)
+        sample(m_entries[i], elapsed);
+    }
+  }
+}
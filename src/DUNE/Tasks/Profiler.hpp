@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_PROFILER_HPP_INCLUDED_
+#define DUNE_TASKS_PROFILER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+#include <ostream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/Tasks/Periodic.hpp>
+#include <DUNE/Tasks/Recipient.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Profiler;
+
+    //! Built-in task that profiles the other tasks. On each cycle it
+    //! samples the processor time and context switches of each task
+    //! thread, the depth of each task's message queue and the time
+    //! spent consuming each message type, and dispatches one
+    //! IMC::Event with topic 'Task Profile' per task. On reception of
+    //! an IMC::Event with topic 'Dump Task Profile' it writes the
+    //! accumulated processor time of all tasks in the folded stack
+    //! format used by flame graph tools.
+    class Profiler: public Periodic
+    {
+    public:
+      //! Constructor.
+      //! @param[in] name task name.
+      //! @param[in] ctx context.
+      //! @param[in] tasks tasks to profile.
+      Profiler(const std::string& name, Context& ctx, const std::vector<Task*>& tasks);
+
+      //! Write the accumulated processor time of all tasks as folded
+      //! stacks (one "dune;task;message microseconds" line per
+      //! message type).
+      //! @param[in] os output stream.
+      void
+      writeFoldedStacks(std::ostream& os) const;
+
+      void
+      consume(const IMC::Event* msg);
+
+      void
+      task(void);
+
+    private:
+      //! Profile of a task.
+      struct Entry
+      {
+        //! Task.
+        Task* task;
+        //! Last usage counters of the task thread.
+        Concurrency::Thread::Usage usage;
+        //! True if the task thread usage counters are available.
+        bool has_usage;
+        //! Accumulated processor time (s).
+        double cpu_time;
+        //! Accumulated consumer statistics.
+        Recipient::StatisticsMap totals;
+      };
+
+      //! Name of the dump file, relative to the log directory.
+      std::string m_dump_file;
+      //! Profiles.
+      std::vector<Entry> m_entries;
+      //! Time of the last sample.
+      double m_last;
+
+      void
+      onResourceInitialization(void);
+
+      //! Sample a task and dispatch its profile.
+      //! @param[in] entry task profile.
+      //! @param[in] elapsed time since the last sample (s).
+      void
+      sample(Entry& entry, double elapsed);
+    };
+  }
+}
+
+#endif
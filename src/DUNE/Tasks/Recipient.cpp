@@ -27,10 +27,13 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/Factory.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
 
@@ -40,7 +43,9 @@ namespace DUNE
   {
     Recipient::Recipient(AbstractTask* task, Context& ctx):
       m_task(task),
-      m_ctx(ctx)
+      m_ctx(ctx),
+      m_profiling(false),
+      m_max_depth(0)
     { }
 
     Recipient::~Recipient(void)
@@ -94,22 +99,56 @@ namespace DUNE
       m_mqueue.push(msg->clone());
     }
 
+    void
+    Recipient::adopt(IMC::Message* msg)
+    {
+      m_mqueue.push(msg);
+    }
+
     void
     Recipient::runCallBacks(void)
     {
       unsigned int size = m_mqueue.size();
 
+      if (m_profiling)
+      {
+        Concurrency::ScopedMutex l(m_stats_lock);
+        m_max_depth = std::max(m_max_depth, size);
+      }
+
       for (unsigned int i = 0; i < size; ++i)
       {
         const IMC::Message* msg = m_mqueue.pop();
         if (msg)
         {
           uint32_t id = msg->getId();
+          uint64_t start = m_profiling ? Time::Clock::getNsec() : 0;
+
           for (size_t j = 0; j < m_cbacks[id].size(); ++j)
             m_cbacks[id][j]->consume(msg);
           delete msg;
+
+          if (m_profiling)
+          {
+            uint64_t elapsed = Time::Clock::getNsec() - start;
+            Concurrency::ScopedMutex l(m_stats_lock);
+            Statistics& stats = m_stats[id];
+            ++stats.count;
+            stats.time += elapsed;
+            stats.max_time = std::max(stats.max_time, elapsed);
+          }
         }
       }
     }
+
+    void
+    Recipient::takeStatistics(StatisticsMap& stats, unsigned& max_depth)
+    {
+      Concurrency::ScopedMutex l(m_stats_lock);
+      stats.clear();
+      stats.swap(m_stats);
+      max_depth = m_max_depth;
+      m_max_depth = 0;
+    }
   }
 }
@@ -33,6 +33,7 @@
 #include <vector>
 
 // DUNE headers.
+#include <DUNE/Concurrency/Mutex.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
@@ -50,6 +51,20 @@ namespace DUNE
     class Recipient
     {
     public:
+      //! Consumer statistics of a message type.
+      struct Statistics
+      {
+        //! Number of consumed messages.
+        unsigned count;
+        //! Total time spent in consumers (ns).
+        uint64_t time;
+        //! Maximum time spent consuming one message (ns).
+        uint64_t max_time;
+      };
+
+      //! Consumer statistics by message identification number.
+      typedef std::map<uint32_t, Statistics> StatisticsMap;
+
       //! Constructor.
       Recipient(AbstractTask* task, Context& ctx);
 
@@ -62,6 +77,11 @@ namespace DUNE
       void
       put(const IMC::Message*);
 
+      //! Queue a message, taking ownership of it.
+      //! @param msg message object.
+      void
+      adopt(IMC::Message* msg);
+
       void
       bind(uint32_t id, AbstractConsumer* c);
 
@@ -71,6 +91,31 @@ namespace DUNE
       void
       runCallBacks(void);
 
+      //! Enable or disable the measurement of the time spent in
+      //! consumers. Must be called before messages are consumed.
+      //! @param[in] enabled true to enable measurements.
+      void
+      setProfiling(bool enabled)
+      {
+        m_profiling = enabled;
+      }
+
+      //! Get the number of messages waiting to be consumed.
+      //! @return number of messages.
+      unsigned
+      getQueueSize(void)
+      {
+        return m_mqueue.size();
+      }
+
+      //! Retrieve and reset the consumer statistics gathered since
+      //! the last call.
+      //! @param[out] stats consumer statistics.
+      //! @param[out] max_depth maximum number of messages waiting to
+      //! be consumed.
+      void
+      takeStatistics(StatisticsMap& stats, unsigned& max_depth);
+
     private:
       //! Task.
       AbstractTask* m_task;
@@ -80,6 +125,14 @@ namespace DUNE
       std::map<uint32_t, std::vector<AbstractConsumer*> > m_cbacks;
       //! Message queue.
       Concurrency::TSQueue<IMC::Message*> m_mqueue;
+      //! True if the time spent in consumers is measured.
+      bool m_profiling;
+      //! Consumer statistics.
+      StatisticsMap m_stats;
+      //! Maximum number of messages waiting to be consumed.
+      unsigned m_max_depth;
+      //! Lock of the consumer statistics.
+      Concurrency::Mutex m_stats_lock;
     };
   }
 }
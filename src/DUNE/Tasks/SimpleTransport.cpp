@@ -44,7 +44,11 @@ namespace DUNE
 
       param("Rate Limiters", m_gargs.rlim)
       .defaultValue("")
-      .description("Rate limiters (message name/frequency pairs)");
+      .description("Rate limiters (message name/frequency pairs, with optional burst size)");
+
+      param("Filtered Entities", m_gargs.entities)
+      .defaultValue("")
+      .description("Entities allowed to send each message (message name/entity labels pairs)");
 
       param("Trace - Incoming Messages", m_gargs.trace_in)
       .defaultValue("false")
@@ -61,7 +65,7 @@ namespace DUNE
     void
     SimpleTransport::consume(const IMC::Message* msg)
     {
-      if (m_rl.filter(msg))
+      if (m_filter.filter(msg))
         return;
 
       unsigned int n = msg->getSerializationSize();
@@ -81,7 +85,7 @@ namespace DUNE
     void
     SimpleTransport::onMain(void)
     {
-      m_rl.setup(m_gargs.rlim);
+      m_filter.setup(m_gargs.rlim, m_gargs.entities, m_ctx.entities);
       bind(this, m_gargs.transports);
 
       while (!stopping())
@@ -90,6 +94,8 @@ namespace DUNE
 
         onDataReception(m_buf.getBuffer(), m_buf.getCapacity(), 0.005);
       }
+
+      m_filter.report(*this);
     }
 
     void
@@ -36,7 +36,7 @@
 #include <DUNE/Utils/ByteBuffer.hpp>
 #include <DUNE/IMC/Parser.hpp>
 #include <DUNE/Tasks/Task.hpp>
-#include <DUNE/Tasks/RateLimiters.hpp>
+#include <DUNE/Tasks/MessageFilter.hpp>
 
 namespace DUNE
 {
@@ -73,12 +73,13 @@ namespace DUNE
       {
         std::vector<std::string> transports;
         std::vector<std::string> rlim;
+        std::vector<std::string> entities;
         bool trace_in;
         bool trace_out;
       };
       GArguments m_gargs;
       Utils::ByteBuffer m_buf;
-      RateLimiters m_rl;
+      MessageFilter m_filter;
     };
   }
 }
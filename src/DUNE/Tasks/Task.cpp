@@ -29,10 +29,12 @@
 // ISO C++ 98 headers.
 #include <sstream>
 #include <cstddef>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Constants.hpp>
 #include <DUNE/IMC/Bus.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/PeriodicDelay.hpp>
 #include <DUNE/Time/Counter.hpp>
@@ -50,6 +52,15 @@ namespace DUNE
 {
   namespace Tasks
   {
+    //! Initial delay between resource initialization attempts (s).
+    static const double c_init_retry_delay_min = 0.1;
+    //! Maximum delay between resource initialization attempts (s).
+    static const double c_init_retry_delay_max = 1.0;
+    //! Minimum interval between repeated resource initialization errors (s).
+    static const double c_init_error_period = 10.0;
+    //! Period at which cooperative tasks check their dependencies (s).
+    static const double c_dependency_poll_period = 0.1;
+
     //! Maximum size of a log book entry message.
     const static size_t c_log_message_max_size = 1024;
 
@@ -59,12 +70,31 @@ namespace DUNE
       m_name(n),
       m_entity(NULL),
       m_debug_level(DEBUG_LEVEL_NONE),
-      m_honours_active(false)
-    {
+      m_honours_active(false),
+      m_cooperative(false),
+      m_defer_messages(false),
+      m_job(NULL),
+      m_job_ready(false),
+      m_job_initializing(false),
+      m_init_delay(c_init_retry_delay_min),
+      m_init_retry(0.0),
+      m_init_failures(0),
+      m_init_last_error(-1.0),
+      m_job_restart(false),
+      m_ready(false),
+      m_setup_time(-1.0),
+      m_setup_acquired(0.0)
+    {
+      m_timeline.wait = 0;
+      m_timeline.acquire = 0;
+      m_timeline.initialize = 0;
+      m_timeline.ready = 0;
+
       m_args.priority = 10;
       m_args.act_time = 0;
       m_args.deact_time = 0;
       m_args.active = false;
+      m_args.dedicated = false;
 
       param(DTR_RT("Entity Label"), m_args.elabel)
       .defaultValue("")
@@ -80,6 +110,22 @@ namespace DUNE
       param(DTR_RT("Deactivation Time"), m_args.deact_time)
       .defaultValue("0");
 
+      param(DTR_RT("CPU Affinity"), m_args.affinity)
+      .defaultValue("")
+      .description(DTR("Processors the task may run on (e.g., '0-1,3'), all if empty"));
+
+      param(DTR_RT("CPU Group"), m_args.cpu_group)
+      .defaultValue("")
+      .description(DTR("Group of processors defined in section 'CPU Groups', or 'Isolated', used if 'CPU Affinity' is empty"));
+
+      param(DTR_RT("Dependencies"), m_args.dependencies)
+      .defaultValue("")
+      .description(DTR("Tasks that must initialize their resources before this task acquires its own"));
+
+      param(DTR_RT("Dedicated Thread"), m_args.dedicated)
+      .defaultValue("false")
+      .description(DTR("Run task on a thread of its own even if the cooperative executor is enabled"));
+
       param(DTR_RT("Debug Level"), m_debug_level_string)
       .defaultValue("None")
       .values("None, Debug, Trace, Spew");
@@ -167,19 +213,93 @@ namespace DUNE
     {
       while (!stopping())
       {
-        try
-        {
-          onResourceInitialization();
+        if (tryInitializeResources())
           return;
-        }
-        catch (std::exception& e)
+
+        double delay = m_init_retry - Time::Clock::get();
+        if (delay > 0)
+          Time::Delay::wait(delay);
+      }
+    }
+
+    bool
+    Task::tryInitializeResources(void)
+    {
+      try
+      {
+        onResourceInitialization();
+        m_init_delay = c_init_retry_delay_min;
+        m_init_retry = 0.0;
+        m_init_failures = 0;
+        m_init_last_error = -1.0;
+        m_init_last_what.clear();
+        return true;
+      }
+      catch (std::exception& e)
+      {
+        // Report the first failure and then at most once per period,
+        // unless the error changes.
+        ++m_init_failures;
+        double now = Time::Clock::get();
+        if (m_init_last_error < 0.0 || m_init_last_what != e.what()
+            || now - m_init_last_error >= c_init_error_period)
         {
-          err("%s", e.what());
-          Time::Delay::wait(1.0);
+          if (m_init_failures > 1)
+            err(DTR("%s (%u failed attempts)"), e.what(), m_init_failures);
+          else
+            err("%s", e.what());
+
+          m_init_last_error = now;
+          m_init_last_what = e.what();
         }
+
+        m_init_retry = now + m_init_delay;
+        m_init_delay = std::min(m_init_delay * 2.0, c_init_retry_delay_max);
+        return false;
       }
     }
 
+    bool
+    Task::isReady(void)
+    {
+      m_ready_cond.lock();
+      bool ready = m_ready;
+      m_ready_cond.unlock();
+      return ready;
+    }
+
+    bool
+    Task::waitReady(double timeout)
+    {
+      m_ready_cond.lock();
+      if (!m_ready)
+        m_ready_cond.wait(timeout);
+      bool ready = m_ready;
+      m_ready_cond.unlock();
+      return ready;
+    }
+
+    Task::Timeline
+    Task::getTimeline(void)
+    {
+      m_ready_cond.lock();
+      Timeline timeline = m_timeline;
+      m_ready_cond.unlock();
+      return timeline;
+    }
+
+    bool
+    Task::dependenciesReady(void)
+    {
+      for (size_t i = 0; i < m_dependencies.size(); ++i)
+      {
+        if (!m_dependencies[i]->isReady())
+          return false;
+      }
+
+      return true;
+    }
+
     void
     Task::paramActive(Parameter::Scope def_scope, Parameter::Visibility def_visibility, bool def_value)
     {
@@ -331,6 +451,115 @@ namespace DUNE
       m_entity->failDeactivation(reason);
     }
 
+    void
+    Task::setup(void)
+    {
+      beginSetup();
+      initializeResources();
+      finishSetup();
+    }
+
+    void
+    Task::beginSetup(void)
+    {
+      m_ready_cond.lock();
+      m_ready = false;
+      m_ready_cond.unlock();
+
+      if (m_setup_time < 0)
+        m_setup_time = Time::Clock::get();
+
+      for (size_t i = 0; i < m_dependencies.size(); ++i)
+      {
+        if (!m_dependencies[i]->isReady())
+          debug(DTR("waiting for %s"), m_dependencies[i]->getName());
+
+        while (!stopping() && !m_dependencies[i]->waitReady(1.0))
+          reportEntityState();
+      }
+
+      double start = Time::Clock::get();
+      resolveEntities();
+      releaseResources();
+      acquireResources();
+      double acquired = Time::Clock::get();
+
+      m_ready_cond.lock();
+      m_timeline.wait = start - m_setup_time;
+      m_timeline.acquire = acquired - start;
+      m_ready_cond.unlock();
+      m_setup_acquired = acquired;
+    }
+
+    void
+    Task::finishSetup(void)
+    {
+      double initialized = Time::Clock::get();
+
+      m_ready_cond.lock();
+      m_timeline.initialize = initialized - m_setup_acquired;
+      m_timeline.ready = initialized;
+      m_ready = !stopping();
+      m_ready_cond.broadcast();
+      m_ready_cond.unlock();
+      m_setup_time = -1.0;
+
+      if (m_honours_active)
+      {
+        Parameter::Scope active_scope = Parameter::scopeFromString(m_args.active_scope);
+        if (m_args.active && ((active_scope == Parameter::SCOPE_GLOBAL) || (active_scope == Parameter::SCOPE_IDLE)))
+          requestActivation();
+      }
+    }
+
+    void
+    Task::reportRestart(RestartNeeded& e)
+    {
+      if (e.isError())
+      {
+        setEntityState(IMC::EntityState::ESTA_FAILURE, DTR("restarting"));
+        err(DTR("restarting in %u seconds due to error: %s"),
+            e.getDelay(), e.getError());
+      }
+    }
+
+    void
+    Task::reportFailure(const std::exception& e)
+    {
+      IMC::EntityState estate;
+      setEntityState(IMC::EntityState::ESTA_FAILURE, e.what());
+      dispatch(estate);
+      err(DTR("task died with uncaught exception: %s: restarting"), e.what());
+    }
+
+    std::vector<unsigned>
+    Task::getProcessorAffinity(void)
+    {
+      if (!m_args.affinity.empty())
+        return Concurrency::Scheduler::parseProcessors(m_args.affinity);
+
+      if (m_args.cpu_group.empty())
+        return std::vector<unsigned>();
+
+      std::vector<unsigned> cpus;
+      if (m_args.cpu_group == "Isolated")
+      {
+        cpus = Concurrency::Scheduler::getIsolatedProcessors();
+      }
+      else
+      {
+        std::string list;
+        m_ctx.config.get("CPU Groups", m_args.cpu_group, "", list);
+        cpus = Concurrency::Scheduler::parseProcessors(list);
+      }
+
+      if (cpus.empty())
+        throw std::runtime_error(Utils::String::str(DTR("processor group '%s' is empty"),
+                                                    m_args.cpu_group.c_str()));
+
+      return cpus;
+    }
+
     void
     Task::run(void)
     {
@@ -345,33 +574,28 @@ namespace DUNE
       catch (...)
       { }
 
+      try
+      {
+        std::vector<unsigned> cpus = getProcessorAffinity();
+        if (!cpus.empty())
+          Thread::setAffinity(cpus);
+      }
+      catch (std::exception& e)
+      {
+        war(DTR("failed to set processor affinity: %s"), e.what());
+      }
+
       while (!stopping())
       {
         try
         {
-          resolveEntities();
-          releaseResources();
-          acquireResources();
-          initializeResources();
-
-          if (m_honours_active)
-          {
-            Parameter::Scope active_scope = Parameter::scopeFromString(m_args.active_scope);
-            if (m_args.active && ((active_scope == Parameter::SCOPE_GLOBAL) || (active_scope == Parameter::SCOPE_IDLE)))
-              requestActivation();
-          }
-
+          setup();
           onMain();
           releaseResources();
         }
         catch (RestartNeeded& e)
         {
-          if (e.isError())
-          {
-            setEntityState(IMC::EntityState::ESTA_FAILURE, DTR("restarting"));
-            err(DTR("restarting in %u seconds due to error: %s"),
-                e.getDelay(), e.getError());
-          }
+          reportRestart(e);
           Time::Counter<unsigned int> counter(e.getDelay());
           while (!stopping() && !counter.overflow())
           {
@@ -391,14 +615,97 @@ namespace DUNE
         }
         catch (std::exception& e)
         {
-          IMC::EntityState estate;
-          setEntityState(IMC::EntityState::ESTA_FAILURE, e.what());
-          dispatch(estate);
-          err(DTR("task died with uncaught exception: %s: restarting"), e.what());
+          reportFailure(e);
         }
       }
     }
 
+    double
+    Task::runJob(void)
+    {
+      bool restarted = false;
+
+      try
+      {
+        if (!m_job_ready)
+        {
+          // Jobs must not block workers waiting for other tasks.
+          if (!dependenciesReady())
+          {
+            if (m_setup_time < 0)
+              m_setup_time = Time::Clock::get();
+            return Time::Clock::get() + c_dependency_poll_period;
+          }
+
+          if (!m_job_initializing)
+          {
+            if (m_job_restart)
+            {
+              m_job_restart = false;
+
+              try
+              {
+                updateParameters();
+              }
+              catch (std::runtime_error& pe)
+              {
+                err(DTR("failed to update parameters: %s"), pe.what());
+              }
+            }
+
+            beginSetup();
+            m_job_initializing = true;
+          }
+
+          // Failed attempts are retried later instead of blocking
+          // the worker (new messages may run the job before that).
+          if (Time::Clock::get() < m_init_retry || !tryInitializeResources())
+            return m_init_retry;
+
+          m_job_initializing = false;
+          finishSetup();
+          m_job_ready = true;
+          restarted = true;
+        }
+
+        return onJob(restarted);
+      }
+      catch (RestartNeeded& e)
+      {
+        reportRestart(e);
+        m_job_ready = false;
+        m_job_initializing = false;
+        m_job_restart = true;
+        return Time::Clock::get() + e.getDelay();
+      }
+      catch (std::exception& e)
+      {
+        reportFailure(e);
+        m_job_ready = false;
+        m_job_initializing = false;
+        return Time::Clock::get();
+      }
+    }
+
+    void
+    Task::stopJob(void)
+    {
+      if (!m_job_ready && !m_job_initializing)
+        return;
+
+      m_job_ready = false;
+      m_job_initializing = false;
+
+      try
+      {
+        releaseResources();
+      }
+      catch (std::exception& e)
+      {
+        err("%s", e.what());
+      }
+    }
+
     void
     Task::dispatch(IMC::Message* msg, unsigned int flags)
     {
@@ -31,12 +31,14 @@
 
 // ISO C++ 98 headers.
 #include <string>
+#include <vector>
 #include <map>
 #include <stack>
 #include <cstdarg>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
 #include <DUNE/Concurrency/Thread.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
@@ -50,6 +52,8 @@
 #include <DUNE/Parsers/BasicStringWriter.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
 #include <DUNE/Tasks/Context.hpp>
+#include <DUNE/Tasks/Executor.hpp>
+#include <DUNE/Tasks/Exceptions.hpp>
 #include <DUNE/Tasks/BasicParameterParser.hpp>
 #include <DUNE/Tasks/ParameterTable.hpp>
 #include <DUNE/Entities/BasicEntity.hpp>
@@ -332,6 +336,20 @@ namespace DUNE
       receive(const IMC::Message* msg)
       {
         m_recipient->put(msg);
+
+        if (m_job != NULL)
+          m_job->notify();
+      }
+
+      //! Queue a message for later consumption without copying it.
+      //! @param msg message object, deleted after consumption.
+      void
+      adopt(IMC::Message* msg)
+      {
+        m_recipient->adopt(msg);
+
+        if (m_job != NULL)
+          m_job->notify();
       }
 
       //! Instruct task to reserve all entity identifiers that it
@@ -354,10 +372,19 @@ namespace DUNE
       releaseResources(void);
 
       //! Instruct task to initialize the resources acquired in
-      //! acquireResources().
+      //! acquireResources(), retrying until it succeeds or the task
+      //! is stopped.
       void
       initializeResources(void);
 
+      //! Make one attempt to initialize the resources acquired in
+      //! acquireResources(). Failures are reported and the next
+      //! attempt is scheduled with an increasing delay.
+      //! @return true if the resources were initialized, false
+      //! otherwise (see m_init_retry).
+      bool
+      tryInitializeResources(void);
+
       //! Instruct task to update its run-time parameters.
       //! @param[in] act_deact if true this function will request
       //! activation/deactivation if the 'Active' parameter changed.
@@ -369,6 +396,133 @@ namespace DUNE
       void
       writeParamsXML(std::ostream& os) const;
 
+      //! Startup timeline of a task.
+      struct Timeline
+      {
+        //! Time spent waiting for dependencies (s).
+        double wait;
+        //! Time spent acquiring resources (s).
+        double acquire;
+        //! Time spent initializing resources (s).
+        double initialize;
+        //! Time at which the task became ready (monotonic clock).
+        double ready;
+      };
+
+      //! Get the names of the tasks that must be ready before this
+      //! task acquires its resources ('Dependencies' parameter).
+      //! @return task names.
+      const std::vector<std::string>&
+      getDependencyNames(void) const
+      {
+        return m_args.dependencies;
+      }
+
+      //! Set the tasks that must be ready before this task acquires
+      //! its resources. Must be called before the task starts.
+      //! @param[in] tasks tasks.
+      void
+      setDependencies(const std::vector<Task*>& tasks)
+      {
+        m_dependencies = tasks;
+      }
+
+      //! Test if the task initialized its resources.
+      //! @return true if the task is ready, false otherwise.
+      bool
+      isReady(void);
+
+      //! Wait until the task initializes its resources.
+      //! @param[in] timeout maximum amount of time to wait (s).
+      //! @return true if the task is ready, false otherwise.
+      bool
+      waitReady(double timeout);
+
+      //! Get the startup timeline of the task. Only meaningful if the
+      //! task is ready.
+      //! @return startup timeline.
+      Timeline
+      getTimeline(void);
+
+      //! Enable or disable the measurement of the time spent
+      //! consuming messages. Must be called before the task starts.
+      //! @param[in] enabled true to enable measurements.
+      void
+      setProfiling(bool enabled)
+      {
+        m_recipient->setProfiling(enabled);
+      }
+
+      //! Get the number of messages waiting to be consumed.
+      //! @return number of messages.
+      unsigned
+      getQueueSize(void)
+      {
+        return m_recipient->getQueueSize();
+      }
+
+      //! Retrieve and reset the consumer statistics gathered since
+      //! the last call (see setProfiling()).
+      //! @param[out] stats consumer statistics.
+      //! @param[out] max_depth maximum number of messages waiting to
+      //! be consumed.
+      void
+      takeConsumerStatistics(Recipient::StatisticsMap& stats, unsigned& max_depth)
+      {
+        m_recipient->takeStatistics(stats, max_depth);
+      }
+
+      //! Get the processors the task thread is pinned to, given by
+      //! the 'CPU Affinity' parameter or, if empty, by the processor
+      //! group named by the 'CPU Group' parameter. Groups are defined
+      //! in the configuration section 'CPU Groups', except the
+      //! 'Isolated' group, that holds the processors isolated from the
+      //! kernel scheduler.
+      //! @return sorted list of processors, empty if the task is not
+      //! pinned.
+      //! @throw std::runtime_error if the processors are invalid.
+      std::vector<unsigned>
+      getProcessorAffinity(void);
+
+      //! Test if the task may run as a job of a cooperative executor.
+      //! @return true if the task is cooperative, false otherwise.
+      bool
+      isCooperative(void) const
+      {
+        return m_cooperative && !m_args.dedicated;
+      }
+
+      //! Test if new messages wait for the run time requested by
+      //! onJob() (see deferMessages()).
+      //! @return true if messages are deferred, false otherwise.
+      bool
+      defersMessages(void) const
+      {
+        return m_defer_messages;
+      }
+
+      //! Attach the task to a job of a cooperative executor. From
+      //! then on the task is driven by the executor instead of its
+      //! own thread.
+      //! @param[in] job executor job.
+      void
+      setJob(Executor::Job* job)
+      {
+        m_job = job;
+      }
+
+      //! Run the task as an executor job: initialize the task if
+      //! needed and run one step of the task (see onJob()).
+      //! @return time (monotonic clock) at which the job must run
+      //! again, or a negative value if the job only needs to run when
+      //! new messages arrive.
+      double
+      runJob(void);
+
+      //! Release the resources of a task run as an executor job.
+      void
+      stopJob(void);
+
     protected:
       //! Context.
       Context& m_ctx;
@@ -450,9 +604,48 @@ namespace DUNE
       bool
       stopping(void)
       {
+        if (m_job != NULL)
+          return m_job->isStopping();
+
         return isStopping();
       }
 
+      //! Declare that onJob() does all the work of the task, which by
+      //! default means that the task only does work in response to
+      //! messages. Cooperative tasks may run as jobs of the
+      //! cooperative executor instead of using a thread of their own,
+      //! in which case onMain() is never called. The 'Dedicated
+      //! Thread' parameter overrides this declaration.
+      void
+      setCooperative(void)
+      {
+        m_cooperative = true;
+      }
+
+      //! Keep new messages waiting until the run time requested by
+      //! onJob(), like periodic tasks do. By default new messages run
+      //! the job right away, before that time.
+      void
+      deferMessages(void)
+      {
+        m_defer_messages = true;
+      }
+
+      //! Run one step of a cooperative task. The default
+      //! implementation consumes all pending messages.
+      //! @param[in] restarted true if the task was initialized right
+      //! before this call.
+      //! @return time (monotonic clock) at which the step must run
+      //! again, unless new messages arrive earlier, or a negative
+      //! value if it only needs to run when new messages arrive.
+      virtual double
+      onJob(bool restarted)
+      {
+        (void)restarted;
+        consumeMessages();
+        return -1.0;
+      }
+
       //! Test if task is active.
       //! @return true if task is active, false otherwise.
       bool
@@ -746,6 +939,14 @@ namespace DUNE
         std::string active_scope;
         //! Visibility of 'Active' parameter.
         std::string active_visibility;
+        //! True if the task must not run on the cooperative executor.
+        bool dedicated;
+        //! Processors the task may run on.
+        std::string affinity;
+        //! Group of processors the task may run on.
+        std::string cpu_group;
+        //! Tasks that must be ready before this task.
+        std::vector<std::string> dependencies;
       };
 
       //! Message recipient (queue).
@@ -768,6 +969,73 @@ namespace DUNE
       bool m_honours_active;
       //! Name of parameter section editor.
       std::string m_param_editor;
+      //! True if the task may run as an executor job.
+      bool m_cooperative;
+      //! True if new messages wait for the requested run time.
+      bool m_defer_messages;
+      //! Executor job (NULL if the task runs on its own thread).
+      Executor::Job* m_job;
+      //! True if the executor job initialized the task.
+      bool m_job_ready;
+      //! True if the executor job acquired resources and is still
+      //! trying to initialize them.
+      bool m_job_initializing;
+      //! Delay before the next resource initialization attempt.
+      double m_init_delay;
+      //! Time (monotonic clock) of the next resource initialization
+      //! attempt.
+      double m_init_retry;
+      //! Number of failed resource initialization attempts.
+      unsigned m_init_failures;
+      //! Time of the last reported resource initialization error
+      //! (negative if none).
+      double m_init_last_error;
+      //! Last reported resource initialization error.
+      std::string m_init_last_what;
+      //! True if the executor job must update parameters before
+      //! initializing the task again.
+      bool m_job_restart;
+      //! Tasks that must be ready before this task.
+      std::vector<Task*> m_dependencies;
+      //! Lock and condition of the ready flag and the timeline.
+      Concurrency::Condition m_ready_cond;
+      //! True if the task initialized its resources.
+      bool m_ready;
+      //! Time at which the task started waiting for its dependencies
+      //! (negative if not waiting).
+      double m_setup_time;
+      //! Time at which the task acquired its resources.
+      double m_setup_acquired;
+      //! Startup timeline.
+      Timeline m_timeline;
+
+      //! Test if all dependencies are ready.
+      //! @return true if all dependencies are ready, false otherwise.
+      bool
+      dependenciesReady(void);
+
+      //! Initialize the task before entering the main loop.
+      void
+      setup(void);
+
+      //! First part of setup(): wait for dependencies, then acquire
+      //! the resources of the task.
+      void
+      beginSetup(void);
+
+      //! Last part of setup(), after resources are initialized.
+      void
+      finishSetup(void);
+
+      //! Report that the task must restart.
+      //! @param[in] e restart exception.
+      void
+      reportRestart(RestartNeeded& e);
+
+      //! Report that the task died with an uncaught exception.
+      //! @param[in] e exception.
+      void
+      reportFailure(const std::exception& e);
 
       //! Report current entity states by dispatching EntityState
       //! messages. This function will at least report the state of
@@ -0,0 +1,252 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_TIMER_WHEEL_HPP_INCLUDED_
+#define DUNE_TASKS_TIMER_WHEEL_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! Hierarchical timer wheel.
+    //!
+    //! Timers are kept in four levels of 64 slots. The slots of the
+    //! first level are one tick wide and the slots of each following
+    //! level are 64 times wider than those of the previous one. Each
+    //! time the first level wraps around the matching slot of the
+    //! next level is redistributed over the lower levels, so adding
+    //! a timer and expiring a timer are constant time operations.
+    //! Timers past the range of the wheel are kept in the last level
+    //! until they get close enough.
+    //!
+    //! Deadlines are absolute times in nanoseconds of a monotonic
+    //! clock. A timer never expires before its deadline and expires
+    //! at most one tick after it.
+    //!
+    //! @tparam T type of the items associated with the timers.
+    template <typename T>
+    class TimerWheel
+    {
+    public:
+      //! Constructor.
+      //! @param[in] origin current time (nanoseconds).
+      //! @param[in] resolution duration of a tick (nanoseconds).
+      TimerWheel(uint64_t origin, uint64_t resolution):
+        m_resolution(resolution),
+        m_tick(origin / resolution),
+        m_size(0)
+      { }
+
+      //! Get the number of pending timers.
+      //! @return number of pending timers.
+      size_t
+      size(void) const
+      {
+        return m_size;
+      }
+
+      //! Test if there are no pending timers.
+      //! @return true if there are no pending timers, false otherwise.
+      bool
+      empty(void) const
+      {
+        return m_size == 0;
+      }
+
+      //! Add a timer.
+      //! @param[in] deadline expiration time (nanoseconds).
+      //! @param[in] item item associated with the timer.
+      void
+      add(uint64_t deadline, const T& item)
+      {
+        Timer timer;
+        timer.tick = (deadline + m_resolution - 1) / m_resolution;
+        timer.item = item;
+        place(timer);
+        ++m_size;
+      }
+
+      //! Expire all timers whose deadline is not later than the given
+      //! time.
+      //! @param[in] now current time (nanoseconds).
+      //! @param[out] expired items of the expired timers, in
+      //! expiration order.
+      void
+      advance(uint64_t now, std::vector<T>& expired)
+      {
+        uint64_t target = now / m_resolution;
+
+        if (m_size == 0)
+        {
+          if (target >= m_tick)
+            m_tick = target + 1;
+          return;
+        }
+
+        for (; m_tick <= target; ++m_tick)
+        {
+          if ((m_tick & c_mask) == 0)
+            cascade();
+
+          std::vector<Timer>& slot = m_slots[0][m_tick & c_mask];
+          for (size_t i = 0; i < slot.size(); ++i)
+            expired.push_back(slot[i].item);
+
+          m_size -= slot.size();
+          slot.clear();
+
+          if (m_size == 0)
+          {
+            m_tick = target + 1;
+            break;
+          }
+        }
+      }
+
+      //! Get the earliest time at which advance() may expire timers.
+      //! The time may be earlier than the earliest deadline, but
+      //! never later.
+      //! @return time (nanoseconds) or zero if there are no timers.
+      uint64_t
+      getNextDeadline(void) const
+      {
+        if (m_size == 0)
+          return 0;
+
+        uint64_t best = 0;
+        bool found = false;
+        for (unsigned level = 0; level < c_levels; ++level)
+        {
+          unsigned shift = level * c_bits;
+          uint64_t base = m_tick >> shift;
+
+          // The slot of the current block was already redistributed,
+          // unless the block starts at the current tick.
+          unsigned first = 1;
+          if (level == 0 || (m_tick & (((uint64_t)1 << shift) - 1)) == 0)
+            first = 0;
+
+          for (unsigned j = first; j < c_slots + first; ++j)
+          {
+            if (m_slots[level][(base + j) & c_mask].empty())
+              continue;
+
+            // Slots above the first level expire no sooner than their
+            // redistribution.
+            uint64_t tick = (base + j) << shift;
+            if (tick < m_tick)
+              tick = m_tick;
+
+            if (!found || tick < best)
+              best = tick;
+            found = true;
+            break;
+          }
+        }
+
+        return best * m_resolution;
+      }
+
+    private:
+      //! Number of bits of the slot index.
+      static const unsigned c_bits = 6;
+      //! Number of slots per level.
+      static const unsigned c_slots = 1 << c_bits;
+      //! Slot index mask.
+      static const uint64_t c_mask = c_slots - 1;
+      //! Number of levels.
+      static const unsigned c_levels = 4;
+
+      //! Pending timer.
+      struct Timer
+      {
+        //! Expiration tick.
+        uint64_t tick;
+        //! Associated item.
+        T item;
+      };
+
+      //! Duration of a tick (nanoseconds).
+      uint64_t m_resolution;
+      //! Current tick.
+      uint64_t m_tick;
+      //! Number of pending timers.
+      size_t m_size;
+      //! Slots.
+      std::vector<Timer> m_slots[c_levels][c_slots];
+
+      //! Place a timer in the slot matching its distance to the
+      //! current tick.
+      //! @param[in] timer timer.
+      void
+      place(const Timer& timer)
+      {
+        uint64_t tick = (timer.tick < m_tick) ? m_tick : timer.tick;
+        uint64_t distance = tick - m_tick;
+
+        unsigned level = 0;
+        while (level < c_levels - 1 && distance >= ((uint64_t)1 << (c_bits * (level + 1))))
+          ++level;
+
+        // Timers past the range of the wheel wait in the last slot of
+        // the last level.
+        if (level == c_levels - 1 && distance >= ((uint64_t)1 << (c_bits * c_levels)))
+          tick = m_tick + ((uint64_t)1 << (c_bits * c_levels)) - 1;
+
+        m_slots[level][(tick >> (c_bits * level)) & c_mask].push_back(timer);
+      }
+
+      //! Redistribute the slots of the upper levels that start at the
+      //! current tick.
+      void
+      cascade(void)
+      {
+        for (unsigned level = 1; level < c_levels; ++level)
+        {
+          unsigned index = (m_tick >> (c_bits * level)) & c_mask;
+          std::vector<Timer> timers;
+          timers.swap(m_slots[level][index]);
+
+          for (size_t i = 0; i < timers.size(); ++i)
+            place(timers[i]);
+
+          if (index != 0)
+            break;
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -53,9 +53,70 @@ namespace DUNE
 {
   namespace Time
   {
+    //! Starting point of the monotonic virtual clock (nanoseconds).
+    static const uint64_t c_virtual_origin = 1000 * c_nsec_per_sec;
+    //! True if the virtual clock is enabled.
+    static volatile bool s_virtual = false;
+    //! Current time of the monotonic virtual clock (nanoseconds).
+    static uint64_t s_virtual_nsec = c_virtual_origin;
+    //! Time since the UNIX Epoch when the virtual clock was enabled
+    //! (nanoseconds).
+    static uint64_t s_virtual_epoch = 0;
+
+#if !defined(__ATOMIC_ACQUIRE) && defined(DUNE_SYS_HAS_PTHREAD_H)
+    //! Lock for compilers without atomic built-ins.
+    static pthread_mutex_t s_virtual_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+    //! Atomically read the monotonic virtual clock. Tasks read it
+    //! from their own threads while the executor moves it forward.
+    //! @return current virtual time in nanoseconds.
+    static uint64_t
+    loadVirtualNsec(void)
+    {
+#if defined(__ATOMIC_ACQUIRE)
+      return __atomic_load_n(&s_virtual_nsec, __ATOMIC_ACQUIRE);
+#elif defined(DUNE_SYS_HAS_PTHREAD_H)
+      pthread_mutex_lock(&s_virtual_lock);
+      uint64_t nsec = s_virtual_nsec;
+      pthread_mutex_unlock(&s_virtual_lock);
+      return nsec;
+#else
+      return s_virtual_nsec;
+#endif
+    }
+
+    //! Atomically move the monotonic virtual clock forward.
+    //! @param[in] nsec new virtual time in nanoseconds, ignored if
+    //! not past the current one.
+    static void
+    advanceVirtualNsec(uint64_t nsec)
+    {
+#if defined(__ATOMIC_ACQUIRE)
+      uint64_t current = __atomic_load_n(&s_virtual_nsec, __ATOMIC_ACQUIRE);
+      while (nsec > current)
+      {
+        if (__atomic_compare_exchange_n(&s_virtual_nsec, &current, nsec, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+          break;
+      }
+#elif defined(DUNE_SYS_HAS_PTHREAD_H)
+      pthread_mutex_lock(&s_virtual_lock);
+      if (nsec > s_virtual_nsec)
+        s_virtual_nsec = nsec;
+      pthread_mutex_unlock(&s_virtual_lock);
+#else
+      if (nsec > s_virtual_nsec)
+        s_virtual_nsec = nsec;
+#endif
+    }
+
     uint64_t
     Clock::getNsec(void)
     {
+      if (s_virtual)
+        return loadVirtualNsec();
+
       // POSIX RT.
 #if defined(DUNE_SYS_HAS_CLOCK_GETTIME)
       timespec ts;
@@ -80,6 +141,9 @@ namespace DUNE
     uint64_t
     Clock::getSinceEpochNsec(void)
     {
+      if (s_virtual)
+        return s_virtual_epoch + (loadVirtualNsec() - c_virtual_origin);
+
       // POSIX RT.
 #if defined(DUNE_SYS_HAS_CLOCK_GETTIME)
       timespec ts;
@@ -125,5 +189,29 @@ namespace DUNE
       (void)value;
 #endif
     }
+
+    void
+    Clock::enableVirtual(uint64_t epoch)
+    {
+      if (s_virtual)
+        return;
+
+      s_virtual_epoch = epoch * c_nsec_per_sec;
+      s_virtual_nsec = c_virtual_origin;
+      s_virtual = true;
+    }
+
+    bool
+    Clock::isVirtual(void)
+    {
+      return s_virtual;
+    }
+
+    void
+    Clock::setVirtualNsec(uint64_t nsec)
+    {
+      if (s_virtual)
+        advanceVirtualNsec(nsec);
+    }
   }
 }
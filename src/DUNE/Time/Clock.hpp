@@ -43,6 +43,10 @@ namespace DUNE
     class Clock
     {
     public:
+      //! Default initial time of the virtual clock since the UNIX
+      //! Epoch (Midnight UTC of January 1, 2020) in seconds.
+      static const uint64_t c_virtual_epoch = 1577836800;
+
       //! Get the amount of time (in nanoseconds) since an unspecified
       //! point in the past. If the system permits, this point does
       //! not change after system start-up time.
@@ -118,6 +122,29 @@ namespace DUNE
       //! @param value time in seconds.
       static void
       set(double value);
+
+      //! Replace the system clock with a virtual clock that only
+      //! advances when told to (see setVirtualNsec()). Both the
+      //! monotonic virtual clock and the time since the UNIX Epoch
+      //! always start at the same point, so that runs are
+      //! reproducible. Calling this function when the virtual clock
+      //! is already enabled has no effect.
+      //! @param[in] epoch initial time since the UNIX Epoch in
+      //! seconds.
+      static void
+      enableVirtual(uint64_t epoch = c_virtual_epoch);
+
+      //! Test if the virtual clock is enabled.
+      //! @return true if the virtual clock is enabled, false otherwise.
+      static bool
+      isVirtual(void);
+
+      //! Move the virtual clock forward. Attempts to move the clock
+      //! backward, or to move it while the virtual clock is disabled,
+      //! are ignored.
+      //! @param[in] nsec monotonic time in nanoseconds.
+      static void
+      setVirtualNsec(uint64_t nsec);
     };
   }
 }
@@ -27,6 +27,7 @@
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/Constants.hpp>
 
@@ -35,6 +36,10 @@
 #  include <time.h>
 #endif
 
+#if defined(DUNE_SYS_HAS_CLOCK_NANOSLEEP)
+#  include <errno.h>
+#endif
+
 #if defined(DUNE_SYS_HAS_WINDOWS_H)
 #  include <windows.h>
 #endif
@@ -74,5 +79,27 @@ namespace DUNE
 #  error Delay::waitNsec() is not yet implemented in this system
 #endif
     }
+
+    void
+    Delay::waitUntilNsec(uint64_t deadline)
+    {
+#if defined(DUNE_SYS_HAS_CLOCK_NANOSLEEP)
+      // Deadlines of the virtual clock are not system clock times.
+      if (!Clock::isVirtual())
+      {
+        timespec ts;
+        ts.tv_sec = deadline / c_nsec_per_sec;
+        ts.tv_nsec = deadline - (ts.tv_sec * c_nsec_per_sec);
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR)
+        { }
+        return;
+      }
+#endif
+
+      uint64_t now = Clock::getNsec();
+      if (deadline > now)
+        waitNsec(deadline - now);
+    }
   }
 }
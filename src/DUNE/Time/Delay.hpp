@@ -78,6 +78,24 @@ namespace DUNE
 
         waitNsec(nsecs);
       }
+
+      //! Suspends the execution of the calling thread until the
+      //! monotonic clock reaches the specified time (in nanoseconds).
+      //! Unlike relative delays, consecutive absolute delays do not
+      //! accumulate the latency of each wakeup.
+      //! @param deadline time at which to resume execution.
+      static void
+      waitUntilNsec(uint64_t deadline);
+
+      //! Suspends the execution of the calling thread until the
+      //! monotonic clock reaches the specified time (in seconds).
+      //! @param deadline time at which to resume execution.
+      static void
+      waitUntil(double deadline)
+      {
+        if (deadline > 0)
+          waitUntilNsec((uint64_t)(deadline * c_nsec_per_sec_fp));
+      }
     };
   }
 }
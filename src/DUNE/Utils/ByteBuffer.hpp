@@ -112,6 +112,12 @@ namespace DUNE
         return m_buffer;
       }
 
+      inline const uint8_t*
+      getBuffer(void) const
+      {
+        return m_buffer;
+      }
+
       inline char*
       getBufferSigned(void)
       {
@@ -125,7 +131,7 @@ namespace DUNE
       }
 
       inline uint32_t
-      getSize(void)
+      getSize(void) const
       {
         return m_size;
       }
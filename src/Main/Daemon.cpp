@@ -152,6 +152,9 @@ runDaemon(DUNE::Daemon& daemon)
 
     while (!s_stop)
     {
+      if (daemon.isFinished())
+        break;
+
       if (!daemon.isRunning())
       {
         call_abort = true;
@@ -209,7 +212,10 @@ main(int argc, char** argv)
   .add("-V", "--vehicle",
        "Vehicle name override", "VEHICLE")
   .add("-X", "--dump-params-xml",
-       "Dump parameters XML to folder DIR", "DIR");
+       "Dump parameters XML to folder DIR", "DIR")
+  .add("-D", "--deterministic",
+       "Step tasks deterministically on a virtual clock and stop after "
+       "SECONDS of simulated time (0 to run until interrupted)", "SECONDS");
 
   // Parse command line arguments.
   if (!options.parse(argc, argv))
@@ -254,17 +260,29 @@ main(int argc, char** argv)
     return 1;
   }
 
+  // Parsed configurations are cached until one of their files changes.
+  Path cfg_cache = context.dir_log / "cache";
+  try
+  {
+    cfg_cache.create();
+  }
+  catch (std::exception& e)
+  {
+    DUNE_WRN("Daemon", e.what());
+  }
+  cfg_cache = cfg_cache / String::replace(options.value("--config-file"), '/', "_") + ".cfg";
+
   Path cfg_file = context.dir_cfg / options.value("--config-file") + ".ini";
   try
   {
-    context.config.parseFile(cfg_file.c_str());
+    context.config.parseFile(cfg_file.c_str(), cfg_cache.c_str());
   }
   catch (std::runtime_error& e)
   {
     try
     {
       cfg_file = context.dir_usr_cfg / options.value("--config-file") + ".ini";
-      context.config.parseFile(cfg_file.c_str());
+      context.config.parseFile(cfg_file.c_str(), cfg_cache.c_str());
       context.dir_cfg = context.dir_usr_cfg;
     }
     catch (std::runtime_error& e2)
@@ -278,6 +296,12 @@ main(int argc, char** argv)
   if (!options.value("--vehicle").empty())
     context.config.set("General", "Vehicle", options.value("--vehicle"));
 
+  if (!options.value("--deterministic").empty())
+  {
+    context.config.set("General", "Deterministic Executor", "true");
+    context.config.set("General", "Deterministic Duration", options.value("--deterministic"));
+  }
+
   try
   {
     DUNE::Daemon daemon(context, options.value("--profiles"));
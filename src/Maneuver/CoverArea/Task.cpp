@@ -339,8 +339,7 @@ namespace Maneuver
       {
         m_maneuver = *maneuver;
 
-        double n, e, op_dir, diameter;
-        Math::Matrix polygon, new_vtx;
+        double op_dir, diameter;
 
         IMC::MessageList<IMC::PolygonVertex>::const_iterator it = maneuver->polygon.begin();
 
@@ -350,18 +349,30 @@ namespace Maneuver
         m_lon = m_maneuver.lon;
         m_lat = m_maneuver.lat;
 
-        e = 0;
-        n = 0;
-        double coords[]= {e, n};
-        polygon = Math::Matrix(coords, 2, 1);
+        size_t count = maneuver->polygon.size();
+        std::vector<double> lats(count);
+        std::vector<double> lons(count);
+        std::vector<double> n(count);
+        std::vector<double> e(count);
 
-        for (; it != maneuver->polygon.end(); it++ )
+        for (size_t i = 0; it != maneuver->polygon.end(); it++, i++)
         {
-          WGS84::displacement(m_lat, m_lon, 0, (*it)->lat, (*it)->lon, 0, &n, &e);
-          coords[0] = e;
-          coords[1] = n;
-          new_vtx = Math::Matrix(coords, 2, 1);
-          polygon = polygon.horzCat(new_vtx);
+          lats[i] = (*it)->lat;
+          lons[i] = (*it)->lon;
+        }
+
+        if (count > 0)
+        {
+          LocalFrame frame(m_lat, m_lon);
+          frame.toNED(&lats[0], &lons[0], NULL, count, &n[0], &e[0]);
+        }
+
+        // First column is the maneuver origin.
+        Math::Matrix polygon(2, count + 1, 0.0);
+        for (size_t i = 0; i < count; ++i)
+        {
+          polygon(0, i + 1) = e[i];
+          polygon(1, i + 1) = n[i];
         }
 
         op_dir = longRowsDirection(polygon, &diameter);
@@ -170,83 +170,98 @@ namespace Maneuver
         m_got_svelocity = true;
       }
 
+      //! Follow the target once fresh state, target and stream
+      //! velocity are available.
       void
-      onMain(void)
+      follow(void)
       {
-        while (!stopping())
-        {
-          waitForMessages(1.0);
+        if (!m_got_estate || !m_got_target || !m_got_svelocity)
+          return;
+
+        m_got_estate = false;
+        m_got_target = false;
+        m_got_svelocity = false;
+
+        double x_actual = m_estate.y;
+        double y_actual = m_estate.x;
+        double psi_actual = atan2(m_estate.vy,m_estate.vx);
+        double v = sqrt((m_estate.vx * m_estate.vx) + (m_estate.vy * m_estate.vy));
+        double y_ref;
+        double x_ref;
+
+        double wx = -m_svelocity.y;
+        double wy = -m_svelocity.x;
 
-          if(m_got_estate && m_got_target && m_got_svelocity)
+        WGS84::displacement(m_estate.lat, m_estate.lon, m_estate.height, m_target.lat, m_target.lon, m_target.z, &y_ref, &x_ref);
 
+        double vx = m_target.sog * sin(m_target.cog);
+        double vy = m_target.sog * cos(m_target.cog);
+        double v_ref = m_target.sog;
+        double psi_ref = m_target.cog;
+
+        double w_ref = 0; //w_ref=x(13);
+        double v_ref_dot = 0; //v_ref_dot=x(16);
+
+        double x_0_c = x_ref;
+        double y_0_c = y_ref;
+
+        double r = m_args.radius;
+
+        double i = 0.0;
+        double minpath_actual = 10000.0;
+        double u_dist_min = 0;
+
+        while(i < 2 * c_pi)
+        {
+          double minpath = minimumDistance(r, i, x_0_c, x_actual, y_0_c, y_actual);
+
+          if(minpath < minpath_actual)
           {
-            m_got_estate = false;
-            m_got_target = false;
-            m_got_svelocity = false;
-
-            double x_actual = m_estate.y;
-            double y_actual = m_estate.x;
-            double psi_actual = atan2(m_estate.vy,m_estate.vx);
-            double v = sqrt((m_estate.vx * m_estate.vx) + (m_estate.vy * m_estate.vy));
-            double y_ref;
-            double x_ref;
-
-            double wx = -m_svelocity.y;
-            double wy = -m_svelocity.x;
-
-            WGS84::displacement(m_estate.lat, m_estate.lon, m_estate.height, m_target.lat, m_target.lon, m_target.z, &y_ref, &x_ref);
-
-            double vx = m_target.sog * sin(m_target.cog);
-            double vy = m_target.sog * cos(m_target.cog);
-            double v_ref = m_target.sog;
-            double psi_ref = m_target.cog;
-
-            double w_ref = 0; //w_ref=x(13);
-            double v_ref_dot = 0; //v_ref_dot=x(16);
-
-            double x_0_c = x_ref;
-            double y_0_c = y_ref;
-
-            double r = m_args.radius;
-
-            double i = 0.0;
-            double minpath_actual = 10000.0;
-            double u_dist_min = 0;
-
-            while(i < 2 * c_pi)
-            {
-              double minpath = minimumDistance(r, i, x_0_c, x_actual, y_0_c, y_actual);
-
-              if(minpath < minpath_actual)
-              {
-                u_dist_min = i;
-                minpath_actual = minpath;
-              }
-
-              i += 0.01;
-
-            }
-
-            double delta_x_min = delta_x(r, u_dist_min, x_0_c, x_actual);
-            double delta_y_min = delta_y(r, u_dist_min, y_0_c, y_actual);
-
-            Matrix delta_xy_min;
-            delta_xy_min(0,0) = delta_x_min;
-            delta_xy_min(1,0) = delta_y_min;
-
-            // Todo: Remove the following assignments once the variables are used.
-            // this is just to avoid unused variables compilation warnings.
-            (void)psi_actual;
-            (void)v;
-            (void)wx;
-            (void)wy;
-            (void)vx;
-            (void)vy;
-            (void)v_ref;
-            (void)psi_ref;
-            (void)w_ref;
-            (void)v_ref_dot;
+            u_dist_min = i;
+            minpath_actual = minpath;
           }
+
+          i += 0.01;
+
+        }
+
+        double delta_x_min = delta_x(r, u_dist_min, x_0_c, x_actual);
+        double delta_y_min = delta_y(r, u_dist_min, y_0_c, y_actual);
+
+        Matrix delta_xy_min;
+        delta_xy_min(0,0) = delta_x_min;
+        delta_xy_min(1,0) = delta_y_min;
+
+        // Todo: Remove the following assignments once the variables are used.
+        // this is just to avoid unused variables compilation warnings.
+        (void)psi_actual;
+        (void)v;
+        (void)wx;
+        (void)wy;
+        (void)vx;
+        (void)vy;
+        (void)v_ref;
+        (void)psi_ref;
+        (void)w_ref;
+        (void)v_ref_dot;
+      }
+
+      double
+      onJob(bool restarted)
+      {
+        (void)restarted;
+        consumeMessages();
+        follow();
+        return -1.0;
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(1.0);
+          follow();
         }
       }
     };
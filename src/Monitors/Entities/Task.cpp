@@ -127,6 +127,8 @@ namespace Monitors
 
         bind<IMC::EntityState>(this);
         bind<IMC::MonitorEntityState>(this);
+
+        setCooperative();
       }
 
       void
@@ -195,6 +195,8 @@ namespace Monitors
         bind<IMC::SetServoPosition>(this);
         bind<IMC::ServoPosition>(this);
         bind<IMC::Current>(this);
+
+        setCooperative();
       }
 
       void
@@ -396,16 +398,31 @@ namespace Monitors
         }
       }
 
+      //! Clear position faults once the error timeout expires.
+      void
+      checkRecovery(void)
+      {
+        if (getEntityState() == IMC::EntityState::ESTA_ERROR)
+          if (m_timer.overflow() && m_args.pos_fault_detect)
+            setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      double
+      onJob(bool restarted)
+      {
+        (void)restarted;
+        consumeMessages();
+        checkRecovery();
+        return Clock::get() + 1.0;
+      }
+
       void
       onMain(void)
       {
         while (!stopping())
         {
           waitForMessages(1.0);
-
-          if (getEntityState() == IMC::EntityState::ESTA_ERROR)
-            if (m_timer.overflow() && m_args.pos_fault_detect)
-              setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+          checkRecovery();
         }
       }
     };
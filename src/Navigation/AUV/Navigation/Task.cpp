@@ -242,6 +242,7 @@ namespace Navigation
           // Extended Kalman Filter initialization.
           m_kal.reset(NUM_STATE, NUM_OUT);
           resetKalman();
+          declarePatterns();
 
           // Register callbacks
           bind<IMC::EntityActivationState>(this);
@@ -434,7 +435,10 @@ namespace Navigation
         onConsumeLblConfig(void)
         {
           if (m_kal.resize(NUM_OUT + m_ranging.getSize()))
+          {
+            declarePatterns();
             Task::onUpdateParameters();
+          }
         }
 
         void
@@ -639,6 +643,48 @@ namespace Navigation
           }
         }
 
+        // Declare which entries of the transition and output matrices
+        // may be non-zero, so that the filter skips the remaining ones.
+        void
+        declarePatterns(void)
+        {
+          // Identity plus the continuous transition entries set by
+          // setTransition() and the heading terms of the covariance
+          // transition.
+          Matrix a(NUM_STATE);
+          a(STATE_PSI, STATE_R) = 1.0;
+          a(STATE_X, STATE_K) = a(STATE_Y, STATE_K) = 1.0;
+          a(STATE_X, STATE_U) = a(STATE_X, STATE_V) = 1.0;
+          a(STATE_Y, STATE_U) = a(STATE_Y, STATE_V) = 1.0;
+          a(STATE_X, STATE_PSI) = a(STATE_Y, STATE_PSI) = 1.0;
+
+          // Structure of the discretized matrix (exponential series).
+          Matrix mask = a;
+          for (unsigned i = 0; i < NUM_STATE; ++i)
+          {
+            mask = mask * a;
+            for (unsigned j = 0; j < NUM_STATE * NUM_STATE; ++j)
+              mask(j) = (mask(j) != 0.0) ? 1.0 : 0.0;
+          }
+
+          m_kal.setTransitionPattern(mask);
+
+          // Output structure, LBL ranges only observe position.
+          unsigned outputs = m_kal.getObservation().rows();
+          Matrix c(outputs, NUM_STATE, 0.0);
+          c(OUT_U, STATE_U) = 1.0;
+          c(OUT_V, STATE_V) = 1.0;
+          c(OUT_PSI, STATE_PSI) = c(OUT_PSI, STATE_PSI_BIAS) = 1.0;
+          c(OUT_R, STATE_R) = c(OUT_R, STATE_R_BIAS) = 1.0;
+          c(OUT_GPS_X, STATE_X) = 1.0;
+          c(OUT_GPS_Y, STATE_Y) = 1.0;
+
+          for (unsigned i = NUM_OUT; i < outputs; ++i)
+            c(i, STATE_X) = c(i, STATE_Y) = 1.0;
+
+          m_kal.setObservationPattern(c);
+        }
+
         // Reinitialize Extended Kalman Filter output matrix function.
         void
         resetKalman(void)
@@ -157,6 +157,8 @@ namespace Navigation
           bind<IMC::LblRange>(this);
           bind<IMC::LblConfig>(this);
           bind<IMC::GpsFix>(this);
+
+          setCooperative();
         }
 
         void
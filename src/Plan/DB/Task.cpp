@@ -115,6 +115,8 @@ namespace Plan
         bind<IMC::PlanControl>(this);
         bind<IMC::PlanDB>(this);
         bind<IMC::PowerOperation>(this);
+
+        setCooperative();
       }
 
       void
@@ -178,6 +178,8 @@ namespace Plan
         bind<IMC::EntityInfo>(this);
         bind<IMC::EntityActivationState>(this);
         bind<IMC::FuelLevel>(this);
+
+        setCooperative();
       }
 
       ~Task()
@@ -1101,60 +1103,81 @@ namespace Plan
         m_pcs.plan_eta = (int32_t)m_plan->getETA();
       }
 
-      void
-      onMain(void)
+      //! Report progress, check for timeouts and process pending
+      //! requests.
+      //! @return time in seconds until the next update.
+      double
+      update(void)
       {
-        setInitialState();
+        if (m_report_timer.overflow())
+        {
+          if (m_args.progress)
+            reportProgress();
 
-        while (!stopping())
+          dispatch(m_pcs);
+
+          m_report_timer.reset();
+        }
+
+        double now = Clock::get();
+
+        if ((getEntityState() == IMC::EntityState::ESTA_NORMAL) &&
+            (now - m_last_vstate >= c_vs_timeout))
         {
-          if (m_report_timer.overflow())
-          {
-            if (m_args.progress)
-              reportProgress();
+          changeMode(IMC::PlanControlState::PCS_BLOCKED, DTR("vehicle state timeout"));
+          m_last_vstate = now;
+        }
 
-            dispatch(m_pcs);
+        // got requests to process
+        if (!pendingReply() && m_requests.size())
+        {
+          processRequest(&m_requests.front());
+          m_requests.pop();
+        }
 
-            m_report_timer.reset();
-          }
+        double delta = m_vc_reply_deadline < 0 ? 1 : m_vc_reply_deadline - now;
 
-          double now = Clock::get();
+        if (delta > 0)
+          return std::min(1.0, delta);
 
-          if ((getEntityState() == IMC::EntityState::ESTA_NORMAL) &&
-              (now - m_last_vstate >= c_vs_timeout))
-          {
-            changeMode(IMC::PlanControlState::PCS_BLOCKED, DTR("vehicle state timeout"));
-            m_last_vstate = now;
-          }
+        // handle reply timeout
+        m_vc_reply_deadline = -1;
 
-          // got requests to process
-          if (!pendingReply() && m_requests.size())
-          {
-            processRequest(&m_requests.front());
-            m_requests.pop();
-          }
+        changeMode(IMC::PlanControlState::PCS_READY, DTR("vehicle reply timeout"));
 
-          double delta = m_vc_reply_deadline < 0 ? 1 : m_vc_reply_deadline - now;
+        // Popping all requests
+        while (m_requests.size())
+          m_requests.pop();
 
-          if (delta > 0)
-          {
-            waitForMessages(std::min(1.0, delta));
-            continue;
-          }
+        // Increment local request id to prevent old replies from being processed
+        ++m_vreq_ctr;
+
+        err(DTR("cleared all requests"));
+
+        return 0.0;
+      }
 
-          // handle reply timeout
-          m_vc_reply_deadline = -1;
+      double
+      onJob(bool restarted)
+      {
+        if (restarted)
+          setInitialState();
 
-          changeMode(IMC::PlanControlState::PCS_READY, DTR("vehicle reply timeout"));
+        consumeMessages();
 
-          // Popping all requests
-          while (m_requests.size())
-            m_requests.pop();
+        return Clock::get() + update();
+      }
 
-          // Increment local request id to prevent old replies from being processed
-          ++m_vreq_ctr;
+      void
+      onMain(void)
+      {
+        setInitialState();
 
-          err(DTR("cleared all requests"));
+        while (!stopping())
+        {
+          double delay = update();
+          if (delay > 0)
+            waitForMessages(delay);
         }
       }
 
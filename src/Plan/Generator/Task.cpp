@@ -111,6 +111,8 @@ namespace Plan
         bind<IMC::PlanGeneration>(this);
         bind<IMC::EstimatedState>(this);
         bind<IMC::LblConfig>(this);
+
+        setCooperative();
       }
 
       //! Frees memory associated with stored messages.
@@ -255,10 +257,10 @@ namespace Plan
         dispatch(response);
       }
 
+      //! Request the plans to be generated at boot.
       void
-      onMain(void)
+      generateAtBoot(void)
       {
-        // Generate plans at boot
         if (!m_args.generate_at_boot.empty())
         {
           IMC::PlanGeneration pg;
@@ -280,6 +282,22 @@ namespace Plan
             }
           }
         }
+      }
+
+      double
+      onJob(bool restarted)
+      {
+        if (restarted)
+          generateAtBoot();
+
+        consumeMessages();
+        return -1.0;
+      }
+
+      void
+      onMain(void)
+      {
+        generateAtBoot();
 
         while (!stopping())
         {
@@ -72,6 +72,8 @@ namespace Power
 
         bind<IMC::PowerChannelControl>(this);
         bind<IMC::QueryPowerChannelState>(this);
+
+        setCooperative();
       }
 
       void
@@ -34,6 +34,7 @@
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/Integrator.hpp>
 
 namespace Simulators
 {
@@ -64,9 +65,13 @@ namespace Simulators
       Matrix quadratic_drag;
       Matrix lift;
       Matrix fin_lift;
+      //! Numerical integration method.
+      std::string integrator;
+      //! Error tolerance of adaptive integration.
+      double int_tol;
     };
 
-    struct Task: public Tasks::Periodic
+    struct Task: public Tasks::Periodic, private Simulation::Integrator::System
     {
       //! Simulation vehicle.
       AUVModel* m_model;
@@ -86,6 +91,10 @@ namespace Simulators
       Matrix m_velocity;
       //! Task arguments.
       Arguments m_args;
+      //! Numerical integrator.
+      Simulation::Integrator m_integrator;
+      //! State vector (position and velocity) used by the integrator.
+      double m_state[12];
 
       Task(const std::string& name, Tasks::Context& ctx):
         Periodic(name, ctx),
@@ -158,12 +167,29 @@ namespace Simulators
         .defaultValue("")
         .description("Fin lift coefficients of the vehicle");
 
+        param("Integration Method", m_args.integrator)
+        .defaultValue("Euler")
+        .values("Euler, RK4, Dormand-Prince")
+        .description("Numerical integration method of the vehicle dynamics");
+
+        param("Integration Tolerance", m_args.int_tol)
+        .defaultValue("1e-6")
+        .minimumValue("1e-12")
+        .description("Error tolerance of the adaptive integration method");
+
         // Register handler routines.
         bind<IMC::GpsFix>(this);
         bind<IMC::SetServoPosition>(this);
         bind<IMC::SetThrusterActuation>(this);
       }
 
+      void
+      onUpdateParameters(void)
+      {
+        m_integrator.setMethod(Simulation::Integrator::parseMethod(m_args.integrator));
+        m_integrator.setTolerances(m_args.int_tol, m_args.int_tol);
+      }
+
       void
       onResourceRelease(void)
       {
@@ -271,6 +297,44 @@ namespace Simulators
         return J1;
       }
 
+      //! Compute the acceleration in the vehicle's frame.
+      Matrix
+      computeAcceleration(const Matrix& position, const Matrix& velocity)
+      {
+        Matrix accel = m_model->stepInv(m_thruster_act, m_servo_pos, velocity, position);
+
+        // surface behavior
+        if (position(2) < c_surface_depth)
+        {
+          accel(2) = std::fabs(accel(2));
+        }
+
+        return accel;
+      }
+
+      void
+      derivatives(double t, const double* x, double* dx)
+      {
+        (void)t;
+
+        Matrix position(6, 1);
+        Matrix velocity(6, 1);
+        for (unsigned i = 0; i < 6; ++i)
+        {
+          position(i) = x[i];
+          velocity(i) = x[i + 6];
+        }
+
+        Matrix dposition = matrixJ(position(3), position(4), position(5)) * velocity;
+        Matrix accel = computeAcceleration(position, velocity);
+
+        for (unsigned i = 0; i < 6; ++i)
+        {
+          dx[i] = dposition(i);
+          dx[i + 6] = accel(i);
+        }
+      }
+
       void
       task(void)
       {
@@ -278,26 +342,35 @@ namespace Simulators
         double timestep = Clock::get() - m_last_update;
         m_last_update = Clock::get();
 
-        // Find the derivative of the position in the earth fixed frame
-        Matrix dposition(6, 1, 0.0);
-        dposition = matrixJ(m_position(3), m_position(4), m_position(5)) * m_velocity;
-
-        // Integrate using Euler method
-        m_position += timestep * dposition;
+        if (m_integrator.getMethod() == Simulation::Integrator::IM_EULER)
+        {
+          // Find the derivative of the position in the earth fixed frame
+          Matrix dposition(6, 1, 0.0);
+          dposition = matrixJ(m_position(3), m_position(4), m_position(5)) * m_velocity;
 
-        // Compute acceleration in the vehicle's frame
-        Matrix accel;
-        accel = m_model->stepInv(m_thruster_act, m_servo_pos, m_velocity, m_position);
+          // Integrate using Euler method
+          m_position += timestep * dposition;
 
-        // surface behavior
-        if (m_position(2) < c_surface_depth)
+          // Compute velocity in the vehicle frame that will be used in the next iteration
+          m_velocity += timestep * computeAcceleration(m_position, m_velocity);
+        }
+        else
         {
-          accel(2) = std::fabs(accel(2));
+          for (unsigned i = 0; i < 6; ++i)
+          {
+            m_state[i] = m_position(i);
+            m_state[i + 6] = m_velocity(i);
+          }
+
+          m_integrator.integrate(*this, m_state, 12, 0.0, timestep);
+
+          for (unsigned i = 0; i < 6; ++i)
+          {
+            m_position(i) = m_state[i];
+            m_velocity(i) = m_state[i + 6];
+          }
         }
 
-        // Compute velocity in the vehicle frame that will be used in the next iteration
-        m_velocity += timestep * accel;
-
         // Fill position.
         double sim_time = Clock::get() - m_start_time;
         m_sstate.x = m_position(0) + sim_time * m_args.wx;
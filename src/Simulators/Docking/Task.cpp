@@ -163,6 +163,8 @@ namespace Simulators
         // Register consumers.
         bind<IMC::GpsFix>(this);
         bind<IMC::SimulatedState>(this);
+
+        setCooperative();
       }
 
       void
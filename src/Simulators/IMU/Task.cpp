@@ -133,6 +133,8 @@ namespace Simulators
 
         // Register consumers.
         bind<IMC::SimulatedState>(this);
+
+        setCooperative();
       }
 
       //! Acquire resources.
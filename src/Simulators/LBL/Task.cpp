@@ -142,6 +142,8 @@ namespace Simulators
         bind<IMC::GpsFix>(this);
         bind<IMC::SimulatedState>(this);
         bind<IMC::UamTxFrame>(this);
+
+        setCooperative();
       }
 
       //! Update parameters.
@@ -339,6 +341,38 @@ namespace Simulators
         }
       }
 
+      //! Range the next beacon.
+      void
+      ping(void)
+      {
+        // Setup next ping.
+        m_pinger.reset();
+
+        if (*m_cursor == NULL)
+          return;
+
+        range((*m_cursor)->beacon);
+
+        if (++m_cursor == m_lbl_cfg->beacons.end())
+          m_cursor = m_lbl_cfg->beacons.begin();
+      }
+
+      double
+      onJob(bool restarted)
+      {
+        (void)restarted;
+        consumeMessages();
+
+        // Ranges are requested by messages when waiting for them.
+        if (!isInitialized() || !isActive() || m_args.wait_request)
+          return -1.0;
+
+        if (m_pinger.overflow())
+          ping();
+
+        return Clock::get() + m_pinger.getRemaining();
+      }
+
       void
       onMain(void)
       {
@@ -359,16 +393,7 @@ namespace Simulators
             continue;
           }
 
-          if (*m_cursor == NULL)
-            continue;
-
-          range((*m_cursor)->beacon);
-
-          // Setup next ping.
-          m_pinger.reset();
-
-          if (++m_cursor == m_lbl_cfg->beacons.end())
-            m_cursor = m_lbl_cfg->beacons.begin();
+          ping();
         }
       }
     };
@@ -64,6 +64,8 @@ namespace Simulators
         .description("Names of leak entities to simulate");
 
         bind<IMC::LeakSimulation>(this);
+
+        setCooperative();
       }
 
       void
@@ -125,6 +125,8 @@ namespace Simulators
         // Register consumers.
         bind<IMC::SetServoPosition>(this);
         bind<IMC::SimulatedState>(this);
+
+        setCooperative();
       }
 
       //! Update parameters
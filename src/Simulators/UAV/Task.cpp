@@ -61,6 +61,9 @@ namespace Simulators
       double wy;
       //! UAV Model Parameters
       std::string sim_type; // Simulation type (3DOF, 4DOF_bank, 4DOF_alt, 5DOF, 6DOF_stabder, and 6DOF_geom)
+      //! - Numerical integration method and tolerance
+      std::string integrator;
+      double int_tol;
       double gaccel;
       //! - Time constants
       double c_bank;
@@ -167,6 +170,16 @@ namespace Simulators
         .values("3DOF, 4DOF_alt, 4DOF_bank, 5DOF")
         .description("Simulation type (DOF)");
 
+        param("Integration Method", m_args.integrator)
+        .defaultValue("Euler")
+        .values("Euler, RK4, Dormand-Prince")
+        .description("Numerical integration method of the model equations");
+
+        param("Integration Tolerance", m_args.int_tol)
+        .defaultValue("1e-6")
+        .minimumValue("1e-12")
+        .description("Error tolerance of the adaptive integration method");
+
         param("Bank Time Constant", m_args.c_bank)
         .defaultValue("1.0")
         .units(Units::Hertz)
@@ -422,6 +435,7 @@ namespace Simulators
         //! - Simulation type
         m_model->m_sim_type = m_args.sim_type;
         inf(DTR("UAV simulation type: %s"), m_args.sim_type.c_str());
+        m_model->setIntegrator(DUNE::Simulation::Integrator::parseMethod(m_args.integrator), m_args.int_tol);
         // Application of the wind vector
         m_model->m_wind(0) = m_args.wx;
         m_model->m_wind(1) = m_args.wy;
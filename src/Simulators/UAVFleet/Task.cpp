@@ -0,0 +1,436 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/UAVFleet.hpp>
+
+namespace Simulators
+{
+  //! Simulation of a fleet of UAVs in a single task.
+  //!
+  //! All vehicles share the same kinematic model and are integrated
+  //! together by DUNE::Simulation::UAVFleet. Each vehicle is an IMC
+  //! system of its own: commands are routed by their destination and
+  //! the simulated and estimated states are published with the
+  //! vehicle address as source.
+  //!
+  //! @author Ricardo Martins
+  namespace UAVFleet
+  {
+    using DUNE_NAMESPACES;
+    using DUNE::Simulation::UAVFleet;
+
+    struct Arguments
+    {
+      //! Simulated systems.
+      std::vector<std::string> vehicles;
+      //! Simulation type.
+      std::string sim_type;
+      //! Time constants.
+      double c_bank;
+      double c_speed;
+      double c_alt;
+      //! Constraints.
+      double l_bank_rate;
+      double l_accel_x;
+      double l_vert_slope;
+      //! Stream velocity.
+      double wx;
+      double wy;
+      //! Numerical integration.
+      std::string integrator;
+      double int_tol;
+      double int_step;
+      //! Vehicles per integration group.
+      unsigned group_size;
+      //! Worker threads.
+      unsigned threads;
+      //! Initial state.
+      double init_lat;
+      double init_lon;
+      double init_hei;
+      double init_alt;
+      double init_speed;
+      double init_yaw;
+      double init_spacing;
+      //! Publish estimated states.
+      bool estate;
+    };
+
+    struct Task: public DUNE::Tasks::Periodic
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Fleet model.
+      UAVFleet* m_fleet;
+      //! System addresses of the vehicles.
+      std::vector<unsigned> m_ids;
+      //! Vehicle index of each system address.
+      std::map<unsigned, size_t> m_index;
+      //! Simulated state.
+      IMC::SimulatedState m_sstate;
+      //! Estimated state.
+      IMC::EstimatedState m_estate;
+      //! Last update time.
+      double m_last_update;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Periodic(name, ctx),
+        m_fleet(NULL),
+        m_last_update(-1.0)
+      {
+        param("Vehicles", m_args.vehicles)
+        .defaultValue("")
+        .description("Names of the simulated systems");
+
+        param("Simulation type", m_args.sim_type)
+        .defaultValue("4DOF_bank")
+        .values("3DOF, 4DOF_alt, 4DOF_bank, 5DOF")
+        .description("Simulation type (DOF)");
+
+        param("Bank Time Constant", m_args.c_bank)
+        .defaultValue("1.0")
+        .units(Units::Second)
+        .description("Bank controller first order time constant");
+
+        param("Speed Time Constant", m_args.c_speed)
+        .defaultValue("1.0")
+        .units(Units::Second)
+        .description("Speed controller first order time constant");
+
+        param("Altitude Time Constant", m_args.c_alt)
+        .defaultValue("1.0")
+        .units(Units::Second)
+        .description("Altitude controller first order time constant");
+
+        param("Bank Rate Limit", m_args.l_bank_rate)
+        .defaultValue("0.0")
+        .units(Units::DegreePerSecond)
+        .description("Bank rate limit to simulate bank dynamics");
+
+        param("Longitudinal Acceleration Limit", m_args.l_accel_x)
+        .defaultValue("0.0")
+        .units(Units::MeterPerSquareSecond)
+        .description("Vehicle longitudinal acceleration limit to simulate the speed dynamics");
+
+        param("Vertical Slope Limit", m_args.l_vert_slope)
+        .defaultValue("0.0")
+        .units(Units::None)
+        .description("Vertical slope limit to simulate altitude dynamics");
+
+        param("Stream Speed to North", m_args.wx)
+        .units(Units::MeterPerSecond)
+        .defaultValue("0.0")
+        .description("Wind speed towards the North in the NED frame");
+
+        param("Stream Speed to East", m_args.wy)
+        .units(Units::MeterPerSecond)
+        .defaultValue("0.0")
+        .description("Wind speed towards the East in the NED frame");
+
+        param("Integration Method", m_args.integrator)
+        .defaultValue("RK4")
+        .values("Euler, RK4, Dormand-Prince")
+        .description("Numerical integration method of the model equations");
+
+        param("Integration Tolerance", m_args.int_tol)
+        .defaultValue("1e-6")
+        .minimumValue("1e-12")
+        .description("Error tolerance of the adaptive integration method");
+
+        param("Maximum Integration Step", m_args.int_step)
+        .defaultValue("0.05")
+        .units(Units::Second)
+        .description("Largest integration step (0 for no limit)");
+
+        param("Group Size", m_args.group_size)
+        .defaultValue("64")
+        .minimumValue("1")
+        .description("Number of vehicles integrated together");
+
+        param("Worker Threads", m_args.threads)
+        .defaultValue("0")
+        .description("Number of threads integrating groups of vehicles besides the task thread");
+
+        param("Initial Reference Latitude", m_args.init_lat)
+        .defaultValue("39.09")
+        .units(Units::Degree)
+        .description("Initial home reference latitude");
+
+        param("Initial Reference Longitude", m_args.init_lon)
+        .defaultValue("-8.964")
+        .units(Units::Degree)
+        .description("Initial home reference longitude");
+
+        param("Reference Ground Height", m_args.init_hei)
+        .defaultValue("47.3")
+        .units(Units::Meter)
+        .description("Home reference ground height");
+
+        param("Initial Altitude", m_args.init_alt)
+        .defaultValue("100")
+        .units(Units::Meter)
+        .description("Initial altitude above the reference");
+
+        param("Initial Speed", m_args.init_speed)
+        .defaultValue("18.0")
+        .units(Units::MeterPerSecond)
+        .description("Initial airspeed");
+
+        param("Initial Yaw", m_args.init_yaw)
+        .defaultValue("0.0")
+        .units(Units::Degree)
+        .description("Initial yaw of all vehicles");
+
+        param("Initial Spacing", m_args.init_spacing)
+        .defaultValue("50.0")
+        .units(Units::Meter)
+        .description("Initial distance between vehicles, placed side by side");
+
+        param("Publish Estimated State", m_args.estate)
+        .defaultValue("true")
+        .description("Publish the simulated state of each vehicle as its estimated state");
+
+        bind<IMC::DesiredRoll>(this);
+        bind<IMC::DesiredSpeed>(this);
+        bind<IMC::DesiredZ>(this);
+        bind<IMC::DesiredPitch>(this);
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if (m_fleet != NULL)
+          m_fleet->setWind(m_args.wx, m_args.wy, 0.0);
+      }
+
+      void
+      onEntityResolution(void)
+      {
+        m_ids.clear();
+        m_index.clear();
+
+        for (size_t i = 0; i < m_args.vehicles.size(); ++i)
+        {
+          unsigned id = resolveSystemName(m_args.vehicles[i]);
+          if (m_index.find(id) != m_index.end())
+            throw std::runtime_error(String::str(DTR("duplicate vehicle: %s"), m_args.vehicles[i].c_str()));
+
+          m_index[id] = m_ids.size();
+          m_ids.push_back(id);
+        }
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        if (m_ids.empty())
+          throw std::runtime_error(DTR("no vehicles to simulate"));
+
+        UAVFleet::Parameters params;
+        params.model = UAVFleet::parseModel(m_args.sim_type);
+        params.bank_time_cst = m_args.c_bank;
+        params.speed_time_cst = m_args.c_speed;
+        params.alt_time_cst = m_args.c_alt;
+        params.bank_rate_lim = Angles::radians(m_args.l_bank_rate);
+        params.lon_accel_lim = m_args.l_accel_x;
+        params.vert_slope_lim = m_args.l_vert_slope;
+        params.wind[0] = m_args.wx;
+        params.wind[1] = m_args.wy;
+
+        m_fleet = new UAVFleet(m_ids.size(), params, m_args.group_size, m_args.threads);
+        m_fleet->setIntegrator(Simulation::Integrator::parseMethod(m_args.integrator),
+                               m_args.int_tol, m_args.int_step);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        Memory::clear(m_fleet);
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        // Vehicles side by side, perpendicular to the initial yaw.
+        double yaw = Angles::radians(m_args.init_yaw);
+        double center = 0.5 * (m_ids.size() - 1);
+
+        for (size_t i = 0; i < m_ids.size(); ++i)
+        {
+          double offset = (i - center) * m_args.init_spacing;
+          m_fleet->setState(i, -std::sin(yaw) * offset, std::cos(yaw) * offset,
+                            -m_args.init_alt, 0.0, yaw, m_args.init_speed);
+        }
+
+        m_sstate.lat = Angles::radians(m_args.init_lat);
+        m_sstate.lon = Angles::radians(m_args.init_lon);
+        m_sstate.height = m_args.init_hei;
+        m_estate.lat = m_sstate.lat;
+        m_estate.lon = m_sstate.lon;
+        m_estate.height = m_sstate.height;
+
+        m_last_update = Clock::get();
+        inf(DTR("simulating %u vehicles (%s)"), (unsigned)m_ids.size(), m_args.sim_type.c_str());
+      }
+
+      //! Find the vehicle a command is addressed to.
+      //! @param[in] msg command.
+      //! @param[out] index vehicle index.
+      //! @return true if the command is addressed to a simulated vehicle.
+      bool
+      getVehicle(const IMC::Message* msg, size_t& index)
+      {
+        if (m_fleet == NULL || Math::isNaN(msg->getValueFP()))
+          return false;
+
+        std::map<unsigned, size_t>::const_iterator itr = m_index.find(msg->getDestination());
+        if (itr == m_index.end())
+          return false;
+
+        index = itr->second;
+        return true;
+      }
+
+      void
+      consume(const IMC::DesiredRoll* msg)
+      {
+        size_t index;
+        if (getVehicle(msg, index))
+          m_fleet->commandBank(index, msg->value);
+      }
+
+      void
+      consume(const IMC::DesiredSpeed* msg)
+      {
+        size_t index;
+        if (!getVehicle(msg, index))
+          return;
+
+        if (msg->value > 0.0)
+          m_fleet->commandAirspeed(index, msg->value);
+      }
+
+      void
+      consume(const IMC::DesiredZ* msg)
+      {
+        size_t index;
+        if (!getVehicle(msg, index))
+          return;
+
+        double alt_cmd;
+        if (msg->z_units == IMC::Z_HEIGHT)
+          alt_cmd = msg->value - m_sstate.height;
+        else if (msg->z_units == IMC::Z_DEPTH)
+          alt_cmd = -msg->value;
+        else
+          alt_cmd = msg->value;
+
+        m_fleet->commandAltitude(index, alt_cmd);
+      }
+
+      void
+      consume(const IMC::DesiredPitch* msg)
+      {
+        size_t index;
+        if (getVehicle(msg, index))
+          m_fleet->commandFPA(index, msg->value);
+      }
+
+      //! Publish the state of a vehicle.
+      //! @param[in] index vehicle index.
+      void
+      dispatchState(size_t index)
+      {
+        UAVFleet::State s;
+        m_fleet->getState(index, s);
+
+        m_sstate.x = s.x;
+        m_sstate.y = s.y;
+        m_sstate.z = s.z;
+        m_sstate.phi = s.phi;
+        m_sstate.theta = s.theta;
+        m_sstate.psi = s.psi;
+        BodyFixedFrame::toBodyFrame(s.phi, s.theta, s.psi, s.vx, s.vy, s.vz,
+                                    &m_sstate.u, &m_sstate.v, &m_sstate.w);
+        m_sstate.p = s.p;
+        m_sstate.q = s.q;
+        m_sstate.r = s.r;
+        m_sstate.svx = m_args.wx;
+        m_sstate.svy = m_args.wy;
+        m_sstate.svz = 0.0;
+        m_sstate.setSource(m_ids[index]);
+        m_sstate.setDestination(m_ids[index]);
+        dispatch(m_sstate);
+
+        if (!m_args.estate)
+          return;
+
+        m_estate.x = s.x;
+        m_estate.y = s.y;
+        m_estate.z = s.z;
+        m_estate.phi = s.phi;
+        m_estate.theta = s.theta;
+        m_estate.psi = s.psi;
+        m_estate.u = m_sstate.u;
+        m_estate.v = m_sstate.v;
+        m_estate.w = m_sstate.w;
+        m_estate.vx = s.vx;
+        m_estate.vy = s.vy;
+        m_estate.vz = s.vz;
+        m_estate.p = s.p;
+        m_estate.q = s.q;
+        m_estate.r = s.r;
+        m_estate.depth = 0.0;
+        m_estate.alt = -s.z;
+        m_estate.setSource(m_ids[index]);
+        dispatch(m_estate);
+      }
+
+      void
+      task(void)
+      {
+        double now = Clock::get();
+        m_fleet->update(now - m_last_update);
+        m_last_update = now;
+
+        for (size_t i = 0; i < m_ids.size(); ++i)
+          dispatchState(i);
+      }
+    };
+  }
+}
+
+DUNE_TASK
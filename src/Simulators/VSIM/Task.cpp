@@ -64,6 +64,10 @@ namespace Simulators
       double wy;
       //! Initial heading (degrees).
       double yaw;
+      //! Numerical integration method.
+      std::string integrator;
+      //! Error tolerance of adaptive integration.
+      double int_tol;
     };
 
     //! Simulator task.
@@ -102,6 +106,16 @@ namespace Simulators
         .defaultValue("0.0")
         .description("Initial heading of the vehicle.");
 
+        param("Integration Method", m_args.integrator)
+        .defaultValue("Euler")
+        .values("Euler, RK4, Dormand-Prince")
+        .description("Numerical integration method of the vehicle dynamics");
+
+        param("Integration Tolerance", m_args.int_tol)
+        .defaultValue("1e-6")
+        .minimumValue("1e-12")
+        .description("Error tolerance of the adaptive integration method");
+
         // Register handler routines.
         bind<IMC::GpsFix>(this);
         bind<IMC::ServoPosition>(this);
@@ -139,6 +153,8 @@ namespace Simulators
 
         m_world->addVehicle(m_vehicle);
         m_world->setTimeStep(1.0 / getFrequency());
+        m_world->setIntegrator(DUNE::Simulation::Integrator::parseMethod(m_args.integrator),
+                               m_args.int_tol);
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
@@ -163,7 +163,7 @@ namespace Simulators
     }
 
     void
-    Object::update(double ts)
+    Object::computeRates(double* d_pos, double* d_vel)
     {
       // Initialize variables.
       double c1 = std::cos(m_orientation[0]);
@@ -183,16 +183,10 @@ namespace Simulators
       double q = m_angular_velocity[1];
       double r = m_angular_velocity[2];
 
-      double d_pos[6];
-      double d_vel[6];
-
       // Accelerations.
       for (unsigned i = 0; i < 6; ++i)
         d_vel[i] = m_forces[i] / m_inertia[i];
 
-      // Reset forces to zero.
-      resetForces();
-
       // Compute Velocities
       // Transformation Matrix: eta1dot = J1(eta2)*nu1
       //    J1=[ c3*c2   c3*s2*s1-s3*c1  s3*s1+c3*c1*s2
@@ -209,6 +203,57 @@ namespace Simulators
       d_pos[3] = p + (s1 * t2) * q + (c1 * t2) * r;
       d_pos[4] = c1 * q + (-s1) * r;
       d_pos[5] = (s1 / c2) * q + (c1 / c2) * r;
+    }
+
+    void
+    Object::setState(const double* x)
+    {
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m_position[i] = x[i];
+        m_orientation[i] = x[i + 3];
+        m_linear_velocity[i] = x[i + 6];
+        m_angular_velocity[i] = x[i + 9];
+      }
+    }
+
+    void
+    Object::derivatives(double t, const double* x, double* dx)
+    {
+      (void)t;
+
+      setState(x);
+      resetForces();
+      applyForces();
+      computeRates(dx, dx + 6);
+    }
+
+    void
+    Object::update(double ts)
+    {
+      if (m_integration_method && m_integrator.getMethod() != DUNE::Simulation::Integrator::IM_EULER)
+      {
+        double x[12];
+        for (unsigned i = 0; i < 3; ++i)
+        {
+          x[i] = m_position[i];
+          x[i + 3] = m_orientation[i];
+          x[i + 6] = m_linear_velocity[i];
+          x[i + 9] = m_angular_velocity[i];
+        }
+
+        m_integrator.integrate(*this, x, 12, 0.0, ts);
+        setState(x);
+        resetForces();
+        return;
+      }
+
+      double d_pos[6];
+      double d_vel[6];
+      computeRates(d_pos, d_vel);
+
+      // Reset forces to zero.
+      resetForces();
 
       // Integrate using Euler's method.
       for (unsigned i = 0; i < 3; i++)
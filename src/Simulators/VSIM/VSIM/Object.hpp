@@ -32,12 +32,15 @@
 // ISO C++ 98 headers.
 #include <cmath>
 
+// DUNE headers.
+#include <DUNE/Simulation/Integrator.hpp>
+
 namespace Simulators
 {
   namespace VSIM
   {
     //! %Object properties.
-    class Object
+    class Object: private DUNE::Simulation::Integrator::System
     {
     public:
       //! Vehicle type.
@@ -83,6 +86,18 @@ namespace Simulators
         m_integration_method = method;
       }
 
+      //! Select the numerical integrator of regular velocity
+      //! integration. With methods other than Euler forces are
+      //! reevaluated at every stage through applyForces().
+      //! @param[in] method numerical integration method.
+      //! @param[in] tolerance error tolerance of adaptive methods.
+      void
+      setIntegrator(DUNE::Simulation::Integrator::Method method, double tolerance)
+      {
+        m_integrator.setMethod(method);
+        m_integrator.setTolerances(tolerance, tolerance);
+      }
+
       //! Insert object in virtual World.
       virtual void
       insertInWorld(void);
@@ -189,6 +204,24 @@ namespace Simulators
       double m_forces[6];
       //! Velocity Integration Method (true = regular)
       bool m_integration_method;
+      //! Numerical integrator.
+      DUNE::Simulation::Integrator m_integrator;
+
+      //! Compute position and velocity rates from the current state
+      //! and applied forces.
+      //! @param[out] d_pos position and orientation rates.
+      //! @param[out] d_vel linear and angular accelerations.
+      void
+      computeRates(double* d_pos, double* d_vel);
+
+      //! Load a state vector [position, orientation, linear velocity,
+      //! angular velocity] into the object.
+      //! @param[in] x state vector.
+      void
+      setState(const double* x);
+
+      void
+      derivatives(double t, const double* x, double* dx);
     };
   }
 }
@@ -51,6 +51,18 @@ namespace Simulators
       m_gravity[2] = z;
     }
 
+    void
+    World::setIntegrator(DUNE::Simulation::Integrator::Method method, double tolerance)
+    {
+      std::list<Object*>::iterator oitr = m_objects.begin();
+      for (; oitr != m_objects.end(); ++oitr)
+        (*oitr)->setIntegrator(method, tolerance);
+
+      std::list<Vehicle*>::iterator vitr = m_vehicles.begin();
+      for (; vitr != m_vehicles.end(); ++vitr)
+        (*vitr)->setIntegrator(method, tolerance);
+    }
+
     void
     World::addObject(Object* obj)
     {
@@ -66,6 +66,13 @@ namespace Simulators
         return m_timestep;
       }
 
+      //! Select the numerical integrator of all objects and vehicles
+      //! in the world.
+      //! @param[in] method numerical integration method.
+      //! @param[in] tolerance error tolerance of adaptive methods.
+      void
+      setIntegrator(DUNE::Simulation::Integrator::Method method, double tolerance);
+
       //! Add object to world.
       //! @param[in] obj new object.
       void
@@ -80,6 +80,8 @@ namespace Transports
 
         // Bind messages.
         bind<IMC::CacheControl>(this);
+
+        setCooperative();
       }
 
       ~Task(void)
@@ -285,6 +287,16 @@ namespace Transports
         m_path.create();
       }
 
+      double
+      onJob(bool restarted)
+      {
+        if (restarted)
+          loadSnapshot();
+
+        consumeMessages();
+        return -1.0;
+      }
+
       void
       onMain(void)
       {
@@ -28,6 +28,8 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 #include <DUNE/Network/FragmentedMessage.hpp>
+#include <DUNE/Network/Fragments.hpp>
+#include <DUNE/Network/FragmentsRedundancy.hpp>
 
 namespace Transports
 {
@@ -39,12 +41,24 @@ namespace Transports
     {
       // Reception timeout.
       float max_age_secs;
+      // Decode parity fragments of incoming messages.
+      bool parity;
+      // Messages to fragment.
+      std::vector<std::string> messages;
+      // Maximum transmission unit of outgoing fragments.
+      unsigned mtu;
+      // Redundancy of outgoing messages.
+      std::vector<std::string> redundancy;
     };
 
     struct Task: public DUNE::Tasks::Task
     {
       std::map<uint32_t, FragmentedMessage> m_incoming;
       Time::Counter<float> m_gc_counter;
+      // Redundancy of outgoing messages.
+      FragmentsRedundancy m_redundancy;
+      // Outgoing fragment.
+      IMC::MessagePart m_part;
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
@@ -54,9 +68,38 @@ namespace Transports
         .defaultValue("1800")
         .description("Maximum amount of seconds to wait for missing fragments in incoming messages");
 
+        param("Decode Parity Fragments", m_args.parity)
+        .defaultValue("false")
+        .description("Decode parity fragments of incoming messages. Only enable it if"
+                     " all peers sending fragments to this system are DUNE systems");
+
+        param("Fragmented Messages", m_args.messages)
+        .defaultValue("")
+        .description("List of local messages to dispatch as fragments");
+
+        param("Maximum Transmission Unit", m_args.mtu)
+        .defaultValue("1024")
+        .units(Units::Byte)
+        .description("Maximum size of outgoing fragments");
+
+        param("Parity Fragments", m_args.redundancy)
+        .defaultValue("")
+        .description("List of <Message>:<Redundancy> where redundancy is the number of parity"
+                     " fragments relative to the number of data fragments of outgoing messages."
+                     " Receivers must decode parity fragments");
+
         bind<IMC::MessagePart>(this);
         m_gc_counter.setTop(120);
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+
+        setCooperative();
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_redundancy.setup(m_args.redundancy);
+        bind(this, m_args.messages);
       }
 
       void
@@ -70,24 +113,49 @@ namespace Transports
       {
         int hash = (msg->uid << 16) | msg->getSource();
 
-        if (m_incoming.find(hash) == m_incoming.end())
+        std::map<uint32_t, FragmentedMessage>::iterator itr = m_incoming.find(hash);
+        if (itr == m_incoming.end())
         {
-          FragmentedMessage incMsg;
-          incMsg.setParentTask(this);
-          m_incoming[hash] = incMsg;
+          itr = m_incoming.insert(std::make_pair(hash, FragmentedMessage())).first;
+          itr->second.setParentTask(this);
+          itr->second.enableParity(m_args.parity);
         }
 
+        IMC::Message* res = itr->second.setFragment(msg);
+
         debug("Incoming message fragment (%d still missing)",
-              m_incoming[hash].getFragmentsMissing());
+              itr->second.getFragmentsMissing());
 
-        IMC::Message * res = m_incoming[hash].setFragment(msg);
         if (res != NULL)
         {
           dispatch(res);
-          m_incoming.erase(hash);
+          delete res;
+          m_incoming.erase(itr);
         }
       }
 
+      void
+      consume(const IMC::Message* msg)
+      {
+        // Only fragment messages of this system.
+        if (msg->getSource() != getSystemId())
+          return;
+
+        DUNE::Network::Fragments frags(msg, m_args.mtu, m_redundancy.get(msg));
+        m_part.setDestination(msg->getDestination());
+        m_part.setDestinationEntity(msg->getDestinationEntity());
+
+        for (int i = 0; i < frags.getNumberOfFragments(); ++i)
+        {
+          frags.getFragment(i, m_part);
+          dispatch(m_part);
+        }
+
+        debug("fragmented %s into %d fragments (%d parity)", msg->getName(),
+              frags.getNumberOfFragments(),
+              frags.getNumberOfFragments() - frags.getNumberOfDataFragments());
+      }
+
       void
       messageRipper(void)
       {
@@ -111,18 +179,33 @@ namespace Transports
           m_incoming.erase(remove[i]);
       }
 
+      //! Periodically discard incomplete messages.
+      void
+      collectGarbage(void)
+      {
+        if (m_gc_counter.overflow())
+        {
+          messageRipper();
+          m_gc_counter.reset();
+        }
+      }
+
+      double
+      onJob(bool restarted)
+      {
+        (void)restarted;
+        consumeMessages();
+        collectGarbage();
+        return Clock::get() + m_gc_counter.getRemaining();
+      }
+
       void
       onMain(void)
       {
         while (!stopping())
         {
           waitForMessages(1.0);
-
-          if (m_gc_counter.overflow())
-          {
-            messageRipper();
-            m_gc_counter.reset();
-          }
+          collectGarbage();
         }
       }
     };
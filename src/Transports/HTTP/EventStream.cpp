@@ -0,0 +1,280 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <sstream>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "EventStream.hpp"
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Maximum number of stream clients.
+    static const unsigned c_max_clients = 16;
+    //! Seconds a client may block a send before being dropped.
+    static const double c_send_timeout = 1.0;
+    //! Seconds between heartbeats on idle streams.
+    static const double c_heartbeat_period = 15.0;
+    //! Seconds between scans of pending updates.
+    static const double c_scan_period = 0.05;
+
+    EventStream::EventStream(void):
+      m_adding(0)
+    { }
+
+    EventStream::~EventStream(void)
+    {
+      ScopedMutex l(m_mutex);
+
+      for (std::list<Client*>::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+      {
+        delete (*itr)->sock;
+        delete *itr;
+      }
+    }
+
+    bool
+    EventStream::matches(const Filter& filter, uint64_t key)
+    {
+      unsigned id = (unsigned)(key >> 32);
+      unsigned entity = (unsigned)(key & 0xff);
+
+      if (!filter.ids.empty() && filter.ids.find(id) == filter.ids.end())
+        return false;
+
+      if (!filter.entities.empty() && filter.entities.find(entity) == filter.entities.end())
+        return false;
+
+      return true;
+    }
+
+    void
+    EventStream::format(std::string& out, const std::map<uint64_t, std::string>& fragments)
+    {
+      std::map<uint64_t, std::string>::const_iterator itr = fragments.begin();
+      for (; itr != fragments.end(); ++itr)
+      {
+        const std::string& json = itr->second;
+
+        // Every line of the payload must be a 'data' field.
+        out += "data: ";
+        size_t end = json.find_last_not_of('\n');
+        for (size_t i = 0; end != std::string::npos && i <= end; ++i)
+        {
+          if (json[i] == '\n')
+            out += "\ndata: ";
+          else
+            out += json[i];
+        }
+
+        out += "\n\n";
+      }
+    }
+
+    bool
+    EventStream::send(Client* client, const std::string& data)
+    {
+      try
+      {
+        const char* bfr = data.c_str();
+        size_t remaining = data.size();
+
+        while (remaining > 0)
+        {
+          size_t rv = client->sock->write(bfr, remaining);
+          bfr += rv;
+          remaining -= rv;
+        }
+      }
+      catch (std::runtime_error& e)
+      {
+        return false;
+      }
+
+      return true;
+    }
+
+    bool
+    EventStream::add(TCPSocket* sock, const Filter& filter,
+                     const std::map<uint64_t, std::string>& initial)
+    {
+      // Reserve a slot, so that concurrent additions cannot exceed
+      // the limit while the initial data is sent.
+      {
+        ScopedMutex l(m_mutex);
+        if (m_clients.size() + m_adding >= c_max_clients)
+          return false;
+
+        ++m_adding;
+      }
+
+      Client* client = new Client;
+      client->sock = sock;
+      client->filter = filter;
+      client->period = (filter.rate > 0) ? 1.0 / filter.rate : 0.0;
+      client->last_send = Clock::get();
+
+      std::map<uint64_t, std::string> matching;
+      std::map<uint64_t, std::string>::const_iterator itr = initial.begin();
+      for (; itr != initial.end(); ++itr)
+      {
+        if (matches(filter, itr->first))
+          matching.insert(*itr);
+      }
+
+      std::string data = "HTTP/1.1 200 OK\r\n"
+        "Server: DUNE/" DUNE_VERSION_STR "\r\n"
+        "Content-Type: text/event-stream\r\n"
+        "Cache-Control: no-cache\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n";
+      format(data, matching);
+
+      try
+      {
+        sock->setSendTimeout(c_send_timeout);
+        sock->setNoDelay(true);
+      }
+      catch (std::runtime_error& e)
+      {
+        DUNE_WRN("EventStream", e.what());
+      }
+
+      bool sent = send(client, data);
+
+      ScopedMutex l(m_mutex);
+      --m_adding;
+
+      if (sent)
+      {
+        m_clients.push_back(client);
+      }
+      else
+      {
+        delete client->sock;
+        delete client;
+      }
+
+      return true;
+    }
+
+    void
+    EventStream::publish(uint64_t key, const IMC::Message* msg)
+    {
+      ScopedMutex l(m_mutex);
+
+      if (m_clients.empty())
+        return;
+
+      std::string json;
+      for (std::list<Client*>::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+      {
+        Client* client = *itr;
+        if (!matches(client->filter, key))
+          continue;
+
+        if (json.empty())
+        {
+          std::ostringstream os;
+          msg->toJSON(os);
+          json = os.str();
+        }
+
+        client->pending[key] = json;
+      }
+    }
+
+    void
+    EventStream::run(void)
+    {
+      std::vector<std::pair<Client*, std::string> > batches;
+
+      while (!isStopping())
+      {
+        Delay::wait(c_scan_period);
+
+        double now = Clock::get();
+        batches.clear();
+
+        // Collect due updates, leaving the lock before any I/O.
+        {
+          ScopedMutex l(m_mutex);
+
+          for (std::list<Client*>::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+          {
+            Client* client = *itr;
+            if (now - client->last_send < client->period)
+              continue;
+
+            if (client->pending.empty())
+            {
+              if (now - client->last_send < c_heartbeat_period)
+                continue;
+
+              batches.push_back(std::make_pair(client, std::string(": heartbeat\n\n")));
+            }
+            else
+            {
+              batches.push_back(std::make_pair(client, std::string()));
+              format(batches.back().second, client->pending);
+              client->pending.clear();
+            }
+
+            client->last_send = now;
+          }
+        }
+
+        // Clients are only removed by this thread, so pointers remain
+        // valid while sending.
+        std::vector<Client*> dead;
+        for (size_t i = 0; i < batches.size(); ++i)
+        {
+          if (!send(batches[i].first, batches[i].second))
+            dead.push_back(batches[i].first);
+        }
+
+        if (dead.empty())
+          continue;
+
+        ScopedMutex l(m_mutex);
+        for (size_t i = 0; i < dead.size(); ++i)
+        {
+          m_clients.remove(dead[i]);
+          delete dead[i]->sock;
+          delete dead[i];
+        }
+      }
+    }
+  }
+}
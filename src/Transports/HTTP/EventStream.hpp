@@ -0,0 +1,125 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_HTTP_EVENT_STREAM_HPP_INCLUDED_
+#define TRANSPORTS_HTTP_EVENT_STREAM_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    //! Server-Sent Events stream of message updates.
+    //!
+    //! Each client has a filter on message identifiers and source
+    //! entities and a maximum event rate. Updates are coalesced per
+    //! message key between sends, so publishing never waits on
+    //! sockets: all network I/O is done by this thread and clients
+    //! that cannot keep up are dropped.
+    class EventStream: public DUNE::Concurrency::Thread
+    {
+    public:
+      //! Subscription filter.
+      struct Filter
+      {
+        //! Message identifiers (empty for all).
+        std::set<unsigned> ids;
+        //! Source entities (empty for all).
+        std::set<unsigned> entities;
+        //! Maximum number of event batches per second.
+        double rate;
+      };
+
+      EventStream(void);
+
+      ~EventStream(void);
+
+      //! Add a client. The HTTP response header is sent immediately,
+      //! followed by the current value of the matching messages.
+      //! @param sock client socket (ownership is transferred).
+      //! @param filter subscription filter.
+      //! @param initial JSON fragments of the latest messages, indexed
+      //! by message key (see MessageMonitor::getKey).
+      //! @return false if there are too many clients (the socket is
+      //! not taken), true otherwise.
+      bool
+      add(DUNE::Network::TCPSocket* sock, const Filter& filter,
+          const std::map<uint64_t, std::string>& initial);
+
+      //! Queue a message update for all interested clients.
+      //! @param key message key.
+      //! @param msg message.
+      void
+      publish(uint64_t key, const DUNE::IMC::Message* msg);
+
+    private:
+      //! Connected client.
+      struct Client
+      {
+        //! Client socket.
+        DUNE::Network::TCPSocket* sock;
+        //! Subscription filter.
+        Filter filter;
+        //! Minimum time between sends.
+        double period;
+        //! Time of last send.
+        double last_send;
+        //! Pending JSON fragments indexed by message key.
+        std::map<uint64_t, std::string> pending;
+      };
+
+      //! Connected clients.
+      std::list<Client*> m_clients;
+      //! Number of clients being added.
+      unsigned m_adding;
+      //! Clients and pending updates mutex.
+      DUNE::Concurrency::Mutex m_mutex;
+
+      static bool
+      matches(const Filter& filter, uint64_t key);
+
+      static void
+      format(std::string& out, const std::map<uint64_t, std::string>& fragments);
+
+      static bool
+      send(Client* client, const std::string& data);
+
+      void
+      run(void);
+    };
+  }
+}
+
+#endif
@@ -39,6 +39,8 @@ namespace Transports
 
     MessageMonitor::MessageMonitor(const std::string& system, uint64_t uid):
       m_uid(uid),
+      m_version(0),
+      m_msgs_json_version(0),
       m_last_msgs_json(0)
     {
       // Initialize meta information.
@@ -56,9 +58,9 @@ namespace Transports
       ScopedMutex l(m_mutex);
 
       {
-        std::map<unsigned, IMC::Message*>::iterator itr = m_msgs.begin();
+        std::map<uint64_t, Entry>::iterator itr = m_msgs.begin();
         for (; itr != m_msgs.end(); ++itr)
-          delete itr->second;
+          delete itr->second.msg;
       }
 
       {
@@ -72,85 +74,146 @@ namespace Transports
     {
       ScopedMutex l(m_mutex);
       m_entities = entities;
+      ++m_version;
     }
 
-    ByteBuffer*
-    MessageMonitor::messagesJSON(void)
+    bool
+    MessageMonitor::messagesJSON(const std::string& if_none_match, ByteBuffer& data, std::string& etag)
     {
-      ScopedMutex l(m_mutex);
+      ScopedMutex jl(m_json_mutex);
 
       uint64_t now = Clock::getMsec();
 
       if ((now - m_last_msgs_json) > 2000)
+      {
         m_last_msgs_json = now;
-      else
-        return &m_msgs_json;
 
-      if (m_msgs.empty())
-        return &m_msgs_json;
+        std::string str;
+
+        // Only hold the messages lock while assembling the snapshot
+        // from cached per-message fragments, compression is done
+        // afterwards.
+        {
+          ScopedMutex l(m_mutex);
+
+          if (m_version != m_msgs_json_version && !m_msgs.empty())
+          {
+            m_msgs_json_version = m_version;
+
+            std::ostringstream os;
+            os << m_meta
+               << "  'dune_time_current': '" << std::setprecision(12) << Clock::getSinceEpoch() << "',\n";
+
+            if (m_entities.empty())
+            {
+              os << "  'dune_entities': { },\n";
+            }
+            else
+            {
+              os << "  'dune_entities': {\n";
+              EntityMap::iterator itr = m_entities.begin();
+              os << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
+              ++itr;
+              for (; itr != m_entities.end(); ++itr)
+                os << ",\n" << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
+              os << "\n},";
+            }
+
+            os << "  'dune_messages': [\n";
+
+            std::map<uint64_t, Entry>::iterator itr = m_msgs.begin();
+            for (; itr != m_msgs.end(); ++itr)
+            {
+              refreshJSON(itr->second);
+
+              if (itr != m_msgs.begin())
+                os << ",\n";
+              os << itr->second.json;
+            }
+
+            for (PowerChannelMap::iterator pitr = m_power_channels.begin(); pitr != m_power_channels.end(); ++pitr)
+            {
+              os << ",\n";
+              pitr->second->toJSON(os);
+            }
+
+            os << "\n]"
+               << "\n};";
+
+            str = os.str();
+          }
+        }
+
+        if (!str.empty())
+        {
+          GzipCompressor cmp;
+          cmp.compress(m_msgs_json, (char*)str.c_str(), (unsigned long)str.size());
+          m_msgs_etag = String::str("\"%llu-%llu\"", (unsigned long long)m_uid,
+                                    (unsigned long long)m_msgs_json_version);
+        }
+      }
 
-      std::ostringstream os;
-      os << m_meta
-         << "  'dune_time_current': '" << std::setprecision(12) << Clock::getSinceEpoch() << "',\n";
+      etag = m_msgs_etag;
 
-      if (m_entities.empty())
-      {
-        os << "  'dune_entities': { },\n";
-      }
-      else
-      {
-        os << "  'dune_entities': {\n";
-        EntityMap::iterator itr = m_entities.begin();
-        os << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
-        ++itr;
-        for (; itr != m_entities.end(); ++itr)
-          os << ",\n" << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
-        os << "\n},";
-      }
+      if (!m_msgs_etag.empty() && if_none_match == m_msgs_etag)
+        return false;
 
-      os << "  'dune_messages': [\n";
+      data.write(m_msgs_json.getBuffer(), m_msgs_json.getSize());
+      return true;
+    }
 
-      std::map<unsigned, IMC::Message*>::iterator itr = m_msgs.begin();
-      itr->second->toJSON(os);
-      ++itr;
+    void
+    MessageMonitor::updateMessage(const IMC::Message* msg)
+    {
+      ScopedMutex l(m_mutex);
 
-      for (; itr != m_msgs.end(); ++itr)
+      if (msg->getId() == DUNE_IMC_POWERCHANNELSTATE)
+        updatePowerChannel(static_cast<const IMC::PowerChannelState*>(msg));
+
+      IMC::Message* tmsg = msg->clone();
+      uint64_t key = getKey(tmsg);
+
+      std::map<uint64_t, Entry>::iterator itr = m_msgs.find(key);
+      if (itr == m_msgs.end())
       {
-        os << ",\n";
-        itr->second->toJSON(os);
+        Entry entry;
+        entry.msg = tmsg;
+        entry.dirty = true;
+        m_msgs.insert(std::make_pair(key, entry));
       }
-
-      for (PowerChannelMap::iterator pitr = m_power_channels.begin(); pitr != m_power_channels.end(); ++pitr)
+      else
       {
-        os << ",\n";
-        pitr->second->toJSON(os);
+        delete itr->second.msg;
+        itr->second.msg = tmsg;
+        itr->second.dirty = true;
       }
 
-      os << "\n]"
-         << "\n};";
-
-      GzipCompressor cmp;
-      std::string str = os.str();
-      cmp.compress(m_msgs_json, (char*)str.c_str(), (unsigned long)str.size());
-
-      return &m_msgs_json;
+      ++m_version;
     }
 
     void
-    MessageMonitor::updateMessage(const IMC::Message* msg)
+    MessageMonitor::getJSONFragments(std::map<uint64_t, std::string>& fragments)
     {
       ScopedMutex l(m_mutex);
 
-      if (msg->getId() == DUNE_IMC_POWERCHANNELSTATE)
-        updatePowerChannel(static_cast<const IMC::PowerChannelState*>(msg));
-
-      IMC::Message* tmsg = msg->clone();
-      unsigned key = tmsg->getId() << 24 | tmsg->getSubId() << 8 | tmsg->getSourceEntity();
+      std::map<uint64_t, Entry>::iterator itr = m_msgs.begin();
+      for (; itr != m_msgs.end(); ++itr)
+      {
+        refreshJSON(itr->second);
+        fragments[itr->first] = itr->second.json;
+      }
+    }
 
-      if (m_msgs[key])
-        delete m_msgs[key];
+    void
+    MessageMonitor::refreshJSON(Entry& entry)
+    {
+      if (!entry.dirty)
+        return;
 
-      m_msgs[key] = tmsg;
+      std::ostringstream os;
+      entry.msg->toJSON(os);
+      entry.json = os.str();
+      entry.dirty = false;
     }
 
     void
@@ -49,12 +49,35 @@ namespace Transports
       void
       setEntities(const std::map<unsigned, std::string>& entities);
 
-      DUNE::Utils::ByteBuffer*
-      messagesJSON(void);
+      //! Retrieve the gzip compressed JavaScript snapshot of the
+      //! latest messages. The snapshot is rebuilt at most every two
+      //! seconds and only if messages changed in the meantime.
+      //! @param[in] if_none_match entity tag known by the client.
+      //! @param[out] data compressed snapshot.
+      //! @param[out] etag entity tag of the snapshot.
+      //! @return false if the client's entity tag is still current
+      //! (data is left untouched), true otherwise.
+      bool
+      messagesJSON(const std::string& if_none_match, DUNE::Utils::ByteBuffer& data, std::string& etag);
 
       void
       updateMessage(const DUNE::IMC::Message* msg);
 
+      //! Retrieve the JSON representation of the latest messages.
+      //! @param[out] fragments JSON fragments indexed by message key.
+      void
+      getJSONFragments(std::map<uint64_t, std::string>& fragments);
+
+      //! Compute the key of a message: identifier in the upper 32
+      //! bits, sub-identifier and source entity in the lower ones.
+      //! @param msg message.
+      //! @return message key.
+      static uint64_t
+      getKey(const DUNE::IMC::Message* msg)
+      {
+        return (uint64_t)msg->getId() << 32 | msg->getSubId() << 8 | msg->getSourceEntity();
+      }
+
       void
       readLock(void)
       {
@@ -74,16 +97,35 @@ namespace Transports
       typedef std::map<unsigned, std::string> EntityMap;
       // Software meta information.
       std::string m_meta;
+      //! Latest message and its cached JSON representation.
+      struct Entry
+      {
+        //! Message.
+        DUNE::IMC::Message* msg;
+        //! JSON representation.
+        std::string json;
+        //! True if json is outdated.
+        bool dirty;
+      };
+
       // Table of messages.
-      std::map<unsigned, DUNE::IMC::Message*> m_msgs;
+      std::map<uint64_t, Entry> m_msgs;
       // Entity map.
       EntityMap m_entities;
       // Concurrency mutex.
       DUNE::Concurrency::Mutex m_mutex;
       // DUNE's UID.
       uint64_t m_uid;
+      // Number of changes to the table of messages.
+      uint64_t m_version;
+      // JSON snapshot mutex.
+      DUNE::Concurrency::Mutex m_json_mutex;
       // JSON messages.
       DUNE::Utils::ByteBuffer m_msgs_json;
+      // Entity tag of JSON messages.
+      std::string m_msgs_etag;
+      // Version of the table of messages in JSON messages.
+      uint64_t m_msgs_json_version;
       // Last JSON messages refresh.
       uint64_t m_last_msgs_json;
       //! Power channels.
@@ -91,6 +133,9 @@ namespace Transports
 
       void
       updatePowerChannel(const DUNE::IMC::PowerChannelState* msg);
+
+      void
+      refreshJSON(Entry& entry);
     };
   }
 }
@@ -43,15 +43,17 @@
 #include "RequestHandler.hpp"
 
 #define SERVER_VERSION "Server: DUNE/" DUNE_VERSION_STR "\r\n"
-#define STATUS_LINE_100 "HTTP/1.0 100 Continue\r\n"
-#define STATUS_LINE_200 "HTTP/1.0 200 OK\r\n"
-#define STATUS_LINE_201 "HTTP/1.0 201 Created\r\n"
-#define STATUS_LINE_206 "HTTP/1.0 206 Partial Content\r\n"
-#define STATUS_LINE_403 "HTTP/1.0 403 Forbidden\r\n"
-#define STATUS_LINE_404 "HTTP/1.0 404 Not Found\r\n"
-#define STATUS_LINE_416 "HTTP/1.0 416 Requested Range Not Satisfiable\r\n"
-#define STATUS_LINE_500 "HTTP/1.0 500 Internal Server Error\r\n"
-#define STATUS_LINE_503 "HTTP/1.0 503 Service Unavailable\r\n"
+#define STATUS_LINE_100 "HTTP/1.1 100 Continue\r\n"
+#define STATUS_LINE_200 "HTTP/1.1 200 OK\r\n"
+#define STATUS_LINE_201 "HTTP/1.1 201 Created\r\n"
+#define STATUS_LINE_206 "HTTP/1.1 206 Partial Content\r\n"
+#define STATUS_LINE_304 "HTTP/1.1 304 Not Modified\r\n"
+#define STATUS_LINE_400 "HTTP/1.1 400 Bad Request\r\n"
+#define STATUS_LINE_403 "HTTP/1.1 403 Forbidden\r\n"
+#define STATUS_LINE_404 "HTTP/1.1 404 Not Found\r\n"
+#define STATUS_LINE_416 "HTTP/1.1 416 Requested Range Not Satisfiable\r\n"
+#define STATUS_LINE_500 "HTTP/1.1 500 Internal Server Error\r\n"
+#define STATUS_LINE_503 "HTTP/1.1 503 Service Unavailable\r\n"
 
 namespace Transports
 {
@@ -59,6 +61,8 @@ namespace Transports
   {
     // Maximum size of a request.
     static const unsigned c_max_request_size = 2048;
+    // Idle timeout of persistent connections advertised to clients.
+    static const unsigned c_keep_alive_timeout = 15;
 
     void
     RequestHandler::sendHeader(TCPSocket* sock, const char* status_line, int64_t length, HeaderFieldsMap* hdr_fields)
@@ -75,6 +79,12 @@ namespace Transports
          << "Expires: " << now << "\r\n"
          << "Accept-Ranges: " << "bytes" << "\r\n";
 
+      if (m_keep_alive.value())
+        ss << "Connection: keep-alive\r\n"
+           << "Keep-Alive: timeout=" << c_keep_alive_timeout << "\r\n";
+      else
+        ss << "Connection: close\r\n";
+
       // Add extra header fields.
       if (hdr_fields)
       {
@@ -104,6 +114,12 @@ namespace Transports
       sock->write("OK", 2);
     }
 
+    void
+    RequestHandler::sendResponse304(TCPSocket* sock, HeaderFieldsMap* hdr_fields)
+    {
+      sendHeader(sock, STATUS_LINE_304, 0, hdr_fields);
+    }
+
     void
     RequestHandler::sendResponse201(TCPSocket* sock)
     {
@@ -111,6 +127,13 @@ namespace Transports
       sock->write("Created", 7);
     }
 
+    void
+    RequestHandler::sendResponse400(TCPSocket* sock, const std::string& message)
+    {
+      sendHeader(sock, STATUS_LINE_400, message.size());
+      sock->write(message.c_str(), message.size());
+    }
+
     void
     RequestHandler::sendResponse403(TCPSocket* sock)
     {
@@ -156,7 +179,7 @@ namespace Transports
 
       while (remaining > 0)
       {
-        rv = sock->write(data, size);
+        rv = sock->write(data + size - remaining, remaining);
 
         if (rv < 0)
         {
@@ -239,11 +262,12 @@ namespace Transports
       sendResponse404(sock);
     }
 
-    void
+    RequestHandler::ConnectionDisposition
     RequestHandler::handleRequest(TCPSocket* sock)
     {
       char mtd[16];
       char uri[512];
+      char ver[16] = {0};
       char bfr[c_max_request_size] = {0};
 
       // Search for end of request.
@@ -279,7 +303,7 @@ namespace Transports
       if (size <= 0)
       {
         DUNE_WRN("HTTP", "request too short");
-        return;
+        return CD_CLOSE;
       }
 
       char* hdr = new char[size + 1];
@@ -287,13 +311,30 @@ namespace Transports
       hdr[size] = 0;
 
       Utils::TupleList headers(hdr, ":", "\r\n", true);
+      bool keep_alive = false;
+      m_detached = false;
 
       // Parse request line.
-      if (std::sscanf(hdr, "%s %s %*s", mtd, uri) == 2)
+      if (std::sscanf(hdr, "%15s %511s %15s", mtd, uri, ver) >= 2)
       {
+        // HTTP/1.1 connections are persistent unless the client asks
+        // otherwise, HTTP/1.0 ones only if the client asks for it.
+        std::string con = headers.get("connection");
+        Utils::String::toLowerCase(con);
+        if (std::strcmp(ver, "HTTP/1.1") == 0)
+          keep_alive = (con != "close");
+        else
+          keep_alive = (con == "keep-alive");
+
+        // Request bodies are not always fully consumed by handlers.
+        if (std::strcmp(mtd, "GET") != 0)
+          keep_alive = false;
+
         std::string uri_dec = URL::decode(uri);
         const char* uri_clean = uri_dec.c_str();
 
+        m_keep_alive = keep_alive;
+
         if (std::strcmp(mtd, "GET") == 0)
         {
           handleGET(sock, headers, uri_clean);
@@ -306,9 +347,19 @@ namespace Transports
         {
           handlePUT(sock, headers, uri_clean);
         }
+
+        m_keep_alive = false;
       }
 
       delete[] hdr;
+
+      if (m_detached.value())
+      {
+        m_detached = false;
+        return CD_DETACHED;
+      }
+
+      return (eor && keep_alive) ? CD_KEEP_ALIVE : CD_CLOSE;
     }
   }
 }
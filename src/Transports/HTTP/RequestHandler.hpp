@@ -47,6 +47,17 @@ namespace Transports
     public:
       typedef std::map<std::string, std::string> HeaderFieldsMap;
 
+      //! What to do with a connection after handling a request.
+      enum ConnectionDisposition
+      {
+        //! Close the connection.
+        CD_CLOSE,
+        //! Keep the connection open for further requests.
+        CD_KEEP_ALIVE,
+        //! The connection was taken over by the request handler.
+        CD_DETACHED
+      };
+
       RequestHandler(void)
       { }
 
@@ -75,6 +86,18 @@ namespace Transports
       void
       sendResponse200(TCPSocket* sock);
 
+      void
+      sendResponse304(TCPSocket* sock, HeaderFieldsMap* hdr_fields = 0);
+
+      void
+      sendResponse400(TCPSocket* sock, const std::string& message);
+
+      inline void
+      sendResponse400(TCPSocket* sock)
+      {
+        sendResponse400(sock, "Bad Request");
+      }
+
       void
       sendResponse403(TCPSocket* sock);
 
@@ -108,8 +131,28 @@ namespace Transports
       void
       sendFile(TCPSocket* sock, const std::string& file, HeaderFieldsMap& hdr_fields, int64_t off_beg = -1, int64_t off_end = -1);
 
-      void
+      //! Read and handle one request.
+      //! @param sock connection socket.
+      //! @return what to do with the connection.
+      ConnectionDisposition
       handleRequest(TCPSocket* sock);
+
+    protected:
+      //! Signal that the handler of the current request took
+      //! ownership of the connection socket.
+      void
+      detach(void)
+      {
+        m_detached = true;
+      }
+
+    private:
+      //! True if the request being handled by the calling thread
+      //! uses a persistent connection.
+      Concurrency::TLS<bool> m_keep_alive;
+      //! True if the handler of the request being handled by the
+      //! calling thread took ownership of the connection.
+      Concurrency::TLS<bool> m_detached;
     };
   }
 }
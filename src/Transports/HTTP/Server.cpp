@@ -45,15 +45,22 @@ namespace Transports
 {
   namespace HTTP
   {
+    //! Seconds after which idle persistent connections are closed.
+    static const double c_keep_alive_timeout = 15.0;
+    //! Maximum number of idle persistent connections.
+    static const unsigned c_max_idle = 128;
+
     class Handler: public Concurrency::Thread
     {
     public:
-      Handler(RequestHandler& hdler, Concurrency::TSQueue<TCPSocket*>& queue):
+      Handler(Server& server, RequestHandler& hdler, Concurrency::TSQueue<TCPSocket*>& queue):
+        m_server(server),
         m_handler(hdler),
         m_queue(queue)
       { }
 
     private:
+      Server& m_server;
       RequestHandler& m_handler;
       Concurrency::TSQueue<TCPSocket*>& m_queue;
 
@@ -72,14 +79,19 @@ namespace Transports
           if (!sock)
             continue;
 
+          RequestHandler::ConnectionDisposition disp = RequestHandler::CD_CLOSE;
+
           try
           {
-            m_handler.handleRequest(sock);
+            disp = m_handler.handleRequest(sock);
           }
           catch (...)
           { }
 
-          delete sock;
+          if (disp == RequestHandler::CD_KEEP_ALIVE)
+            m_server.release(sock);
+          else if (disp == RequestHandler::CD_CLOSE)
+            delete sock;
         }
       }
     };
@@ -91,9 +103,13 @@ namespace Transports
       m_sock.listen(1024);
       m_poll.add(m_sock);
 
+      m_wakeup.bind(0, Address::Loopback);
+      m_wakeup_port = m_wakeup.getBoundPort();
+      m_poll.add(m_wakeup);
+
       for (unsigned int i = 0; i < threads; ++i)
       {
-        Concurrency::Thread* t = new Handler(handler, m_queue);
+        Concurrency::Thread* t = new Handler(*this, handler, m_queue);
         m_pool.push_back(t);
         t->start();
       }
@@ -121,19 +137,109 @@ namespace Transports
         if (sock)
           delete sock;
       }
+
+      while (!m_released.empty())
+        delete m_released.pop();
+
+      for (std::list<Connection>::iterator itr = m_idle.begin(); itr != m_idle.end(); ++itr)
+        delete itr->sock;
+    }
+
+    void
+    Server::release(TCPSocket* sock)
+    {
+      m_released.push(sock);
+
+      try
+      {
+        uint8_t byte = 0;
+        m_wakeup.write(&byte, 1, Address::Loopback, m_wakeup_port);
+      }
+      catch (std::runtime_error& e)
+      {
+        DUNE_ERR("Server", e.what());
+      }
+    }
+
+    void
+    Server::addIdle(TCPSocket* sock)
+    {
+      if (m_idle.size() >= c_max_idle)
+      {
+        m_poll.remove(*m_idle.front().sock);
+        delete m_idle.front().sock;
+        m_idle.pop_front();
+      }
+
+      Connection con;
+      con.sock = sock;
+      con.time = Clock::get();
+      m_idle.push_back(con);
+      m_poll.add(*sock);
+    }
+
+    void
+    Server::rearm(void)
+    {
+      while (!m_released.empty())
+        addIdle(m_released.pop());
+    }
+
+    void
+    Server::expire(void)
+    {
+      double now = Clock::get();
+
+      while (!m_idle.empty() && (now - m_idle.front().time) > c_keep_alive_timeout)
+      {
+        m_poll.remove(*m_idle.front().sock);
+        delete m_idle.front().sock;
+        m_idle.pop_front();
+      }
     }
 
     void
     Server::poll(double timeout)
     {
+      rearm();
+
       if (m_poll.poll(timeout))
       {
+        // Requests on idle connections.
+        std::list<Connection>::iterator itr = m_idle.begin();
+        while (itr != m_idle.end())
+        {
+          if (m_poll.wasTriggered(*itr->sock))
+          {
+            m_poll.remove(*itr->sock);
+            m_queue.push(itr->sock);
+            itr = m_idle.erase(itr);
+          }
+          else
+          {
+            ++itr;
+          }
+        }
+
+        if (m_poll.wasTriggered(m_wakeup))
+        {
+          try
+          {
+            uint8_t bfr[64];
+            m_wakeup.read(bfr, sizeof(bfr));
+          }
+          catch (std::runtime_error& e)
+          {
+            DUNE_ERR("Server", e.what());
+          }
+        }
+
         if (m_poll.wasTriggered(m_sock))
         {
           try
           {
             TCPSocket* nc = m_sock.accept();
-            m_queue.push(nc);
+            addIdle(nc);
           }
           catch (std::runtime_error& e)
           {
@@ -141,6 +247,9 @@ namespace Transports
           }
         }
       }
+
+      rearm();
+      expire();
     }
   }
 }
@@ -29,6 +29,7 @@
 #define TRANSPORTS_HTTP_SERVER_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <list>
 #include <vector>
 
 // DUNE headers.
@@ -41,6 +42,13 @@ namespace Transports
 {
   namespace HTTP
   {
+    //! HTTP server with persistent connections.
+    //!
+    //! Idle connections are multiplexed in the polling thread and
+    //! only handed to a worker thread when a request arrives, so
+    //! workers never block waiting on idle clients. After replying,
+    //! workers return persistent connections to the polling thread
+    //! and wake it up through a loopback datagram.
     class Server
     {
     public:
@@ -56,17 +64,49 @@ namespace Transports
       void
       poll(double timeout);
 
+      //! Return a persistent connection to the set of idle
+      //! connections. This function is thread-safe.
+      //! @param sock connection.
+      void
+      release(TCPSocket* sock);
+
     private:
+      //! Idle connection.
+      struct Connection
+      {
+        //! Connection socket.
+        TCPSocket* sock;
+        //! Time of last activity.
+        double time;
+      };
+
       //! HTTP request handler.
       RequestHandler& m_handler;
       //! Server socket.
       TCPSocket m_sock;
+      //! Wake up socket.
+      UDPSocket m_wakeup;
+      //! Wake up port.
+      uint16_t m_wakeup_port;
       //! Worker threads pool.
       std::vector<Concurrency::Thread*> m_pool;
       //! Socket queue.
       Concurrency::TSQueue<TCPSocket*> m_queue;
+      //! Connections returned by workers.
+      Concurrency::TSQueue<TCPSocket*> m_released;
+      //! Idle connections.
+      std::list<Connection> m_idle;
       //! I/O multiplexing.
       IO::Poll m_poll;
+
+      void
+      addIdle(TCPSocket* sock);
+
+      void
+      rearm(void);
+
+      void
+      expire(void);
     };
   }
 }
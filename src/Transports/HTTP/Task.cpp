@@ -38,6 +38,7 @@
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
+#include "EventStream.hpp"
 #include "MessageMonitor.hpp"
 #include "RequestHandler.hpp"
 #include "Server.hpp"
@@ -59,6 +60,8 @@ namespace Transports
       unsigned threads;
       //! List of messages to transport.
       std::vector<std::string> messages;
+      //! Maximum event rate of message streams.
+      double stream_rate;
     };
 
     //! Buffer length.
@@ -70,6 +73,8 @@ namespace Transports
     {
       //! HTTP server.
       Server* m_server;
+      //! Message event stream.
+      EventStream* m_stream;
       //! Configuration directory.
       std::string m_cfg_dir;
       //! Agent name.
@@ -83,6 +88,7 @@ namespace Transports
         Tasks::Task(name, ctx),
         RequestHandler(),
         m_server(NULL),
+        m_stream(NULL),
         m_msg_mon(getSystemName(), ctx.uid)
       {
         // Define configuration parameters.
@@ -98,6 +104,13 @@ namespace Transports
         .defaultValue("")
         .description("List of messages to transport");
 
+        param("Maximum Stream Rate", m_args.stream_rate)
+        .defaultValue("5.0")
+        .minimumValue("0.1")
+        .units(Units::Hertz)
+        .description("Maximum number of updates per second sent to each"
+                     " message stream client");
+
         m_cfg_dir = ctx.dir_cfg.str();
         m_agent = getSystemName();
       }
@@ -105,6 +118,9 @@ namespace Transports
       void
       onResourceAcquisition(void)
       {
+        m_stream = new EventStream;
+        m_stream->start();
+
         uint16_t last_port = m_args.port + c_max_port_tries;
 
         for (uint16_t port = m_args.port; port < last_port; ++port)
@@ -146,6 +162,12 @@ namespace Transports
       onResourceRelease(void)
       {
         Memory::clear(m_server);
+
+        if (m_stream != NULL)
+        {
+          m_stream->stopAndJoin();
+          Memory::clear(m_stream);
+        }
       }
 
       void
@@ -163,8 +185,13 @@ namespace Transports
       void
       consume(const IMC::Message* msg)
       {
-        if (msg->getSource() == getSystemId())
-          m_msg_mon.updateMessage(msg);
+        if (msg->getSource() != getSystemId())
+          return;
+
+        m_msg_mon.updateMessage(msg);
+
+        if (m_stream != NULL)
+          m_stream->publish(MessageMonitor::getKey(msg), msg);
       }
 
       static bool
@@ -200,6 +227,8 @@ namespace Transports
             sendAgentJSON(sock, headers, uri);
           else if (matchURL(uri, "/dune/state/messages.js"))
             showMessages(sock, headers, uri);
+          else if (matchURL(uri, "/dune/state/stream", true))
+            streamMessages(sock, headers, uri);
           else if (matchURL(uri, "/dune/power/channel/", true))
             handlePowerChannel(sock, headers, uri);
           else
@@ -321,15 +350,103 @@ namespace Transports
       void
       showMessages(TCPSocket* sock, TupleList& headers, const char* uri)
       {
-        (void)headers;
         (void)uri;
 
+        ByteBuffer bfr;
+        std::string etag;
         RequestHandler::HeaderFieldsMap hdr;
+
+        if (!m_msg_mon.messagesJSON(headers.get("if-none-match"), bfr, etag))
+        {
+          hdr["ETag"] = etag;
+          sendResponse304(sock, &hdr);
+          return;
+        }
+
         hdr["Content-Type"] = "text/javascript";
         hdr["Content-Encoding"] = "gzip";
+        if (!etag.empty())
+          hdr["ETag"] = etag;
+
+        sendData(sock, bfr.getBufferSigned(), bfr.getSize(), &hdr);
+      }
+
+      //! Stream message updates using Server-Sent Events. The optional
+      //! query parameters 'names' (message abbreviations), 'entities'
+      //! (entity labels or identifiers), both comma separated, and
+      //! 'rate' (maximum updates per second) filter the stream.
+      void
+      streamMessages(TCPSocket* sock, TupleList& headers, const char* uri)
+      {
+        (void)headers;
+
+        EventStream::Filter filter;
+        filter.rate = m_args.stream_rate;
+
+        const char* query = std::strchr(uri, '?');
+        if (query != NULL)
+        {
+          std::vector<std::string> params;
+          String::split(query + 1, "&", params);
+
+          for (size_t i = 0; i < params.size(); ++i)
+          {
+            std::vector<std::string> kv;
+            String::split(params[i], "=", kv);
+            if (kv.size() != 2)
+            {
+              sendResponse400(sock, "invalid query parameter: " + params[i]);
+              return;
+            }
+
+            std::vector<std::string> values;
+            String::split(kv[1], ",", values);
+
+            try
+            {
+              if (kv[0] == "names")
+              {
+                for (size_t j = 0; j < values.size(); ++j)
+                  filter.ids.insert(IMC::Factory::getIdFromAbbrev(values[j]));
+              }
+              else if (kv[0] == "entities")
+              {
+                for (size_t j = 0; j < values.size(); ++j)
+                {
+                  unsigned id = 0;
+                  if (castLexical(values[j], id))
+                    filter.entities.insert(id);
+                  else
+                    filter.entities.insert(m_ctx.entities.resolve(values[j]));
+                }
+              }
+              else if (kv[0] == "rate")
+              {
+                double rate = 0;
+                if (!castLexical(kv[1], rate) || rate <= 0)
+                  throw std::runtime_error("invalid rate: " + kv[1]);
+
+                filter.rate = std::min(rate, m_args.stream_rate);
+              }
+            }
+            catch (std::exception& e)
+            {
+              sendResponse400(sock, e.what());
+              return;
+            }
+          }
+        }
+
+        std::map<uint64_t, std::string> initial;
+        m_msg_mon.getJSONFragments(initial);
+
+        if (!m_stream->add(sock, filter, initial))
+        {
+          sendResponse503(sock);
+          return;
+        }
 
-        ByteBuffer* bfr = m_msg_mon.messagesJSON();
-        sendData(sock, bfr->getBufferSigned(), bfr->getSize(), &hdr);
+        detach();
       }
 
       void
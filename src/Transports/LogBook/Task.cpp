@@ -61,6 +61,8 @@ namespace Transports
 
         bind<IMC::LogBookEntry>(this);
         bind<IMC::LogBookControl>(this);
+
+        setCooperative();
       }
 
       void
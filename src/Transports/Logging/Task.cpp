@@ -56,6 +56,10 @@ namespace Transports
       unsigned lsf_volume_size;
       // Compression method.
       std::string lsf_compression;
+      // Rate limits.
+      std::vector<std::string> rate_lims;
+      // Filtered entities.
+      std::vector<std::string> entities_flt;
     };
 
     struct Task: public Tasks::Task
@@ -80,6 +84,8 @@ namespace Transports
       IMC::LoggingControl m_log_ctl;
       // True if logging is enabled.
       bool m_active;
+      // Rate limiters and filtered entities.
+      Tasks::MessageFilter m_filter;
       // Task arguments.
       Arguments m_args;
 
@@ -109,12 +115,22 @@ namespace Transports
         param("Transports", m_args.messages)
         .defaultValue("");
 
+        param("Rate Limiters", m_args.rate_lims)
+        .defaultValue("")
+        .description("List of <Message>:<Frequency>[:<Burst>]");
+
+        param("Filtered Entities", m_args.entities_flt)
+        .defaultValue("")
+        .description("List of <Message>:<Entity>+<Entity> that define the source entities allowed to pass message of a specific message type.");
+
         m_log_ctl.setSource(getSystemId());
 
         bind<IMC::CacheControl>(this);
         bind<IMC::LoggingControl>(this);
         bind<IMC::PowerOperation>(this);
         bind<IMC::EntityInfo>(this);
+
+        setCooperative();
       }
 
       ~Task(void)
@@ -132,6 +148,7 @@ namespace Transports
       void
       onResourceRelease(void)
       {
+        m_filter.report(*this);
         Memory::clear(m_lsf);
       }
 
@@ -142,6 +159,9 @@ namespace Transports
         if (m_args.lsf_volumes.empty())
           m_args.lsf_volumes.push_back("");
 
+        m_filter.report(*this);
+        m_filter.setup(m_args.rate_lims, m_args.entities_flt, m_ctx.entities);
+
         bind(this, m_args.messages);
       }
 
@@ -216,7 +236,7 @@ namespace Transports
       void
       consume(const IMC::Message* msg)
       {
-        if (m_active)
+        if (m_active && !m_filter.filter(msg))
           logMessage(msg);
       }
 
@@ -370,11 +390,22 @@ namespace Transports
       void
       tryFlush(void)
       {
+        if (!m_active)
+          return;
+
         double now = Clock::get();
 
         if (now > (m_last_flush + m_args.flush_interval))
         {
-          tryRotate();
+          try
+          {
+            tryRotate();
+          }
+          catch (std::exception& e)
+          {
+            throw RestartNeeded(e.what(), 5);
+          }
+
           m_last_flush = now;
         }
       }
@@ -423,6 +454,22 @@ namespace Transports
         m_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
       }
 
+      double
+      onJob(bool restarted)
+      {
+        if (restarted)
+        {
+          changeVolumeDirectory();
+
+          tryStartLog();
+        }
+
+        consumeMessages();
+        tryFlush();
+
+        return Clock::get() + 1.0;
+      }
+
       void
       onMain(void)
       {
@@ -433,17 +480,7 @@ namespace Transports
         while (!stopping())
         {
           waitForMessages(1.0);
-          if (m_active)
-          {
-            try
-            {
-              tryFlush();
-            }
-            catch(std::exception& e)
-            {
-              throw RestartNeeded(e.what(), 5);
-            }
-          }
+          tryFlush();
         }
       }
     };
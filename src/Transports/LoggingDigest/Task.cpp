@@ -46,6 +46,10 @@ namespace Transports
       std::string lsf_name;
       //! Log file folder.
       std::string log_folder;
+      //! Rate limits.
+      std::vector<std::string> rate_lims;
+      //! Filtered entities.
+      std::vector<std::string> entities_flt;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -60,6 +64,8 @@ namespace Transports
       Counter<double> m_flush_timer;
       //! Serialization buffer.
       ByteBuffer m_buffer;
+      //! Rate limiters and filtered entities.
+      Tasks::MessageFilter m_filter;
       //! Task arguments.
       Arguments m_args;
 
@@ -90,6 +96,14 @@ namespace Transports
         param("Transports", m_args.messages)
         .defaultValue("");
 
+        param("Rate Limiters", m_args.rate_lims)
+        .defaultValue("")
+        .description("List of <Message>:<Frequency>[:<Burst>]");
+
+        param("Filtered Entities", m_args.entities_flt)
+        .defaultValue("")
+        .description("List of <Message>:<Entity>+<Entity> that define the source entities allowed to pass message of a specific message type.");
+
         bind<IMC::LoggingControl>(this);
         bind<IMC::EntityInfo>(this);
       }
@@ -112,6 +126,12 @@ namespace Transports
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
+      void
+      onResourceRelease(void)
+      {
+        m_filter.report(*this);
+      }
+
       //! Update internal state with new parameter values.
       void
       onUpdateParameters(void)
@@ -122,6 +142,9 @@ namespace Transports
         if (paramChanged(m_args.flush_interval))
           m_flush_timer.setTop(m_args.flush_interval);
 
+        m_filter.report(*this);
+        m_filter.setup(m_args.rate_lims, m_args.entities_flt, m_ctx.entities);
+
         bind(this, m_args.messages);
       }
 
@@ -216,6 +239,9 @@ namespace Transports
       void
       consume(const IMC::Message* msg)
       {
+        if (m_filter.filter(msg))
+          return;
+
         uint32_t key = getKey(msg);
 
         std::map<uint32_t, IMC::Message*>::iterator itr = m_messages.find(key);
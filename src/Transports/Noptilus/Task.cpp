@@ -113,6 +113,8 @@ namespace Transports
         bind<IMC::GpsFix>(this);
         bind<IMC::NavigationUncertainty>(this);
         bind<IMC::UamRxFrame>(this);
+
+        setCooperative();
       }
 
       ~Task(void)
@@ -0,0 +1,118 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_SHARED_MEMORY_LISTENER_HPP_INCLUDED_
+#define TRANSPORTS_SHARED_MEMORY_LISTENER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace SharedMemory
+  {
+    using DUNE_NAMESPACES;
+
+    //! Consumer of one inbound ring. Messages are deserialized
+    //! straight from shared memory and dispatched to the bus.
+    class Listener: public Concurrency::Thread
+    {
+    public:
+      //! Constructor. The ring is created immediately.
+      //! @param[in] task parent task.
+      //! @param[in] peer name of the producing system.
+      //! @param[in] ring_name name of the inbound ring.
+      //! @param[in] capacity ring capacity in bytes.
+      //! @param[in] trace true to print incoming messages.
+      Listener(Tasks::Task& task, const std::string& peer, const std::string& ring_name,
+               unsigned capacity, bool trace = false):
+        m_task(task),
+        m_peer(peer),
+        m_ring(ring_name.c_str(), capacity),
+        m_trace(trace)
+      {
+        m_ring.create();
+      }
+
+    private:
+      // Wait timeout in milliseconds.
+      static const int c_wait_tout = 1000;
+      // Parent task.
+      Tasks::Task& m_task;
+      // Producer name.
+      std::string m_peer;
+      // Inbound ring.
+      SharedRingBuffer m_ring;
+      // True to print incoming messages.
+      bool m_trace;
+
+      void
+      run(void)
+      {
+        while (!isStopping())
+        {
+          if (!m_ring.wait(c_wait_tout / 1000.0))
+            continue;
+
+          unsigned size = 0;
+          const uint8_t* data = NULL;
+          while ((data = m_ring.peek(size)) != NULL)
+          {
+            IMC::Message* msg = NULL;
+
+            try
+            {
+              msg = IMC::Packet::deserialize(data, size);
+            }
+            catch (std::exception& e)
+            {
+              m_task.debug("error while unpacking message from %s: %s",
+                           m_peer.c_str(), e.what());
+            }
+
+            m_ring.release();
+
+            if (msg == NULL)
+              continue;
+
+            m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+
+            if (m_trace)
+              msg->toText(std::cerr);
+
+            delete msg;
+          }
+        }
+      }
+    };
+  }
+}
+
+#endif
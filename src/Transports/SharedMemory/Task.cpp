@@ -0,0 +1,285 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Listener.hpp"
+
+namespace Transports
+{
+  //! Exchange of IMC messages between DUNE instances running on the
+  //! same host using one single-producer single-consumer ring in
+  //! shared memory per direction and peer.
+  //!
+  //! Outgoing messages are serialized directly into the peer's ring
+  //! and incoming messages are deserialized directly from our rings,
+  //! thus avoiding the kernel copies and context switches of the UDP
+  //! loopback path. Rings are named after the producing and consuming
+  //! systems, each instance creates its inbound rings and attaches to
+  //! the outbound rings of its peers as soon as they are available.
+  //!
+  //! @author Ricardo Martins
+  namespace SharedMemory
+  {
+    using DUNE_NAMESPACES;
+
+    //! Outbound ring state.
+    struct Peer
+    {
+      //! Peer system name.
+      std::string name;
+      //! Ring where messages for this peer are written.
+      SharedRingBuffer* ring;
+      //! Number of messages dropped because the ring was full.
+      unsigned drops;
+    };
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      // Peer systems.
+      std::vector<std::string> peers;
+      // Ring capacity.
+      unsigned capacity;
+      // Trace incoming messages.
+      bool trace_in;
+      // Trace outgoing messages.
+      bool trace_out;
+      // Rate limits.
+      std::vector<std::string> rate_lims;
+      // List of messages to publish.
+      std::vector<std::string> messages;
+    };
+
+    // Period of attempts to attach to peer rings (s).
+    static const double c_attach_period = 1.0;
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Outbound rings.
+      std::vector<Peer> m_peers;
+      //! Inbound ring consumers.
+      std::vector<Listener*> m_listeners;
+      //! Rate limiters.
+      Tasks::MessageFilter m_filter;
+      //! Attach retry timer.
+      Time::Counter<double> m_attach_timer;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx)
+      {
+        param("Peers", m_args.peers)
+        .defaultValue("")
+        .description("List of names of systems running on this host that will exchange messages with us");
+
+        param("Ring Capacity", m_args.capacity)
+        .defaultValue("262144")
+        .minimumValue("4096")
+        .units(Units::Byte)
+        .description("Capacity of each ring, must be equal on all peers");
+
+        param("Print Outgoing Messages", m_args.trace_out)
+        .defaultValue("false")
+        .description("Print outgoing messages (Debug)");
+
+        param("Print Incoming Messages", m_args.trace_in)
+        .defaultValue("false")
+        .description("Print incoming messages (Debug)");
+
+        param("Rate Limiters", m_args.rate_lims)
+        .description("List of <Message>:<Frequency>[:<Burst>]");
+
+        param("Transports", m_args.messages)
+        .defaultValue("")
+        .description("List of messages to transport");
+
+        m_attach_timer.setTop(c_attach_period);
+      }
+
+      ~Task(void)
+      {
+        onResourceRelease();
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_filter.report(*this);
+        m_filter.setup(m_args.rate_lims);
+        bind(this, m_args.messages);
+      }
+
+      //! Get the name of the ring carrying messages between two systems.
+      //! @param[in] src producer name.
+      //! @param[in] dst consumer name.
+      //! @return ring name.
+      static std::string
+      getRingName(const std::string& src, const std::string& dst)
+      {
+        return "imc-" + src + "-" + dst;
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        for (unsigned i = 0; i < m_args.peers.size(); ++i)
+        {
+          std::string ring = getRingName(m_args.peers[i], getSystemName());
+
+          try
+          {
+            Listener* listener = new Listener(*this, m_args.peers[i], ring,
+                                              m_args.capacity, m_args.trace_in);
+            listener->start();
+            m_listeners.push_back(listener);
+          }
+          catch (std::exception& e)
+          {
+            throw RestartNeeded(String::str(DTR("failed to create ring '%s': %s"),
+                                            ring.c_str(), e.what()), 5.0);
+          }
+
+          Peer peer;
+          peer.name = m_args.peers[i];
+          peer.ring = new SharedRingBuffer(getRingName(getSystemName(), m_args.peers[i]).c_str(),
+                                           m_args.capacity);
+          peer.drops = 0;
+          m_peers.push_back(peer);
+        }
+
+        attach();
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        m_filter.report(*this);
+
+        for (unsigned i = 0; i < m_listeners.size(); ++i)
+        {
+          m_listeners[i]->stopAndJoin();
+          delete m_listeners[i];
+        }
+        m_listeners.clear();
+
+        for (unsigned i = 0; i < m_peers.size(); ++i)
+          delete m_peers[i].ring;
+        m_peers.clear();
+      }
+
+      //! Attach to the rings of peers that are not being served.
+      void
+      attach(void)
+      {
+        for (unsigned i = 0; i < m_peers.size(); ++i)
+        {
+          Peer& peer = m_peers[i];
+          if (peer.ring->isOpen())
+          {
+            if (peer.ring->checkConsumer())
+              continue;
+
+            war(DTR("consumer of '%s' is gone"), peer.name.c_str());
+          }
+
+          try
+          {
+            peer.ring->open();
+            peer.drops = 0;
+            inf(DTR("attached to '%s'"), peer.name.c_str());
+          }
+          catch (std::exception& e)
+          {
+            debug("unable to attach to '%s': %s", peer.name.c_str(), e.what());
+          }
+        }
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        if (m_filter.filter(msg))
+          return;
+
+        if (m_args.trace_out)
+          msg->toText(std::cerr);
+
+        unsigned size = msg->getSerializationSize();
+
+        for (unsigned i = 0; i < m_peers.size(); ++i)
+        {
+          Peer& peer = m_peers[i];
+          if (!peer.ring->isOpen())
+            continue;
+
+          uint8_t* bfr = peer.ring->reserve(size);
+          if (bfr == NULL)
+          {
+            if (peer.drops++ == 0)
+              war(DTR("ring of '%s' is full, dropping messages"), peer.name.c_str());
+            continue;
+          }
+
+          if (peer.drops > 0)
+          {
+            war(DTR("ring of '%s' recovered after dropping %u messages"),
+                peer.name.c_str(), peer.drops);
+            peer.drops = 0;
+          }
+
+          peer.ring->commit(IMC::Packet::serialize(msg, bfr, size));
+        }
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(1.0);
+
+          if (m_attach_timer.overflow())
+          {
+            attach();
+            m_attach_timer.reset();
+          }
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -47,18 +47,6 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
-    //! Vector for Entity Mapping.
-    typedef std::vector<uint32_t> Entities;
-
-    //! Structure that contains information about rate info.
-    struct RateInfo
-    {
-      // Interval between sending the same message (s).
-      double rate;
-      // Last time a given message type was sent.
-      double last;
-    };
-
     //! %Task arguments.
     struct Arguments
     {
@@ -103,12 +91,8 @@ namespace Transports
       UDPSocket m_sock;
       //! Set of static nodes.
       std::set<NodeAddress> m_static_dsts;
-      //! Message rate information: rates per message id.
-      std::map<uint32_t, double> m_rates_per_id;
-      //! Message rate information: rates per key id.
-      std::map<uint32_t, RateInfo> m_rates;
-      //! List of entities to be passed by given message.
-      std::map<uint32_t, Entities> m_filtered;
+      //! Rate limiters and filtered entities.
+      Tasks::MessageFilter m_filter;
       //! Set of destination nodes.
       NodeTable m_node_table;
       //! Task arguments.
@@ -154,7 +138,7 @@ namespace Transports
         .description("List of <IPv4>:<Port> destinations that will always receive outgoing messages");
 
         param("Rate Limiters", m_args.rate_lims)
-        .description("List of <Message>:<Frequency>");
+        .description("List of <Message>:<Frequency>[:<Burst>]");
 
         param("Filtered Entities", m_args.entities_flt)
         .description("List of <Message>:<Entity>+<Entity> that define the source entities allowed to pass message of a specific message type.");
@@ -204,51 +188,12 @@ namespace Transports
         for (unsigned int i = 0; i < m_args.destinations.size(); ++i)
           m_static_dsts.insert(NodeAddress(m_args.destinations[i]));
 
-        // Process rate limiters.
-        m_rates_per_id.clear();
-        m_rates.clear();
-        for (unsigned int i = 0; i < m_args.rate_lims.size(); ++i)
-        {
-          std::vector<std::string> parts;
-          String::split(m_args.rate_lims[i], ":", parts);
-          if (parts.size() != 2)
-            continue;
-
-          uint32_t id = IMC::Factory::getIdFromAbbrev(parts[0]);
-          float rate = 0;
-          std::sscanf(parts[1].c_str(), "%f", &rate);
-          m_rates_per_id[id] = 1.0 / rate;
-        }
-
-        // Process filtered entities.
-        m_filtered.clear();
-        for (unsigned int i = 0; i < m_args.entities_flt.size(); ++i)
-        {
-          std::vector<std::string> parts;
-          String::split(m_args.entities_flt[i], ":", parts);
-          if (parts.size() != 2)
-            continue;
-
-          // Split entities.
-          uint32_t id = IMC::Factory::getIdFromAbbrev(parts[0]);
-          std::vector<std::string> entities;
-          String::split(parts[1], "+", entities);
-          m_filtered[id].resize(entities.size());
-
-          // Resolve entities id.
-          for (unsigned j = 0; j < entities.size(); j++)
-          {
-            // Resolve entities.
-            try
-            {
-              m_filtered[id][j] = resolveEntity(entities[j]);
-            }
-            catch (...)
-            {
-              m_filtered[id][j] = UINT_MAX;
-            }
-          }
-        }
+        // Process rate limiters and filtered entities. Messages are
+        // limited per source entity and sub-identifier, as different
+        // sub-identifiers carry distinct data (e.g., by beacon).
+        m_filter.report(*this);
+        m_filter.setKeyBySubId(true);
+        m_filter.setup(m_args.rate_lims, m_args.entities_flt, m_ctx.entities);
 
         m_underwater_comms = m_args.underwater_comms;
 
@@ -335,6 +280,8 @@ namespace Transports
       void
       onResourceRelease(void)
       {
+        m_filter.report(*this);
+
         if (m_listener != NULL)
         {
           m_listener->stopAndJoin();
@@ -357,36 +304,8 @@ namespace Transports
         if (m_node_table.getActiveCount() == 0 && m_static_dsts.size() == 0)
           return;
 
-        uint32_t key = (msg->getId() << 16) + (msg->getSourceEntity() << 8) + (msg->getSubId() & 0xff);
-
-        // Filter message by entity.
-        if (m_filtered[msg->getId()].size() > 0)
-        {
-          bool matched = false;
-          std::vector<uint32_t>::iterator itr = m_filtered[msg->getId()].begin();
-          for (; itr != m_filtered[msg->getId()].end(); ++itr)
-          {
-            if (*itr == msg->getSourceEntity())
-              matched = true;
-          }
-
-          // This entity is not listed to be passed.
-          if (!matched)
-            return;
-        }
-
-        if (m_rates.find(key) == m_rates.end())
-        {
-          m_rates[key].rate = m_rates_per_id[msg->getId()];
-          m_rates[key].last = 0.0;
-        }
-        else
-        {
-          double now = Clock::get();
-          if (m_rates[key].last + m_rates[key].rate >= now)
-            return;
-          m_rates[key].last = now;
-        }
+        if (m_filter.filter(msg))
+          return;
 
         if (m_args.trace_out)
           msg->toText(std::cerr);